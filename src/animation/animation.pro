@@ -6,6 +6,16 @@ MODULE = 3danimation
 
 QT += core-private 3dcore-private 3drender 3drender-private
 
+qtConfig(qt3d-simd-avx2) {
+    CONFIG += simd
+    QMAKE_CXXFLAGS += $$QMAKE_CFLAGS_AVX2
+}
+
+qtConfig(qt3d-simd-sse2):!qtConfig(qt3d-simd-avx2) {
+    CONFIG += simd
+    QMAKE_CXXFLAGS += $$QMAKE_CFLAGS_SSE2
+}
+
 include(frontend/frontend.pri)
 include(backend/backend.pri)
 
@@ -53,7 +53,9 @@ public:
 
     void postFrame(Qt3DCore::QAspectManager *manager) override;
 
-    AnimationRecord m_record;
+    void applyRecord(Qt3DCore::QAspectManager *manager, const AnimationRecord &record);
+
+    QVector<AnimationRecord> m_records;
     QVector<AnimationCallbackAndValue> m_callbacks;
 };
 
@@ -64,34 +66,58 @@ AbstractEvaluateClipAnimatorJob::AbstractEvaluateClipAnimatorJob()
 
 void AbstractEvaluateClipAnimatorJob::setPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks)
 {
-    auto mainThreadCB = callbacks;
-    mainThreadCB.erase(std::remove_if(mainThreadCB.begin(), mainThreadCB.end(), [](const AnimationCallbackAndValue &callback) {
-                        if (callback.flags.testFlag(QAnimationCallback::OnThreadPool)) {
-                            // call these now and remove them from the list
-                            callback.callback->valueChanged(callback.value);
-                            return true;
-                        }
-                        return false;
-                    }), mainThreadCB.end());
-    // Should now only have callbacks to be called on main thread
+    clearPostFrameData();
+    addPostFrameData(record, callbacks);
+}
 
+void AbstractEvaluateClipAnimatorJob::addPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks)
+{
     Q_D(AbstractEvaluateClipAnimatorJob);
-    d->m_record = record;
-    d->m_callbacks = mainThreadCB;
+    for (const AnimationCallbackAndValue &callback : callbacks) {
+        if (callback.flags.testFlag(QAnimationCallback::OnThreadPool)) {
+            // call these now, the others are called on the main thread
+            callback.callback->valueChanged(callback.value);
+        } else {
+            d->m_callbacks.push_back(callback);
+        }
+    }
+    d->m_records.push_back(record);
+}
+
+void AbstractEvaluateClipAnimatorJob::clearPostFrameData()
+{
+    Q_D(AbstractEvaluateClipAnimatorJob);
+    d->m_records.clear();
+    d->m_callbacks.clear();
 }
 
 void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager *manager)
 {
-    if (m_record.animatorId.isNull())
+    for (const AnimationRecord &record : qAsConst(m_records))
+        applyRecord(manager, record);
+
+    for (const AnimationCallbackAndValue &callback: qAsConst(m_callbacks)) {
+        if (callback.callback)
+            callback.callback->valueChanged(callback.value);
+    }
+
+    m_records.clear();
+    m_callbacks.clear();
+}
+
+void AbstractEvaluateClipAnimatorJobPrivate::applyRecord(Qt3DCore::QAspectManager *manager,
+                                                         const AnimationRecord &record)
+{
+    if (record.animatorId.isNull())
         return;
 
-    for (auto targetData : qAsConst(m_record.targetChanges)) {
+    for (auto targetData : qAsConst(record.targetChanges)) {
         Qt3DCore::QNode *node = manager->lookupNode(targetData.targetId);
         if (node)
             node->setProperty(targetData.propertyName, targetData.value);
     }
 
-    for (auto skeletonData : qAsConst(m_record.skeletonChanges)) {
+    for (auto skeletonData : qAsConst(record.skeletonChanges)) {
         Qt3DCore::QAbstractSkeleton *node = qobject_cast<Qt3DCore::QAbstractSkeleton *>(manager->lookupNode(skeletonData.first));
         if (node) {
             auto d = Qt3DCore::QAbstractSkeletonPrivate::get(node);
@@ -100,20 +126,13 @@ void AbstractEvaluateClipAnimatorJobPrivate::postFrame(Qt3DCore::QAspectManager
         }
     }
 
-    QAbstractClipAnimator *animator = qobject_cast<QAbstractClipAnimator *>(manager->lookupNode(m_record.animatorId));
+    QAbstractClipAnimator *animator = qobject_cast<QAbstractClipAnimator *>(manager->lookupNode(record.animatorId));
     if (animator) {
-        if (isValidNormalizedTime(m_record.normalizedTime))
-            animator->setNormalizedTime(m_record.normalizedTime);
-        if (m_record.finalFrame)
+        if (isValidNormalizedTime(record.normalizedTime))
+            animator->setNormalizedTime(record.normalizedTime);
+        if (record.finalFrame)
             animator->setRunning(false);
     }
-
-    for (const AnimationCallbackAndValue &callback: qAsConst(m_callbacks)) {
-        if (callback.callback)
-            callback.callback->valueChanged(callback.value);
-    }
-
-    m_record = {};
 }
 
 } // Animation
@@ -64,6 +64,10 @@ protected:
     AbstractEvaluateClipAnimatorJob();
 
     void setPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks);
+    // Used by jobs evaluating several animators, the results are all
+    // applied in postFrame
+    void addPostFrameData(const AnimationRecord &record, const QVector<AnimationCallbackAndValue> &callbacks);
+    void clearPostFrameData();
 
 private:
     Q_DECLARE_PRIVATE(AbstractEvaluateClipAnimatorJob)
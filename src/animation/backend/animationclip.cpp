@@ -51,6 +51,8 @@
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qurlquery.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 #define ANIMATION_INDEX_KEY     QLatin1String("animationIndex")
@@ -154,6 +156,7 @@ void AnimationClip::loadAnimation()
     setDuration(t);
 
     m_channelComponentCount = findChannelComponentCount();
+    buildEvaluationPlan();
 
     // If using a loader inform the frontend of the status change
     if (m_source.isEmpty()) {
@@ -339,16 +342,16 @@ int AnimationClip::channelIndex(const QString &channelName, int jointIndex) cons
  */
 int AnimationClip::channelComponentBaseIndex(int channelIndex) const
 {
-    int index = 0;
-    for (int i = 0; i < channelIndex; ++i)
-        index += m_channels[i].channelComponents.size();
-    return index;
+    if (channelIndex < m_evaluationPlan.size())
+        return m_evaluationPlan[channelIndex].componentOffset;
+    return m_channelComponentCount;
 }
 
 void AnimationClip::clearData()
 {
     m_name.clear();
     m_channels.clear();
+    m_evaluationPlan.clear();
 }
 
 float AnimationClip::findDuration()
@@ -373,6 +376,37 @@ int AnimationClip::findChannelComponentCount()
     return channelCount;
 }
 
+void AnimationClip::buildEvaluationPlan()
+{
+    m_evaluationPlan.resize(m_channels.size());
+
+    int offset = 0;
+    for (int i = 0, m = m_channels.size(); i < m; ++i) {
+        const Channel &channel = m_channels[i];
+        ChannelEvaluationPlan &plan = m_evaluationPlan[i];
+        plan.componentOffset = offset;
+        plan.componentCount = channel.channelComponents.size();
+        plan.interpolation = ChannelEvaluationPlan::PerComponent;
+        offset += plan.componentCount;
+
+        // Rotations are slerped when all four components share their keyframes
+        if (plan.componentCount != 4 || !channel.name.contains(QLatin1String("Rotation")))
+            continue;
+
+        const int keyframeCount = channel.channelComponents[0].fcurve.keyframeCount();
+        const bool canSlerp = std::all_of(channel.channelComponents.cbegin() + 1,
+                                          channel.channelComponents.cend(),
+                                          [keyframeCount] (const ChannelComponent &component) {
+            return component.fcurve.keyframeCount() == keyframeCount;
+        });
+        if (!canSlerp || keyframeCount == 0)
+            continue;
+
+        plan.interpolation = keyframeCount == 1 ? ChannelEvaluationPlan::QuaternionConstant
+                                                : ChannelEvaluationPlan::QuaternionSlerp;
+    }
+}
+
 } // namespace Animation
 } // namespace Qt3DAnimation
 
@@ -62,6 +62,25 @@ namespace Animation {
 
 class Handler;
 
+// How a channel of a clip gets evaluated. Worked out when the clip is
+// loaded so that evaluating it doesn't need to inspect the channel names
+// or keyframes again.
+struct ChannelEvaluationPlan
+{
+    enum Interpolation : quint8 {
+        // Each component is interpolated on its own
+        PerComponent,
+        // Rotation whose components have matching keyframes
+        QuaternionSlerp,
+        // Rotation with a single keyframe
+        QuaternionConstant
+    };
+
+    int componentOffset = 0;
+    int componentCount = 0;
+    Interpolation interpolation = PerComponent;
+};
+
 class Q_AUTOTEST_EXPORT AnimationClip : public BackendNode
 {
 public:
@@ -87,6 +106,7 @@ public:
     int channelIndex(const QString &channelName, int jointIndex) const;
     int channelCount() const { return m_channelComponentCount; }
     int channelComponentBaseIndex(int channelGroupIndex) const;
+    const QVector<ChannelEvaluationPlan> &evaluationPlan() const { return m_evaluationPlan; }
 
     // Allow unit tests to set the data type
 #if !defined(QT_BUILD_INTERNAL)
@@ -108,6 +128,7 @@ private:
     void clearData();
     float findDuration();
     int findChannelComponentCount();
+    void buildEvaluationPlan();
 
     QMutex m_mutex;
 
@@ -118,6 +139,7 @@ private:
 
     QString m_name;
     QVector<Channel> m_channels;
+    QVector<ChannelEvaluationPlan> m_evaluationPlan;
     float m_duration;
     int m_channelComponentCount;
 
@@ -48,9 +48,18 @@
 #include <QtCore/qvariant.h>
 #include <QtCore/qvarlengtharray.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
+#include <Qt3DCore/private/qt3dcore-config_p.h>
+#include <private/qsimd_p.h>
 
 #include <numeric>
 
+// Same conditions as the Matrix4x4 and Vector3D SIMD implementations
+#if QT_CONFIG(qt3d_simd_avx2) && defined(__AVX2__) && defined(QT_COMPILER_SUPPORTS_AVX2)
+#  define QT3D_ANIMATION_LERP_AVX2
+#elif QT_CONFIG(qt3d_simd_sse2) && defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+#  define QT3D_ANIMATION_LERP_SSE2
+#endif
+
 QT_BEGIN_NAMESPACE
 
 namespace {
@@ -230,107 +239,213 @@ ComponentIndices channelComponentsToIndicesHelper(const Channel &channel,
     return indices;
 }
 
-ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
+namespace {
+
+void slerpQuaternionChannel(const QVector<ChannelComponent> &components,
+                            float localTime,
+                            int *keyframeCursor,
+                            float *channelResults)
 {
-    QVector<float> channelResults;
-    Q_ASSERT(clip);
+    auto quaternionFromChannel = [&components](const int keyframe) {
+        const float w = components[0].fcurve.value(keyframe);
+        const float x = components[1].fcurve.value(keyframe);
+        const float y = components[2].fcurve.value(keyframe);
+        const float z = components[3].fcurve.value(keyframe);
+        QQuaternion quat{w,x,y,z};
+        quat.normalize();
+        return quat;
+    };
 
-    // Ensure we have enough storage to hold the evaluations
-    channelResults.resize(clip->channelCount());
+    const int lowerKeyframeBound = components[0].fcurve.lowerKeyframeBound(localTime, keyframeCursor);
+    const auto lowerQuat = quaternionFromChannel(lowerKeyframeBound);
+    const auto higherQuat = quaternionFromChannel(lowerKeyframeBound + 1);
+    auto cosHalfTheta = QQuaternion::dotProduct(lowerQuat, higherQuat);
+    // If the two keyframe quaternions are equal, just return the first one as the interpolated value.
+    if (std::abs(cosHalfTheta) >= 1.0f) {
+        channelResults[0] = lowerQuat.scalar();
+        channelResults[1] = lowerQuat.x();
+        channelResults[2] = lowerQuat.y();
+        channelResults[3] = lowerQuat.z();
+        return;
+    }
 
-    // Iterate over channels and evaluate the fcurves
-    const QVector<Channel> &channels = clip->channels();
+    const auto sinHalfTheta = std::sqrt(1.0f - std::pow(cosHalfTheta,2.0f));
+    if (std::abs(sinHalfTheta) < ::slerpThreshold) {
+        for (int i = 0; i < 4; ++i)
+            channelResults[i] = components[i].fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
+
+        // Normalize the resulting quaternion
+        QQuaternion quat{channelResults[0], channelResults[1], channelResults[2], channelResults[3]};
+        quat.normalize();
+        channelResults[0] = quat.scalar();
+        channelResults[1] = quat.x();
+        channelResults[2] = quat.y();
+        channelResults[3] = quat.z();
+    } else {
+        const auto reverseQ1 = cosHalfTheta < 0 ? -1.0f : 1.0f;
+        cosHalfTheta *= reverseQ1;
+        const auto halfTheta = std::acos(cosHalfTheta);
+        for (int i = 0; i < 4; ++i)
+            channelResults[i] = components[i].fcurve.evaluateAtTimeAsSlerp(localTime,
+                                                                           lowerKeyframeBound,
+                                                                           halfTheta,
+                                                                           sinHalfTheta,
+                                                                           reverseQ1);
+    }
+}
+
+// Interpolates count linear segments at localTime. The data of each segment
+// is spread over the input arrays at the same index.
+void interpolateLinearSegments(float localTime,
+                               const float *startTimes, const float *durations,
+                               const float *startValues, const float *endValues,
+                               float *results, int count)
+{
     int i = 0;
-    for (const Channel &channel : channels) {
-        if (channel.name.contains(QStringLiteral("Rotation")) &&
-                        channel.channelComponents.size() == 4) {
-
-            // Try to SLERP
-            const int nbKeyframes = channel.channelComponents[0].fcurve.keyframeCount();
-            const bool canSlerp = std::find_if(std::begin(channel.channelComponents)+1,
-                                               std::end(channel.channelComponents),
-                                               [nbKeyframes](const ChannelComponent &v) {
-                return v.fcurve.keyframeCount() != nbKeyframes;
-            }) == std::end(channel.channelComponents);
-
-            if (!canSlerp) {
-                // Interpolate per component
-                for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
-                    const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
-                    channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
-                }
-            } else {
-                // There's only one keyframe. We cant compute omega. Interpolate per component
-                if (channel.channelComponents[0].fcurve.keyframeCount() == 1) {
-                    for (const auto &channelComponent : qAsConst(channel.channelComponents))
-                        channelResults[i++] = channelComponent.fcurve.keyframe(0).value;
-                } else {
-                    auto quaternionFromChannel = [channel](const int keyframe) {
-                        const float w = channel.channelComponents[0].fcurve.keyframe(keyframe).value;
-                        const float x = channel.channelComponents[1].fcurve.keyframe(keyframe).value;
-                        const float y = channel.channelComponents[2].fcurve.keyframe(keyframe).value;
-                        const float z = channel.channelComponents[3].fcurve.keyframe(keyframe).value;
-                        QQuaternion quat{w,x,y,z};
-                        quat.normalize();
-                        return quat;
-                    };
-
-                    const int lowerKeyframeBound = channel.channelComponents[0].fcurve.lowerKeyframeBound(localTime);
-                    const auto lowerQuat = quaternionFromChannel(lowerKeyframeBound);
-                    const auto higherQuat = quaternionFromChannel(lowerKeyframeBound + 1);
-                    auto cosHalfTheta = QQuaternion::dotProduct(lowerQuat, higherQuat);
-                    // If the two keyframe quaternions are equal, just return the first one as the interpolated value.
-                    if (std::abs(cosHalfTheta) >= 1.0f) {
-                        channelResults[i++] = lowerQuat.scalar();
-                        channelResults[i++] = lowerQuat.x();
-                        channelResults[i++] = lowerQuat.y();
-                        channelResults[i++] = lowerQuat.z();
-                    } else {
-                        const auto sinHalfTheta = std::sqrt(1.0f - std::pow(cosHalfTheta,2.0f));
-                        if (std::abs(sinHalfTheta) < ::slerpThreshold) {
-                            auto initial_i = i;
-                            for (const auto &channelComponent : qAsConst(channel.channelComponents))
-                                channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
-
-                            // Normalize the resulting quaternion
-                            QQuaternion quat{channelResults[initial_i], channelResults[initial_i+1], channelResults[initial_i+2], channelResults[initial_i+3]};
-                            quat.normalize();
-                            channelResults[initial_i+0] = quat.scalar();
-                            channelResults[initial_i+1] = quat.x();
-                            channelResults[initial_i+2] = quat.y();
-                            channelResults[initial_i+3] = quat.z();
-                        } else {
-                            const auto reverseQ1 = cosHalfTheta < 0 ? -1.0f : 1.0f;
-                            cosHalfTheta *= reverseQ1;
-                            const auto halfTheta = std::acos(cosHalfTheta);
-                            for (const auto &channelComponent : qAsConst(channel.channelComponents))
-                                channelResults[i++] = channelComponent.fcurve.evaluateAtTimeAsSlerp(localTime,
-                                                                                                    lowerKeyframeBound,
-                                                                                                    halfTheta,
-                                                                                                    sinHalfTheta,
-                                                                                                    reverseQ1);
-                        }
-                    }
-                }
-            }
-        } else {
-            // If the channel is not a Rotation, apply linear interpolation per channel component
+
+#if defined(QT3D_ANIMATION_LERP_AVX2)
+    const __m256 x = _mm256_set1_ps(localTime);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 8 <= count; i += 8) {
+        const __m256 t = _mm256_div_ps(_mm256_sub_ps(x, _mm256_loadu_ps(startTimes + i)),
+                                       _mm256_loadu_ps(durations + i));
+        const __m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(one, t), _mm256_loadu_ps(startValues + i)),
+                                       _mm256_mul_ps(t, _mm256_loadu_ps(endValues + i)));
+        _mm256_storeu_ps(results + i, r);
+    }
+#elif defined(QT3D_ANIMATION_LERP_SSE2)
+    const __m128 x = _mm_set1_ps(localTime);
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+        const __m128 t = _mm_div_ps(_mm_sub_ps(x, _mm_loadu_ps(startTimes + i)),
+                                    _mm_loadu_ps(durations + i));
+        const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(one, t), _mm_loadu_ps(startValues + i)),
+                                    _mm_mul_ps(t, _mm_loadu_ps(endValues + i)));
+        _mm_storeu_ps(results + i, r);
+    }
+#endif
+
+    // Remaining segments, or all of them without SIMD. Same operation order
+    // as the vectorized paths and FCurve::evaluateAtTime.
+    for (; i < count; ++i) {
+        const float t = (localTime - startTimes[i]) / durations[i];
+        results[i] = (1 - t) * startValues[i] + t * endValues[i];
+    }
+}
+
+} // anonymous
+
+void evaluateClipAtLocalTime(AnimationClip *clip, float localTime, ClipResults &channelResults,
+                             ClipEvaluationState *state)
+{
+    Q_ASSERT(clip);
+
+    ClipEvaluationState localState;
+    if (!state)
+        state = &localState;
+
+    // Ensure we have enough storage to hold the evaluations. This doesn't
+    // allocate when the buffer is reused for clips of the same size.
+    const int componentCount = clip->channelCount();
+    channelResults.resize(componentCount);
+    float *results = channelResults.data();
+
+    // Cursors left over from another clip are meaningless, start from scratch
+    if (state->keyframeCursors.size() != componentCount)
+        state->keyframeCursors.fill(0, componentCount);
+    int *cursors = state->keyframeCursors.data();
+
+    // Linear segments are gathered and interpolated all at once at the end
+    state->linearIndices.resize(componentCount);
+    state->linearStartTimes.resize(componentCount);
+    state->linearDurations.resize(componentCount);
+    state->linearStartValues.resize(componentCount);
+    state->linearEndValues.resize(componentCount);
+    int *linearIndices = state->linearIndices.data();
+    float *linearStartTimes = state->linearStartTimes.data();
+    float *linearDurations = state->linearDurations.data();
+    float *linearStartValues = state->linearStartValues.data();
+    float *linearEndValues = state->linearEndValues.data();
+    int linearCount = 0;
+
+    // Iterate over channels and evaluate the fcurves as planned when the
+    // clip was loaded
+    const QVector<Channel> &channels = clip->channels();
+    const QVector<ChannelEvaluationPlan> &evaluationPlan = clip->evaluationPlan();
+    Q_ASSERT(evaluationPlan.size() == channels.size());
+    for (int i = 0, m = channels.size(); i < m; ++i) {
+        const ChannelEvaluationPlan &plan = evaluationPlan[i];
+        const QVector<ChannelComponent> &components = channels[i].channelComponents;
+        float *componentResults = results + plan.componentOffset;
+
+        switch (plan.interpolation) {
+        case ChannelEvaluationPlan::QuaternionSlerp:
+            slerpQuaternionChannel(components, localTime, cursors + plan.componentOffset,
+                                   componentResults);
+            break;
+
+        case ChannelEvaluationPlan::QuaternionConstant:
+            // There's only one keyframe. We cant compute omega.
+            for (int j = 0; j < plan.componentCount; ++j)
+                componentResults[j] = components[j].fcurve.value(0);
+            break;
+
+        case ChannelEvaluationPlan::PerComponent:
+            // Apply linear interpolation per channel component
             // TODO How do we handle other interpolations. For exammple, color interpolation
             // in a linear perceptual way or other non linear spaces?
-            for (const auto &channelComponent : qAsConst(channel.channelComponents)) {
-                const int lowerKeyframeBound = channelComponent.fcurve.lowerKeyframeBound(localTime);
-                channelResults[i++] = channelComponent.fcurve.evaluateAtTime(localTime, lowerKeyframeBound);
+            for (int j = 0; j < plan.componentCount; ++j) {
+                const FCurve &fcurve = components[j].fcurve;
+                const int lowerBound = fcurve.lowerKeyframeBound(localTime,
+                                                                 cursors + plan.componentOffset + j);
+                if (fcurve.isLinearSegment(localTime, lowerBound)) {
+                    const float *times = fcurve.localTimes();
+                    const float *values = fcurve.values();
+                    linearIndices[linearCount] = plan.componentOffset + j;
+                    linearStartTimes[linearCount] = times[lowerBound];
+                    linearDurations[linearCount] = times[lowerBound + 1] - times[lowerBound];
+                    linearStartValues[linearCount] = values[lowerBound];
+                    linearEndValues[linearCount] = values[lowerBound + 1];
+                    ++linearCount;
+                } else {
+                    componentResults[j] = fcurve.evaluateAtTime(localTime, lowerBound);
+                }
             }
+            break;
         }
     }
+
+    if (linearCount == 0)
+        return;
+
+    // Interpolate in place of the start values, then scatter the results
+    interpolateLinearSegments(localTime, linearStartTimes, linearDurations,
+                              linearStartValues, linearEndValues,
+                              linearStartValues, linearCount);
+    for (int i = 0; i < linearCount; ++i)
+        results[linearIndices[i]] = linearStartValues[i];
+}
+
+ClipResults evaluateClipAtLocalTime(AnimationClip *clip, float localTime)
+{
+    ClipResults channelResults;
+    evaluateClipAtLocalTime(clip, localTime, channelResults);
     return channelResults;
 }
 
-ClipResults evaluateClipAtPhase(AnimationClip *clip, float phase)
+void evaluateClipAtPhase(AnimationClip *clip, float phase, ClipResults &channelResults,
+                         ClipEvaluationState *state)
 {
     // Calculate the clip local time from the phase and clip duration
     const double localTime = phase * clip->duration();
-    return evaluateClipAtLocalTime(clip, localTime);
+    evaluateClipAtLocalTime(clip, localTime, channelResults, state);
+}
+
+ClipResults evaluateClipAtPhase(AnimationClip *clip, float phase)
+{
+    ClipResults channelResults;
+    evaluateClipAtPhase(clip, phase, channelResults);
+    return channelResults;
 }
 
 template<typename Container>
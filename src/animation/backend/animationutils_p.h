@@ -126,6 +126,20 @@ struct ClipEvaluationData
 
 typedef QVector<float> ClipResults;
 
+// Per evaluator state reused from one evaluation of a clip to the next
+struct ClipEvaluationState
+{
+    // Keyframe lower bound found last time, per channel component
+    QVector<int> keyframeCursors;
+
+    // Scratch storage for the linear segments evaluated as one batch
+    QVector<int> linearIndices;
+    QVector<float> linearStartTimes;
+    QVector<float> linearDurations;
+    QVector<float> linearStartValues;
+    QVector<float> linearEndValues;
+};
+
 struct ChannelNameAndType
 {
     QString jointName;
@@ -353,6 +367,20 @@ Q_AUTOTEST_EXPORT
 ClipResults evaluateClipAtPhase(AnimationClip *clip,
                                 float phase);
 
+// Variants writing into a results buffer reused across evaluations. Passing
+// the evaluation state of the previous frame speeds up the keyframe lookups.
+Q_AUTOTEST_EXPORT
+void evaluateClipAtLocalTime(AnimationClip *clip,
+                             float localTime,
+                             ClipResults &channelResults,
+                             ClipEvaluationState *state = nullptr);
+
+Q_AUTOTEST_EXPORT
+void evaluateClipAtPhase(AnimationClip *clip,
+                         float phase,
+                         ClipResults &channelResults,
+                         ClipEvaluationState *state = nullptr);
+
 Q_AUTOTEST_EXPORT
 QVector<AnimationCallbackAndValue> prepareCallbacks(const QVector<MappingData> &mappingDataVec,
                                                     const QVector<float> &channelResults);
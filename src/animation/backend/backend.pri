@@ -9,7 +9,6 @@ HEADERS += \
     $$PWD/keyframe_p.h \
     $$PWD/fcurve_p.h \
     $$PWD/bezierevaluator_p.h \
-    $$PWD/functionrangefinder_p.h \
     $$PWD/clipanimator_p.h \
     $$PWD/blendedclipanimator_p.h \
     $$PWD/backendnode_p.h \
@@ -19,6 +18,7 @@ HEADERS += \
     $$PWD/findrunningclipanimatorsjob_p.h \
     $$PWD/abstractevaluateclipanimatorjob_p.h \
     $$PWD/evaluateclipanimatorjob_p.h \
+    $$PWD/evaluateclipanimatorbatchjob_p.h \
     $$PWD/clipblendnode_p.h \
     $$PWD/clipblendnodevisitor_p.h \
     $$PWD/animationutils_p.h \
@@ -36,7 +36,6 @@ SOURCES += \
     $$PWD/handler.cpp \
     $$PWD/fcurve.cpp \
     $$PWD/bezierevaluator.cpp \
-    $$PWD/functionrangefinder.cpp \
     $$PWD/clipanimator.cpp \
     $$PWD/blendedclipanimator.cpp \
     $$PWD/backendnode.cpp \
@@ -46,6 +45,7 @@ SOURCES += \
     $$PWD/findrunningclipanimatorsjob.cpp \
     $$PWD/abstractevaluateclipanimatorjob.cpp \
     $$PWD/evaluateclipanimatorjob.cpp \
+    $$PWD/evaluateclipanimatorbatchjob.cpp \
     $$PWD/clipblendnode.cpp \
     $$PWD/managers.cpp \
     $$PWD/clipblendnodevisitor.cpp \
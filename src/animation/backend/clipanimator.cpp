@@ -113,6 +113,7 @@ void ClipAnimator::cleanup()
     m_loops = 1;
     m_clipFormat = ClipFormat();
     m_normalizedLocalTime = m_lastNormalizedLocalTime = -1.0f;
+    m_evaluationState = ClipEvaluationState();
 }
 
 void ClipAnimator::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime)
@@ -112,6 +112,8 @@ public:
                 && !qFuzzyCompare(m_lastNormalizedLocalTime, m_normalizedLocalTime);
     }
 
+    ClipEvaluationState *evaluationState() { return &m_evaluationState; }
+
 private:
     Qt3DCore::QNodeId m_clipId;
     Qt3DCore::QNodeId m_mapperId;
@@ -129,6 +131,8 @@ private:
 
     float m_normalizedLocalTime;
     float m_lastNormalizedLocalTime;
+
+    ClipEvaluationState m_evaluationState;
 };
 
 } // namespace Animation
@@ -59,7 +59,13 @@ void ClipBlendValue::syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firs
     if (!node)
         return;
 
-    m_clipId = Qt3DCore::qIdForNode(node->clip());
+    const Qt3DCore::QNodeId clipId = Qt3DCore::qIdForNode(node->clip());
+    if (clipId != m_clipId) {
+        m_clipId = clipId;
+        // The cursors index into the keyframes of the previous clip
+        for (ClipEvaluationState &state : m_evaluationStates)
+            state = ClipEvaluationState();
+    }
 }
 
 ClipResults ClipBlendValue::doBlend(const QVector<ClipResults> &blendData) const
@@ -87,6 +93,7 @@ void ClipBlendValue::setClipFormat(Qt3DCore::QNodeId animatorId, const ClipForma
         // Nope, add it
         m_animatorIds.push_back(animatorId);
         m_clipFormats.push_back(formatIndices);
+        m_evaluationStates.push_back(ClipEvaluationState());
     } else {
         m_clipFormats[animatorIndex] = formatIndices;
     }
@@ -104,6 +111,12 @@ const ClipFormat &ClipBlendValue::clipFormat(Qt3DCore::QNodeId animatorId) const
     return m_clipFormats[animatorIndex];
 }
 
+ClipEvaluationState *ClipBlendValue::evaluationState(Qt3DCore::QNodeId animatorId)
+{
+    const int animatorIndex = m_animatorIds.indexOf(animatorId);
+    return &m_evaluationStates[animatorIndex];
+}
+
 } // namespace Animation
 } // namespace Qt3DAnimation
 
@@ -109,11 +109,12 @@ void EvaluateBlendClipAnimatorJob::run()
         AnimationClip *clip = clipLoaderManager->lookupResource(valueNode->clipId());
         Q_ASSERT(clip);
 
-        ClipResults rawClipResults = evaluateClipAtPhase(clip, float(phase));
+        evaluateClipAtPhase(clip, float(phase), m_rawClipResults,
+                            valueNode->evaluationState(blendedClipAnimator->peerId()));
 
         // Reformat the clip results into the layout used by this animator/blend tree
         const ClipFormat format = valueNode->clipFormat(blendedClipAnimator->peerId());
-        ClipResults formattedClipResults = formatClipResults(rawClipResults, format.sourceClipIndices);
+        ClipResults formattedClipResults = formatClipResults(m_rawClipResults, format.sourceClipIndices);
         applyComponentDefaultValues(format.defaultComponentValues, formattedClipResults);
         valueNode->setClipResults(blendedClipAnimator->peerId(), formattedClipResults);
     }
@@ -78,6 +78,7 @@ protected:
 
 private:
     HBlendedClipAnimator m_blendClipAnimatorHandle;
+    ClipResults m_rawClipResults;
     Handler *m_handler;
 };
 
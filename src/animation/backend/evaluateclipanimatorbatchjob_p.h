@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DANIMATION_ANIMATION_EVALUATECLIPANIMATORBATCHJOB_P_H
+#define QT3DANIMATION_ANIMATION_EVALUATECLIPANIMATORBATCHJOB_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DAnimation/private/abstractevaluateclipanimatorjob_p.h>
+#include <Qt3DAnimation/private/handle_types_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DAnimation {
+namespace Animation {
+
+class Handler;
+
+// Evaluates a range of the running clip animators. The results of all the
+// animators of the range are kept in the job and applied in postFrame.
+class Q_AUTOTEST_EXPORT EvaluateClipAnimatorBatchJob : public AbstractEvaluateClipAnimatorJob
+{
+public:
+    EvaluateClipAnimatorBatchJob();
+
+    void setHandler(Handler *handler) { m_handler = handler; }
+    Handler *handler() const { return m_handler; }
+
+    void setClipAnimators(const QVector<HClipAnimator> &clipAnimatorHandles)
+    {
+        m_clipAnimatorHandles = clipAnimatorHandles;
+    }
+    QVector<HClipAnimator> clipAnimators() const { return m_clipAnimatorHandles; }
+
+    // Animators found to be neither running nor seeking while evaluating,
+    // the handler removes them from its running set on the next frame
+    QVector<HClipAnimator> takeStoppedClipAnimators()
+    {
+        return std::move(m_stoppedClipAnimatorHandles);
+    }
+    void clearStoppedClipAnimators() { m_stoppedClipAnimatorHandles.clear(); }
+
+    void run() override;
+
+private:
+    QVector<HClipAnimator> m_clipAnimatorHandles;
+    QVector<HClipAnimator> m_stoppedClipAnimatorHandles;
+    ClipResults m_rawClipResults;
+    Handler *m_handler;
+};
+
+using EvaluateClipAnimatorBatchJobPtr = QSharedPointer<EvaluateClipAnimatorBatchJob>;
+
+} // namespace Animation
+} // namespace Qt3DAnimation
+
+QT_END_NAMESPACE
+
+#endif // QT3DANIMATION_ANIMATION_EVALUATECLIPANIMATORBATCHJOB_P_H
@@ -61,21 +61,35 @@ void EvaluateClipAnimatorJob::run()
 {
     Q_ASSERT(m_handler);
 
-    ClipAnimator *clipAnimator = m_handler->clipAnimatorManager()->data(m_clipAnimatorHandle);
-    Q_ASSERT(clipAnimator);
-    const bool running = clipAnimator->isRunning();
-    const bool seeking = clipAnimator->isSeeking();
-    if (!running && !seeking) {
+    AnimationRecord record;
+    QVector<AnimationCallbackAndValue> callbacks;
+    if (!evaluateClipAnimator(m_handler, m_clipAnimatorHandle, m_rawClipResults, &record, &callbacks)) {
         m_handler->setClipAnimatorRunning(m_clipAnimatorHandle, false);
         return;
     }
 
-    const qint64 globalTimeNS = m_handler->simulationTime();
+    setPostFrameData(record, callbacks);
+}
 
-    Clock *clock = m_handler->clockManager()->lookupResource(clipAnimator->clockId());
+bool EvaluateClipAnimatorJob::evaluateClipAnimator(Handler *handler,
+                                                   const HClipAnimator &clipAnimatorHandle,
+                                                   ClipResults &rawClipResults,
+                                                   AnimationRecord *record,
+                                                   QVector<AnimationCallbackAndValue> *callbacks)
+{
+    ClipAnimator *clipAnimator = handler->clipAnimatorManager()->data(clipAnimatorHandle);
+    Q_ASSERT(clipAnimator);
+    const bool running = clipAnimator->isRunning();
+    const bool seeking = clipAnimator->isSeeking();
+    if (!running && !seeking)
+        return false;
+
+    const qint64 globalTimeNS = handler->simulationTime();
+
+    Clock *clock = handler->clockManager()->lookupResource(clipAnimator->clockId());
 
     // Evaluate the fcurves
-    AnimationClip *clip = m_handler->animationClipLoaderManager()->lookupResource(clipAnimator->clipId());
+    AnimationClip *clip = handler->animationClipLoaderManager()->lookupResource(clipAnimator->clipId());
     Q_ASSERT(clip);
 
     const qint64 nsSincePreviousFrame = seeking ? toNsecs(clip->duration() * clipAnimator->normalizedLocalTime())
@@ -87,7 +101,8 @@ void EvaluateClipAnimatorJob::run()
                                                                                     nsSincePreviousFrame);
 
     const ClipEvaluationData preEvaluationDataForClip = evaluationDataForClip(clip, animatorEvaluationData);
-    const ClipResults rawClipResults = evaluateClipAtPhase(clip, preEvaluationDataForClip.normalizedLocalTime);
+    evaluateClipAtPhase(clip, preEvaluationDataForClip.normalizedLocalTime, rawClipResults,
+                        clipAnimator->evaluationState());
 
     // Reformat the clip results into the layout used by this animator/blend tree
     const ClipFormat clipFormat = clipAnimator->clipFormat();
@@ -103,16 +118,15 @@ void EvaluateClipAnimatorJob::run()
     clipAnimator->setNormalizedLocalTime(-1.0f); // Re-set to something invalid.
 
     // Prepare property changes (if finalFrame it also prepares the change for the running property for the frontend)
-    auto record = prepareAnimationRecord(clipAnimator->peerId(),
-                                         clipAnimator->mappingData(),
-                                         formattedClipResults,
-                                         preEvaluationDataForClip.isFinalFrame,
-                                         preEvaluationDataForClip.normalizedLocalTime);
+    *record = prepareAnimationRecord(clipAnimator->peerId(),
+                                     clipAnimator->mappingData(),
+                                     formattedClipResults,
+                                     preEvaluationDataForClip.isFinalFrame,
+                                     preEvaluationDataForClip.normalizedLocalTime);
 
     // Trigger callbacks either on this thread or by notifying the gui thread.
-    auto callbacks = prepareCallbacks(clipAnimator->mappingData(), formattedClipResults);
-
-    setPostFrameData(record, callbacks);
+    *callbacks = prepareCallbacks(clipAnimator->mappingData(), formattedClipResults);
+    return true;
 }
 
 } // namespace Animation
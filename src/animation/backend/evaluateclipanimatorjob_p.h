@@ -76,11 +76,22 @@ public:
         m_clipAnimatorHandle = HClipAnimator();
     }
 
+    // Evaluates the animator at the simulation time of the handler. Returns
+    // false, without touching record and callbacks, when the animator is
+    // neither running nor seeking. rawClipResults is scratch storage the
+    // caller can reuse from one evaluation to the next.
+    static bool evaluateClipAnimator(Handler *handler,
+                                     const HClipAnimator &clipAnimatorHandle,
+                                     ClipResults &rawClipResults,
+                                     AnimationRecord *record,
+                                     QVector<AnimationCallbackAndValue> *callbacks);
+
 protected:
     void run() override;
 
 private:
     HClipAnimator m_clipAnimatorHandle;
+    ClipResults m_rawClipResults;
     Handler *m_handler;
 };
 
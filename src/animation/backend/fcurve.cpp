@@ -41,16 +41,27 @@
 #include <QtCore/qjsonobject.h>
 #include <QtCore/QLatin1String>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DAnimation {
 namespace Animation {
 
 FCurve::FCurve()
-    : m_rangeFinder(m_localTimes)
 {
 }
 
+Keyframe FCurve::keyframe(int index) const
+{
+    Keyframe keyframe;
+    keyframe.value = m_values[index];
+    keyframe.leftControlPoint = m_leftControlPoints[index];
+    keyframe.rightControlPoint = m_rightControlPoints[index];
+    keyframe.interpolation = m_interpolations[index];
+    return keyframe;
+}
+
 float FCurve::evaluateAtTime(float localTime) const
 {
     return evaluateAtTime(localTime, lowerKeyframeBound(localTime));
@@ -61,78 +72,75 @@ float FCurve::evaluateAtTime(float localTime, int lowerBound) const
 {
     // TODO: Implement extrapolation beyond first/last keyframes
     if (localTime < m_localTimes.first()) {
-        return m_keyframes.first().value;
+        return m_values.first();
     } else if (localTime > m_localTimes.last()) {
-        return m_keyframes.last().value;
+        return m_values.last();
     } else {
         // Find keyframes that sandwich the requested localTime
         if (lowerBound < 0) // only one keyframe
-            return m_keyframes.first().value;
+            return m_values.first();
 
         const float t0 = m_localTimes[lowerBound];
         const float t1 = m_localTimes[lowerBound + 1];
-        const Keyframe &keyframe0(m_keyframes[lowerBound]);
-        const Keyframe &keyframe1(m_keyframes[lowerBound + 1]);
+        const QKeyFrame::InterpolationType interpolation = m_interpolations[lowerBound];
 
-        switch (keyframe0.interpolation) {
+        switch (interpolation) {
         case QKeyFrame::ConstantInterpolation:
-            return keyframe0.value;
+            return m_values[lowerBound];
         case QKeyFrame::LinearInterpolation:
             if (localTime >= t0 && localTime <= t1 && t1 > t0) {
                 float t = (localTime - t0) / (t1 - t0);
-                return (1 - t) * keyframe0.value + t * keyframe1.value;
+                return (1 - t) * m_values[lowerBound] + t * m_values[lowerBound + 1];
             }
             break;
         case QKeyFrame::BezierInterpolation:
         {
-            BezierEvaluator evaluator(t0, keyframe0, t1, keyframe1);
+            BezierEvaluator evaluator(t0, keyframe(lowerBound), t1, keyframe(lowerBound + 1));
             return evaluator.valueForTime(localTime);
         }
         default:
-            qWarning("Unknown interpolation type %d", keyframe0.interpolation);
+            qWarning("Unknown interpolation type %d", interpolation);
             break;
         }
     }
 
-    return m_keyframes.first().value;
+    return m_values.first();
 }
 
 float FCurve::evaluateAtTimeAsSlerp(float localTime, int lowerBound, float halfTheta, float sinHalfTheta, float reverseQ1) const
 {
     // TODO: Implement extrapolation beyond first/last keyframes
     if (localTime < m_localTimes.first())
-        return m_keyframes.first().value;
+        return m_values.first();
 
     if (localTime > m_localTimes.last())
-        return m_keyframes.last().value;
+        return m_values.last();
     // Find keyframes that sandwich the requested localTime
     if (lowerBound < 0) // only one keyframe
-        return m_keyframes.first().value;
+        return m_values.first();
 
     const float t0 = m_localTimes[lowerBound];
     const float t1 = m_localTimes[lowerBound + 1];
-    const Keyframe &keyframe0(m_keyframes[lowerBound]);
-    const Keyframe &keyframe1(m_keyframes[lowerBound + 1]);
 
-    switch (keyframe0.interpolation) {
+    switch (m_interpolations[lowerBound]) {
     case QKeyFrame::ConstantInterpolation:
-        return keyframe0.value;
+        return m_values[lowerBound];
     case QKeyFrame::LinearInterpolation:
         if (localTime >= t0 && localTime <= t1 && t1 > t0) {
             const auto t = (localTime - t0) / (t1 - t0);
 
             const auto A = std::sin((1.0f-t) * halfTheta) / sinHalfTheta;
             const auto B = std::sin(t * halfTheta) / sinHalfTheta;
-            return A * keyframe0.value + reverseQ1 * B * keyframe1.value;
+            return A * m_values[lowerBound] + reverseQ1 * B * m_values[lowerBound + 1];
         }
         break;
     case QKeyFrame::BezierInterpolation:
         // TODO implement a proper slerp bezier interpolation
-        BezierEvaluator evaluator(t0, keyframe0, t1, keyframe1);
+        BezierEvaluator evaluator(t0, keyframe(lowerBound), t1, keyframe(lowerBound + 1));
         return evaluator.valueForTime(localTime);
     }
 
-    return m_keyframes.first().value;
+    return m_values.first();
 }
 
 int FCurve::lowerKeyframeBound(float localTime) const
@@ -141,7 +149,55 @@ int FCurve::lowerKeyframeBound(float localTime) const
         return 0;
     if (localTime > m_localTimes.last())
         return 0;
-    return m_rangeFinder.findLowerBound(localTime);
+    return findLowerBound(localTime);
+}
+
+int FCurve::lowerKeyframeBound(float localTime, int *cursor) const
+{
+    const int count = m_localTimes.size();
+    if (localTime < m_localTimes.first() || localTime > m_localTimes.last())
+        return 0;
+    if (count < 2)
+        return -1;
+
+    // Playback usually stays in the same interval or moves on to the next one
+    const float *times = m_localTimes.constData();
+    int lowerBound = *cursor;
+    if (lowerBound < 0 || lowerBound > count - 2 || localTime < times[lowerBound]) {
+        lowerBound = findLowerBound(localTime);
+    } else if (localTime >= times[lowerBound + 1]) {
+        if (lowerBound + 2 < count && localTime < times[lowerBound + 2])
+            ++lowerBound;
+        else if (lowerBound < count - 2)
+            lowerBound = findLowerBound(localTime);
+    }
+
+    *cursor = lowerBound;
+    return lowerBound;
+}
+
+int FCurve::findLowerBound(float localTime) const
+{
+    const int count = m_localTimes.size();
+    if (count < 2)
+        return -1;
+
+    // Index of the last keyframe at or before localTime, clamped such that
+    // there always is a keyframe following it
+    const auto it = std::upper_bound(m_localTimes.cbegin(), m_localTimes.cend(), localTime);
+    const int index = int(it - m_localTimes.cbegin()) - 1;
+    return qBound(0, index, count - 2);
+}
+
+bool FCurve::isLinearSegment(float localTime, int lowerBound) const
+{
+    if (lowerBound < 0)
+        return false;
+    if (m_interpolations[lowerBound] != QKeyFrame::LinearInterpolation)
+        return false;
+    const float t0 = m_localTimes[lowerBound];
+    const float t1 = m_localTimes[lowerBound + 1];
+    return localTime >= t0 && localTime <= t1 && t1 > t0;
 }
 
 float FCurve::startTime() const
@@ -161,7 +217,19 @@ float FCurve::endTime() const
 void FCurve::appendKeyframe(float localTime, const Keyframe &keyframe)
 {
     m_localTimes.append(localTime);
-    m_keyframes.append(keyframe);
+    m_values.append(keyframe.value);
+    m_leftControlPoints.append(keyframe.leftControlPoint);
+    m_rightControlPoints.append(keyframe.rightControlPoint);
+    m_interpolations.append(keyframe.interpolation);
+}
+
+void FCurve::clearKeyframes()
+{
+    m_localTimes.clear();
+    m_values.clear();
+    m_leftControlPoints.clear();
+    m_rightControlPoints.clear();
+    m_interpolations.clear();
 }
 
 void FCurve::read(const QJsonObject &json)
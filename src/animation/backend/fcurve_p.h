@@ -49,7 +49,6 @@
 //
 
 #include "keyframe_p.h"
-#include "functionrangefinder_p.h"
 
 #include <Qt3DAnimation/qchannel.h>
 #include <Qt3DAnimation/qchannelcomponent.h>
@@ -72,12 +71,17 @@ public:
 
     int keyframeCount() const { return m_localTimes.size(); }
     void appendKeyframe(float localTime, const Keyframe &keyframe);
-    void clearKeyframes() { m_localTimes.clear(); m_keyframes.clear(); }
+    void clearKeyframes();
 
     const float &localTime(int index) const { return m_localTimes[index]; }
     float &localTime(int index) { return m_localTimes[index]; }
-    const Keyframe &keyframe(int index) const { return m_keyframes[index]; }
-    Keyframe &keyframe(int index) { return m_keyframes[index]; }
+    Keyframe keyframe(int index) const;
+    float value(int index) const { return m_values[index]; }
+    QKeyFrame::InterpolationType interpolation(int index) const { return m_interpolations[index]; }
+
+    // The keyframe data is stored as one contiguous array per attribute
+    const float *localTimes() const { return m_localTimes.constData(); }
+    const float *values() const { return m_values.constData(); }
 
     float startTime() const;
     float endTime() const;
@@ -86,15 +90,24 @@ public:
     float evaluateAtTime(float localTime, int lowerBound) const;
     float evaluateAtTimeAsSlerp(float localTime, int lowerBound, float halfTheta, float sinHalfTheta, float reverseQ1) const;
     int lowerKeyframeBound(float localTime) const;
+    // Same as above, starting from the bound found by the previous lookup of
+    // the caller. cursor is updated with the new bound.
+    int lowerKeyframeBound(float localTime, int *cursor) const;
+    // Whether evaluateAtTime interpolates linearly between the keyframes at
+    // lowerBound and lowerBound + 1 for this time
+    bool isLinearSegment(float localTime, int lowerBound) const;
 
     void read(const QJsonObject &json);
     void setFromQChannelComponent(const QChannelComponent &qcc);
 
 private:
-    QVector<float> m_localTimes;
-    QVector<Keyframe> m_keyframes;
+    int findLowerBound(float localTime) const;
 
-    FunctionRangeFinder m_rangeFinder;
+    QVector<float> m_localTimes;
+    QVector<float> m_values;
+    QVector<QVector2D> m_leftControlPoints;
+    QVector<QVector2D> m_rightControlPoints;
+    QVector<QKeyFrame::InterpolationType> m_interpolations;
 };
 
 #ifndef QT_NO_DEBUG_STREAM
@@ -103,7 +116,7 @@ inline QDebug operator<<(QDebug dbg, const FCurve &fcurve)
     QDebugStateSaver saver(dbg);
     dbg << "Keyframe Count = " << fcurve.keyframeCount() << Qt::endl;
     for (int i = 0; i < fcurve.keyframeCount(); ++i) {
-        const Keyframe &kf = fcurve.keyframe(i);
+        const Keyframe kf = fcurve.keyframe(i);
         switch (kf.interpolation) {
         case QKeyFrame::BezierInterpolation: {
             dbg << "t = " << fcurve.localTime(i)
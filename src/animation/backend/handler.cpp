@@ -39,17 +39,27 @@
 #include <Qt3DAnimation/private/loadanimationclipjob_p.h>
 #include <Qt3DAnimation/private/findrunningclipanimatorsjob_p.h>
 #include <Qt3DAnimation/private/evaluateclipanimatorjob_p.h>
+#include <Qt3DAnimation/private/evaluateclipanimatorbatchjob_p.h>
 #include <Qt3DAnimation/private/buildblendtreesjob_p.h>
 #include <Qt3DAnimation/private/evaluateblendclipanimatorjob_p.h>
 #include <Qt3DAnimation/private/animationlogging_p.h>
 #include <Qt3DAnimation/private/buildblendtreesjob_p.h>
 #include <Qt3DAnimation/private/evaluateblendclipanimatorjob_p.h>
 
+#include <QtCore/QThread>
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DAnimation {
 namespace Animation {
 
+namespace {
+
+// Smallest number of animators worth a job of their own
+const int MinClipAnimatorsPerBatch = 32;
+
+} // anonymous
+
 Handler::Handler()
     : m_animationClipLoaderManager(new AnimationClipLoaderManager)
     , m_clockManager(new ClockManager)
@@ -63,6 +73,8 @@ Handler::Handler()
     , m_findRunningClipAnimatorsJob(new FindRunningClipAnimatorsJob)
     , m_buildBlendTreesJob(new BuildBlendTreesJob)
     , m_simulationTime(0)
+    , m_clipAnimatorEvaluationMode(qEnvironmentVariableIsSet("QT3D_BATCHED_ANIMATION_EVALUATION")
+                                   ? BatchedEvaluation : PerAnimatorEvaluation)
 {
     m_loadAnimationClipJob->setHandler(this);
     m_findRunningClipAnimatorsJob->setHandler(this);
@@ -73,6 +85,18 @@ Handler::~Handler()
 {
 }
 
+void Handler::setClipAnimatorEvaluationMode(ClipAnimatorEvaluationMode mode)
+{
+    if (mode == m_clipAnimatorEvaluationMode)
+        return;
+    m_clipAnimatorEvaluationMode = mode;
+
+    // The animators reported stopped by the batch jobs may have been
+    // restarted by the time they run again, don't act on stale handles
+    for (const EvaluateClipAnimatorBatchJobPtr &job : qAsConst(m_evaluateClipAnimatorBatchJobs))
+        job->clearStoppedClipAnimators();
+}
+
 void Handler::setDirty(DirtyFlag flag, Qt3DCore::QNodeId nodeId)
 {
     switch (flag) {
@@ -225,10 +249,46 @@ QVector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
         jobs.push_back(m_buildBlendTreesJob);
     }
 
-    // TODO: Parallelise the animator evaluation and property building at a finer level
-
     // If there are any running ClipAnimators, evaluate them for the current
     // time and send property changes
+    if (m_clipAnimatorEvaluationMode == BatchedEvaluation)
+        addClipAnimatorBatchJobs(jobs, hasLoadAnimationClipJob, hasFindRunningClipAnimatorsJob);
+    else
+        addClipAnimatorJobs(jobs, hasLoadAnimationClipJob, hasFindRunningClipAnimatorsJob);
+
+    // BlendClipAnimator execution
+    cleanupHandleList(&m_runningBlendedClipAnimators);
+    if (!m_runningBlendedClipAnimators.isEmpty()) {
+        // Ensure we have a job per clip animator
+        const int oldSize = m_evaluateBlendClipAnimatorJobs.size();
+        const int newSize = m_runningBlendedClipAnimators.size();
+        if (oldSize < newSize) {
+            m_evaluateBlendClipAnimatorJobs.resize(newSize);
+            for (int i = oldSize; i < newSize; ++i) {
+                m_evaluateBlendClipAnimatorJobs[i] = QSharedPointer<EvaluateBlendClipAnimatorJob>::create();
+                m_evaluateBlendClipAnimatorJobs[i]->setHandler(this);
+            }
+        }
+
+        // Set each job up with an animator to process and set dependencies
+        for (int i = 0; i < newSize; ++i) {
+            m_evaluateBlendClipAnimatorJobs[i]->setBlendClipAnimator(m_runningBlendedClipAnimators[i]);
+            m_evaluateBlendClipAnimatorJobs[i]->removeDependency(QWeakPointer<Qt3DCore::QAspectJob>());
+            if (hasLoadAnimationClipJob)
+                m_evaluateBlendClipAnimatorJobs[i]->addDependency(m_loadAnimationClipJob);
+            if (hasBuildBlendTreesJob)
+                m_evaluateBlendClipAnimatorJobs[i]->addDependency(m_buildBlendTreesJob);
+            jobs.push_back(m_evaluateBlendClipAnimatorJobs[i]);
+        }
+    }
+
+    return jobs;
+}
+
+void Handler::addClipAnimatorJobs(QVector<Qt3DCore::QAspectJobPtr> &jobs,
+                                  bool hasLoadAnimationClipJob,
+                                  bool hasFindRunningClipAnimatorsJob)
+{
     cleanupHandleList(&m_runningClipAnimators);
     if (!m_runningClipAnimators.isEmpty()) {
         qCDebug(HandlerLogic) << "Added EvaluateClipAnimatorJobs";
@@ -258,34 +318,54 @@ QVector<Qt3DCore::QAspectJobPtr> Handler::jobsToExecute(qint64 time)
             jobs.push_back(m_evaluateClipAnimatorJobs[i]);
         }
     }
+}
 
-    // BlendClipAnimator execution
-    cleanupHandleList(&m_runningBlendedClipAnimators);
-    if (!m_runningBlendedClipAnimators.isEmpty()) {
-        // Ensure we have a job per clip animator
-        const int oldSize = m_evaluateBlendClipAnimatorJobs.size();
-        const int newSize = m_runningBlendedClipAnimators.size();
-        if (oldSize < newSize) {
-            m_evaluateBlendClipAnimatorJobs.resize(newSize);
-            for (int i = oldSize; i < newSize; ++i) {
-                m_evaluateBlendClipAnimatorJobs[i] = QSharedPointer<EvaluateBlendClipAnimatorJob>::create();
-                m_evaluateBlendClipAnimatorJobs[i]->setHandler(this);
-            }
-        }
+void Handler::addClipAnimatorBatchJobs(QVector<Qt3DCore::QAspectJobPtr> &jobs,
+                                       bool hasLoadAnimationClipJob,
+                                       bool hasFindRunningClipAnimatorsJob)
+{
+    // The batch jobs don't modify the running set while running in
+    // parallel, remove the animators they found stopped last frame
+    for (const EvaluateClipAnimatorBatchJobPtr &job : qAsConst(m_evaluateClipAnimatorBatchJobs)) {
+        const QVector<HClipAnimator> stoppedClipAnimators = job->takeStoppedClipAnimators();
+        for (const HClipAnimator &handle : stoppedClipAnimators)
+            setClipAnimatorRunning(handle, false);
+    }
 
-        // Set each job up with an animator to process and set dependencies
-        for (int i = 0; i < newSize; ++i) {
-            m_evaluateBlendClipAnimatorJobs[i]->setBlendClipAnimator(m_runningBlendedClipAnimators[i]);
-            m_evaluateBlendClipAnimatorJobs[i]->removeDependency(QWeakPointer<Qt3DCore::QAspectJob>());
-            if (hasLoadAnimationClipJob)
-                m_evaluateBlendClipAnimatorJobs[i]->addDependency(m_loadAnimationClipJob);
-            if (hasBuildBlendTreesJob)
-                m_evaluateBlendClipAnimatorJobs[i]->addDependency(m_buildBlendTreesJob);
-            jobs.push_back(m_evaluateBlendClipAnimatorJobs[i]);
+    cleanupHandleList(&m_runningClipAnimators);
+    const int animatorCount = m_runningClipAnimators.size();
+    if (animatorCount == 0)
+        return;
+
+    qCDebug(HandlerLogic) << "Added EvaluateClipAnimatorBatchJobs";
+
+    const int batchCount = qBound(1,
+                                  (animatorCount + MinClipAnimatorsPerBatch - 1) / MinClipAnimatorsPerBatch,
+                                  QThread::idealThreadCount());
+    const int oldSize = m_evaluateClipAnimatorBatchJobs.size();
+    if (oldSize < batchCount) {
+        m_evaluateClipAnimatorBatchJobs.resize(batchCount);
+        for (int i = oldSize; i < batchCount; ++i) {
+            m_evaluateClipAnimatorBatchJobs[i] = EvaluateClipAnimatorBatchJobPtr::create();
+            m_evaluateClipAnimatorBatchJobs[i]->setHandler(this);
         }
     }
 
-    return jobs;
+    for (int i = 0; i < batchCount; ++i) {
+        const EvaluateClipAnimatorBatchJobPtr &job = m_evaluateClipAnimatorBatchJobs[i];
+        const int begin = int(qint64(i) * animatorCount / batchCount);
+        const int end = int(qint64(i + 1) * animatorCount / batchCount);
+        job->setClipAnimators(m_runningClipAnimators.mid(begin, end - begin));
+
+        job->removeDependency(QWeakPointer<Qt3DCore::QAspectJob>());
+        if (hasLoadAnimationClipJob &&
+                !job->dependencies().contains(m_loadAnimationClipJob))
+            job->addDependency(m_loadAnimationClipJob);
+        if (hasFindRunningClipAnimatorsJob &&
+                !job->dependencies().contains(m_findRunningClipAnimatorsJob))
+            job->addDependency(m_findRunningClipAnimatorsJob);
+        jobs.push_back(job);
+    }
 }
 
 } // namespace Animation
@@ -81,11 +81,13 @@ class SkeletonManager;
 class FindRunningClipAnimatorsJob;
 class LoadAnimationClipJob;
 class EvaluateClipAnimatorJob;
+class EvaluateClipAnimatorBatchJob;
 class BuildBlendTreesJob;
 class EvaluateBlendClipAnimatorJob;
 
 using BuildBlendTreesJobPtr = QSharedPointer<BuildBlendTreesJob>;
 using EvaluateBlendClipAnimatorJobPtr = QSharedPointer<EvaluateBlendClipAnimatorJob>;
+using EvaluateClipAnimatorBatchJobPtr = QSharedPointer<EvaluateClipAnimatorBatchJob>;
 
 class Q_AUTOTEST_EXPORT Handler
 {
@@ -100,8 +102,18 @@ public:
         BlendedClipAnimatorDirty
     };
 
+    enum ClipAnimatorEvaluationMode {
+        // One job per running clip animator
+        PerAnimatorEvaluation,
+        // The running clip animators are split in about one job per thread
+        BatchedEvaluation
+    };
+
     qint64 simulationTime() const { return m_simulationTime; }
 
+    void setClipAnimatorEvaluationMode(ClipAnimatorEvaluationMode mode);
+    ClipAnimatorEvaluationMode clipAnimatorEvaluationMode() const { return m_clipAnimatorEvaluationMode; }
+
     void setDirty(DirtyFlag flag, Qt3DCore::QNodeId nodeId);
 
     void setClipAnimatorRunning(const HClipAnimator &handle, bool running);
@@ -126,6 +138,13 @@ public:
     void cleanupHandleList(QVector<HBlendedClipAnimator> *animators);
 
 private:
+    void addClipAnimatorJobs(QVector<Qt3DCore::QAspectJobPtr> &jobs,
+                             bool hasLoadAnimationClipJob,
+                             bool hasFindRunningClipAnimatorsJob);
+    void addClipAnimatorBatchJobs(QVector<Qt3DCore::QAspectJobPtr> &jobs,
+                                  bool hasLoadAnimationClipJob,
+                                  bool hasFindRunningClipAnimatorsJob);
+
     QMutex m_mutex;
     QScopedPointer<AnimationClipLoaderManager> m_animationClipLoaderManager;
     QScopedPointer<ClockManager> m_clockManager;
@@ -148,9 +167,11 @@ private:
     QSharedPointer<FindRunningClipAnimatorsJob> m_findRunningClipAnimatorsJob;
     QVector<QSharedPointer<EvaluateClipAnimatorJob>> m_evaluateClipAnimatorJobs;
     QVector<EvaluateBlendClipAnimatorJobPtr> m_evaluateBlendClipAnimatorJobs;
+    QVector<EvaluateClipAnimatorBatchJobPtr> m_evaluateClipAnimatorBatchJobs;
     BuildBlendTreesJobPtr m_buildBlendTreesJob;
 
     qint64 m_simulationTime;
+    ClipAnimatorEvaluationMode m_clipAnimatorEvaluationMode;
 
 #if defined(QT_BUILD_INTERNAL)
     friend class QT_PREPEND_NAMESPACE(tst_Handler);
@@ -65,7 +65,9 @@ QAbstractAspectPrivate::QAbstractAspectPrivate()
     , m_aspectManager(nullptr)
     , m_jobManager(nullptr)
     , m_arbiter(nullptr)
+    , m_backendNodeCacheId(0)
 {
+    invalidateBackendNodeCache();
 }
 
 QAbstractAspectPrivate::~QAbstractAspectPrivate()
@@ -89,6 +91,7 @@ void QAbstractAspectPrivate::onEngineAboutToShutdown()
 void QAbstractAspectPrivate::unregisterBackendType(const QMetaObject &mo)
 {
     m_backendCreatorFunctors.remove(&mo);
+    m_mapperCache.clear();
 }
 
 /*!
@@ -175,12 +178,14 @@ void QAbstractAspect::registerBackendType(const QMetaObject &obj, const QBackend
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.insert(&obj, functor);
+    d->m_mapperCache.clear();
 }
 
 void QAbstractAspect::unregisterBackendType(const QMetaObject &obj)
 {
     Q_D(QAbstractAspect);
     d->m_backendCreatorFunctors.remove(&obj);
+    d->m_mapperCache.clear();
 }
 
 QVariant QAbstractAspect::executeCommand(const QStringList &args)
@@ -198,25 +203,73 @@ QVector<QAspectJobPtr> QAbstractAspect::jobsToExecute(qint64 time)
 QBackendNodeMapperPtr QAbstractAspectPrivate::mapperForNode(const QMetaObject *metaObj) const
 {
     Q_ASSERT(metaObj);
+    const auto it = m_mapperCache.constFind(metaObj);
+    if (it != m_mapperCache.cend())
+        return it.value();
+
+    const QMetaObject *type = metaObj;
     QBackendNodeMapperPtr mapper;
 
-    while (metaObj != nullptr && mapper.isNull()) {
-        mapper = m_backendCreatorFunctors.value(metaObj);
-        metaObj = metaObj->superClass();
+    while (type != nullptr && mapper.isNull()) {
+        mapper = m_backendCreatorFunctors.value(type);
+        type = type->superClass();
     }
+    m_mapperCache.insert(metaObj, mapper);
     return mapper;
 }
 
-void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QVector<QNode *> &nodes)
+// Returns the backend node of this aspect for node, using the backend cached
+// on the node when it was created if any. This avoids a mapper lookup and a
+// backend manager lookup for each node we need to sync.
+QBackendNode *QAbstractAspectPrivate::backendForNode(QNode *node) const
 {
-    for (auto node: qAsConst(nodes)) {
-        const QMetaObject *metaObj = QNodePrivate::get(node)->m_typeInfo;
-        const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(metaObj);
+    const QNodePrivate *d = QNodePrivate::get(node);
+    for (const auto &entry : d->m_backendNodes) {
+        if (entry.first == m_backendNodeCacheId)
+            return entry.second;
+    }
 
-        if (!backendNodeMapper)
-            continue;
+    // Types without a mapper have no backend in this aspect, the resolved
+    // mapper is cached per type so this doesn't walk the superclass chain
+    const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(d->m_typeInfo);
+    if (!backendNodeMapper)
+        return nullptr;
 
-        QBackendNode *backend = backendNodeMapper->get(node->id());
+    QBackendNode *backend = backendNodeMapper->get(node->id());
+    if (backend)
+        cacheBackendForNode(node, backend);
+    return backend;
+}
+
+void QAbstractAspectPrivate::cacheBackendForNode(QNode *node, QBackendNode *backend) const
+{
+    // Only actual backends are cached, a node without one is looked up again
+    if (!node || !backend)
+        return;
+
+    QNodePrivate *d = QNodePrivate::get(node);
+    for (auto &entry : d->m_backendNodes) {
+        if (entry.first == m_backendNodeCacheId) {
+            entry.second = backend;
+            return;
+        }
+    }
+    d->m_backendNodes.push_back(qMakePair(m_backendNodeCacheId, backend));
+}
+
+// Backends cached on nodes by a previous registration of the aspect
+// must not be returned once the aspect has been unregistered
+void QAbstractAspectPrivate::invalidateBackendNodeCache()
+{
+    static QBasicAtomicInt nextBackendNodeCacheId = Q_BASIC_ATOMIC_INITIALIZER(0);
+    m_backendNodeCacheId = nextBackendNodeCacheId.fetchAndAddRelaxed(1) + 1;
+    m_mapperCache.clear();
+}
+
+void QAbstractAspectPrivate::syncDirtyFrontEndNodes(const QVector<QNode *> &nodes)
+{
+    for (auto node: qAsConst(nodes)) {
+        QBackendNode *backend = backendForNode(node);
         if (!backend)
             continue;
 
@@ -231,22 +284,12 @@ void QAbstractAspectPrivate::syncDirtyFrontEndNode(QNode *node, QBackendNode *ba
 
 void QAbstractAspectPrivate::syncDirtyEntityComponentNodes(const QVector<ComponentRelationshipChange> &changes)
 {
-    auto getBackend = [this] (QNode *node) -> QBackendNode* {
-        const QMetaObject *metaObj = QNodePrivate::get(node)->m_typeInfo;
-        const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(metaObj);
-
-        if (!backendNodeMapper)
-            return nullptr;
-
-        return backendNodeMapper->get(node->id());
-    };
-
     for (const auto &change: qAsConst(changes)) {
-        auto entityBackend = getBackend(change.node);
+        auto entityBackend = backendForNode(change.node);
         if (!entityBackend)
             continue;
 
-        auto componentBackend = getBackend(change.subNode);
+        auto componentBackend = backendForNode(change.subNode);
         if (!componentBackend)
             continue;
 
@@ -267,17 +310,20 @@ QBackendNode *QAbstractAspectPrivate::createBackendNode(const NodeTreeChange &ch
 {
     const QMetaObject *metaObj = change.metaObj;
     const QBackendNodeMapperPtr backendNodeMapper = mapperForNode(metaObj);
+    QNode *node = change.node;
 
     if (!backendNodeMapper)
         return nullptr;
 
     QBackendNode *backend = backendNodeMapper->get(change.id);
-    if (backend != nullptr)
+    if (backend != nullptr) {
+        cacheBackendForNode(node, backend);
         return backend;
+    }
 
-    QNode *node = change.node;
     QNodeId nodeId = qIdForNode(node);
     backend = backendNodeMapper->create(nodeId);
+    cacheBackendForNode(node, backend);
 
     if (!backend)
         return nullptr;
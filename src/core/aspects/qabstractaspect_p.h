@@ -145,6 +145,9 @@ public:
     Q_DECLARE_PUBLIC(QAbstractAspect)
 
     QBackendNodeMapperPtr mapperForNode(const QMetaObject *metaObj) const;
+    QBackendNode *backendForNode(QNode *node) const;
+    void cacheBackendForNode(QNode *node, QBackendNode *backend) const;
+    void invalidateBackendNodeCache();
 
     QEntity *m_root;
     QNodeId m_rootId;
@@ -152,6 +155,9 @@ public:
     QAbstractAspectJobManager *m_jobManager;
     QChangeArbiter *m_arbiter;
     QHash<const QMetaObject*, QBackendNodeMapperPtr> m_backendCreatorFunctors;
+    // Mapper resolved for a given most derived type, avoids walking the superclass chain
+    mutable QHash<const QMetaObject*, QBackendNodeMapperPtr> m_mapperCache;
+    int m_backendNodeCacheId;
     QMutex m_singleShotMutex;
     QVector<QAspectJobPtr> m_singleShotJobs;
 
@@ -52,7 +52,6 @@
 #include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
 #include <Qt3DCore/private/qabstractframeadvanceservice_p.h>
 #include <Qt3DCore/private/qaspectengine_p.h>
-// TODO Make the kind of job manager configurable (e.g. ThreadWeaver vs Intel TBB)
 #include <Qt3DCore/private/qaspectjobmanager_p.h>
 #include <Qt3DCore/private/qaspectjob_p.h>
 #include <Qt3DCore/private/qchangearbiter_p.h>
@@ -62,6 +61,7 @@
 #include <Qt3DCore/private/qthreadpooler_p.h>
 #include <Qt3DCore/private/qtickclock_p.h>
 #include <Qt3DCore/private/qtickclockservice_p.h>
+#include <Qt3DCore/private/qworkstealingjobmanager_p.h>
 #include <Qt3DCore/private/qnodevisitor_p.h>
 #include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qscene_p.h>
@@ -75,6 +75,19 @@ QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
 
+namespace {
+
+// QT3D_JOB_SCHEDULER=workstealing swaps the QThreadPool based job manager
+// for one with per thread queues and work stealing
+QAbstractAspectJobManager *createJobManager(QAspectManager *manager)
+{
+    if (qgetenv("QT3D_JOB_SCHEDULER") == QByteArrayLiteral("workstealing"))
+        return new QWorkStealingJobManager(manager);
+    return new QAspectJobManager(manager);
+}
+
+} // anonymous
+
 #if QT_CONFIG(animation)
 class RequestFrameAnimation final : public QAbstractAnimation
 {
@@ -121,7 +134,7 @@ QAspectManager::QAspectManager(QAspectEngine *parent)
     , m_engine(parent)
     , m_root(nullptr)
     , m_scheduler(new QScheduler(this))
-    , m_jobManager(new QAspectJobManager(this))
+    , m_jobManager(createJobManager(this))
     , m_changeArbiter(new QChangeArbiter(this))
     , m_serviceLocator(new QServiceLocator(parent))
     , m_simulationLoopRunning(false)
@@ -341,6 +354,9 @@ void QAspectManager::removeNodes(const QVector<QNode *> &nodes)
                                                [&node] (const NodeTreeChange &change) { return change.id == node->id(); }),
                                 m_nodeTreeChanges.end());
 
+        // Backend nodes are about to be destroyed
+        QNodePrivate::get(node)->m_backendNodes.clear();
+
         m_nodeTreeChanges.push_back({ node->id(),
                                       QNodePrivate::get(node)->m_typeInfo,
                                       NodeTreeChange::Removed,
@@ -384,6 +400,7 @@ void QAspectManager::unregisterAspect(Qt3DCore::QAbstractAspect *aspect)
     qCDebug(Aspects) << "Unregistering aspect";
     Q_ASSERT(aspect);
     aspect->onUnregistered();
+    QAbstractAspectPrivate::get(aspect)->invalidateBackendNodeCache();
     QAbstractAspectPrivate::get(aspect)->m_arbiter = nullptr;
     QAbstractAspectPrivate::get(aspect)->m_jobManager = nullptr;
     QAbstractAspectPrivate::get(aspect)->m_aspectManager = nullptr;
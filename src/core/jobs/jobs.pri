@@ -3,7 +3,9 @@ SOURCES += \
     $$PWD/qaspectjob.cpp \
     $$PWD/qaspectjobmanager.cpp \
     $$PWD/qabstractaspectjobmanager.cpp \
+    $$PWD/qparallelfor.cpp \
     $$PWD/qthreadpooler.cpp \
+    $$PWD/qworkstealingjobmanager.cpp \
     $$PWD/task.cpp
 
 HEADERS += \
@@ -12,8 +14,10 @@ HEADERS += \
     $$PWD/qaspectjobproviderinterface_p.h \
     $$PWD/qaspectjobmanager_p.h \
     $$PWD/qabstractaspectjobmanager_p.h \
+    $$PWD/qparallelfor_p.h \
     $$PWD/task_p.h \
-    $$PWD/qthreadpooler_p.h
+    $$PWD/qthreadpooler_p.h \
+    $$PWD/qworkstealingjobmanager_p.h
 
 INCLUDEPATH += $$PWD
 
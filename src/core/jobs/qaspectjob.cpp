@@ -43,6 +43,7 @@
 #include <Qt3DCore/qaspectengine.h>
 #include <Qt3DCore/private/qaspectengine_p.h>
 
+#include <QtCore/QAtomicInt>
 #include <QtCore/QByteArray>
 
 QT_BEGIN_NAMESPACE
@@ -56,10 +57,14 @@ bool isDependencyNull(const QWeakPointer<QAspectJob> &dep)
     return dep.isNull();
 }
 
+QBasicAtomicInt nextDependencyRevision = Q_BASIC_ATOMIC_INITIALIZER(0);
+
 } // anonymous
 
 QAspectJobPrivate::QAspectJobPrivate()
-    : m_jobName(QLatin1String("UnknowJob"))
+    : m_dependencyRevision(nextDependencyRevision.fetchAndAddRelaxed(1))
+    , m_jobName(QLatin1String("UnknowJob"))
+    , m_service(nullptr)
 {
 }
 
@@ -80,6 +85,11 @@ void QAspectJobPrivate::postFrame(QAspectManager *aspectManager)
     Q_UNUSED(aspectManager)
 }
 
+void QAspectJobPrivate::dependenciesChanged()
+{
+    m_dependencyRevision = nextDependencyRevision.fetchAndAddRelaxed(1);
+}
+
 QAspectJob::QAspectJob()
     : d_ptr(new QAspectJobPrivate)
 {
@@ -117,6 +127,7 @@ void QAspectJob::addDependency(QWeakPointer<QAspectJob> dependency)
 {
     Q_D(QAspectJob);
     d->m_dependencies.append(dependency);
+    d->dependenciesChanged();
 #ifdef QT3DCORE_ASPECT_JOB_DEBUG
     static int threshold = qMax(1, qgetenv("QT3DCORE_ASPECT_JOB_DEPENDENCY_THRESHOLD").toInt());
     if (d->m_dependencies.count() > threshold)
@@ -138,6 +149,7 @@ void QAspectJob::removeDependency(QWeakPointer<QAspectJob> dependency)
                                                isDependencyNull),
                                 d->m_dependencies.end());
     }
+    d->dependenciesChanged();
 }
 
 /*!
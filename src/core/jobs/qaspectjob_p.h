@@ -75,9 +75,16 @@ public:
     virtual bool isRequired();
     virtual void postFrame(QAspectManager *aspectManager);
 
+    void dependenciesChanged();
+
     QVector<QWeakPointer<QAspectJob> > m_dependencies;
+    // Changes whenever m_dependencies does, unique across all jobs so that it
+    // also tells a job apart from a later one allocated at the same address
+    int m_dependencyRevision;
     JobId m_jobId;
     QString m_jobName;
+    // Set by the job manager, for QParallelFor to trace the chunks it runs
+    QSystemInformationService *m_service;
 };
 } // Qt3D
 
@@ -44,6 +44,7 @@
 #include <QtCore/QDebug>
 #include <QtCore/QThread>
 #include <QtCore/QFuture>
+#include <Qt3DCore/private/qaspectjob_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
 #include <Qt3DCore/private/qthreadpooler_p.h>
 #include <Qt3DCore/private/task_p.h>
@@ -52,15 +53,52 @@ QT_BEGIN_NAMESPACE
 
 namespace Qt3DCore {
 
+namespace {
+
+// Links tasks[i], which runs jobQueue[i], to the tasks it has to wait for
+void connectTasks(const QVector<QAspectJobPtr> &jobQueue,
+                  const QVector<AspectTaskRunnable *> &tasks)
+{
+    QHash<QAspectJob *, AspectTaskRunnable *> tasksMap;
+    tasksMap.reserve(jobQueue.size());
+    for (int i = 0, m = jobQueue.size(); i < m; ++i)
+        tasksMap.insert(jobQueue.at(i).data(), tasks.at(i));
+
+    for (int i = 0, m = jobQueue.size(); i < m; ++i) {
+        const QVector<QWeakPointer<QAspectJob> > &deps = QAspectJobPrivate::get(jobQueue.at(i).data())->m_dependencies;
+        AspectTaskRunnable *taskDepender = tasks.at(i);
+
+        int dependerCount = 0;
+        for (const QWeakPointer<QAspectJob> &dep : deps) {
+            AspectTaskRunnable *taskDependee = tasksMap.value(dep.toStrongRef().data());
+            // The dependencies here are not hard requirements, i.e., the dependencies
+            // not in the jobQueue should already have their data ready.
+            if (taskDependee) {
+                taskDependee->m_dependers.append(taskDepender);
+                ++dependerCount;
+            }
+        }
+
+        taskDepender->m_dependerCount += dependerCount;
+        taskDepender->m_initialDependerCount = taskDepender->m_dependerCount;
+    }
+}
+
+} // anonymous
+
 QAspectJobManager::QAspectJobManager(QAspectManager *parent)
     : QAbstractAspectJobManager(parent)
     , m_threadPooler(new QThreadPooler(this))
     , m_aspectManager(parent)
+    , m_graphService(nullptr)
 {
 }
 
 QAspectJobManager::~QAspectJobManager()
 {
+    // Reused tasks aren't auto deleted, make sure none of them is still running
+    m_threadPooler->waitForAllJobs();
+    qDeleteAll(m_graphTasks);
 }
 
 void QAspectJobManager::initialize()
@@ -74,37 +112,78 @@ void QAspectJobManager::enqueueJobs(const QVector<QAspectJobPtr> &jobQueue)
     if (systemService)
         systemService->writePreviousFrameTraces();
 
-    // Convert QJobs to Tasks
-    QHash<QAspectJob *, AspectTaskRunnable *> tasksMap;
-    QVector<RunnableInterface *> taskList;
-    taskList.reserve(jobQueue.size());
-    for (const QAspectJobPtr &job : jobQueue) {
-        AspectTaskRunnable *task = new AspectTaskRunnable(systemService);
-        task->m_job = job;
-        tasksMap.insert(job.data(), task);
+    // The cached tasks may still be in flight if the previous jobs weren't
+    // waited for, use one-shot tasks for this batch instead
+    if (m_threadPooler->hasPendingTasks()) {
+        QVector<AspectTaskRunnable *> tasks;
+        QVector<RunnableInterface *> taskList;
+        tasks.reserve(jobQueue.size());
+        taskList.reserve(jobQueue.size());
+        for (const QAspectJobPtr &job : jobQueue) {
+            AspectTaskRunnable *task = new AspectTaskRunnable(systemService);
+            task->m_job = job;
+            tasks << task;
+            taskList << task;
+        }
+        connectTasks(jobQueue, tasks);
+        m_threadPooler->mapDependables(taskList);
+        return;
+    }
 
-        taskList << task;
+    if (systemService != m_graphService || !isTaskGraphUpToDate(jobQueue)) {
+        rebuildTaskGraph(jobQueue, systemService);
+    } else {
+        for (AspectTaskRunnable *task : qAsConst(m_graphTasks))
+            task->reset();
     }
 
-    for (const QAspectJobPtr &job : jobQueue) {
-        const QVector<QWeakPointer<QAspectJob> > &deps = job->dependencies();
-        AspectTaskRunnable *taskDepender = tasksMap.value(job.data());
+    // Tasks drop their job once run or skipped
+    for (int i = 0, m = jobQueue.size(); i < m; ++i)
+        m_graphTasks.at(i)->m_job = jobQueue.at(i);
 
-        int dependerCount = 0;
-        for (const QWeakPointer<QAspectJob> &dep : deps) {
-            AspectTaskRunnable *taskDependee = tasksMap.value(dep.toStrongRef().data());
-            // The dependencies here are not hard requirements, i.e., the dependencies
-            // not in the jobQueue should already have their data ready.
-            if (taskDependee) {
-                taskDependee->m_dependers.append(taskDepender);
-                ++dependerCount;
-            }
-        }
+    m_threadPooler->mapDependables(m_graphTaskList);
+}
 
-        taskDepender->m_dependerCount += dependerCount;
+bool QAspectJobManager::isTaskGraphUpToDate(const QVector<QAspectJobPtr> &jobQueue) const
+{
+    if (jobQueue.size() != m_graphJobs.size())
+        return false;
+
+    for (int i = 0, m = jobQueue.size(); i < m; ++i) {
+        QAspectJob *job = jobQueue.at(i).data();
+        if (job != m_graphJobs.at(i)
+                || QAspectJobPrivate::get(job)->m_dependencyRevision != m_graphJobRevisions.at(i))
+            return false;
+    }
+    return true;
+}
+
+void QAspectJobManager::rebuildTaskGraph(const QVector<QAspectJobPtr> &jobQueue,
+                                         QSystemInformationService *service)
+{
+    qDeleteAll(m_graphTasks);
+    m_graphTasks.clear();
+    m_graphTaskList.clear();
+    m_graphJobs.clear();
+    m_graphJobRevisions.clear();
+    m_graphService = service;
+
+    const int jobCount = jobQueue.size();
+    m_graphTasks.reserve(jobCount);
+    m_graphTaskList.reserve(jobCount);
+    m_graphJobs.reserve(jobCount);
+    m_graphJobRevisions.reserve(jobCount);
+
+    for (const QAspectJobPtr &job : jobQueue) {
+        AspectTaskRunnable *task = new AspectTaskRunnable(service);
+        task->setAutoDelete(false);
+        m_graphTasks << task;
+        m_graphTaskList << task;
+        m_graphJobs << job.data();
+        m_graphJobRevisions << QAspectJobPrivate::get(job.data())->m_dependencyRevision;
     }
 
-    m_threadPooler->mapDependables(taskList);
+    connectTasks(jobQueue, m_graphTasks);
 }
 
 // Wait for all aspects jobs to be completed
@@ -64,6 +64,9 @@ namespace Qt3DCore {
 class QThreadPooler;
 class DependencyHandler;
 class QAspectManager;
+class AspectTaskRunnable;
+class RunnableInterface;
+class QSystemInformationService;
 
 class Q_3DCORE_PRIVATE_EXPORT QAspectJobManager : public QAbstractAspectJobManager
 {
@@ -81,8 +84,20 @@ public:
     void waitForPerThreadFunction(JobFunction func, void *arg) override;
 
 private:
+    bool isTaskGraphUpToDate(const QVector<QAspectJobPtr> &jobQueue) const;
+    void rebuildTaskGraph(const QVector<QAspectJobPtr> &jobQueue,
+                          QSystemInformationService *service);
+
     QThreadPooler *m_threadPooler;
     QAspectManager *m_aspectManager;
+
+    // Task graph of the last enqueued jobs, reused while neither the jobs nor
+    // their dependencies change
+    QVector<QAspectJob *> m_graphJobs;
+    QVector<int> m_graphJobRevisions;
+    QVector<AspectTaskRunnable *> m_graphTasks;
+    QVector<RunnableInterface *> m_graphTaskList;
+    QSystemInformationService *m_graphService;
 };
 
 } // namespace Qt3DCore
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qparallelfor_p.h"
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+#include <Qt3DCore/private/qaspectjob_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+namespace {
+
+// Shared with the helper runnables, which may only get to start once the
+// loop is over; they then find no chunk left and never touch the kernel
+struct ParallelForState
+{
+    const QParallelFor::Kernel *kernel;
+    QSystemInformationService *service;
+    JobId jobId;
+    int size;
+    int chunkCount;
+    QAtomicInt nextChunk;
+    QAtomicInt completedChunks;
+    QMutex mutex;
+    QWaitCondition finished;
+};
+
+bool runNextChunk(ParallelForState *state)
+{
+    const int chunk = state->nextChunk.fetchAndAddRelaxed(1);
+    if (chunk >= state->chunkCount)
+        return false;
+
+    const int begin = int(qint64(chunk) * state->size / state->chunkCount);
+    const int end = int(qint64(chunk + 1) * state->size / state->chunkCount);
+    {
+        QTaskLogger logger(state->service, state->jobId, QTaskLogger::AspectJob);
+        (*state->kernel)(chunk, begin, end);
+    }
+
+    if (state->completedChunks.fetchAndAddOrdered(1) + 1 == state->chunkCount) {
+        const QMutexLocker locker(&state->mutex);
+        state->finished.wakeAll();
+    }
+    return true;
+}
+
+class ParallelForRunnable : public QRunnable
+{
+public:
+    explicit ParallelForRunnable(const QSharedPointer<ParallelForState> &state)
+        : m_state(state)
+    {
+    }
+
+    void run() override
+    {
+        while (runNextChunk(m_state.data()))
+            ;
+    }
+
+private:
+    QSharedPointer<ParallelForState> m_state;
+};
+
+} // anonymous
+
+QParallelFor::QParallelFor(int size, int minChunkSize)
+    : m_size(qMax(0, size))
+    , m_chunkCount(0)
+{
+    if (m_size == 0)
+        return;
+
+    // A few chunks per thread so that uneven chunks balance out
+    const int maxChunkCount = qMax(1, QThread::idealThreadCount() * 4);
+    const int minChunk = qMax(1, minChunkSize);
+    m_chunkCount = qBound(1, (m_size + minChunk - 1) / minChunk, maxChunkCount);
+}
+
+void QParallelFor::run(const Kernel &kernel, QAspectJob *job) const
+{
+    if (m_chunkCount == 0)
+        return;
+
+    QSharedPointer<ParallelForState> state = QSharedPointer<ParallelForState>::create();
+    state->kernel = &kernel;
+    state->service = nullptr;
+    state->size = m_size;
+    state->chunkCount = m_chunkCount;
+    if (job) {
+        const QAspectJobPrivate *jobD = QAspectJobPrivate::get(job);
+        state->service = jobD->m_service;
+        state->jobId = jobD->m_jobId;
+    }
+
+    if (m_chunkCount > 1) {
+        QThreadPool *pool = QThreadPool::globalInstance();
+        const int helperCount = qMin(m_chunkCount, pool->maxThreadCount()) - 1;
+        for (int i = 0; i < helperCount; ++i)
+            pool->start(new ParallelForRunnable(state));
+    }
+
+    // The calling thread takes part, so the loop completes even if the pool
+    // is busy running other jobs
+    while (runNextChunk(state.data()))
+        ;
+
+    const QMutexLocker locker(&state->mutex);
+    while (state->completedChunks.loadAcquire() < m_chunkCount)
+        state->finished.wait(&state->mutex);
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
@@ -0,0 +1,92 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QPARALLELFOR_P_H
+#define QT3DCORE_QPARALLELFOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class QAspectJob;
+
+// Data parallel loop over [0, size) for use inside QAspectJob::run().
+// The range is split in chunks of at least minChunkSize elements, never more
+// than a few per thread, which are processed by the global thread pool and
+// the calling thread. Chunks are numbered in range order so that kernels can
+// fill per chunk results and merge them in order once run() has returned.
+class Q_3DCORE_PRIVATE_EXPORT QParallelFor
+{
+public:
+    typedef std::function<void (int chunk, int begin, int end)> Kernel;
+
+    explicit QParallelFor(int size, int minChunkSize = 256);
+
+    int size() const { return m_size; }
+    int chunkCount() const { return m_chunkCount; }
+
+    // Blocks until all chunks have run. When job is given, each chunk is
+    // traced as a run of that job.
+    void run(const Kernel &kernel, QAspectJob *job = nullptr) const;
+
+private:
+    int m_size;
+    int m_chunkCount;
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QPARALLELFOR_P_H
@@ -110,7 +110,12 @@ void QThreadPooler::skipTask(RunnableInterface *task)
         m_futureInterface = nullptr;
     }
 
-    delete task; // normally gets deleted by threadpool
+    if (task->autoDelete()) {
+        delete task; // normally gets deleted by threadpool
+    } else if (task->type() == RunnableInterface::RunnableType::AspectTask) {
+        // Reused task, only drop the job it would have released when run
+        static_cast<AspectTaskRunnable *>(task)->m_job.reset();
+    }
 }
 
 void QThreadPooler::enqueueDepencies(RunnableInterface *task)
@@ -175,6 +180,13 @@ int QThreadPooler::waitForAllJobs()
     return m_totalRunJobs;
 }
 
+bool QThreadPooler::hasPendingTasks()
+{
+    const QMutexLocker locker(&m_mutex);
+
+    return currentCount() > 0;
+}
+
 QFuture<void> QThreadPooler::future()
 {
     const QMutexLocker locker(&m_mutex);
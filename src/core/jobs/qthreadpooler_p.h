@@ -76,6 +76,7 @@ public:
     int waitForAllJobs();
     void taskFinished(RunnableInterface *task);
     QFuture<void> future();
+    bool hasPendingTasks();
 
     int maxThreadCount() const;
 
@@ -0,0 +1,328 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qworkstealingjobmanager_p.h"
+
+#include <QtCore/QHash>
+#include <QtCore/QThread>
+#include <Qt3DCore/private/qaspectjob_p.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qservicelocator_p.h>
+#include <Qt3DCore/private/qsysteminformationservice_p_p.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class QWorkStealingWorker : public QThread
+{
+public:
+    QWorkStealingWorker(QWorkStealingJobManager *manager, int index)
+        : m_manager(manager)
+        , m_index(index)
+    {
+        setObjectName(QStringLiteral("Qt3D Job Worker %1").arg(index));
+    }
+
+    void run() override
+    {
+        while (QWorkStealingJobManager::Task *task = m_manager->takeTask(m_index)) {
+            // Keep going with the dependent a task made ready, if any
+            while (task)
+                task = m_manager->execute(task, m_index);
+        }
+    }
+
+private:
+    QWorkStealingJobManager *m_manager;
+    const int m_index;
+};
+
+QWorkStealingJobManager::QWorkStealingJobManager(QAspectManager *parent)
+    : QAbstractAspectJobManager(parent)
+    , m_aspectManager(parent)
+    , m_service(nullptr)
+    , m_pendingTaskCount(0)
+    , m_queuedTaskCount(0)
+    , m_runJobCount(0)
+    , m_nextQueue(0)
+    , m_sleepingWorkerCount(0)
+    , m_quit(false)
+{
+    int workerCount = QThread::idealThreadCount();
+    const QByteArray maxThreadCount = qgetenv("QT3D_MAX_THREAD_COUNT");
+    if (!maxThreadCount.isEmpty()) {
+        bool conversionOK = false;
+        const int maxThreadCountValue = maxThreadCount.toInt(&conversionOK);
+        if (conversionOK)
+            workerCount = maxThreadCountValue;
+    }
+    workerCount = qMax(1, workerCount);
+
+    m_queues.reserve(workerCount);
+    m_workers.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i)
+        m_queues.push_back(new WorkerQueue);
+    for (int i = 0; i < workerCount; ++i) {
+        QWorkStealingWorker *worker = new QWorkStealingWorker(this, i);
+        m_workers.push_back(worker);
+        worker->start();
+    }
+}
+
+QWorkStealingJobManager::~QWorkStealingJobManager()
+{
+    waitForIdle();
+
+    {
+        const QMutexLocker locker(&m_sleepMutex);
+        m_quit = true;
+        m_sleepCondition.wakeAll();
+    }
+    for (QWorkStealingWorker *worker : qAsConst(m_workers)) {
+        worker->wait();
+        delete worker;
+    }
+    qDeleteAll(m_queues);
+}
+
+void QWorkStealingJobManager::enqueueJobs(const QVector<QAspectJobPtr> &jobQueue)
+{
+    m_service = m_aspectManager ? m_aspectManager->serviceLocator()->systemInformation() : nullptr;
+    if (m_service)
+        m_service->writePreviousFrameTraces();
+
+    QHash<QAspectJob *, Task *> tasksMap;
+    QVector<Task *> tasks;
+    tasksMap.reserve(jobQueue.size());
+    tasks.reserve(jobQueue.size());
+    for (const QAspectJobPtr &job : jobQueue) {
+        Task *task = new Task;
+        task->job = job;
+        tasksMap.insert(job.data(), task);
+        tasks.push_back(task);
+    }
+
+    for (int i = 0, m = jobQueue.size(); i < m; ++i) {
+        Task *taskDepender = tasks.at(i);
+        const QVector<QWeakPointer<QAspectJob> > &deps = QAspectJobPrivate::get(jobQueue.at(i).data())->m_dependencies;
+
+        int dependencyCount = 0;
+        for (const QWeakPointer<QAspectJob> &dep : deps) {
+            // As with QAspectJobManager, dependencies which aren't
+            // part of the queue are considered ready
+            Task *taskDependee = tasksMap.value(dep.toStrongRef().data());
+            if (taskDependee) {
+                taskDependee->dependers.push_back(taskDepender);
+                ++dependencyCount;
+            }
+        }
+        taskDepender->pendingDependencies.storeRelaxed(dependencyCount);
+    }
+
+    start(tasks);
+}
+
+int QWorkStealingJobManager::waitForAllJobs()
+{
+    waitForIdle();
+    return m_runJobCount.fetchAndStoreOrdered(0);
+}
+
+void QWorkStealingJobManager::waitForPerThreadFunction(JobFunction func, void *arg)
+{
+    // Each sync task spins until all of them have been picked up, so no
+    // worker can end up running two of them
+    const int workerCount = m_workers.size();
+    QAtomicInt barrier(workerCount);
+
+    QVector<Task *> tasks;
+    tasks.reserve(workerCount);
+    for (int i = 0; i < workerCount; ++i) {
+        Task *task = new Task;
+        task->func = func;
+        task->arg = arg;
+        task->barrier = &barrier;
+        tasks.push_back(task);
+    }
+
+    start(tasks);
+    waitForIdle();
+}
+
+void QWorkStealingJobManager::start(const QVector<Task *> &tasks)
+{
+    if (tasks.isEmpty())
+        return;
+
+    m_tasks += tasks;
+    m_pendingTaskCount.fetchAndAddOrdered(tasks.size());
+
+    // Spread the tasks that are ready right away over the workers
+    for (Task *task : tasks) {
+        if (task->pendingDependencies.loadRelaxed() == 0) {
+            push(m_nextQueue, task);
+            m_nextQueue = (m_nextQueue + 1) % m_queues.size();
+        }
+    }
+}
+
+void QWorkStealingJobManager::push(int workerIndex, Task *task)
+{
+    WorkerQueue *queue = m_queues.at(workerIndex);
+    {
+        const QMutexLocker locker(&queue->mutex);
+        queue->tasks.push_back(task);
+    }
+    m_queuedTaskCount.fetchAndAddOrdered(1);
+
+    if (m_sleepingWorkerCount.fetchAndAddOrdered(0) > 0) {
+        const QMutexLocker locker(&m_sleepMutex);
+        m_sleepCondition.wakeOne();
+    }
+}
+
+QWorkStealingJobManager::Task *QWorkStealingJobManager::pop(int workerIndex)
+{
+    WorkerQueue *queue = m_queues.at(workerIndex);
+    const QMutexLocker locker(&queue->mutex);
+    if (queue->tasks.empty())
+        return nullptr;
+    Task *task = queue->tasks.back();
+    queue->tasks.pop_back();
+    m_queuedTaskCount.fetchAndAddOrdered(-1);
+    return task;
+}
+
+QWorkStealingJobManager::Task *QWorkStealingJobManager::steal(int thiefIndex)
+{
+    const int queueCount = m_queues.size();
+    for (int i = 1; i < queueCount; ++i) {
+        WorkerQueue *queue = m_queues.at((thiefIndex + i) % queueCount);
+        // Don't wait on a busy victim, try the next one
+        if (!queue->mutex.tryLock())
+            continue;
+        Task *task = nullptr;
+        if (!queue->tasks.empty()) {
+            task = queue->tasks.front();
+            queue->tasks.pop_front();
+            m_queuedTaskCount.fetchAndAddOrdered(-1);
+        }
+        queue->mutex.unlock();
+        if (task)
+            return task;
+    }
+    return nullptr;
+}
+
+QWorkStealingJobManager::Task *QWorkStealingJobManager::takeTask(int workerIndex)
+{
+    while (true) {
+        if (Task *task = pop(workerIndex))
+            return task;
+        if (Task *task = steal(workerIndex))
+            return task;
+
+        const QMutexLocker locker(&m_sleepMutex);
+        if (m_quit)
+            return nullptr;
+        m_sleepingWorkerCount.fetchAndAddOrdered(1);
+        // A task pushed after this point wakes us up, one pushed before is
+        // accounted for in the queued count
+        if (m_queuedTaskCount.fetchAndAddOrdered(0) <= 0)
+            m_sleepCondition.wait(&m_sleepMutex);
+        m_sleepingWorkerCount.fetchAndAddOrdered(-1);
+        if (m_quit)
+            return nullptr;
+    }
+}
+
+QWorkStealingJobManager::Task *QWorkStealingJobManager::execute(Task *task, int workerIndex)
+{
+    if (task->job) {
+        QAspectJobPrivate *jobD = QAspectJobPrivate::get(task->job.data());
+        if (jobD->isRequired()) {
+            jobD->m_service = m_service;
+            QTaskLogger logger(m_service, jobD->m_jobId, QTaskLogger::AspectJob);
+            task->job->run();
+            m_runJobCount.fetchAndAddOrdered(1);
+        }
+        task->job.reset();
+    } else if (task->func) {
+        task->func(task->arg);
+        task->barrier->deref();
+        while (task->barrier->loadAcquire() > 0)
+            QThread::yieldCurrentThread();
+    }
+
+    // Run the first dependent we made ready ourselves, queue the others
+    Task *next = nullptr;
+    for (Task *depender : qAsConst(task->dependers)) {
+        if (!depender->pendingDependencies.deref()) {
+            if (!next)
+                next = depender;
+            else
+                push(workerIndex, depender);
+        }
+    }
+
+    if (!m_pendingTaskCount.deref()) {
+        const QMutexLocker locker(&m_idleMutex);
+        m_idleCondition.wakeAll();
+    }
+
+    return next;
+}
+
+// Waits for all enqueued tasks to have run and releases them
+void QWorkStealingJobManager::waitForIdle()
+{
+    {
+        QMutexLocker locker(&m_idleMutex);
+        while (m_pendingTaskCount.loadAcquire() > 0)
+            m_idleCondition.wait(&m_idleMutex);
+    }
+
+    qDeleteAll(m_tasks);
+    m_tasks.clear();
+}
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
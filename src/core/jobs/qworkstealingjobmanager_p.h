@@ -0,0 +1,144 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DCORE_QWORKSTEALINGJOBMANAGER_P_H
+#define QT3DCORE_QWORKSTEALINGJOBMANAGER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DCore/qaspectjob.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QVector>
+#include <QtCore/QWaitCondition>
+
+#include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
+#include <Qt3DCore/private/qt3dcore_global_p.h>
+
+#include <deque>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DCore {
+
+class QAspectManager;
+class QSystemInformationService;
+class QWorkStealingWorker;
+
+// Job scheduler with its own worker threads, each owning a deque of ready
+// tasks. Workers pop their own tasks LIFO, steal from the other end of the
+// other deques when they run dry and run the first dependent a finished task
+// made ready straight away rather than queuing it.
+class Q_3DCORE_PRIVATE_EXPORT QWorkStealingJobManager : public QAbstractAspectJobManager
+{
+    Q_OBJECT
+public:
+    explicit QWorkStealingJobManager(QAspectManager *parent = nullptr);
+    ~QWorkStealingJobManager();
+
+    void enqueueJobs(const QVector<QAspectJobPtr> &jobQueue) override;
+
+    int waitForAllJobs() override;
+
+    void waitForPerThreadFunction(JobFunction func, void *arg) override;
+
+    int workerCount() const { return m_workers.size(); }
+
+    struct Task
+    {
+        QAspectJobPtr job;
+        JobFunction func = nullptr;
+        void *arg = nullptr;
+        QAtomicInt *barrier = nullptr;
+        QVector<Task *> dependers;
+        QAtomicInt pendingDependencies;
+    };
+
+private:
+    struct WorkerQueue
+    {
+        QMutex mutex;
+        std::deque<Task *> tasks;
+    };
+
+    void start(const QVector<Task *> &tasks);
+    void push(int workerIndex, Task *task);
+    Task *pop(int workerIndex);
+    Task *steal(int thiefIndex);
+    Task *takeTask(int workerIndex);
+    Task *execute(Task *task, int workerIndex);
+    void waitForIdle();
+
+    QAspectManager *m_aspectManager;
+    QSystemInformationService *m_service;
+    QVector<QWorkStealingWorker *> m_workers;
+    QVector<WorkerQueue *> m_queues;
+
+    // Tasks enqueued since the last wait, owned by the manager
+    QVector<Task *> m_tasks;
+    QAtomicInt m_pendingTaskCount;
+    QAtomicInt m_queuedTaskCount;
+    QAtomicInt m_runJobCount;
+    int m_nextQueue;
+
+    QMutex m_sleepMutex;
+    QWaitCondition m_sleepCondition;
+    QAtomicInt m_sleepingWorkerCount;
+    bool m_quit;
+
+    QMutex m_idleMutex;
+    QWaitCondition m_idleCondition;
+
+    friend class QWorkStealingWorker;
+};
+
+} // namespace Qt3DCore
+
+QT_END_NAMESPACE
+
+#endif // QT3DCORE_QWORKSTEALINGJOBMANAGER_P_H
@@ -77,10 +77,14 @@ void AspectTaskRunnable::run()
 {
     if (m_job) {
         QAspectJobPrivate *jobD = QAspectJobPrivate::get(m_job.data());
-        QTaskLogger logger(m_pooler ? m_service : nullptr, jobD->m_jobId, QTaskLogger::AspectJob);
+        jobD->m_service = m_pooler ? m_service : nullptr;
+        QTaskLogger logger(jobD->m_service, jobD->m_jobId, QTaskLogger::AspectJob);
         m_job->run();
     }
 
+    // Don't keep the job alive when the task is kept around for reuse
+    m_job.reset();
+
     // We could have an append sub task or something in here
     // So that a job can post sub jobs ?
 
@@ -88,6 +92,13 @@ void AspectTaskRunnable::run()
         m_pooler->taskFinished(this);
 }
 
+void AspectTaskRunnable::reset()
+{
+    m_dependerCount = m_initialDependerCount;
+    m_pooler = nullptr;
+    m_reserved = false;
+}
+
 // Synchronized task
 
 SyncTaskRunnable::SyncTaskRunnable(QAbstractAspectJobManager::JobFunction func,
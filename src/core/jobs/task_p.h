@@ -110,10 +110,14 @@ public:
 
     RunnableType type() const Q_DECL_OVERRIDE { return RunnableType::AspectTask; }
 
+    // Restores the state a reused task had right after being built
+    void reset();
+
 public:
     QSharedPointer<QAspectJob> m_job;
     QVector<AspectTaskRunnable *> m_dependers;
     int m_dependerCount = 0;
+    int m_initialDependerCount = 0;
 
 private:
     QSystemInformationService *m_service;
@@ -67,6 +67,7 @@ QNodePrivate::QNodePrivate()
     , m_typeInfo(nullptr)
     , m_scene(nullptr)
     , m_id(QNodeId::createId())
+    , m_dirtyFrontEndNodeIndex(-1)
     , m_blockNotifications(false)
     , m_hasBackendNode(false)
     , m_enabled(true)
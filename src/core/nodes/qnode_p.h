@@ -60,6 +60,7 @@
 #include <Qt3DCore/private/qscene_p.h>
 #include <Qt3DCore/private/qt3dcore_global_p.h>
 #include <QtCore/private/qobject_p.h>
+#include <QtCore/QVarLengthArray>
 #include <QQueue>
 
 QT_BEGIN_NAMESPACE
@@ -67,6 +68,7 @@ QT_BEGIN_NAMESPACE
 namespace Qt3DCore {
 
 class QNode;
+class QBackendNode;
 class QAspectEngine;
 
 class Q_3DCORE_PRIVATE_EXPORT QNodePrivate : public QObjectPrivate
@@ -100,12 +102,17 @@ public:
     QScene *m_scene;
     mutable QNodeId m_id;
     QNodeId m_parentId; // Store this so we have it even in parent's QObject dtor
+    // Position in the dirty front end node list of m_changeArbiter, -1 if not dirty
+    int m_dirtyFrontEndNodeIndex;
     bool m_blockNotifications;
     bool m_hasBackendNode;
     bool m_enabled;
     bool m_notifiedParent;
     QNode::PropertyTrackingMode m_defaultPropertyTrackMode;
     QHash<QString, QNode::PropertyTrackingMode> m_trackedPropertiesOverrides;
+    // Backend node of each aspect, keyed by QAbstractAspectPrivate::m_backendNodeCacheId.
+    // A null backend means the aspect has no backend for this node
+    QVarLengthArray<QPair<int, QBackendNode *>, 4> m_backendNodes;
 
     static QNodePrivate *get(QNode *q);
     static const QNodePrivate *get(const QNode *q);
@@ -48,6 +48,7 @@
 
 #include <Qt3DCore/private/corelogging_p.h>
 #include <Qt3DCore/private/qabstractaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qscene_p.h>
 
 #include <mutex>
@@ -59,6 +60,7 @@ namespace Qt3DCore {
 QChangeArbiter::QChangeArbiter(QObject *parent)
     : QObject(parent)
     , m_scene(nullptr)
+    , m_removedDirtyFrontEndNodeCount(0)
 {
 }
 
@@ -76,10 +78,22 @@ QScene *QChangeArbiter::scene() const
     return m_scene;
 }
 
+// The index stored on the node is only trusted if it matches our list, the node
+// could have been marked dirty on another arbiter that was since destroyed
+bool QChangeArbiter::isDirtyFrontEndNode(const QNodePrivate *d, const QNode *node) const
+{
+    const int idx = d->m_dirtyFrontEndNodeIndex;
+    return idx >= 0 && idx < m_dirtyFrontEndNodes.size() && m_dirtyFrontEndNodes.at(idx) == node;
+}
+
 void QChangeArbiter::addDirtyFrontEndNode(QNode *node)
 {
-    if (!m_dirtyFrontEndNodes.contains(node)) {
-        m_dirtyFrontEndNodes += node;
+    // The node keeps track of its position in m_dirtyFrontEndNodes
+    // which allows checking for duplicates in constant time
+    QNodePrivate *d = QNodePrivate::get(node);
+    if (!isDirtyFrontEndNode(d, node)) {
+        d->m_dirtyFrontEndNodeIndex = m_dirtyFrontEndNodes.size();
+        m_dirtyFrontEndNodes.push_back(node);
         emit receivedChange();
     }
 }
@@ -93,7 +107,18 @@ void QChangeArbiter::addDirtyEntityComponentNodes(QEntity *entity, QComponent *c
 
 void QChangeArbiter::removeDirtyFrontEndNode(QNode *node)
 {
-    m_dirtyFrontEndNodes.removeOne(node);
+    // Leave a hole rather than shifting the remaining nodes,
+    // holes are discarded in takeDirtyFrontEndNodes
+    QNodePrivate *d = QNodePrivate::get(node);
+    if (isDirtyFrontEndNode(d, node)) {
+        m_dirtyFrontEndNodes[d->m_dirtyFrontEndNodeIndex] = nullptr;
+        ++m_removedDirtyFrontEndNodeCount;
+        d->m_dirtyFrontEndNodeIndex = -1;
+    }
+
+    if (m_dirtyEntityComponentNodeChanges.empty())
+        return;
+
     m_dirtyEntityComponentNodeChanges.erase(std::remove_if(m_dirtyEntityComponentNodeChanges.begin(), m_dirtyEntityComponentNodeChanges.end(), [node](const ComponentRelationshipChange &elt) {
                                     return elt.node == node || elt.subNode == node;
                                 }), m_dirtyEntityComponentNodeChanges.end());
@@ -101,7 +126,21 @@ void QChangeArbiter::removeDirtyFrontEndNode(QNode *node)
 
 QVector<QNode *> QChangeArbiter::takeDirtyFrontEndNodes()
 {
-    return std::move(m_dirtyFrontEndNodes);
+    QVector<QNode *> dirtyFrontEndNodes = std::move(m_dirtyFrontEndNodes);
+    m_dirtyFrontEndNodes.clear();
+
+    for (QNode *node : qAsConst(dirtyFrontEndNodes)) {
+        if (node)
+            QNodePrivate::get(node)->m_dirtyFrontEndNodeIndex = -1;
+    }
+
+    if (m_removedDirtyFrontEndNodeCount > 0) {
+        dirtyFrontEndNodes.erase(std::remove(dirtyFrontEndNodes.begin(), dirtyFrontEndNodes.end(), nullptr),
+                                 dirtyFrontEndNodes.end());
+        m_removedDirtyFrontEndNodeCount = 0;
+    }
+
+    return dirtyFrontEndNodes;
 }
 
 QVector<ComponentRelationshipChange> QChangeArbiter::takeDirtyEntityComponentNodes()
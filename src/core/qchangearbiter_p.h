@@ -68,6 +68,7 @@ QT_BEGIN_NAMESPACE
 namespace Qt3DCore {
 
 class QNode;
+class QNodePrivate;
 class QObservableInterface;
 class QAbstractAspectJobManager;
 class QSceneObserverInterface;
@@ -112,8 +113,12 @@ Q_SIGNALS:
     void receivedChange();
 
 protected:
+    bool isDirtyFrontEndNode(const QNodePrivate *d, const QNode *node) const;
+
     QScene *m_scene;
+    // Ordered by insertion, removed nodes are left as nullptr until taken
     QVector<QNode *> m_dirtyFrontEndNodes;
+    int m_removedDirtyFrontEndNodeCount;
     QVector<ComponentRelationshipChange> m_dirtyEntityComponentNodeChanges;
 };
 
@@ -182,6 +182,11 @@ bool QTextureAtlasGenerator::operator==(const QTextureGenerator &other) const
             && otherFunctor->m_generation == m_generation);
 }
 
+uint QTextureAtlasGenerator::hash() const
+{
+    return qHash(m_atlasId, qHash(m_generation));
+}
+
 QTextureAtlas::QTextureAtlas(Qt3DCore::QNode *parent)
     : QAbstractTexture(*new QTextureAtlasPrivate(), parent)
 {
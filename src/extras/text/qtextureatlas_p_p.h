@@ -120,6 +120,7 @@ public:
     ~QTextureAtlasGenerator();
     Qt3DRender::QTextureDataPtr operator()() override;
     bool operator==(const QTextureGenerator &other) const override;
+    uint hash() const override;
 
     QT3D_FUNCTOR(QTextureAtlasGenerator)
 
@@ -202,6 +202,7 @@ void ImGuiRenderer::renderDebugOverlay(const QVector<RenderView *> &renderViews,
         QSet<Qt3DCore::QNodeId> inUseTextures;
         for (int j=0; j<renderViewsCount; j++) {
             const auto &commands = renderViews.at(j)->commands();
+            const auto &commandsBuildData = renderViews.at(j)->commandsBuildData();
             nCommands += commands.size();
             for (int k=0; k<commands.size(); k++) {
                 const RenderCommand &command = commands.at(k);
@@ -209,7 +210,7 @@ void ImGuiRenderer::renderDebugOverlay(const QVector<RenderView *> &renderViews,
                     continue;
                 nVertices += command.m_primitiveCount;
                 nPrimitives += vertexToPrimitiveCount(command.m_primitiveType, command.m_primitiveCount);
-                inUseGeometries.insert(command.m_geometryRenderer);
+                inUseGeometries.insert(commandsBuildData.at(k).m_geometryRenderer);
                 const auto &textures = command.m_parameterPack.textures();
                 for (const auto &ns: textures)
                     inUseTextures.insert(ns.nodeId);
@@ -250,6 +251,16 @@ void ImGuiRenderer::renderDebugOverlay(const QVector<RenderView *> &renderViews,
         column2Numbers(inUseGeometries.size(), m_renderer->nodeManagers()->geometryRendererManager()->count());
         column2Numbers(inUseTextures.size(), m_renderer->nodeManagers()->textureManager()->count());
 
+        // Counted over the previous frame, this one is still being submitted
+        ImGui::Columns(2);
+        ImGui::Separator();
+        for (auto s: {"Uniforms Uploaded", "Uniforms Skipped"}) {
+            ImGui::Text("#%s", s);
+            ImGui::NextColumn();
+        }
+        columnNumber(m_renderer->uniformsUploadedInLastFrame());
+        columnNumber(m_renderer->uniformsSkippedInLastFrame());
+
         ImGui::Columns(1);
         ImGui::Separator();
 
@@ -332,9 +343,11 @@ void ImGuiRenderer::showRenderDetails(const QVector<RenderView *> &renderViews)
             ImGui::Text("Clear Depth Value: %f", static_cast<double>(view->clearDepthValue()));
             ImGui::Text("Clear Stencil Value: %d", view->clearStencilValue());
             int j = 1;
-            const auto commands = view->commands();
-            for (const RenderCommand &command: commands) {
-                GeometryRenderer *rGeometryRenderer = m_renderer->nodeManagers()->data<GeometryRenderer, GeometryRendererManager>(command.m_geometryRenderer);
+            const auto &commands = view->commands();
+            const auto &commandsBuildData = view->commandsBuildData();
+            for (int k = 0; k < commands.size(); k++) {
+                const RenderCommand &command = commands.at(k);
+                GeometryRenderer *rGeometryRenderer = m_renderer->nodeManagers()->data<GeometryRenderer, GeometryRendererManager>(commandsBuildData.at(k).m_geometryRenderer);
                 QString label = QString(QLatin1String("Command %1 {%2}")).arg(QString::number(j++), QString::number(rGeometryRenderer->peerId().id()));
                 if (ImGui::TreeNode(label.toLatin1().data())) {
                     ImGui::Text("Primitive Type: %s %s", primitiveTypeName(command.m_primitiveType),
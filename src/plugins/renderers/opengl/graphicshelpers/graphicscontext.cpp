@@ -458,6 +458,16 @@ bool GraphicsContext::supportsDrawBuffersBlend() const
     return m_glHelper->supportsFeature(GraphicsHelperInterface::DrawBuffersBlend);
 }
 
+bool GraphicsContext::supportsMultiDrawIndirect() const
+{
+    return m_glHelper->supportsFeature(GraphicsHelperInterface::MultiDrawIndirect);
+}
+
+bool GraphicsContext::supportsBufferStorage() const
+{
+    return m_glHelper->supportsFeature(GraphicsHelperInterface::BufferStorage);
+}
+
 /*!
  * \internal
  * Wraps an OpenGL call to glDrawElementsInstanced.
@@ -736,6 +746,21 @@ char *GraphicsContext::mapBuffer(GLenum target, GLsizeiptr size)
     return m_glHelper->mapBuffer(target, size);
 }
 
+void GraphicsContext::bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+    m_glHelper->bufferStorage(target, size, data, flags);
+}
+
+void *GraphicsContext::mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    return m_glHelper->mapBufferRange(target, offset, length, access);
+}
+
+void GraphicsContext::copyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    m_glHelper->copyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+}
+
 void GraphicsContext::enablei(GLenum cap, GLuint index)
 {
     m_glHelper->enablei(cap, index);
@@ -153,6 +153,9 @@ public:
     void    dispatchCompute(int x, int y, int z);
     char *  mapBuffer(GLenum target, GLsizeiptr size);
     GLboolean unmapBuffer(GLenum target);
+    void    bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+    void *  mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access);
+    void    copyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size);
     void    drawArrays(GLenum primitiveType, GLint first, GLsizei count);
     void    drawArraysIndirect(GLenum mode,void *indirect);
     void    drawArraysInstanced(GLenum primitiveType, GLint first, GLsizei count, GLsizei instances);
@@ -187,6 +190,8 @@ public:
     static GLint glDataTypeFromAttributeDataType(Qt3DCore::QAttribute::VertexBaseType dataType);
 
     bool supportsDrawBuffersBlend() const;
+    bool supportsMultiDrawIndirect() const;
+    bool supportsBufferStorage() const;
     bool supportsVAO() const { return m_supportsVAO; }
 
     void initialize();
@@ -181,6 +181,40 @@ void GraphicsHelperES2::drawArraysIndirect(GLenum , void *)
     qWarning() << "Indirect Drawing is not supported with OpenGL ES 2";
 }
 
+void GraphicsHelperES2::multiDrawArraysIndirect(GLenum, const void *, GLsizei, GLsizei)
+{
+    static bool showWarning = true;
+    if (!showWarning)
+        return;
+    showWarning = false;
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL ES";
+}
+
+void GraphicsHelperES2::multiDrawElementsIndirect(GLenum, GLenum, const void *, GLsizei, GLsizei)
+{
+    static bool showWarning = true;
+    if (!showWarning)
+        return;
+    showWarning = false;
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL ES";
+}
+
+void GraphicsHelperES2::bufferStorage(GLenum, GLsizeiptr, const void *, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL ES";
+}
+
+void *GraphicsHelperES2::mapBufferRange(GLenum, GLintptr, GLsizeiptr, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL ES";
+    return nullptr;
+}
+
+void GraphicsHelperES2::copyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL ES";
+}
+
 void GraphicsHelperES2::setVerticesPerPatch(GLint verticesPerPatch)
 {
     Q_UNUSED(verticesPerPatch);
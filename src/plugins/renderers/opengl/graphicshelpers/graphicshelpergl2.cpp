@@ -150,6 +150,32 @@ void GraphicsHelperGL2::drawArraysIndirect(GLenum , void *)
     qWarning() << "Indirect Drawing is not supported with OpenGL 2";
 }
 
+void GraphicsHelperGL2::multiDrawArraysIndirect(GLenum, const void *, GLsizei, GLsizei)
+{
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL 2";
+}
+
+void GraphicsHelperGL2::bufferStorage(GLenum, GLsizeiptr, const void *, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 2";
+}
+
+void *GraphicsHelperGL2::mapBufferRange(GLenum, GLintptr, GLsizeiptr, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 2";
+    return nullptr;
+}
+
+void GraphicsHelperGL2::copyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 2";
+}
+
+void GraphicsHelperGL2::multiDrawElementsIndirect(GLenum, GLenum, const void *, GLsizei, GLsizei)
+{
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL 2";
+}
+
 void GraphicsHelperGL2::setVerticesPerPatch(GLint verticesPerPatch)
 {
     Q_UNUSED(verticesPerPatch);
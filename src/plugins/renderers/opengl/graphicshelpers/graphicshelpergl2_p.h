@@ -117,6 +117,11 @@ public:
     void pointSize(bool programmable, GLfloat value) override;
     GLint maxClipPlaneCount() override;
     void memoryBarrier(QMemoryBarrier::Operations barriers) override;
+    void multiDrawArraysIndirect(GLenum mode, const void *indirect, GLsizei drawCount, GLsizei stride) override;
+    void multiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawCount, GLsizei stride) override;
+    void bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags) override;
+    void *mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) override;
+    void copyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) override;
     QVector<ShaderUniformBlock> programUniformBlocks(GLuint programId) override;
     QVector<ShaderAttribute> programAttributesAndLocations(GLuint programId) override;
     QVector<ShaderUniform> programUniformsAndLocations(GLuint programId) override;
@@ -170,6 +170,32 @@ void GraphicsHelperGL3_2::drawArraysIndirect(GLenum , void *)
     qWarning() << "Indirect Drawing is not supported with OpenGL 3.2";
 }
 
+void GraphicsHelperGL3_2::multiDrawArraysIndirect(GLenum, const void *, GLsizei, GLsizei)
+{
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL 3.2";
+}
+
+void GraphicsHelperGL3_2::bufferStorage(GLenum, GLsizeiptr, const void *, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 3.2";
+}
+
+void *GraphicsHelperGL3_2::mapBufferRange(GLenum, GLintptr, GLsizeiptr, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 3.2";
+    return nullptr;
+}
+
+void GraphicsHelperGL3_2::copyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 3.2";
+}
+
+void GraphicsHelperGL3_2::multiDrawElementsIndirect(GLenum, GLenum, const void *, GLsizei, GLsizei)
+{
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL 3.2";
+}
+
 void GraphicsHelperGL3_2::setVerticesPerPatch(GLint verticesPerPatch)
 {
 #if defined(QT_OPENGL_4)
@@ -169,6 +169,32 @@ void GraphicsHelperGL3_3::drawArraysIndirect(GLenum , void *)
     qWarning() << "Indirect Drawing is not supported with OpenGL 3";
 }
 
+void GraphicsHelperGL3_3::multiDrawArraysIndirect(GLenum, const void *, GLsizei, GLsizei)
+{
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL 3";
+}
+
+void GraphicsHelperGL3_3::bufferStorage(GLenum, GLsizeiptr, const void *, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 3";
+}
+
+void *GraphicsHelperGL3_3::mapBufferRange(GLenum, GLintptr, GLsizeiptr, GLbitfield)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 3";
+    return nullptr;
+}
+
+void GraphicsHelperGL3_3::copyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr)
+{
+    qWarning() << "Buffer Storage is not supported with OpenGL 3";
+}
+
+void GraphicsHelperGL3_3::multiDrawElementsIndirect(GLenum, GLenum, const void *, GLsizei, GLsizei)
+{
+    qWarning() << "Multi Draw Indirect is not supported with OpenGL 3";
+}
+
 void GraphicsHelperGL3_3::setVerticesPerPatch(GLint verticesPerPatch)
 {
 #if defined(QT_OPENGL_4)
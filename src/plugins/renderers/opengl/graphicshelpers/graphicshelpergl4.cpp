@@ -167,17 +167,27 @@ GLbitfield memoryBarrierGLBitfield(QMemoryBarrier::Operations barriers)
 
 GraphicsHelperGL4::GraphicsHelperGL4()
     : m_funcs(nullptr)
+    , m_bufferStorageFuncs()
+{
+}
+
+GraphicsHelperGL4::~GraphicsHelperGL4()
 {
 }
 
 void GraphicsHelperGL4::initializeHelper(QOpenGLContext *context,
                                          QAbstractOpenGLFunctions *functions)
 {
-    Q_UNUSED(context);
     m_funcs = static_cast<QOpenGLFunctions_4_3_Core*>(functions);
     const bool ok = m_funcs->initializeOpenGLFunctions();
     Q_ASSERT(ok);
     Q_UNUSED(ok);
+
+    // Core since OpenGL 4.4
+    if (context->hasExtension(QByteArrayLiteral("GL_ARB_buffer_storage"))) {
+        m_bufferStorageFuncs.reset(new QOpenGLExtension_ARB_buffer_storage);
+        m_bufferStorageFuncs->initializeOpenGLFunctions();
+    }
 }
 
 void GraphicsHelperGL4::drawElementsInstancedBaseVertexBaseInstance(GLenum primitiveType,
@@ -255,6 +265,35 @@ void GraphicsHelperGL4::drawArraysIndirect(GLenum mode, void *indirect)
     m_funcs->glDrawArraysIndirect(mode, indirect);
 }
 
+void GraphicsHelperGL4::multiDrawArraysIndirect(GLenum mode, const void *indirect, GLsizei drawCount, GLsizei stride)
+{
+    m_funcs->glMultiDrawArraysIndirect(mode, indirect, drawCount, stride);
+}
+
+void GraphicsHelperGL4::multiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawCount, GLsizei stride)
+{
+    m_funcs->glMultiDrawElementsIndirect(mode, type, indirect, drawCount, stride);
+}
+
+void GraphicsHelperGL4::bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags)
+{
+    if (!m_bufferStorageFuncs) {
+        qWarning() << "Buffer Storage is not supported with OpenGL 4.3 without GL_ARB_buffer_storage";
+        return;
+    }
+    m_bufferStorageFuncs->glBufferStorage(target, size, data, flags);
+}
+
+void *GraphicsHelperGL4::mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    return m_funcs->glMapBufferRange(target, offset, length, access);
+}
+
+void GraphicsHelperGL4::copyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size)
+{
+    m_funcs->glCopyBufferSubData(readTarget, writeTarget, readOffset, writeOffset, size);
+}
+
 void GraphicsHelperGL4::setVerticesPerPatch(GLint verticesPerPatch)
 {
     m_funcs->glPatchParameteri(GL_PATCH_VERTICES, verticesPerPatch);
@@ -875,7 +914,10 @@ bool GraphicsHelperGL4::supportsFeature(GraphicsHelperInterface::Feature feature
     case MapBuffer:
     case Fences:
     case ShaderImage:
+    case MultiDrawIndirect:
         return true;
+    case BufferStorage:
+        return !m_bufferStorageFuncs.isNull();
     default:
         return false;
     }
@@ -59,6 +59,7 @@
 QT_BEGIN_NAMESPACE
 
 class QOpenGLFunctions_4_3_Core;
+class QOpenGLExtension_ARB_buffer_storage;
 
 namespace Qt3DRender {
 namespace Render {
@@ -68,6 +69,7 @@ class Q_AUTOTEST_EXPORT GraphicsHelperGL4 : public GraphicsHelperInterface
 {
 public:
     GraphicsHelperGL4();
+    ~GraphicsHelperGL4();
 
     // QGraphicHelperInterface interface
     void alphaTest(GLenum mode1, GLenum mode2) override;
@@ -117,6 +119,11 @@ public:
     void pointSize(bool programmable, GLfloat value) override;
     GLint maxClipPlaneCount() override;
     void memoryBarrier(QMemoryBarrier::Operations barriers) override;
+    void multiDrawArraysIndirect(GLenum mode, const void *indirect, GLsizei drawCount, GLsizei stride) override;
+    void multiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawCount, GLsizei stride) override;
+    void bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags) override;
+    void *mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) override;
+    void copyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) override;
     QVector<ShaderUniformBlock> programUniformBlocks(GLuint programId) override;
     QVector<ShaderAttribute> programAttributesAndLocations(GLuint programId) override;
     QVector<ShaderUniform> programUniformsAndLocations(GLuint programId) override;
@@ -171,6 +178,7 @@ public:
 
 private:
     QOpenGLFunctions_4_3_Core *m_funcs;
+    QScopedPointer<QOpenGLExtension_ARB_buffer_storage> m_bufferStorageFuncs;
 };
 
 } // namespace OpenGL
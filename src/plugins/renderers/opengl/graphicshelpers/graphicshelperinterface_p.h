@@ -87,7 +87,9 @@ public:
         IndirectDrawing,
         MapBuffer,
         Fences,
-        ShaderImage
+        ShaderImage,
+        MultiDrawIndirect,
+        BufferStorage
     };
 
     enum FBOBindMode {
@@ -143,6 +145,11 @@ public:
     virtual void    initializeHelper(QOpenGLContext *context, QAbstractOpenGLFunctions *functions) = 0;
     virtual GLint   maxClipPlaneCount() = 0;
     virtual void    memoryBarrier(QMemoryBarrier::Operations barriers) = 0;
+    virtual void    multiDrawArraysIndirect(GLenum mode, const void *indirect, GLsizei drawCount, GLsizei stride) = 0;
+    virtual void    multiDrawElementsIndirect(GLenum mode, GLenum type, const void *indirect, GLsizei drawCount, GLsizei stride) = 0;
+    virtual void    bufferStorage(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags) = 0;
+    virtual void   *mapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access) = 0;
+    virtual void    copyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) = 0;
     virtual void    pointSize(bool programmable, GLfloat value) = 0;
     virtual QVector<ShaderAttribute> programAttributesAndLocations(GLuint programId) = 0;
     virtual QVector<ShaderUniform> programUniformsAndLocations(GLuint programId) = 0;
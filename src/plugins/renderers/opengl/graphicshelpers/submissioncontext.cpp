@@ -119,6 +119,8 @@ unsigned int nextFreeContextId()
 
 namespace {
 
+const uint uploadStreamingBufferSize = 8 * 1024 * 1024;
+
 GLBuffer::Type attributeTypeToGLBufferType(QAttribute::AttributeType type)
 {
     switch (type) {
@@ -369,6 +371,7 @@ SubmissionContext::SubmissionContext()
     , m_id(nextFreeContextId())
     , m_surface(nullptr)
     , m_activeShader(nullptr)
+    , m_activeGLShader(nullptr)
     , m_renderTargetFormat(QAbstractTexture::NoFormat)
     , m_currClearStencilValue(0)
     , m_currClearDepthValue(1.f)
@@ -379,6 +382,7 @@ SubmissionContext::SubmissionContext()
     , m_stateSet(nullptr)
     , m_renderer(nullptr)
     , m_uboTempArray(QByteArray(1024, 0))
+    , m_uploadStreamingBufferFailed(false)
 {
     static_contexts[m_id] = this;
 }
@@ -465,6 +469,7 @@ bool SubmissionContext::beginDrawing(QSurface *surface)
 
     if (m_activeShader) {
         m_activeShader = nullptr;
+        m_activeGLShader = nullptr;
     }
 
     m_boundArrayBuffer = nullptr;
@@ -473,6 +478,9 @@ bool SubmissionContext::beginDrawing(QSurface *surface)
 
 void SubmissionContext::endDrawing(bool swapBuffers)
 {
+    // Staged uploads of the frame can be overwritten once the GPU is past this
+    if (m_uploadStreamingBuffer.isCreated())
+        m_uploadStreamingBuffer.fence(this);
     if (swapBuffers)
         m_gl->swapBuffers(m_surface);
     if (m_ownCurrent)
@@ -807,6 +815,7 @@ bool SubmissionContext::activateShader(GLShader *shader)
         m_material = nullptr;
 
         m_activeShader = shader->shaderProgram();
+        m_activeGLShader = shader;
         if (Q_LIKELY(m_activeShader != nullptr)) {
             m_activeShader->bind();
         } else {
@@ -1159,6 +1168,63 @@ void SubmissionContext::deleteSync(GLFence sync)
     m_glHelper->deleteSync(sync);
 }
 
+void SubmissionContext::multiDrawArraysIndirect(GLenum mode, const QVector<DrawArraysIndirectCommand> &draws)
+{
+    if (uploadDrawIndirectCommands(draws.constData(), draws.size() * sizeof(DrawArraysIndirectCommand)))
+        m_glHelper->multiDrawArraysIndirect(mode, nullptr, draws.size(), 0);
+}
+
+void SubmissionContext::multiDrawElementsIndirect(GLenum mode, GLenum type, const QVector<DrawElementsIndirectCommand> &draws)
+{
+    if (uploadDrawIndirectCommands(draws.constData(), draws.size() * sizeof(DrawElementsIndirectCommand)))
+        m_glHelper->multiDrawElementsIndirect(mode, type, nullptr, draws.size(), 0);
+}
+
+// Called with the context current
+void SubmissionContext::destroyDrawIndirectBuffer()
+{
+    if (m_drawIndirectBuffer.isCreated())
+        m_drawIndirectBuffer.destroy(this);
+}
+
+void SubmissionContext::setDrawData(int bindingIndex, const QVector<DrawData> &drawData)
+{
+    if (!m_drawDataBuffer.isCreated() && !m_drawDataBuffer.create(this))
+        return;
+    if (!bindGLBuffer(&m_drawDataBuffer, GLBuffer::ShaderStorageBuffer))
+        return;
+    // Orphaned like the draw indirect buffer, previous draws may still read it
+    m_drawDataBuffer.allocate(this, drawData.constData(), drawData.size() * sizeof(DrawData), true);
+    m_drawDataBuffer.bindBufferBase(this, bindingIndex, GLBuffer::ShaderStorageBuffer);
+}
+
+// Called with the context current
+void SubmissionContext::destroyDrawDataBuffer()
+{
+    if (m_drawDataBuffer.isCreated())
+        m_drawDataBuffer.destroy(this);
+}
+
+// Called with the context current
+void SubmissionContext::destroyUploadStreamingBuffer()
+{
+    m_uploadStreamingBuffer.destroy(this);
+    // Creating it may succeed with the next context
+    m_uploadStreamingBufferFailed = false;
+}
+
+bool SubmissionContext::uploadDrawIndirectCommands(const void *data, uint size)
+{
+    if (!m_drawIndirectBuffer.isCreated() && !m_drawIndirectBuffer.create(this))
+        return false;
+    if (!m_drawIndirectBuffer.bind(this, GLBuffer::DrawIndirectBuffer))
+        return false;
+    // Respecifying the whole storage lets the driver orphan the previous
+    // content instead of waiting for the draws still reading it
+    m_drawIndirectBuffer.allocate(this, data, size, true);
+    return true;
+}
+
 void SubmissionContext::setUpdatedTexture(const Qt3DCore::QNodeIdVector &updatedTextureIds)
 {
     m_updateTextureIds = updatedTextureIds;
@@ -1166,7 +1232,7 @@ void SubmissionContext::setUpdatedTexture(const Qt3DCore::QNodeIdVector &updated
 
 // It will be easier if the QGraphicContext applies the QUniformPack
 // than the other way around
-bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack)
+bool SubmissionContext::setParameters(const ShaderParameterPack &parameterPack)
 {
     static const int irradianceId = StringToInt::lookupId(QLatin1String("envLight.irradiance"));
     static const int specularId = StringToInt::lookupId(QLatin1String("envLight.specular"));
@@ -1176,8 +1242,15 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack)
     // Set the pinned texture of the previous material texture
     // to pinable so that we should easily find an available texture unit
     m_textureContext.deactivateTexturesWithScope(TextureSubmissionContext::TextureScopeMaterial);
-    // Update the uniforms with the correct texture unit id's
-    PackUniformHash &uniformValues = parameterPack.uniforms();
+    // The pack may share its values with other commands, the uniforms
+    // holding texture and image units are filled in a separate hash
+    const PackUniformHash &uniformValues = parameterPack.uniforms();
+    m_resourceUnitUniforms.clear();
+    const auto resourceUnitUniform = [&] (int nameId) {
+        return m_resourceUnitUniforms.contains(nameId)
+                ? m_resourceUnitUniforms.value(nameId)
+                : uniformValues.value(nameId);
+    };
 
     // Fill Texture Uniform Value with proper texture units
     // so that they can be applied as regular uniforms in a second step
@@ -1187,10 +1260,11 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack)
         if (uniformValues.contains(namedTex.glslNameId)) {
             GLTexture *t = m_renderer->glResourceManagers()->glTextureManager()->lookupResource(namedTex.nodeId);
             if (t != nullptr) {
-                UniformValue &texUniform = uniformValues.value(namedTex.glslNameId);
-                if (texUniform.valueType() == UniformValue::TextureValue) {
+                if (uniformValues.valueType(namedTex.glslNameId) == UniformValue::TextureValue) {
+                    UniformValue texUniform = resourceUnitUniform(namedTex.glslNameId);
                     const int texUnit = m_textureContext.activateTexture(TextureSubmissionContext::TextureScopeMaterial, m_gl, t);
                     texUniform.data<int>()[namedTex.uniformArrayIndex] = texUnit;
+                    m_resourceUnitUniforms.insert(namedTex.glslNameId, texUniform);
                     if (texUnit == -1) {
                         if (namedTex.glslNameId != irradianceId &&
                             namedTex.glslNameId != specularId) {
@@ -1217,10 +1291,11 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack)
                     qCWarning(Backend) << "Shader Image referencing invalid texture";
                     continue;
                 } else {
-                    UniformValue &imgUniform = uniformValues.value(namedTex.glslNameId);
-                    if (imgUniform.valueType() == UniformValue::ShaderImageValue) {
+                    if (uniformValues.valueType(namedTex.glslNameId) == UniformValue::ShaderImageValue) {
+                        UniformValue imgUniform = resourceUnitUniform(namedTex.glslNameId);
                         const int imgUnit = m_imageContext.activateImage(img, t);
                         imgUniform.data<int>()[namedTex.uniformArrayIndex] = imgUnit;
+                        m_resourceUnitUniforms.insert(namedTex.glslNameId, imgUniform);
                         if (imgUnit == -1) {
                             qCWarning(Backend) << "Unable to bind Image to Texture";
                             return false;
@@ -1269,13 +1344,12 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack)
     }
 
     // Update uniforms in the Default Uniform Block
-    const PackUniformHash values = parameterPack.uniforms();
     const QVector<ShaderUniform> activeUniforms = parameterPack.submissionUniforms();
 
     for (const ShaderUniform &uniform : activeUniforms) {
         // We can use [] as we are sure the the uniform wouldn't
         // be un activeUniforms if there wasn't a matching value
-        const UniformValue &v = values.value(uniform.m_nameId);
+        const UniformValue v = resourceUnitUniform(uniform.m_nameId);
 
         // skip invalid textures/images
         if ((v.valueType() == UniformValue::TextureValue ||
@@ -1283,12 +1357,28 @@ bool SubmissionContext::setParameters(ShaderParameterPack &parameterPack)
             *v.constData<int>() == -1)
             continue;
 
+        // The program keeps its uniform values across draws and frames,
+        // only upload the ones that changed since they were last set
+        if (!needsUniformUpload(m_activeGLShader, uniform.m_nameId, v, m_uniformUploadStatistics))
+            continue;
+
         applyUniform(uniform, v);
     }
     // if not all data is valid, the next frame will be rendered immediately
     return true;
 }
 
+bool SubmissionContext::needsUniformUpload(GLShader *shader, int nameId, const UniformValue &value,
+                                           UniformUploadStatistics &statistics)
+{
+    if (shader != nullptr && !shader->updateUploadedUniformValue(nameId, value)) {
+        ++statistics.skipped;
+        return false;
+    }
+    ++statistics.uploaded;
+    return true;
+}
+
 void SubmissionContext::enableAttribute(const VAOVertexAttribute &attr)
 {
     // Bind buffer within the current VAO
@@ -1482,14 +1572,15 @@ void SubmissionContext::uploadDataToGLBuffer(Buffer *buffer, GLBuffer *b, bool r
                 update->data.replace(it->offset - update->offset, it->data.size(), it->data);
                 it->data.clear();
             }
-            // TO DO: based on the number of updates .., it might make sense to
-            // sometime use glMapBuffer rather than glBufferSubData
-            b->update(this, update->data.constData(), update->data.size(), update->offset);
+            if (!streamDataToGLBuffer(update->data.constData(), update->data.size(), update->offset))
+                b->update(this, update->data.constData(), update->data.size(), update->offset);
         } else {
             // We have an update that was done by calling QBuffer::setData
             // which is used to resize or entirely clear the buffer
             // Note: we use the buffer data directly in that case
             const int bufferSize = buffer->data().size();
+            if (uint(bufferSize) == b->size() && streamDataToGLBuffer(buffer->data().constData(), bufferSize, 0))
+                continue;
             b->allocate(this, bufferSize, false); // orphan the buffer
             b->allocate(this, buffer->data().constData(), bufferSize, false);
         }
@@ -1502,6 +1593,28 @@ void SubmissionContext::uploadDataToGLBuffer(Buffer *buffer, GLBuffer *b, bool r
     qCDebug(Io) << "uploaded buffer size=" << buffer->data().size();
 }
 
+// Copies data at offset into the buffer bound as an ArrayBuffer through the
+// streaming buffer. Returns false if the caller should upload data itself
+bool SubmissionContext::streamDataToGLBuffer(const void *data, uint size, int offset)
+{
+    if (size == 0 || m_uploadStreamingBufferFailed)
+        return false;
+
+    if (!m_uploadStreamingBuffer.isCreated()
+            && !m_uploadStreamingBuffer.create(this, uploadStreamingBufferSize)) {
+        m_uploadStreamingBufferFailed = true;
+        return false;
+    }
+
+    const int streamOffset = m_uploadStreamingBuffer.write(this, data, size);
+    if (streamOffset < 0)
+        return false;
+
+    m_uploadStreamingBuffer.buffer()->bind(this, GLBuffer::CopyReadBuffer);
+    copyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, streamOffset, offset, size);
+    return true;
+}
+
 QByteArray SubmissionContext::downloadDataFromGLBuffer(Buffer *buffer, GLBuffer *b)
 {
     if (!bindGLBuffer(b, GLBuffer::ArrayBuffer)) // We're downloading, the type doesn't matter here
@@ -54,6 +54,7 @@
 
 
 #include <glbuffer_p.h>
+#include <glstreamingbuffer_p.h>
 #include <glfence_p.h>
 #include <graphicscontext_p.h>
 #include <texturesubmissioncontext_p.h>
@@ -137,7 +138,20 @@ public:
     GLBuffer *glBufferForRenderBuffer(Buffer *buf);
 
     // Parameters
-    bool setParameters(ShaderParameterPack &parameterPack);
+    bool setParameters(const ShaderParameterPack &parameterPack);
+
+    // Default block uniforms counted since the last reset
+    struct UniformUploadStatistics
+    {
+        int uploaded = 0;
+        int skipped = 0;
+    };
+    UniformUploadStatistics uniformUploadStatistics() const { return m_uniformUploadStatistics; }
+    void resetUniformUploadStatistics() { m_uniformUploadStatistics = UniformUploadStatistics(); }
+    // Returns whether value has to be uploaded for the uniform nameId of
+    // shader and counts it as uploaded or skipped in statistics
+    static bool needsUniformUpload(GLShader *shader, int nameId, const UniformValue &value,
+                                   UniformUploadStatistics &statistics);
 
     // RenderState
     void setCurrentStateSet(RenderStateSet* ss);
@@ -163,6 +177,34 @@ public:
     // Textures
     void setUpdatedTexture(const Qt3DCore::QNodeIdVector &updatedTextureIds);
 
+    // Multi Draw Indirect, layouts as expected by GL
+    struct DrawArraysIndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint first;
+        GLuint baseInstance;
+    };
+
+    struct DrawElementsIndirectCommand
+    {
+        GLuint count;
+        GLuint instanceCount;
+        GLuint firstIndex;
+        GLint baseVertex;
+        GLuint baseInstance;
+    };
+
+    void multiDrawArraysIndirect(GLenum mode, const QVector<DrawArraysIndirectCommand> &draws);
+    void multiDrawElementsIndirect(GLenum mode, GLenum type, const QVector<DrawElementsIndirectCommand> &draws);
+    void destroyDrawIndirectBuffer();
+    void destroyUploadStreamingBuffer();
+
+    // Uploads the DrawData of the next draws and binds them to the
+    // shader storage binding point bindingIndex
+    void setDrawData(int bindingIndex, const QVector<DrawData> &drawData);
+    void destroyDrawDataBuffer();
+
 private:
     struct RenderTargetInfo {
         GLuint fboId;
@@ -188,6 +230,8 @@ private:
     void uploadDataToGLBuffer(Buffer *buffer, GLBuffer *b, bool releaseBuffer = false);
     QByteArray downloadDataFromGLBuffer(Buffer *buffer, GLBuffer *b);
     bool bindGLBuffer(GLBuffer *buffer, GLBuffer::Type type);
+    bool uploadDrawIndirectCommands(const void *data, uint size);
+    bool streamDataToGLBuffer(const void *data, uint size, int offset);
 
     bool m_ownCurrent;
     const unsigned int m_id;
@@ -195,6 +239,10 @@ private:
     QSize m_surfaceSize;
 
     QOpenGLShaderProgram *m_activeShader;
+    GLShader *m_activeGLShader;
+    UniformUploadStatistics m_uniformUploadStatistics;
+    // Texture and image uniforms of the pack being set, with their units
+    PackUniformHash m_resourceUnitUniforms;
 
     QHash<Qt3DCore::QNodeId, HGLBuffer> m_renderBufferHash;
 
@@ -220,6 +268,15 @@ private:
     TextureSubmissionContext m_textureContext;
     ImageSubmissionContext m_imageContext;
 
+    // Holds the draws of the last multi draw call
+    GLBuffer m_drawIndirectBuffer;
+    // Holds the DrawData of the last draw calls
+    GLBuffer m_drawDataBuffer;
+
+    // Staging area for buffer uploads where persistent mapping is available
+    GLStreamingBuffer m_uploadStreamingBuffer;
+    bool m_uploadStreamingBufferFailed;
+
     // Attributes
     friend class OpenGLVertexArrayObject;
 
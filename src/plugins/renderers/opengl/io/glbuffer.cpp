@@ -82,7 +82,8 @@ GLenum glBufferTypes[] = {
     GL_SHADER_STORAGE_BUFFER,
     GL_PIXEL_PACK_BUFFER,
     GL_PIXEL_UNPACK_BUFFER,
-    GL_DRAW_INDIRECT_BUFFER
+    GL_DRAW_INDIRECT_BUFFER,
+    GL_COPY_READ_BUFFER
 };
 
 } // anonymous
@@ -92,6 +93,7 @@ GLBuffer::GLBuffer()
     , m_isCreated(false)
     , m_bound(false)
     , m_lastTarget(GL_ARRAY_BUFFER)
+    , m_size(0)
 {
 }
 
@@ -123,6 +125,7 @@ void GLBuffer::destroy(GraphicsContext *ctx)
 {
     ctx->openGLContext()->functions()->glDeleteBuffers(1, &m_bufferId);
     m_isCreated = false;
+    m_size = 0;
 }
 
 void GLBuffer::allocate(GraphicsContext *ctx, uint size, bool dynamic)
@@ -130,11 +133,13 @@ void GLBuffer::allocate(GraphicsContext *ctx, uint size, bool dynamic)
     // Either GL_STATIC_DRAW OR GL_DYNAMIC_DRAW depending on  the use case
     // TO DO: find a way to know how a buffer/QShaderData will be used to use the right usage
     ctx->openGLContext()->functions()->glBufferData(m_lastTarget, size, NULL, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    m_size = size;
 }
 
 void GLBuffer::allocate(GraphicsContext *ctx, const void *data, uint size, bool dynamic)
 {
     ctx->openGLContext()->functions()->glBufferData(m_lastTarget, size, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+    m_size = size;
 }
 
 void GLBuffer::update(GraphicsContext *ctx, const void *data, uint size, int offset)
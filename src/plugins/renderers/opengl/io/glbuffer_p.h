@@ -55,6 +55,12 @@
 #include <Qt3DCore/qnodeid.h>
 #include <qbytearray.h>
 
+// Used through GLBuffer::CopyReadBuffer and by the streaming buffer,
+// missing from the OpenGL ES 2 headers
+#if !defined(GL_COPY_READ_BUFFER)
+#define GL_COPY_READ_BUFFER 0x8F36
+#endif
+
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
@@ -78,7 +84,8 @@ public:
         ShaderStorageBuffer,
         PixelPackBuffer,
         PixelUnpackBuffer,
-        DrawIndirectBuffer
+        DrawIndirectBuffer,
+        CopyReadBuffer
     };
 
     bool bind(GraphicsContext *ctx, Type t);
@@ -95,12 +102,15 @@ public:
     inline GLuint bufferId() const { return m_bufferId; }
     inline bool isCreated() const { return m_isCreated; }
     inline bool isBound() const { return m_bound; }
+    // Size of the data store last allocated
+    inline uint size() const { return m_size; }
 
 private:
     GLuint m_bufferId;
     bool m_isCreated;
     bool m_bound;
     GLenum m_lastTarget;
+    uint m_size;
 };
 
 } // namespace OpenGL
@@ -0,0 +1,156 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "glstreamingbuffer_p.h"
+#include <submissioncontext_p.h>
+
+#include <cstring>
+
+#if !defined(GL_MAP_WRITE_BIT)
+#define GL_MAP_WRITE_BIT 0x0002
+#endif
+#if !defined(GL_MAP_PERSISTENT_BIT)
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#if !defined(GL_MAP_COHERENT_BIT)
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace OpenGL {
+
+namespace {
+
+// Keeps the copies from the ring aligned on what drivers expect for vectors
+const uint writeAlignment = 16;
+
+} // anonymous
+
+GLStreamingBuffer::GLStreamingBuffer()
+    : m_mappedData(nullptr)
+{
+}
+
+bool GLStreamingBuffer::create(SubmissionContext *ctx, uint size)
+{
+    if (!ctx->supportsBufferStorage() || !m_buffer.create(ctx))
+        return false;
+
+    // Coherent mapping, writes are visible to the GL commands issued after them
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    m_buffer.bind(ctx, GLBuffer::CopyReadBuffer);
+    ctx->bufferStorage(GL_COPY_READ_BUFFER, size, nullptr, flags);
+    m_mappedData = static_cast<char *>(ctx->mapBufferRange(GL_COPY_READ_BUFFER, 0, size, flags));
+    m_buffer.release(ctx);
+
+    if (m_mappedData == nullptr) {
+        m_buffer.destroy(ctx);
+        return false;
+    }
+
+    m_ring.reset(size);
+    return true;
+}
+
+// Called with the context current
+void GLStreamingBuffer::destroy(SubmissionContext *ctx)
+{
+    for (const GLFence fence : qAsConst(m_fences))
+        ctx->deleteSync(fence);
+    m_fences.clear();
+
+    if (m_mappedData != nullptr) {
+        m_buffer.bind(ctx, GLBuffer::CopyReadBuffer);
+        ctx->unmapBuffer(GL_COPY_READ_BUFFER);
+        m_buffer.release(ctx);
+        m_buffer.destroy(ctx);
+        m_mappedData = nullptr;
+    }
+    m_ring.reset(0);
+}
+
+int GLStreamingBuffer::write(SubmissionContext *ctx, const void *data, uint size)
+{
+    const uint alignedSize = (size + writeAlignment - 1) & ~(writeAlignment - 1);
+    // Leave room for the other uploads of the frame, larger ones gain
+    // little from being staged anyway
+    if (m_mappedData == nullptr || alignedSize > m_ring.size() / 4)
+        return -1;
+
+    releaseSignaledRanges(ctx);
+    const int offset = m_ring.allocate(alignedSize);
+    if (offset < 0)
+        return -1;
+
+    memcpy(m_mappedData + offset, data, size);
+    return offset;
+}
+
+void GLStreamingBuffer::fence(SubmissionContext *ctx)
+{
+    if (m_ring.closeRange())
+        m_fences.push_back(ctx->fenceSync());
+}
+
+void GLStreamingBuffer::releaseSignaledRanges(SubmissionContext *ctx)
+{
+    // Fences are signaled in the order they were inserted
+    int signaledCount = 0;
+    for (const GLFence fence : qAsConst(m_fences)) {
+        if (!ctx->wasSyncSignaled(fence))
+            break;
+        ctx->deleteSync(fence);
+        ++signaledCount;
+    }
+    m_fences.remove(0, signaledCount);
+    m_ring.releaseRanges(signaledCount);
+}
+
+} // namespace OpenGL
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,109 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_OPENGL_GLSTREAMINGBUFFER_P_H
+#define QT3DRENDER_RENDER_OPENGL_GLSTREAMINGBUFFER_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <glbuffer_p.h>
+#include <glfence_p.h>
+#include <ringbufferallocator_p.h>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace OpenGL {
+
+class SubmissionContext;
+
+// Persistently mapped ring buffer used as a staging area for buffer uploads.
+// Data is copied into the ring on the CPU and from there into the destination
+// buffers on the GPU. Ranges are fenced per frame and only reused once the
+// GPU has signaled it is done reading them.
+class GLStreamingBuffer
+{
+public:
+    GLStreamingBuffer();
+
+    bool create(SubmissionContext *ctx, uint size);
+    void destroy(SubmissionContext *ctx);
+
+    // Returns the offset data was copied at in the ring, -1 if there isn't
+    // enough space not in use by the GPU anymore
+    int write(SubmissionContext *ctx, const void *data, uint size);
+    // Fences the data written since the last call
+    void fence(SubmissionContext *ctx);
+
+    inline bool isCreated() const { return m_mappedData != nullptr; }
+    inline uint size() const { return m_ring.size(); }
+    inline GLBuffer *buffer() { return &m_buffer; }
+
+private:
+    void releaseSignaledRanges(SubmissionContext *ctx);
+
+    GLBuffer m_buffer;
+    char *m_mappedData;
+    // Each closed range of the ring has its fence, at the same index
+    RingBufferAllocator m_ring;
+    QVector<GLFence> m_fences;
+};
+
+} // namespace OpenGL
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_OPENGL_GLSTREAMINGBUFFER_P_H
@@ -1,8 +1,12 @@
 INCLUDEPATH += $$PWD
 
 SOURCES += \
-    $$PWD/glbuffer.cpp
+    $$PWD/glbuffer.cpp \
+    $$PWD/glstreamingbuffer.cpp \
+    $$PWD/ringbufferallocator.cpp
 
 HEADERS += \
-    $$PWD/glbuffer_p.h
+    $$PWD/glbuffer_p.h \
+    $$PWD/glstreamingbuffer_p.h \
+    $$PWD/ringbufferallocator_p.h
 
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "ringbufferallocator_p.h"
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace OpenGL {
+
+RingBufferAllocator::RingBufferAllocator()
+    : m_size(0)
+    , m_head(0)
+    , m_usedSize(0)
+    , m_unclosedSize(0)
+{
+}
+
+void RingBufferAllocator::reset(uint size)
+{
+    m_size = size;
+    m_head = 0;
+    m_usedSize = 0;
+    m_unclosedSize = 0;
+    m_closedRangeSizes.clear();
+}
+
+int RingBufferAllocator::allocate(uint size)
+{
+    if (m_usedSize == 0)
+        m_head = 0;
+    if (size == 0 || m_usedSize + size > m_size)
+        return -1;
+
+    // The free space is [m_head, m_size) then [0, tail) if the used one
+    // doesn't wrap around, [m_head, tail) otherwise
+    const uint tail = (m_head + m_size - m_usedSize) % m_size;
+    uint offset = m_head;
+    uint consumedSize = size;
+    if (m_head >= tail) {
+        if (m_size - m_head < size) {
+            if (tail < size)
+                return -1;
+            // Skip the end of the ring
+            consumedSize += m_size - m_head;
+            offset = 0;
+        }
+    } else if (tail - m_head < size) {
+        return -1;
+    }
+
+    m_head = offset + size;
+    m_usedSize += consumedSize;
+    m_unclosedSize += consumedSize;
+    return int(offset);
+}
+
+bool RingBufferAllocator::closeRange()
+{
+    if (m_unclosedSize == 0)
+        return false;
+    m_closedRangeSizes.push_back(m_unclosedSize);
+    m_unclosedSize = 0;
+    return true;
+}
+
+void RingBufferAllocator::releaseRanges(int count)
+{
+    Q_ASSERT(count <= m_closedRangeSizes.size());
+    for (int i = 0; i < count; ++i)
+        m_usedSize -= m_closedRangeSizes.at(i);
+    m_closedRangeSizes.remove(0, count);
+}
+
+} // namespace OpenGL
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,107 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QT3DRENDER_RENDER_OPENGL_RINGBUFFERALLOCATOR_P_H
+#define QT3DRENDER_RENDER_OPENGL_RINGBUFFERALLOCATOR_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace OpenGL {
+
+// Bookkeeping of the space of a ring buffer. Allocations are grouped into
+// ranges, which are released as a whole in the order they were closed.
+class Q_AUTOTEST_EXPORT RingBufferAllocator
+{
+public:
+    RingBufferAllocator();
+
+    void reset(uint size);
+
+    // Returns the offset of size contiguous bytes, -1 if there isn't
+    // enough free space
+    int allocate(uint size);
+    // Groups the bytes allocated since the last call into a range,
+    // returns false if there were none
+    bool closeRange();
+    // Frees the count oldest closed ranges
+    void releaseRanges(int count);
+
+    inline uint size() const { return m_size; }
+    inline uint usedSize() const { return m_usedSize; }
+    inline int closedRangeCount() const { return m_closedRangeSizes.size(); }
+
+private:
+    uint m_size;
+    // Next allocation offset
+    uint m_head;
+    // Bytes between the oldest range still in use and m_head, including the
+    // end of the ring skipped when wrapping around
+    uint m_usedSize;
+    uint m_unclosedSize;
+    QVector<uint> m_closedRangeSizes;
+};
+
+} // namespace OpenGL
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_OPENGL_RINGBUFFERALLOCATOR_P_H
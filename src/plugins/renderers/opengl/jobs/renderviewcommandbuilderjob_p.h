@@ -75,6 +75,9 @@ public:
         m_count = count;
         m_entities = entities;
     }
+    inline const QVector<Entity *> &entities() const Q_DECL_NOTHROW { return m_entities; }
+    inline int offset() const Q_DECL_NOTHROW { return m_offset; }
+    inline int count() const Q_DECL_NOTHROW { return m_count; }
     inline EntityRenderCommandData &commandData() { return m_commandData; }
 
     void run() final;
@@ -82,8 +82,6 @@ public:
     }
     EntityRenderCommandDataPtr renderables() const { return m_renderables; }
 
-    QVector<RenderCommand> &commands() Q_DECL_NOTHROW { return m_commands; }
-
     void run() final;
 
 private:
@@ -92,7 +90,6 @@ private:
     RenderView *m_renderView;
     Renderer *m_renderer;
     EntityRenderCommandDataPtr m_renderables;
-    QVector<RenderCommand> m_commands;
 
     Q_DECLARE_PRIVATE(RenderViewCommandUpdaterJob)
 };
@@ -457,15 +457,24 @@ void addStatesToRenderStateSet(RenderStateSet *stateSet,
 
 namespace {
 
-const QString blockArray = QStringLiteral("[%1]");
 const int qNodeIdTypeId = qMetaTypeId<QNodeId>();
 
+// Only needed if a list grew since the ids were cached
+int elementNameId(const ShaderData::PropertyNameIds &nameIds, int i)
+{
+    if (Q_LIKELY(i < nameIds.elementNameIds.size()))
+        return nameIds.elementNameIds.at(i);
+    return StringToInt::lookupId(StringToInt::lookupString(nameIds.nameId)
+                                 + QLatin1Char('[') + QString::number(i) + QLatin1Char(']'));
+}
+
 }
 
 UniformBlockValueBuilder::UniformBlockValueBuilder()
     : updatedPropertiesOnly(false)
     , shaderDataManager(nullptr)
     , textureManager(nullptr)
+    , plan(nullptr)
 {
 }
 
@@ -473,85 +482,114 @@ UniformBlockValueBuilder::~UniformBlockValueBuilder()
 {
 }
 
-void UniformBlockValueBuilder::buildActiveUniformNameValueMapHelper(ShaderData *currentShaderData, const QString &blockName, const QString &qmlPropertyName, const QVariant &value)
+void UniformBlockValueBuilder::buildActiveUniformNameValueMapHelper(ShaderData *currentShaderData,
+                                                                    const ShaderData::PropertyNameIds &nameIds,
+                                                                    const QString &qmlPropertyName,
+                                                                    const ShaderData::PropertyValue &propertyValue)
 {
+    const QVariant &value = propertyValue.value;
+
     // In the end, values are either scalar or a scalar array
     // Composed elements (structs, structs array) are simplified into simple scalars
     if (value.userType() == QMetaType::QVariantList) { // Array
-        QVariantList list = value.value<QVariantList>();
+        const QVariantList list = value.value<QVariantList>();
         if (list.at(0).userType() == qNodeIdTypeId) { // Array of struct qmlPropertyName[i].structMember
             for (int i = 0; i < list.size(); ++i) {
-                const QVariant variantElement = list.at(i);
-                if (list.at(i).userType() == qNodeIdTypeId) {
+                const QVariant &variantElement = list.at(i);
+                if (variantElement.userType() == qNodeIdTypeId) {
                     const auto nodeId = variantElement.value<QNodeId>();
                     ShaderData *subShaderData = shaderDataManager->lookupResource(nodeId);
-                    if (subShaderData) {
-                        buildActiveUniformNameValueMapStructHelper(subShaderData,
-                                                                   blockName + QLatin1Char('.') + qmlPropertyName + blockArray.arg(i),
-                                                                   QLatin1String(""));
-                    }
+                    if (subShaderData)
+                        buildActiveUniformNameValueMapStructHelper(subShaderData, elementNameId(nameIds, i));
+                    else if (plan && !nodeId.isNull())
+                        plan->unresolvedDependencies.push_back(nodeId);
                     // Note: we only handle ShaderData as nested container nodes here
                 }
             }
         } else { // Array of scalar/vec  qmlPropertyName[0]
-            QString varName;
-            varName.reserve(blockName.length() + 1 + qmlPropertyName.length() + 3);
-            varName.append(blockName);
-            varName.append(QLatin1String("."));
-            varName.append(qmlPropertyName);
-            varName.append(QLatin1String("[0]"));
-            if (uniforms.contains(varName)) {
-                qCDebug(Shaders) << "UBO array member " << varName << " set for update";
-                activeUniformNamesToValue.insert(StringToInt::lookupId(varName), value);
+            const int varNameId = elementNameId(nameIds, 0);
+            if (uniforms.contains(varNameId)) {
+                qCDebug(Shaders) << "UBO array member " << StringToInt::lookupString(varNameId) << " set for update";
+                activeUniformNamesToValue.insert(varNameId, value);
             }
         }
     } else if (value.userType() == qNodeIdTypeId) { // Struct qmlPropertyName.structMember
         const auto nodeId = value.value<QNodeId>();
         ShaderData *rSubShaderData = shaderDataManager->lookupResource(nodeId);
         if (rSubShaderData) {
-            buildActiveUniformNameValueMapStructHelper(rSubShaderData,
-                                                       blockName,
-                                                       qmlPropertyName);
+            buildActiveUniformNameValueMapStructHelper(rSubShaderData, nameIds.nameId);
         } else if (textureManager->contains(nodeId)) {
-            const auto varId = StringToInt::lookupId(blockName + QLatin1Char('.') + qmlPropertyName);
-            activeUniformNamesToValue.insert(varId, value);
+            activeUniformNamesToValue.insert(nameIds.nameId, value);
+            if (plan)
+                plan->textureDependencies.push_back(nodeId);
+        } else if (plan && !nodeId.isNull()) {
+            plan->unresolvedDependencies.push_back(nodeId);
         }
     } else { // Scalar / Vec
-        QString varName;
-        varName.reserve(blockName.length() + 1 + qmlPropertyName.length());
-        varName.append(blockName);
-        varName.append(QLatin1String("."));
-        varName.append(qmlPropertyName);
-        if (uniforms.contains(varName)) {
-            qCDebug(Shaders) << "UBO scalar member " << varName << " set for update";
+        if (uniforms.contains(nameIds.nameId)) {
+            qCDebug(Shaders) << "UBO scalar member " << StringToInt::lookupString(nameIds.nameId) << " set for update";
 
             // If the property needs to be transformed, we transform it here as
             // the shaderdata cannot hold transformed properties for multiple
             // thread contexts at once
-            activeUniformNamesToValue.insert(StringToInt::lookupId(varName),
-                                             currentShaderData->getTransformedProperty(qmlPropertyName, viewMatrix));
+            if (!propertyValue.isTransformed) {
+                activeUniformNamesToValue.insert(nameIds.nameId, value);
+            } else if (plan) {
+                plan->transformedUniforms.push_back({ nameIds.nameId, currentShaderData,
+                                                      Vector3D(value.value<QVector3D>()),
+                                                      currentShaderData->propertyTransformType(qmlPropertyName) });
+            } else {
+                activeUniformNamesToValue.insert(nameIds.nameId,
+                                                 currentShaderData->getTransformedProperty(qmlPropertyName, viewMatrix));
+            }
         }
     }
 }
 
 void UniformBlockValueBuilder::buildActiveUniformNameValueMapStructHelper(ShaderData *rShaderData, const QString &blockName, const QString &qmlPropertyName)
 {
-    const QHash<QString, ShaderData::PropertyValue> &properties = rShaderData->properties();
-    auto it = properties.begin();
-    const auto end = properties.end();
-
-    while (it != end) {
-        QString fullBlockName;
-        fullBlockName.reserve(blockName.length() + 1 + qmlPropertyName.length());
-        fullBlockName.append(blockName);
-        if (!qmlPropertyName.isEmpty()) {
-            fullBlockName.append(QLatin1String("."));
-            fullBlockName.append(qmlPropertyName);
-        }
-        buildActiveUniformNameValueMapHelper(rShaderData, fullBlockName,
-                                             it.key(), it.value().value);
-        ++it;
+    QString fullBlockName;
+    fullBlockName.reserve(blockName.length() + 1 + qmlPropertyName.length());
+    fullBlockName.append(blockName);
+    if (!qmlPropertyName.isEmpty()) {
+        fullBlockName.append(QLatin1String("."));
+        fullBlockName.append(qmlPropertyName);
+    }
+    buildActiveUniformNameValueMapStructHelper(rShaderData, StringToInt::lookupId(fullBlockName));
+}
+
+void UniformBlockValueBuilder::buildActiveUniformNameValueMapStructHelper(ShaderData *rShaderData, int blockNameId)
+{
+    const QHash<QString, ShaderData::PropertyValue> properties = rShaderData->properties();
+    // Same order as properties
+    const QVector<ShaderData::PropertyNameIds> nameIds = rShaderData->propertyNameIds(blockNameId);
+    Q_ASSERT(nameIds.size() == properties.size());
+
+    if (plan)
+        plan->dependencies.push_back({ rShaderData->peerId(), rShaderData->revision() });
+
+    int i = 0;
+    for (auto it = properties.cbegin(), end = properties.cend(); it != end; ++it, ++i)
+        buildActiveUniformNameValueMapHelper(rShaderData, nameIds.at(i), it.key(), it.value());
+}
+
+bool ShaderDataUniformPlan::isUpToDate(ShaderDataManager *manager, TextureManager *textureManager) const
+{
+    for (const auto &dependency : dependencies) {
+        const ShaderData *shaderData = manager->lookupResource(dependency.first);
+        if (shaderData == nullptr || shaderData->revision() != dependency.second)
+            return false;
+    }
+    for (const Qt3DCore::QNodeId textureId : textureDependencies) {
+        if (!textureManager->contains(textureId))
+            return false;
+    }
+    // The backend node of a nested id may only have been created since
+    for (const Qt3DCore::QNodeId nodeId : unresolvedDependencies) {
+        if (manager->contains(nodeId) || textureManager->contains(nodeId))
+            return false;
     }
+    return true;
 }
 
 ParameterInfo::ParameterInfo(const int nameId, const HParameter &handle)
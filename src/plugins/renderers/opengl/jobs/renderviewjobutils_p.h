@@ -59,6 +59,7 @@
 #include <Qt3DRender/private/uniform_p.h>
 #include <Qt3DRender/private/handle_types_p.h>
 #include <Qt3DRender/private/aligned_malloc_p.h>
+#include <Qt3DRender/private/shaderdata_p.h>
 #include  <shadervariables_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -155,6 +156,31 @@ Q_AUTOTEST_EXPORT void addStatesToRenderStateSet(RenderStateSet *stateSet,
 
 typedef QHash<int, QVariant> UniformBlockValueBuilderHash;
 
+// The default block uniforms a ShaderData struct expands to for a given shader.
+// Compiled once, then reused until one of the ShaderData walked changes.
+struct Q_AUTOTEST_EXPORT ShaderDataUniformPlan
+{
+    struct TransformedUniform {
+        int nameId;
+        ShaderData *shaderData;
+        Vector3D value;
+        ShaderData::TransformType transformType;
+    };
+
+    bool isUpToDate(ShaderDataManager *manager, TextureManager *textureManager) const;
+
+    // Every ShaderData walked and its revision at compile time
+    QVector<QPair<Qt3DCore::QNodeId, uint>> dependencies;
+    // Nested textures, whose ids are only set while they exist
+    QVector<Qt3DCore::QNodeId> textureDependencies;
+    // Nested ids that were neither a ShaderData nor a texture
+    QVector<Qt3DCore::QNodeId> unresolvedDependencies;
+    // Values which don't depend on the view or world matrices
+    QVector<QPair<int, UniformValue>> uniforms;
+    // Evaluated again for each use
+    QVector<TransformedUniform> transformedUniforms;
+};
+
 struct Q_AUTOTEST_EXPORT UniformBlockValueBuilder
 {
     UniformBlockValueBuilder();
@@ -163,19 +189,25 @@ struct Q_AUTOTEST_EXPORT UniformBlockValueBuilder
     QT3D_ALIGNED_MALLOC_AND_FREE()
 
     void buildActiveUniformNameValueMapHelper(ShaderData *currentShaderData,
-                                              const QString &blockName,
+                                              const ShaderData::PropertyNameIds &nameIds,
                                               const QString &qmlPropertyName,
-                                              const QVariant &value);
+                                              const ShaderData::PropertyValue &value);
     void buildActiveUniformNameValueMapStructHelper(ShaderData *rShaderData,
                                                     const QString &blockName,
                                                     const QString &qmlPropertyName = QString());
+    void buildActiveUniformNameValueMapStructHelper(ShaderData *rShaderData,
+                                                    int blockNameId);
 
     bool updatedPropertiesOnly;
-    QHash<QString, ShaderUniform> uniforms;
+    // Keyed by uniform name id
+    QHash<int, ShaderUniform> uniforms;
     UniformBlockValueBuilderHash activeUniformNamesToValue;
     ShaderDataManager *shaderDataManager;
     TextureManager *textureManager;
     Matrix4x4 viewMatrix;
+    // When set, records dependencies and transformed properties into the
+    // plan instead of evaluating them with viewMatrix
+    ShaderDataUniformPlan *plan;
 };
 
 } // namespace OpenGL
@@ -178,16 +178,17 @@ QJsonObject parameterPackToJson(const Render::OpenGL::ShaderParameterPack &pack)
 
     const Render::OpenGL::PackUniformHash &uniforms = pack.uniforms();
     QJsonArray uniformsArray;
-    for (int i = 0, m = uniforms.keys.size(); i < m; ++i) {
+    uniforms.forEachNameId([&] (int nameId) {
         QJsonObject uniformObj;
-        uniformObj.insert(QLatin1String("name"), Render::StringToInt::lookupString(uniforms.keys.at(i)));
-        const Render::UniformValue::ValueType type = uniforms.values.at(i).valueType();
+        uniformObj.insert(QLatin1String("name"), Render::StringToInt::lookupString(nameId));
+        const Render::UniformValue::ValueType type = uniforms.valueType(nameId);
         uniformObj.insert(QLatin1String("type"),
                           type == Render::UniformValue::ScalarValue
                           ? QLatin1String("value")
                           : QLatin1String("texture"));
         uniformsArray.push_back(uniformObj);
-    }
+        return true;
+    });
     obj.insert(QLatin1String("uniforms"), uniformsArray);
 
     QJsonArray texturesArray;
@@ -276,14 +277,18 @@ void CommandExecuter::performAsynchronousCommandExecution(const QVector<Render::
                 viewObj.insert(QLatin1String("clearStencilValue"), v->clearStencilValue());
 
                 QJsonArray renderCommandsArray;
-                for (Render::OpenGL::RenderCommand &c : v->commands()) {
+                const QVector<Render::OpenGL::RenderCommand> &commands = v->commands();
+                const QVector<Render::OpenGL::RenderCommandBuildData> &commandsBuildData = v->commandsBuildData();
+                for (int i = 0, m = commands.size(); i < m; ++i) {
+                    const Render::OpenGL::RenderCommand &c = commands.at(i);
+                    const Render::OpenGL::RenderCommandBuildData &b = commandsBuildData.at(i);
                     QJsonObject commandObj;
                     Render::NodeManagers *nodeManagers = m_renderer->nodeManagers();
-                    commandObj.insert(QLatin1String("shader"), typeToJsonValue(QVariant::fromValue(c.m_shaderId)));
+                    commandObj.insert(QLatin1String("shader"), typeToJsonValue(QVariant::fromValue(b.m_shaderId)));
                     commandObj.insert(QLatin1String("vao"),  double(c.m_vao.handle()));
                     commandObj.insert(QLatin1String("instanceCount"), c.m_instanceCount);
-                    commandObj.insert(QLatin1String("geometry"),  backendNodeToJSon(c.m_geometry, nodeManagers->geometryManager()));
-                    commandObj.insert(QLatin1String("geometryRenderer"),  backendNodeToJSon(c.m_geometryRenderer, nodeManagers->geometryRendererManager()));
+                    commandObj.insert(QLatin1String("geometry"),  backendNodeToJSon(b.m_geometry, nodeManagers->geometryManager()));
+                    commandObj.insert(QLatin1String("geometryRenderer"),  backendNodeToJSon(b.m_geometryRenderer, nodeManagers->geometryRendererManager()));
                     commandObj.insert(QLatin1String("shaderParameterPack"), parameterPackToJson(c.m_parameterPack));
 
                     renderCommandsArray.push_back(commandObj);
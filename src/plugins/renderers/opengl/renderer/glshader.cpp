@@ -101,7 +101,7 @@ QVector<QByteArray> GLShader::shaderCode() const
     return m_shaderCode;
 }
 
-QHash<QString, ShaderUniform> GLShader::activeUniformsForUniformBlock(int blockIndex) const
+QHash<int, ShaderUniform> GLShader::activeUniformsForUniformBlock(int blockIndex) const
 {
     return m_uniformBlockIndexToShaderUniforms.value(blockIndex);
 }
@@ -167,19 +167,28 @@ void GLShader::prepareUniforms(ShaderParameterPack &pack)
 {
     const PackUniformHash &values = pack.uniforms();
 
-    auto it = values.keys.cbegin();
-    const auto end = values.keys.cend();
-
-    while (it != end) {
+    values.forEachNameId([&] (int nameId) {
         // Find if there's a uniform with the same name id
-        for (const ShaderUniform &uniform : qAsConst(m_uniforms)) {
-            if (uniform.m_nameId == *it) {
-                pack.setSubmissionUniform(uniform);
-                break;
-            }
-        }
-        ++it;
-    }
+        const int uniformIndex = m_uniformIndexForNameId.value(nameId, -1);
+        if (uniformIndex != -1)
+            pack.setSubmissionUniform(m_uniforms.at(uniformIndex));
+        return true;
+    });
+}
+
+bool GLShader::updateUploadedUniformValue(int nameId, const UniformValue &value)
+{
+    const int uniformIndex = m_uniformIndexForNameId.value(nameId, -1);
+    if (uniformIndex == -1)
+        return true;
+
+    if (m_uploadedUniformValuesSet.at(uniformIndex)
+            && m_uploadedUniformValues.at(uniformIndex) == value)
+        return false;
+
+    m_uploadedUniformValues[uniformIndex] = value;
+    m_uploadedUniformValuesSet[uniformIndex] = true;
+    return true;
 }
 
 void GLShader::setFragOutputs(const QHash<QString, int> &fragOutputs)
@@ -197,13 +206,48 @@ const QHash<QString, int> GLShader::fragOutputs() const
     return m_fragOutputs;
 }
 
+QSharedPointer<const ShaderDataUniformPlan> GLShader::shaderDataUniformPlan(Qt3DCore::QNodeId shaderDataId, int blockNameId) const
+{
+    QReadLocker lock(&m_shaderDataUniformPlansLock);
+    return m_shaderDataUniformPlans.value(qMakePair(shaderDataId, blockNameId));
+}
+
+void GLShader::setShaderDataUniformPlan(Qt3DCore::QNodeId shaderDataId, int blockNameId,
+                                        const QSharedPointer<const ShaderDataUniformPlan> &plan)
+{
+    QWriteLocker lock(&m_shaderDataUniformPlansLock);
+    m_shaderDataUniformPlans.insert(qMakePair(shaderDataId, blockNameId), plan);
+}
+
+void GLShader::removeShaderDataUniformPlans(const QVector<Qt3DCore::QNodeId> &shaderDataIds)
+{
+    QWriteLocker lock(&m_shaderDataUniformPlansLock);
+    auto it = m_shaderDataUniformPlans.begin();
+    while (it != m_shaderDataUniformPlans.end()) {
+        if (shaderDataIds.contains(it.key().first))
+            it = m_shaderDataUniformPlans.erase(it);
+        else
+            ++it;
+    }
+}
+
 void GLShader::initializeUniforms(const QVector<ShaderUniform> &uniformsDescription)
 {
+    {
+        QWriteLocker lock(&m_shaderDataUniformPlansLock);
+        m_shaderDataUniformPlans.clear();
+    }
+
     m_uniforms = uniformsDescription;
     m_uniformsNames.resize(uniformsDescription.size());
     m_uniformsNamesIds.reserve(uniformsDescription.size());
     m_standardUniformNamesIds.reserve(5);
-    QHash<QString, ShaderUniform> activeUniformsInDefaultBlock;
+    QHash<int, ShaderUniform> activeUniformsInDefaultBlock;
+    m_uniformIndexForNameId.clear();
+    m_uniformIndexForNameId.reserve(uniformsDescription.size());
+    // Linking resets the values held by the program
+    m_uploadedUniformValues = QVector<UniformValue>(uniformsDescription.size());
+    m_uploadedUniformValuesSet = QVector<bool>(uniformsDescription.size(), false);
 
     static const QVector<int> standardUniformNameIds = {
         Shader::modelMatrixNameId,
@@ -235,6 +279,7 @@ void GLShader::initializeUniforms(const QVector<ShaderUniform> &uniformsDescript
         m_uniformsNames[i] = m_uniforms[i].m_name;
         const int nameId = StringToInt::lookupId(m_uniformsNames[i]);
         m_uniforms[i].m_nameId = nameId;
+        m_uniformIndexForNameId.insert(nameId, i);
 
         // Is the uniform a Qt3D "Standard" uniform or a user defined one?
         if (standardUniformNameIds.contains(nameId))
@@ -244,7 +289,7 @@ void GLShader::initializeUniforms(const QVector<ShaderUniform> &uniformsDescript
 
         if (uniformsDescription[i].m_blockIndex == -1) { // Uniform is in default block
             qCDebug(Shaders) << "Active Uniform in Default Block " << uniformsDescription[i].m_name << uniformsDescription[i].m_blockIndex;
-            activeUniformsInDefaultBlock.insert(uniformsDescription[i].m_name, uniformsDescription[i]);
+            activeUniformsInDefaultBlock.insert(nameId, m_uniforms[i]);
         }
     }
     m_uniformBlockIndexToShaderUniforms.insert(-1, activeUniformsInDefaultBlock);
@@ -281,14 +326,14 @@ void GLShader::initializeUniformBlocks(const QVector<ShaderUniformBlock> &unifor
         QVector<QString>::const_iterator uniformNamesIt = m_uniformsNames.cbegin();
         const QVector<QString>::const_iterator uniformNamesEnd = m_attributesNames.cend();
 
-        QHash<QString, ShaderUniform> activeUniformsInBlock;
+        QHash<int, ShaderUniform> activeUniformsInBlock;
 
         while (uniformsIt != uniformsEnd && uniformNamesIt != uniformNamesEnd) {
             if (uniformsIt->m_blockIndex == uniformBlockDescription[i].m_index) {
                 QString uniformName = *uniformNamesIt;
                 if (!m_uniformBlockNames[i].isEmpty() && !uniformName.startsWith(m_uniformBlockNames[i]))
                     uniformName = m_uniformBlockNames[i] + QLatin1Char('.') + *uniformNamesIt;
-                activeUniformsInBlock.insert(uniformName, *uniformsIt);
+                activeUniformsInBlock.insert(StringToInt::lookupId(uniformName), *uniformsIt);
                 qCDebug(Shaders) << "Active Uniform Block " << uniformName << " in block " << m_uniformBlockNames[i] << " at index " << uniformsIt->m_blockIndex;
             }
             ++uniformsIt;
@@ -303,11 +348,14 @@ void GLShader::initializeShaderStorageBlocks(const QVector<ShaderStorageBlock> &
     m_shaderStorageBlocks = shaderStorageBlockDescription;
     m_shaderStorageBlockNames.resize(shaderStorageBlockDescription.size());
     m_shaderStorageBlockNamesIds.resize(shaderStorageBlockDescription.size());
+    m_drawDataBlock = ShaderStorageBlock();
 
     for (int i = 0, m = shaderStorageBlockDescription.size(); i < m; ++i) {
         m_shaderStorageBlockNames[i] = m_shaderStorageBlocks[i].m_name;
         m_shaderStorageBlockNamesIds[i] = StringToInt::lookupId(m_shaderStorageBlockNames[i]);
         m_shaderStorageBlocks[i].m_nameId =m_shaderStorageBlockNamesIds[i];
+        if (m_shaderStorageBlockNames[i] == QLatin1String("qt3d_DrawData"))
+            m_drawDataBlock = m_shaderStorageBlocks[i];
         qCDebug(Shaders) << "Initializing Shader Storage Block {" << m_shaderStorageBlockNames[i] << "}";
     }
 }
@@ -56,7 +56,13 @@
 #include <shaderparameterpack_p.h>
 #include <Qt3DRender/qshaderprogram.h>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QSharedPointer>
 
+#if defined(QT_BUILD_INTERNAL)
+class tst_GLShader;
+class tst_Renderer;
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -68,6 +74,8 @@ namespace Render {
 
 namespace OpenGL {
 
+struct ShaderDataUniformPlan;
+
 class Q_AUTOTEST_EXPORT GLShader
 {
 public:
@@ -81,6 +89,10 @@ public:
 
     void prepareUniforms(ShaderParameterPack &pack);
 
+    // Records value as held by the program for the uniform of the default
+    // block named nameId, returns false if it already held it
+    bool updateUploadedUniformValue(int nameId, const UniformValue &value);
+
     void setFragOutputs(const QHash<QString, int> &fragOutputs);
     const QHash<QString, int> fragOutputs() const;
 
@@ -100,7 +112,8 @@ public:
     inline QVector<ShaderUniformBlock> uniformBlocks() const { return m_uniformBlocks; }
     inline QVector<ShaderStorageBlock> storageBlocks() const { return m_shaderStorageBlocks; }
 
-    QHash<QString, ShaderUniform> activeUniformsForUniformBlock(int blockIndex) const;
+    // Keyed by uniform name id
+    QHash<int, ShaderUniform> activeUniformsForUniformBlock(int blockIndex) const;
 
     ShaderUniformBlock uniformBlockForBlockIndex(int blockNameId);
     ShaderUniformBlock uniformBlockForBlockNameId(int blockIndex);
@@ -110,6 +123,17 @@ public:
     ShaderStorageBlock storageBlockForBlockNameId(int blockNameId);
     ShaderStorageBlock storageBlockForBlockName(const QString &blockName);
 
+    // The qt3d_DrawData block holds the DrawData of each draw, indexed by
+    // gl_DrawID, so that draws of different entities can be batched
+    inline bool hasDrawData() const { return m_drawDataBlock.m_index != -1; }
+    inline const ShaderStorageBlock &drawDataBlock() const { return m_drawDataBlock; }
+
+    // Plans are dropped whenever the uniforms are introspected again
+    QSharedPointer<const ShaderDataUniformPlan> shaderDataUniformPlan(Qt3DCore::QNodeId shaderDataId, int blockNameId) const;
+    void setShaderDataUniformPlan(Qt3DCore::QNodeId shaderDataId, int blockNameId,
+                                  const QSharedPointer<const ShaderDataUniformPlan> &plan);
+    void removeShaderDataUniformPlans(const QVector<Qt3DCore::QNodeId> &shaderDataIds);
+
     QOpenGLShaderProgram *shaderProgram() { return &m_shader; }
 
     void setShaderCode(const QVector<QByteArray> shaderCode) { m_shaderCode = shaderCode; }
@@ -124,6 +148,10 @@ private:
     QVector<int> m_uniformsNamesIds;
     QVector<int> m_standardUniformNamesIds;
     QVector<ShaderUniform> m_uniforms;
+    QHash<int, int> m_uniformIndexForNameId;
+    // Indexed like m_uniforms, only meaningful where the flag is set
+    QVector<UniformValue> m_uploadedUniformValues;
+    QVector<bool> m_uploadedUniformValuesSet;
 
     QVector<QString> m_attributesNames;
     QVector<int> m_attributeNamesIds;
@@ -132,15 +160,20 @@ private:
     QVector<QString> m_uniformBlockNames;
     QVector<int> m_uniformBlockNamesIds;
     QVector<ShaderUniformBlock> m_uniformBlocks;
-    QHash<int, QHash<QString, ShaderUniform> > m_uniformBlockIndexToShaderUniforms;
+    QHash<int, QHash<int, ShaderUniform> > m_uniformBlockIndexToShaderUniforms;
 
     QVector<QString> m_shaderStorageBlockNames;
     QVector<int> m_shaderStorageBlockNamesIds;
     QVector<ShaderStorageBlock> m_shaderStorageBlocks;
+    ShaderStorageBlock m_drawDataBlock;
 
     QHash<QString, int> m_fragOutputs;
     QVector<QByteArray> m_shaderCode;
 
+    // Render views compile and look these up concurrently
+    mutable QReadWriteLock m_shaderDataUniformPlansLock;
+    QHash<QPair<Qt3DCore::QNodeId, int>, QSharedPointer<const ShaderDataUniformPlan>> m_shaderDataUniformPlans;
+
     // Private so that only GraphicContext can call it
     void initializeUniforms(const QVector<ShaderUniform> &uniformsDescription);
     void initializeAttributes(const QVector<ShaderAttribute> &attributesDescription);
@@ -148,6 +181,10 @@ private:
     void initializeShaderStorageBlocks(const QVector<ShaderStorageBlock> &shaderStorageBlockDescription);
 
     friend class GraphicsContext;
+#if defined(QT_BUILD_INTERNAL)
+    friend class ::tst_GLShader;
+    friend class ::tst_Renderer;
+#endif
 
     mutable QMutex m_mutex;
     QMetaObject::Connection m_contextConnection;
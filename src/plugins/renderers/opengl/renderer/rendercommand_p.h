@@ -77,31 +77,21 @@ namespace OpenGL {
 
 class GLShader;
 
+// Everything needed to submit a command. What is only needed to build,
+// sort and prepare the commands lives in the parallel RenderCommandBuildData
+// so that submission doesn't walk over it
 class Q_AUTOTEST_EXPORT RenderCommand
 {
 public:
     RenderCommand();
 
     HVao m_vao; // VAO used during the submission step to store all states and VBOs
-    HMaterial m_material; // Purely used to ease sorting (minimize stage changes, binding changes ....)
     GLShader *m_glShader; // GL Shader to be used at render time
-    Qt3DCore::QNodeId m_shaderId; // Shader for given pass and mesh
     ShaderParameterPack m_parameterPack; // Might need to be reworked so as to be able to destroy the
                             // Texture while submission is happening.
     RenderStateSetPtr m_stateSet;
 
-    HGeometry m_geometry;
-    HGeometryRenderer m_geometryRenderer;
-
     HBuffer m_indirectDrawBuffer; // Reference to indirect draw buffer (valid only m_drawIndirect == true)
-    HComputeCommand m_computeCommand;
-
-    // A QAttribute pack might be interesting
-    // This is a temporary fix in the meantime, to remove the hacked methods in Technique
-    QVector<int> m_activeAttributes;
-
-    float m_depth;
-    int m_changeCost;
 
     enum CommandType {
         Draw,
@@ -134,39 +124,75 @@ Q_AUTOTEST_EXPORT bool operator==(const RenderCommand &a, const RenderCommand &b
 inline bool operator!=(const RenderCommand &lhs, const RenderCommand &rhs) noexcept
 { return !operator==(lhs, rhs); }
 
+// Data of a RenderCommand only used while building, sorting and preparing
+// it for submission, stored at the same index in a parallel vector
+class Q_AUTOTEST_EXPORT RenderCommandBuildData
+{
+public:
+    RenderCommandBuildData();
+
+    HMaterial m_material; // Purely used to ease sorting (minimize stage changes, binding changes ....)
+    Qt3DCore::QNodeId m_shaderId; // Shader for given pass and mesh
+
+    HGeometry m_geometry;
+    HGeometryRenderer m_geometryRenderer;
+
+    HComputeCommand m_computeCommand;
+
+    // A QAttribute pack might be interesting
+    // This is a temporary fix in the meantime, to remove the hacked methods in Technique
+    QVector<int> m_activeAttributes;
+
+    float m_depth;
+    int m_changeCost;
+};
+
+Q_AUTOTEST_EXPORT bool operator==(const RenderCommandBuildData &a, const RenderCommandBuildData &b) noexcept;
+
+inline bool operator!=(const RenderCommandBuildData &lhs, const RenderCommandBuildData &rhs) noexcept
+{ return !operator==(lhs, rhs); }
+
 struct EntityRenderCommandData
 {
     QVector<Entity *> entities;
     QVector<RenderCommand> commands;
+    QVector<RenderCommandBuildData> buildData;
     QVector<RenderPassParameterData> passesData;
 
     void reserve(int size)
     {
         entities.reserve(size);
         commands.reserve(size);
+        buildData.reserve(size);
         passesData.reserve(size);
     }
 
     inline int size() const { return entities.size(); }
 
-    inline void push_back(Entity *e, const RenderCommand &c, const RenderPassParameterData &p)
+    inline void push_back(Entity *e, const RenderCommand &c, const RenderCommandBuildData &b,
+                          const RenderPassParameterData &p)
     {
         entities.push_back(e);
         commands.push_back(c);
+        buildData.push_back(b);
         passesData.push_back(p);
     }
 
-    inline void push_back(Entity *e, RenderCommand &&c, RenderPassParameterData &&p)
+    // The pass data only holds implicitly shared containers, copying it is cheap
+    inline void push_back(Entity *e, RenderCommand &&c, RenderCommandBuildData &&b,
+                          const RenderPassParameterData &p)
     {
         entities.push_back(e);
         commands.push_back(std::move(c));
-        passesData.push_back(std::move(p));
+        buildData.push_back(std::move(b));
+        passesData.push_back(p);
     }
 
     EntityRenderCommandData &operator+=(EntityRenderCommandData &&t)
     {
         entities += std::move(t.entities);
         commands += std::move(t.commands);
+        buildData += std::move(t.buildData);
         passesData += std::move(t.passesData);
         return *this;
     }
@@ -123,6 +123,8 @@
 #include <QKeyEvent>
 #include <QMouseEvent>
 
+#include <algorithm>
+
 #include <QtGui/private/qopenglcontext_p.h>
 #include "frameprofiler_p.h"
 
@@ -208,6 +210,101 @@ private:
     RendererCache *m_cache;
 };
 
+uint indexTypeByteSize(GLint indexType)
+{
+    switch (indexType) {
+    case GL_UNSIGNED_BYTE:
+        return sizeof(GLubyte);
+    case GL_UNSIGNED_SHORT:
+        return sizeof(GLushort);
+    case GL_UNSIGNED_INT:
+        return sizeof(GLuint);
+    default:
+        return 0;
+    }
+}
+
+bool isResourceUniform(int nameId, const ShaderParameterPack &pack)
+{
+    const QVector<ShaderParameterPack::NamedResource> textures = pack.textures();
+    for (const ShaderParameterPack::NamedResource &texture : textures) {
+        if (texture.glslNameId == nameId)
+            return true;
+    }
+    const QVector<ShaderParameterPack::NamedResource> images = pack.images();
+    for (const ShaderParameterPack::NamedResource &image : images) {
+        if (image.glslNameId == nameId)
+            return true;
+    }
+    return false;
+}
+
+bool hasSameBuffers(const ShaderParameterPack &a, const ShaderParameterPack &b)
+{
+    const QVector<BlockToUBO> ubosA = a.uniformBuffers();
+    const QVector<BlockToUBO> ubosB = b.uniformBuffers();
+    const QVector<BlockToSSBO> ssbosA = a.shaderStorageBuffers();
+    const QVector<BlockToSSBO> ssbosB = b.shaderStorageBuffers();
+    if (ubosA.size() != ubosB.size() || ssbosA.size() != ssbosB.size())
+        return false;
+    for (int i = 0, m = ubosA.size(); i < m; ++i) {
+        if (ubosA.at(i).m_blockIndex != ubosB.at(i).m_blockIndex
+                || ubosA.at(i).m_bufferID != ubosB.at(i).m_bufferID)
+            return false;
+    }
+    for (int i = 0, m = ssbosA.size(); i < m; ++i) {
+        if (ssbosA.at(i).m_blockIndex != ssbosB.at(i).m_blockIndex
+                || ssbosA.at(i).m_bindingIndex != ssbosB.at(i).m_bindingIndex
+                || ssbosA.at(i).m_bufferID != ssbosB.at(i).m_bufferID)
+            return false;
+    }
+    return true;
+}
+
+// Whether other can be drawn with the shader, VAO, render states and
+// parameters set up for command, only their draw ranges and DrawData differing
+bool canBeMultiDrawnWith(const RenderCommand &command, const RenderCommand &other)
+{
+    if (other.m_type != RenderCommand::Draw
+            || !other.m_isValid
+            || other.m_vao != command.m_vao
+            || other.m_glShader != command.m_glShader
+            || other.m_drawIndirect
+            || other.m_drawIndexed != command.m_drawIndexed
+            || other.m_primitiveType != command.m_primitiveType
+            || other.m_primitiveRestartEnabled
+            || other.m_indexAttributeDataType != command.m_indexAttributeDataType)
+        return false;
+
+    // An indexed multi draw addresses indices by their position, not by byte
+    if (other.m_drawIndexed && other.m_indexAttributeByteOffset % indexTypeByteSize(other.m_indexAttributeDataType) != 0)
+        return false;
+
+    const RenderStateSet *states = command.m_stateSet.data();
+    const RenderStateSet *otherStates = other.m_stateSet.data();
+    if ((states == nullptr) != (otherStates == nullptr))
+        return false;
+    if (states != nullptr && states != otherStates && states->states() != otherStates->states())
+        return false;
+
+    const ShaderParameterPack &pack = command.m_parameterPack;
+    const ShaderParameterPack &otherPack = other.m_parameterPack;
+    if (otherPack.textures() != pack.textures()
+            || otherPack.images() != pack.images()
+            || !hasSameBuffers(pack, otherPack))
+        return false;
+
+    // Packs minimized by RenderView::sort only hold the uniforms that changed
+    // since the previous command, otherwise values are compared one by one.
+    // Texture and image units are skipped, they are the same if the bound
+    // resources are.
+    const PackUniformHash &uniforms = pack.uniforms();
+    const PackUniformHash &otherUniforms = otherPack.uniforms();
+    return otherUniforms.forEachNameId([&] (int nameId) {
+        return isResourceUniform(nameId, otherPack) || uniforms.hasSameValue(nameId, otherUniforms);
+    });
+}
+
 } // anonymous
 
 /*!
@@ -268,6 +365,9 @@ Renderer::Renderer(QRenderAspect::RenderType type)
     , m_shouldSwapBuffers(true)
     , m_imGuiRenderer(nullptr)
     , m_jobsInLastFrame(0)
+    , m_textureDataJobsSpawned(false)
+    , m_uniformsUploadedInLastFrame(0)
+    , m_uniformsSkippedInLastFrame(0)
 {
     // Set renderer as running - it will wait in the context of the
     // RenderThread for RenderViews to be submitted
@@ -613,6 +713,9 @@ void Renderer::releaseGraphicsResources()
             GLBuffer *buffer = m_glResourceManagers->glBufferManager()->data(bufferHandle);
             buffer->destroy(m_submissionContext.data());
         }
+        m_submissionContext->destroyDrawIndirectBuffer();
+        m_submissionContext->destroyDrawDataBuffer();
+        m_submissionContext->destroyUploadStreamingBuffer();
 
         // Do the same thing with shaders
         const QVector<GLShader *> shaders = m_glResourceManagers->glShaderManager()->takeActiveResources();
@@ -940,11 +1043,14 @@ void Renderer::prepareCommandsSubmission(const QVector<RenderView *> &renderView
 
     for (RenderView *rv: renderViews) {
         QVector<RenderCommand> &commands = rv->commands();
-        for (RenderCommand &command : commands) {
+        const QVector<RenderCommandBuildData> &commandsBuildData = rv->commandsBuildData();
+        for (int i = 0, m = commands.size(); i < m; ++i) {
+            RenderCommand &command = commands[i];
+            const RenderCommandBuildData &buildData = commandsBuildData.at(i);
             // Update/Create VAO
             if (command.m_type == RenderCommand::Draw) {
-                Geometry *rGeometry = m_nodesManager->data<Geometry, GeometryManager>(command.m_geometry);
-                GeometryRenderer *rGeometryRenderer = m_nodesManager->data<GeometryRenderer, GeometryRendererManager>(command.m_geometryRenderer);
+                Geometry *rGeometry = m_nodesManager->data<Geometry, GeometryManager>(buildData.m_geometry);
+                GeometryRenderer *rGeometryRenderer = m_nodesManager->data<GeometryRenderer, GeometryRendererManager>(buildData.m_geometryRenderer);
                 GLShader *shader = command.m_glShader;
 
                 // We should never have inserted a command for which these are null
@@ -958,7 +1064,7 @@ void Renderer::prepareCommandsSubmission(const QVector<RenderView *> &renderView
 
                 // Create VAO or return already created instance associated with command shader/geometry
                 // (VAO is emulated if not supported)
-                createOrUpdateVAO(&command, &vaoHandle, &vao);
+                createOrUpdateVAO(&command, &buildData, &vaoHandle, &vao);
                 command.m_vao = vaoHandle;
 
                 // Avoids redoing the same thing for the same VAO
@@ -966,7 +1072,7 @@ void Renderer::prepareCommandsSubmission(const QVector<RenderView *> &renderView
                     updatedTable.insert(vaoHandle, true);
 
                     // Do we have any attributes that are dirty ?
-                    const bool requiresPartialVAOUpdate = requiresVAOAttributeUpdate(rGeometry, &command);
+                    const bool requiresPartialVAOUpdate = requiresVAOAttributeUpdate(rGeometry, &buildData);
 
                     // If true, we need to reupload all attributes to set the VAO
                     // Otherwise only dirty attributes will be updates
@@ -977,7 +1083,7 @@ void Renderer::prepareCommandsSubmission(const QVector<RenderView *> &renderView
                     if (rGeometry->isDirty())
                         m_dirtyGeometry.push_back(rGeometry);
 
-                    if (!command.m_activeAttributes.isEmpty() && (requiresFullVAOUpdate || requiresPartialVAOUpdate)) {
+                    if (!buildData.m_activeAttributes.isEmpty() && (requiresFullVAOUpdate || requiresPartialVAOUpdate)) {
                         Profiling::GLTimeRecorder recorder(Profiling::VAOUpload, activeProfiler());
                         // Activate shader
                         m_submissionContext->activateShader(shader);
@@ -985,7 +1091,7 @@ void Renderer::prepareCommandsSubmission(const QVector<RenderView *> &renderView
                         vao->bind();
                         // Update or set Attributes and Buffers for the given rGeometry and Command
                         // Note: this fills m_dirtyAttributes as well
-                        if (updateVAOWithAttributes(rGeometry, &command, shader, requiresFullVAOUpdate))
+                        if (updateVAOWithAttributes(rGeometry, &buildData, shader, requiresFullVAOUpdate))
                             vao->setSpecified(true);
                     }
                 }
@@ -1385,6 +1491,16 @@ void Renderer::updateGLResources()
         m_textureIdsToCleanup += m_nodesManager->textureManager()->takeTexturesIdsToCleanup();
     }
 
+    // Drop the uniform plans compiled for destroyed ShaderData
+    {
+        const QVector<Qt3DCore::QNodeId> shaderDataIds = m_nodesManager->shaderDataManager()->takeShaderDataIdsToCleanup();
+        if (!shaderDataIds.isEmpty()) {
+            const QVector<GLShader *> shaders = m_glResourceManagers->glShaderManager()->takeActiveResources();
+            for (GLShader *shader : shaders)
+                shader->removeShaderDataUniformPlans(shaderDataIds);
+        }
+    }
+
     // Record list of buffer that might need uploading
     lookForDownloadableBuffers();
 
@@ -1417,6 +1533,7 @@ void Renderer::updateTexture(Texture *texture)
     if (glTexture == nullptr) {
         glTexture = glTextureManager->getOrCreateResource(texture->peerId());
         glTextureManager->texNodeIdForGLTexture.insert(glTexture, texture->peerId());
+        glTexture->setDataManagers(&m_textureDataManager, &m_textureImageDataManager);
     }
 
     // Update GLTexture to match Texture instance
@@ -1445,12 +1562,41 @@ void Renderer::updateTexture(Texture *texture)
                 images.push_back(glImg);
             }
         }
+        // Reference the new generators before releasing the previous ones
+        // so that the data of those in both sets is kept
+        bool hasNewGenerators = false;
+        for (const GLTexture::Image &img : qAsConst(images)) {
+            if (img.generator)
+                hasNewGenerators |= m_textureImageDataManager.requestData(img.generator, texture->peerId());
+        }
+        const QVector<GLTexture::Image> previousImages = glTexture->images();
+        for (const GLTexture::Image &img : previousImages) {
+            if (!img.generator)
+                continue;
+            const bool stillUsed = std::find_if(images.cbegin(), images.cend(), [&img] (const GLTexture::Image &newImg) {
+                return newImg.generator && *newImg.generator == *img.generator;
+            }) != images.cend();
+            if (!stillUsed)
+                m_textureImageDataManager.releaseData(img.generator, texture->peerId());
+        }
         glTexture->setImages(images);
+        if (hasNewGenerators)
+            markDirty(AbstractRenderer::TexturesDirty, nullptr);
     }
 
     // Will make the texture requestUpload
-    if (dirtyFlags.testFlag(Texture::DirtyDataGenerator))
-        glTexture->setGenerator(texture->dataGenerator());
+    if (dirtyFlags.testFlag(Texture::DirtyDataGenerator)) {
+        const QTextureGeneratorPtr previousGenerator = glTexture->textureGenerator();
+        const QTextureGeneratorPtr generator = texture->dataGenerator();
+        const bool sameGenerator = previousGenerator && generator && *previousGenerator == *generator;
+        if (!sameGenerator) {
+            if (generator && m_textureDataManager.requestData(generator, glTexture))
+                markDirty(AbstractRenderer::TexturesDirty, nullptr);
+            if (previousGenerator)
+                m_textureDataManager.releaseData(previousGenerator, glTexture);
+        }
+        glTexture->setGenerator(generator);
+    }
 
     // Will make the texture requestUpload
     if (dirtyFlags.testFlag(Texture::DirtyPendingDataUpdates))
@@ -1468,6 +1614,13 @@ void Renderer::cleanupTexture(Qt3DCore::QNodeId cleanedUpTextureId)
 
     // Destroying the GLTexture implicitely also destroy the GL resources
     if (glTexture != nullptr) {
+        if (glTexture->textureGenerator())
+            m_textureDataManager.releaseData(glTexture->textureGenerator(), glTexture);
+        const QVector<GLTexture::Image> images = glTexture->images();
+        for (const GLTexture::Image &img : images) {
+            if (img.generator)
+                m_textureImageDataManager.releaseData(img.generator, cleanedUpTextureId);
+        }
         glTextureManager->releaseResource(cleanedUpTextureId);
         glTextureManager->texNodeIdForGLTexture.remove(glTexture);
     }
@@ -1514,6 +1667,7 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const QVector<Ren
     m_lastFrameCorrect.storeRelaxed(1);    // everything fine until now.....
 
     qCDebug(Memory) << Q_FUNC_INFO << "rendering frame ";
+    m_submissionContext->resetUniformUploadStatistics();
 
     // We might not want to render on the default FBO
     uint lastBoundFBOId = m_submissionContext->boundFrameBufferObject();
@@ -1530,7 +1684,7 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const QVector<Ren
     for (int i = 0; i < renderViewsCount; ++i) {
         // Initialize GraphicsContext for drawing
         // If the RenderView has a RenderStateSet defined
-        const RenderView *renderView = renderViews.at(i);
+        RenderView *renderView = renderViews.at(i);
 
         if (renderView->shouldSkipSubmission())
             continue;
@@ -1755,6 +1909,12 @@ Renderer::ViewSubmissionResultData Renderer::submitRenderViews(const QVector<Ren
     qCDebug(Rendering) << Q_FUNC_INFO << "Submission of Queue in " << queueElapsed << "ms <=> " << queueElapsed / renderViewsCount << "ms per RenderView <=> Avg " << 1000.0f / (queueElapsed * 1.0f/ renderViewsCount * 1.0f) << " RenderView/s";
     qCDebug(Rendering) << Q_FUNC_INFO << "Submission Completed in " << timer.elapsed() << "ms";
 
+    const SubmissionContext::UniformUploadStatistics uniformStatistics = m_submissionContext->uniformUploadStatistics();
+    m_uniformsUploadedInLastFrame = uniformStatistics.uploaded;
+    m_uniformsSkippedInLastFrame = uniformStatistics.skipped;
+    qCDebug(Rendering) << Q_FUNC_INFO << "Uniforms uploaded" << m_uniformsUploadedInLastFrame
+                       << "skipped" << m_uniformsSkippedInLastFrame;
+
     // Stores the necessary information to safely perform
     // the last swap buffer call
     ViewSubmissionResultData resultData;
@@ -1836,6 +1996,29 @@ QVector<QAspectJobPtr> Renderer::preRenderingJobs()
     if (m_sendBufferCaptureJob->hasRequests())
         jobs.push_back(m_sendBufferCaptureJob);
 
+    // Render another frame to upload the data of new generators. Generators
+    // that returned no data are retried whenever a frame is rendered.
+    m_textureDataJobsSpawned = m_textureDataManager.hasNewGenerators()
+            || m_textureImageDataManager.hasNewGenerators();
+
+    // Decode the data of the texture generators registered since the last
+    // frame, the GLTextures remain Loading until it has been generated
+    const QVector<QTextureGeneratorPtr> textureGenerators = m_textureDataManager.pendingGenerators();
+    for (const QTextureGeneratorPtr &generator : textureGenerators) {
+        TextureDataManager *manager = &m_textureDataManager;
+        jobs.push_back(GenericLambdaJobPtr<std::function<void ()>>::create(
+                           [manager, generator] { manager->assignData(generator, generator->operator()()); },
+                           JobTypes::LoadTextureData, "LoadTextureData"));
+    }
+
+    const QVector<QTextureImageDataGeneratorPtr> imageGenerators = m_textureImageDataManager.pendingGenerators();
+    for (const QTextureImageDataGeneratorPtr &generator : imageGenerators) {
+        TextureImageDataManager *manager = &m_textureImageDataManager;
+        jobs.push_back(GenericLambdaJobPtr<std::function<void ()>>::create(
+                           [manager, generator] { manager->assignData(generator, generator->operator()()); },
+                           JobTypes::LoadTextureData, "LoadTextureImageData"));
+    }
+
     return jobs;
 }
 
@@ -1871,6 +2054,10 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     if (dirtyBitsForFrame & AbstractRenderer::TexturesDirty)
         renderBinJobs.push_back(m_textureGathererJob);
 
+    // Render the next frame as well to upload the data generated this frame
+    if (m_textureDataJobsSpawned)
+        notCleared |= AbstractRenderer::TexturesDirty;
+
     // Layer cache is dependent on layers, layer filters (hence FG structure
     // changes) and the enabled flag on entities
     const bool entitiesEnabledDirty = dirtyBitsForFrame & AbstractRenderer::EntityEnabledDirty;
@@ -1883,7 +2070,9 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
     const bool computeableDirty = dirtyBitsForFrame & AbstractRenderer::ComputeDirty;
     const bool renderableDirty = dirtyBitsForFrame & AbstractRenderer::GeometryDirty;
     const bool materialCacheNeedsToBeRebuilt = shadersDirty || materialDirty || frameGraphDirty;
-    const bool renderCommandsDirty = materialCacheNeedsToBeRebuilt || renderableDirty || computeableDirty;
+    // Material, shader and FrameGraph changes can affect any command, whereas
+    // geometry changes only affect the commands of the entities using them
+    const bool renderCommandsDirty = renderableDirty || computeableDirty;
 
     if (renderableDirty)
         renderBinJobs.push_back(m_renderableEntityFilterJob);
@@ -1925,7 +2114,9 @@ QVector<Qt3DCore::QAspectJobPtr> Renderer::renderBinJobs()
             const bool isNewRV = !m_cache.leafNodeCache.contains(leaf);
             builder.setLayerCacheNeedsToBeRebuilt(layersCacheNeedsToBeRebuilt || isNewRV);
             builder.setMaterialGathererCacheNeedsToBeRebuilt(materialCacheNeedsToBeRebuilt || isNewRV);
-            builder.setRenderCommandCacheNeedsToBeRebuilt(renderCommandsDirty || isNewRV);
+            const bool fullCommandRebuild = materialCacheNeedsToBeRebuilt || isNewRV;
+            builder.setRenderCommandCacheNeedsToBeRebuilt(fullCommandRebuild);
+            builder.setRenderCommandCacheNeedsToBeUpdated(!fullCommandRebuild && renderCommandsDirty);
 
             builder.prepareJobs();
             renderBinJobs.append(builder.buildJobHierachy());
@@ -2037,12 +2228,54 @@ void Renderer::performDraw(RenderCommand *command)
         m_submissionContext->disablePrimitiveRestart();
 }
 
+// Draws count commands sharing their VAO, shader, states and parameters,
+// see multiDrawBatchSize
+void Renderer::performMultiDraw(const RenderCommand *commands, int count)
+{
+    const RenderCommand &first = commands[0];
+
+    if (first.m_drawIndexed) {
+        Profiling::GLTimeRecorder recorder(Profiling::DrawElement, activeProfiler());
+        const uint indexSize = indexTypeByteSize(first.m_indexAttributeDataType);
+        QVector<SubmissionContext::DrawElementsIndirectCommand> draws;
+        draws.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            const RenderCommand &command = commands[i];
+            draws.push_back({ GLuint(command.m_primitiveCount),
+                              GLuint(command.m_instanceCount),
+                              GLuint(command.m_indexAttributeByteOffset / indexSize),
+                              command.m_indexOffset,
+                              GLuint(command.m_firstInstance) });
+        }
+        m_submissionContext->multiDrawElementsIndirect(first.m_primitiveType,
+                                                       first.m_indexAttributeDataType,
+                                                       draws);
+    } else {
+        Profiling::GLTimeRecorder recorder(Profiling::DrawArray, activeProfiler());
+        QVector<SubmissionContext::DrawArraysIndirectCommand> draws;
+        draws.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            const RenderCommand &command = commands[i];
+            draws.push_back({ GLuint(command.m_primitiveCount),
+                              GLuint(command.m_instanceCount),
+                              GLuint(command.m_firstVertex),
+                              GLuint(command.m_firstInstance) });
+        }
+        m_submissionContext->multiDrawArraysIndirect(first.m_primitiveType, draws);
+    }
+
+#if defined(QT3D_RENDER_ASPECT_OPENGL_DEBUG)
+    int err = m_submissionContext->openGLContext()->functions()->glGetError();
+    if (err)
+        qCWarning(Rendering) << "GL error after multi drawing meshes:" << QString::number(err, 16);
+#endif
+}
+
 void Renderer::performCompute(const RenderView *, RenderCommand *command)
 {
     {
         Profiling::GLTimeRecorder recorder(Profiling::ShaderUpdate, activeProfiler());
-        GLShader *shader = m_glResourceManagers->glShaderManager()->lookupResource(command->m_shaderId);
-        m_submissionContext->activateShader(shader);
+        m_submissionContext->activateShader(command->m_glShader);
     }
     {
         Profiling::GLTimeRecorder recorder(Profiling::UniformUpdate, activeProfiler());
@@ -2065,10 +2298,11 @@ void Renderer::performCompute(const RenderView *, RenderCommand *command)
 }
 
 void Renderer::createOrUpdateVAO(RenderCommand *command,
+                                 const RenderCommandBuildData *buildData,
                                  HVao *previousVaoHandle,
                                  OpenGLVertexArrayObject **vao)
 {
-    const VAOIdentifier vaoKey(command->m_geometry, command->m_shaderId);
+    const VAOIdentifier vaoKey(buildData->m_geometry, buildData->m_shaderId);
 
     VAOManager *vaoManager = m_glResourceManagers->vaoManager();
     command->m_vao = vaoManager->lookupHandle(vaoKey);
@@ -2086,14 +2320,36 @@ void Renderer::createOrUpdateVAO(RenderCommand *command,
     Q_ASSERT(*vao);
 }
 
+// Returns how many commands, starting with commands[first], can be submitted
+// with a single multi draw call
+int Renderer::multiDrawBatchSize(const QVector<RenderCommand> &commands, int first)
+{
+    const RenderCommand &command = commands.at(first);
+    if (command.m_type != RenderCommand::Draw
+            || command.m_drawIndirect
+            || command.m_primitiveRestartEnabled
+            || command.m_primitiveType == QGeometryRenderer::Patches)
+        return 1;
+    if (command.m_drawIndexed && (indexTypeByteSize(command.m_indexAttributeDataType) == 0
+                                  || command.m_indexAttributeByteOffset % indexTypeByteSize(command.m_indexAttributeDataType) != 0))
+        return 1;
+
+    int last = first + 1;
+    while (last < commands.size() && canBeMultiDrawnWith(command, commands.at(last)))
+        ++last;
+    return last - first;
+}
+
 // Called by RenderView->submit() in RenderThread context
 // Returns true, if all RenderCommands were sent to the GPU
-bool Renderer::executeCommandsSubmission(const RenderView *rv)
+bool Renderer::executeCommandsSubmission(RenderView *rv)
 {
     bool allCommandsIssued = true;
 
     // Render drawing commands
-    QVector<RenderCommand> commands = rv->commands();
+    // Texture and image units are written into the commands' parameter packs
+    // in place, no need to copy them
+    QVector<RenderCommand> &commands = rv->commands();
 
     // Use the graphicscontext to submit the commands to the underlying
     // graphics API (OpenGL)
@@ -2102,7 +2358,12 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
     RenderStateSet *globalState = m_submissionContext->currentStateSet();
     OpenGLVertexArrayObject *vao = nullptr;
 
-    for (RenderCommand &command : commands) {
+    // Consecutive commands only differing by their draw ranges are submitted
+    // together with glMultiDraw*Indirect where available
+    const bool multiDrawSupported = m_submissionContext->supportsMultiDrawIndirect();
+
+    for (int i = 0, m = commands.size(); i < m; ++i) {
+        RenderCommand &command = commands[i];
 
         if (command.m_type == RenderCommand::Compute) { // Compute Call
             performCompute(rv, &command);
@@ -2121,6 +2382,10 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
                 continue;
             }
 
+            // Has to be found before setParameters and the state merging
+            // below modify the command
+            const int batchSize = multiDrawSupported ? multiDrawBatchSize(commands, i) : 1;
+
             {
                 Profiling::GLTimeRecorder recorder(Profiling::ShaderUpdate, activeProfiler());
                 //// We activate the shader here
@@ -2146,6 +2411,15 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
                     // we won't perform the draw call which could show invalid content
                     continue;
                 }
+
+                // One DrawData per command of the batch, gl_DrawID indexes them
+                if (command.m_glShader->hasDrawData()) {
+                    QVector<DrawData> drawData;
+                    drawData.reserve(batchSize);
+                    for (int j = i, end = i + batchSize; j < end; ++j)
+                        drawData.push_back(commands.at(j).m_parameterPack.drawData());
+                    m_submissionContext->setDrawData(command.m_glShader->drawDataBlock().m_binding, drawData);
+                }
             }
 
             //// OpenGL State
@@ -2170,7 +2444,12 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
             // at that point
 
             //// Draw Calls
-            performDraw(&command);
+            if (batchSize > 1) {
+                performMultiDraw(&command, batchSize);
+                i += batchSize - 1;
+            } else {
+                performDraw(&command);
+            }
         }
     } // end of RenderCommands loop
 
@@ -2186,7 +2465,7 @@ bool Renderer::executeCommandsSubmission(const RenderView *rv)
 }
 
 bool Renderer::updateVAOWithAttributes(Geometry *geometry,
-                                       const RenderCommand *command,
+                                       const RenderCommandBuildData *buildData,
                                        GLShader *shader,
                                        bool forceUpdate)
 {
@@ -2213,7 +2492,7 @@ bool Renderer::updateVAOWithAttributes(Geometry *geometry,
             if ((attributeWasDirty = attribute->isDirty()) == true || forceUpdate)
                 m_submissionContext->specifyIndices(buffer);
             // Vertex Attribute
-        } else if (command->m_activeAttributes.contains(attribute->nameId())) {
+        } else if (buildData->m_activeAttributes.contains(attribute->nameId())) {
             if ((attributeWasDirty = attribute->isDirty()) == true || forceUpdate) {
                 // Find the location for the attribute
                 const QVector<ShaderAttribute> shaderAttributes = shader->attributes();
@@ -2246,7 +2525,7 @@ bool Renderer::updateVAOWithAttributes(Geometry *geometry,
 }
 
 bool Renderer::requiresVAOAttributeUpdate(Geometry *geometry,
-                                          const RenderCommand *command) const
+                                          const RenderCommandBuildData *buildData) const
 {
     const auto attributeIds = geometry->attributes();
 
@@ -2258,7 +2537,7 @@ bool Renderer::requiresVAOAttributeUpdate(Geometry *geometry,
             continue;
 
         if ((attribute->attributeType() == QAttribute::IndexAttribute && attribute->isDirty()) ||
-                (command->m_activeAttributes.contains(attribute->nameId()) && attribute->isDirty()))
+                (buildData->m_activeAttributes.contains(attribute->nameId()) && attribute->isDirty()))
             return true;
     }
     return false;
@@ -67,6 +67,7 @@
 #include <Qt3DRender/private/shaderbuilder_p.h>
 #include <Qt3DRender/private/lightgatherer_p.h>
 #include <Qt3DRender/private/texture_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
 #include <Qt3DRender/private/filterentitybycomponentjob_p.h>
 #include <shaderparameterpack_p.h>
 #include <renderviewinitializerjob_p.h>
@@ -161,6 +162,7 @@ namespace OpenGL {
 class CommandThread;
 class SubmissionContext;
 class RenderCommand;
+class RenderCommandBuildData;
 class RenderQueue;
 class RenderView;
 class GLShader;
@@ -252,14 +254,15 @@ public:
                          GLuint defaultFramebuffer);
 
     void prepareCommandsSubmission(const QVector<RenderView *> &renderViews);
-    bool executeCommandsSubmission(const RenderView *rv);
+    bool executeCommandsSubmission(RenderView *rv);
+    static int multiDrawBatchSize(const QVector<RenderCommand> &commands, int first);
     bool updateVAOWithAttributes(Geometry *geometry,
-                                 const RenderCommand *command,
+                                 const RenderCommandBuildData *buildData,
                                  GLShader *shader,
                                  bool forceUpdate);
 
     bool requiresVAOAttributeUpdate(Geometry *geometry,
-                                    const RenderCommand *command) const;
+                                    const RenderCommandBuildData *buildData) const;
 
     // For Scene2D rendering
     void setOpenGLContext(QOpenGLContext *context) override;
@@ -272,6 +275,8 @@ public:
 
     const GraphicsApiFilterData *contextInfo() const;
     SubmissionContext *submissionContext() const;
+    int uniformsUploadedInLastFrame() const { return m_uniformsUploadedInLastFrame; }
+    int uniformsSkippedInLastFrame() const { return m_uniformsSkippedInLastFrame; }
 
     inline RenderStateSet *defaultRenderState() const { return m_defaultRenderStateSet; }
 
@@ -365,8 +370,10 @@ private:
     QVector<Qt3DCore::QNodeId> m_pendingRenderCaptureSendRequests;
 
     void performDraw(RenderCommand *command);
+    void performMultiDraw(const RenderCommand *commands, int count);
     void performCompute(const RenderView *rv, RenderCommand *command);
     void createOrUpdateVAO(RenderCommand *command,
+                           const RenderCommandBuildData *buildData,
                            HVao *previousVAOHandle,
                            OpenGLVertexArrayObject **vao);
 
@@ -425,6 +432,13 @@ private:
     QList<QKeyEvent> m_frameKeyEvents;
     QMutex m_frameEventsMutex;
     int m_jobsInLastFrame;
+
+    // Texture generators are run by jobs ahead of the upload of their data
+    TextureDataManager m_textureDataManager;
+    TextureImageDataManager m_textureImageDataManager;
+    bool m_textureDataJobsSpawned;
+    int m_uniformsUploadedInLastFrame;
+    int m_uniformsSkippedInLastFrame;
 };
 
 } // namespace OpenGL
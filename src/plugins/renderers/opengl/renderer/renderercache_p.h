@@ -54,6 +54,7 @@
 #include <Qt3DRender/QFrameGraphNode>
 
 #include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/handle_types_p.h>
 #include <renderviewjobutils_p.h>
 #include <Qt3DRender/private/lightsource_p.h>
 #include <rendercommand_p.h>
@@ -68,11 +69,25 @@ namespace OpenGL {
 
 struct RendererCache
 {
+    // What the RenderCommands of an Entity were built from, used to only
+    // rebuild the commands of the entities that have changed
+    struct EntityCommandRevision
+    {
+        Entity *entity;
+        HGeometryRenderer geometryRenderer;
+        HGeometry geometry;
+        int geometryRendererRevision;
+        int geometryRevision;
+        bool geometryRendererEnabled;
+    };
+
     struct LeafNodeData
     {
         QVector<Entity *> filterEntitiesByLayer;
         MaterialParameterGathererData materialParameterGatherer;
         EntityRenderCommandData renderCommandData;
+        // Sorted by Entity, only filled for draw RenderViews
+        QVector<EntityCommandRevision> renderCommandRevisions;
     };
 
     // Shared amongst all RV cache
@@ -75,6 +75,7 @@
 #include <Qt3DCore/qentity.h>
 #include <QtGui/qsurface.h>
 #include <algorithm>
+#include <numeric>
 
 #include <QDebug>
 #if defined(QT3D_RENDER_VIEW_JOB_TIMINGS)
@@ -105,13 +106,13 @@ int LIGHT_POSITION_NAMES[MAX_LIGHTS];
 int LIGHT_TYPE_NAMES[MAX_LIGHTS];
 int LIGHT_COLOR_NAMES[MAX_LIGHTS];
 int LIGHT_INTENSITY_NAMES[MAX_LIGHTS];
-QString LIGHT_STRUCT_NAMES[MAX_LIGHTS];
+int LIGHT_STRUCT_NAMES[MAX_LIGHTS];
 
 int LIGHT_POSITION_UNROLL_NAMES[MAX_LIGHTS];
 int LIGHT_TYPE_UNROLL_NAMES[MAX_LIGHTS];
 int LIGHT_COLOR_UNROLL_NAMES[MAX_LIGHTS];
 int LIGHT_INTENSITY_UNROLL_NAMES[MAX_LIGHTS];
-QString LIGHT_STRUCT_UNROLL_NAMES[MAX_LIGHTS];
+int LIGHT_STRUCT_UNROLL_NAMES[MAX_LIGHTS];
 
 bool wasInitialized = false;
 
@@ -271,17 +272,19 @@ RenderView::RenderView()
         LIGHT_COUNT_NAME_ID = StringToInt::lookupId(QLatin1String("lightCount"));
         for (int i = 0; i < MAX_LIGHTS; ++i) {
             Q_STATIC_ASSERT_X(MAX_LIGHTS < 10, "can't use the QChar trick anymore");
-            LIGHT_STRUCT_NAMES[i] = QLatin1String("lights[") + QLatin1Char(char('0' + i)) + QLatin1Char(']');
-            LIGHT_POSITION_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_NAMES[i] + LIGHT_POSITION_NAME);
-            LIGHT_TYPE_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_NAMES[i] + LIGHT_TYPE_NAME);
-            LIGHT_COLOR_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_NAMES[i] + LIGHT_COLOR_NAME);
-            LIGHT_INTENSITY_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_NAMES[i] + LIGHT_INTENSITY_NAME);
-
-            LIGHT_STRUCT_UNROLL_NAMES[i] = QLatin1String("light_") + QLatin1Char(char('0' + i));
-            LIGHT_POSITION_UNROLL_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_UNROLL_NAMES[i] + LIGHT_POSITION_NAME);
-            LIGHT_TYPE_UNROLL_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_UNROLL_NAMES[i] + LIGHT_TYPE_NAME);
-            LIGHT_COLOR_UNROLL_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_UNROLL_NAMES[i] + LIGHT_COLOR_NAME);
-            LIGHT_INTENSITY_UNROLL_NAMES[i] = StringToInt::lookupId(LIGHT_STRUCT_UNROLL_NAMES[i] + LIGHT_INTENSITY_NAME);
+            const QString lightStructName = QLatin1String("lights[") + QLatin1Char(char('0' + i)) + QLatin1Char(']');
+            LIGHT_STRUCT_NAMES[i] = StringToInt::lookupId(lightStructName);
+            LIGHT_POSITION_NAMES[i] = StringToInt::lookupId(lightStructName + LIGHT_POSITION_NAME);
+            LIGHT_TYPE_NAMES[i] = StringToInt::lookupId(lightStructName + LIGHT_TYPE_NAME);
+            LIGHT_COLOR_NAMES[i] = StringToInt::lookupId(lightStructName + LIGHT_COLOR_NAME);
+            LIGHT_INTENSITY_NAMES[i] = StringToInt::lookupId(lightStructName + LIGHT_INTENSITY_NAME);
+
+            const QString lightStructUnrollName = QLatin1String("light_") + QLatin1Char(char('0' + i));
+            LIGHT_STRUCT_UNROLL_NAMES[i] = StringToInt::lookupId(lightStructUnrollName);
+            LIGHT_POSITION_UNROLL_NAMES[i] = StringToInt::lookupId(lightStructUnrollName + LIGHT_POSITION_NAME);
+            LIGHT_TYPE_UNROLL_NAMES[i] = StringToInt::lookupId(lightStructUnrollName + LIGHT_TYPE_NAME);
+            LIGHT_COLOR_UNROLL_NAMES[i] = StringToInt::lookupId(lightStructUnrollName + LIGHT_COLOR_NAME);
+            LIGHT_INTENSITY_UNROLL_NAMES[i] = StringToInt::lookupId(lightStructUnrollName + LIGHT_INTENSITY_NAME);
         }
     }
 }
@@ -293,10 +296,18 @@ RenderView::~RenderView()
 
 namespace {
 
+// The sort policies look at fields of both the RenderCommands and their
+// build data, so commands are sorted through their indices and moved once
+struct CommandSortData
+{
+    const QVector<RenderCommand> &commands;
+    const QVector<RenderCommandBuildData> &buildData;
+};
+
 template<int SortType>
 struct AdjacentSubRangeFinder
 {
-    static bool adjacentSubRange(const RenderCommand &, const RenderCommand &)
+    static bool adjacentSubRange(const CommandSortData &, int, int)
     {
         Q_UNREACHABLE();
         return false;
@@ -306,47 +317,47 @@ struct AdjacentSubRangeFinder
 template<>
 struct AdjacentSubRangeFinder<QSortPolicy::StateChangeCost>
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
+    static bool adjacentSubRange(const CommandSortData &data, int a, int b)
     {
-        return a.m_changeCost == b.m_changeCost;
+        return data.buildData.at(a).m_changeCost == data.buildData.at(b).m_changeCost;
     }
 };
 
 template<>
 struct AdjacentSubRangeFinder<QSortPolicy::BackToFront>
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
+    static bool adjacentSubRange(const CommandSortData &data, int a, int b)
     {
-        return qFuzzyCompare(a.m_depth, b.m_depth);
+        return qFuzzyCompare(data.buildData.at(a).m_depth, data.buildData.at(b).m_depth);
     }
 };
 
 template<>
 struct AdjacentSubRangeFinder<QSortPolicy::Material>
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
+    static bool adjacentSubRange(const CommandSortData &data, int a, int b)
     {
-        return a.m_glShader == b.m_glShader;
+        return data.commands.at(a).m_glShader == data.commands.at(b).m_glShader;
     }
 };
 
 template<>
 struct AdjacentSubRangeFinder<QSortPolicy::FrontToBack>
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
+    static bool adjacentSubRange(const CommandSortData &data, int a, int b)
     {
-        return qFuzzyCompare(a.m_depth, b.m_depth);
+        return qFuzzyCompare(data.buildData.at(a).m_depth, data.buildData.at(b).m_depth);
     }
 };
 
 template<>
 struct AdjacentSubRangeFinder<QSortPolicy::Texture>
 {
-    static bool adjacentSubRange(const RenderCommand &a, const RenderCommand &b)
+    static bool adjacentSubRange(const CommandSortData &data, int a, int b)
     {
         // Two renderCommands are adjacent if one contains all the other command's textures
-        QVector<ShaderParameterPack::NamedResource> texturesA = a.m_parameterPack.textures();
-        QVector<ShaderParameterPack::NamedResource> texturesB = b.m_parameterPack.textures();
+        QVector<ShaderParameterPack::NamedResource> texturesA = data.commands.at(a).m_parameterPack.textures();
+        QVector<ShaderParameterPack::NamedResource> texturesB = data.commands.at(b).m_parameterPack.textures();
 
         if (texturesB.size() > texturesA.size())
             qSwap(texturesA, texturesB);
@@ -361,12 +372,12 @@ struct AdjacentSubRangeFinder<QSortPolicy::Texture>
 };
 
 template<typename Predicate>
-int advanceUntilNonAdjacent(const QVector<RenderCommand> &commands,
+int advanceUntilNonAdjacent(const CommandSortData &data, const std::vector<int> &order,
                             const int beg, const int end, Predicate pred)
 {
     int i = beg + 1;
     while (i < end) {
-        if (!pred(*(commands.begin() + beg), *(commands.begin() + i)))
+        if (!pred(data, order[beg], order[i]))
             break;
         ++i;
     }
@@ -374,13 +385,14 @@ int advanceUntilNonAdjacent(const QVector<RenderCommand> &commands,
 }
 
 
-using CommandIt = QVector<RenderCommand>::iterator;
+using CommandIt = std::vector<int>::iterator;
 
 template<int SortType>
 struct SubRangeSorter
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
+    static void sortSubRange(const CommandSortData &data, CommandIt begin, const CommandIt end)
     {
+        Q_UNUSED(data)
         Q_UNUSED(begin)
         Q_UNUSED(end)
         Q_UNREACHABLE();
@@ -390,10 +402,10 @@ struct SubRangeSorter
 template<>
 struct SubRangeSorter<QSortPolicy::StateChangeCost>
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
+    static void sortSubRange(const CommandSortData &data, CommandIt begin, const CommandIt end)
     {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_changeCost > b.m_changeCost;
+        std::stable_sort(begin, end, [&data] (int a, int b) {
+            return data.buildData.at(a).m_changeCost > data.buildData.at(b).m_changeCost;
         });
     }
 };
@@ -401,10 +413,10 @@ struct SubRangeSorter<QSortPolicy::StateChangeCost>
 template<>
 struct SubRangeSorter<QSortPolicy::BackToFront>
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
+    static void sortSubRange(const CommandSortData &data, CommandIt begin, const CommandIt end)
     {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_depth > b.m_depth;
+        std::stable_sort(begin, end, [&data] (int a, int b) {
+            return data.buildData.at(a).m_depth > data.buildData.at(b).m_depth;
         });
     }
 };
@@ -412,11 +424,11 @@ struct SubRangeSorter<QSortPolicy::BackToFront>
 template<>
 struct SubRangeSorter<QSortPolicy::Material>
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
+    static void sortSubRange(const CommandSortData &data, CommandIt begin, const CommandIt end)
     {
         // First we sort by shader
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_glShader > b.m_glShader;
+        std::stable_sort(begin, end, [&data] (int a, int b) {
+            return data.commands.at(a).m_glShader > data.commands.at(b).m_glShader;
         });
     }
 };
@@ -424,10 +436,10 @@ struct SubRangeSorter<QSortPolicy::Material>
 template<>
 struct SubRangeSorter<QSortPolicy::FrontToBack>
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
+    static void sortSubRange(const CommandSortData &data, CommandIt begin, const CommandIt end)
     {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            return a.m_depth < b.m_depth;
+        std::stable_sort(begin, end, [&data] (int a, int b) {
+            return data.buildData.at(a).m_depth < data.buildData.at(b).m_depth;
         });
     }
 };
@@ -435,11 +447,11 @@ struct SubRangeSorter<QSortPolicy::FrontToBack>
 template<>
 struct SubRangeSorter<QSortPolicy::Texture>
 {
-    static void sortSubRange(CommandIt begin, const CommandIt end)
+    static void sortSubRange(const CommandSortData &data, CommandIt begin, const CommandIt end)
     {
-        std::stable_sort(begin, end, [] (const RenderCommand &a, const RenderCommand &b) {
-            QVector<ShaderParameterPack::NamedResource> texturesA = a.m_parameterPack.textures();
-            QVector<ShaderParameterPack::NamedResource> texturesB = b.m_parameterPack.textures();
+        std::stable_sort(begin, end, [&data] (int a, int b) {
+            QVector<ShaderParameterPack::NamedResource> texturesA = data.commands.at(a).m_parameterPack.textures();
+            QVector<ShaderParameterPack::NamedResource> texturesB = data.commands.at(b).m_parameterPack.textures();
 
             const int originalTextureASize = texturesA.size();
 
@@ -458,21 +470,21 @@ struct SubRangeSorter<QSortPolicy::Texture>
     }
 };
 
-int findSubRange(const QVector<RenderCommand> &commands,
+int findSubRange(const CommandSortData &data, const std::vector<int> &order,
                  const int begin, const int end,
                  const QSortPolicy::SortType sortType)
 {
     switch (sortType) {
     case QSortPolicy::StateChangeCost:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::StateChangeCost>::adjacentSubRange);
+        return advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::StateChangeCost>::adjacentSubRange);
     case QSortPolicy::BackToFront:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::BackToFront>::adjacentSubRange);
+        return advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::BackToFront>::adjacentSubRange);
     case QSortPolicy::Material:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
+        return advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
     case QSortPolicy::FrontToBack:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::FrontToBack>::adjacentSubRange);
+        return advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::FrontToBack>::adjacentSubRange);
     case QSortPolicy::Texture:
-        return advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Texture>::adjacentSubRange);
+        return advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::Texture>::adjacentSubRange);
     case QSortPolicy::Uniform:
         return end;
     default:
@@ -481,22 +493,22 @@ int findSubRange(const QVector<RenderCommand> &commands,
     }
 }
 
-void sortByMaterial(QVector<RenderCommand> &commands, int begin, const int end)
+void sortByMaterial(const CommandSortData &data, std::vector<int> &order, int begin, const int end)
 {
     // We try to arrange elements so that their rendering cost is minimized for a given shader
-    int rangeEnd = advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
+    int rangeEnd = advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
     while (begin != end) {
         if (begin + 1 < rangeEnd) {
-            std::stable_sort(commands.begin() + begin + 1, commands.begin() + rangeEnd, [] (const RenderCommand &a, const RenderCommand &b){
-                return a.m_material.handle() < b.m_material.handle();
+            std::stable_sort(order.begin() + begin + 1, order.begin() + rangeEnd, [&data] (int a, int b){
+                return data.buildData.at(a).m_material.handle() < data.buildData.at(b).m_material.handle();
             });
         }
         begin = rangeEnd;
-        rangeEnd = advanceUntilNonAdjacent(commands, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
+        rangeEnd = advanceUntilNonAdjacent(data, order, begin, end, AdjacentSubRangeFinder<QSortPolicy::Material>::adjacentSubRange);
     }
 }
 
-void sortCommandRange(QVector<RenderCommand> &commands, int begin, const int end, const int level,
+void sortCommandRange(const CommandSortData &data, std::vector<int> &order, int begin, const int end, const int level,
                       const QVector<Qt3DRender::QSortPolicy::SortType> &sortingTypes)
 {
     if (level >= sortingTypes.size())
@@ -504,22 +516,22 @@ void sortCommandRange(QVector<RenderCommand> &commands, int begin, const int end
 
     switch (sortingTypes.at(level)) {
     case QSortPolicy::StateChangeCost:
-        SubRangeSorter<QSortPolicy::StateChangeCost>::sortSubRange(commands.begin() + begin, commands.begin() + end);
+        SubRangeSorter<QSortPolicy::StateChangeCost>::sortSubRange(data, order.begin() + begin, order.begin() + end);
         break;
     case QSortPolicy::BackToFront:
-        SubRangeSorter<QSortPolicy::BackToFront>::sortSubRange(commands.begin() + begin, commands.begin() + end);
+        SubRangeSorter<QSortPolicy::BackToFront>::sortSubRange(data, order.begin() + begin, order.begin() + end);
         break;
     case QSortPolicy::Material:
         // Groups all same shader DNA together
-        SubRangeSorter<QSortPolicy::Material>::sortSubRange(commands.begin() + begin, commands.begin() + end);
+        SubRangeSorter<QSortPolicy::Material>::sortSubRange(data, order.begin() + begin, order.begin() + end);
         // Group all same material together (same parameters most likely)
-        sortByMaterial(commands, begin, end);
+        sortByMaterial(data, order, begin, end);
         break;
     case QSortPolicy::FrontToBack:
-        SubRangeSorter<QSortPolicy::FrontToBack>::sortSubRange(commands.begin() + begin, commands.begin() + end);
+        SubRangeSorter<QSortPolicy::FrontToBack>::sortSubRange(data, order.begin() + begin, order.begin() + end);
         break;
     case QSortPolicy::Texture:
-        SubRangeSorter<QSortPolicy::Texture>::sortSubRange(commands.begin() + begin, commands.begin() + end);
+        SubRangeSorter<QSortPolicy::Texture>::sortSubRange(data, order.begin() + begin, order.begin() + end);
         break;
     case QSortPolicy::Uniform:
         break;
@@ -529,21 +541,167 @@ void sortCommandRange(QVector<RenderCommand> &commands, int begin, const int end
 
     // For all sub ranges of adjacent item for sortType[i]
     // Perform filtering with sortType[i + 1]
-    int rangeEnd = findSubRange(commands, begin, end, sortingTypes.at(level));
+    int rangeEnd = findSubRange(data, order, begin, end, sortingTypes.at(level));
     while (begin != end) {
-        sortCommandRange(commands, begin, rangeEnd, level + 1, sortingTypes);
+        sortCommandRange(data, order, begin, rangeEnd, level + 1, sortingTypes);
         begin = rangeEnd;
-        rangeEnd = findSubRange(commands, begin, end, sortingTypes.at(level));
+        rangeEnd = findSubRange(data, order, begin, end, sortingTypes.at(level));
+    }
+}
+
+// Unsigned key which orders like the float, with -0 and +0 equal
+inline uint floatSortKey(float f)
+{
+    if (f == 0.0f)
+        f = 0.0f;
+    uint bits;
+    memcpy(&bits, &f, sizeof(float));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+// Replaces each value by its rank among the distinct values
+template<typename ValueGetter>
+std::vector<uint> rankSortKeys(int commandCount, ValueGetter value, bool descending)
+{
+    QHash<quintptr, uint> ranks;
+    std::vector<quintptr> distinctValues;
+    for (int i = 0; i < commandCount; ++i) {
+        const quintptr v = value(i);
+        if (!ranks.contains(v)) {
+            ranks.insert(v, 0);
+            distinctValues.push_back(v);
+        }
+    }
+
+    if (descending)
+        std::sort(distinctValues.begin(), distinctValues.end(), std::greater<quintptr>());
+    else
+        std::sort(distinctValues.begin(), distinctValues.end());
+    for (uint r = 0, m = uint(distinctValues.size()); r < m; ++r)
+        ranks[distinctValues[r]] = r;
+
+    std::vector<uint> keys(commandCount);
+    for (int i = 0; i < commandCount; ++i)
+        keys[i] = ranks.value(value(i));
+    return keys;
+}
+
+// Stable LSD radix sort of order by keys[order[i]], a byte at a time
+void radixSortByKey(const std::vector<uint> &keys, std::vector<int> &order, std::vector<int> &scratch)
+{
+    const int count = int(order.size());
+    for (int shift = 0; shift < 32; shift += 8) {
+        int offsets[257] = {};
+        for (int i = 0; i < count; ++i)
+            ++offsets[((keys[i] >> shift) & 0xff) + 1];
+
+        // Skip the byte if it is the same for every key
+        if (std::find(offsets + 1, offsets + 257, count) != offsets + 257)
+            continue;
+
+        for (int b = 0; b < 256; ++b)
+            offsets[b + 1] += offsets[b];
+        for (int i = 0; i < count; ++i) {
+            const int idx = order[i];
+            scratch[offsets[(keys[idx] >> shift) & 0xff]++] = idx;
+        }
+        order.swap(scratch);
+    }
+}
+
+// Same order as sortCommandRange, but with one 32 bit key per sort level and
+// a stable radix sort from the least to the most significant level. Returns
+// false when the policy can't be expressed as keys.
+bool sortCommandsByKeys(const CommandSortData &data, std::vector<int> &order,
+                        const QVector<Qt3DRender::QSortPolicy::SortType> &sortingTypes)
+{
+    // Texture sorting groups commands sharing textures, which isn't an order
+    if (sortingTypes.contains(QSortPolicy::Texture))
+        return false;
+
+    const int commandCount = int(order.size());
+    if (commandCount < 2)
+        return true;
+
+    // Most significant level first
+    std::vector<std::vector<uint>> levelKeys;
+    std::vector<uint> materialKeys;
+    levelKeys.reserve(sortingTypes.size() + 1);
+
+    for (const QSortPolicy::SortType sortType : sortingTypes) {
+        std::vector<uint> keys;
+        switch (sortType) {
+        case QSortPolicy::StateChangeCost:
+            keys.resize(commandCount);
+            for (int i = 0; i < commandCount; ++i)
+                keys[i] = ~(uint(data.buildData.at(i).m_changeCost) ^ 0x80000000u);
+            break;
+        case QSortPolicy::BackToFront:
+            keys.resize(commandCount);
+            for (int i = 0; i < commandCount; ++i)
+                keys[i] = ~floatSortKey(data.buildData.at(i).m_depth);
+            break;
+        case QSortPolicy::FrontToBack:
+            keys.resize(commandCount);
+            for (int i = 0; i < commandCount; ++i)
+                keys[i] = floatSortKey(data.buildData.at(i).m_depth);
+            break;
+        case QSortPolicy::Material:
+            keys = rankSortKeys(commandCount, [&data] (int i) { return quintptr(data.commands.at(i).m_glShader); }, true);
+            if (materialKeys.empty())
+                materialKeys = rankSortKeys(commandCount, [&data] (int i) { return data.buildData.at(i).m_material.handle(); }, false);
+            break;
+        default:
+            break;
+        }
+        if (!keys.empty())
+            levelKeys.push_back(std::move(keys));
     }
+
+    // Following levels only refine ranges of same shader, so the material
+    // order only breaks the ties they leave
+    if (!materialKeys.empty())
+        levelKeys.push_back(std::move(materialKeys));
+
+    std::vector<int> scratch(commandCount);
+    for (auto it = levelKeys.crbegin(), end = levelKeys.crend(); it != end; ++it)
+        radixSortByKey(*it, order, scratch);
+    return true;
+}
+
+// Moves the elements of v into the given order
+template<typename T>
+void applyOrder(QVector<T> &v, const std::vector<int> &order)
+{
+    QVector<T> sorted;
+    sorted.reserve(v.size());
+    for (const int idx : order)
+        sorted.push_back(std::move(v[idx]));
+    v = std::move(sorted);
 }
 
 } // anonymous
 
 void RenderView::sort()
 {
+    Q_ASSERT(m_commands.size() == m_commandsBuildData.size());
+
     // Compares the bitsetKey of the RenderCommands
     // Key[Depth | StateCost | Shader]
-    sortCommandRange(m_commands, 0, m_commands.size(), 0, m_data.m_sortingTypes);
+    std::vector<int> order(m_commands.size());
+    std::iota(order.begin(), order.end(), 0);
+    const CommandSortData sortData { m_commands, m_commandsBuildData };
+    if (!sortCommandsByKeys(sortData, order, m_data.m_sortingTypes))
+        sortCommandRange(sortData, order, 0, int(order.size()), 0, m_data.m_sortingTypes);
+
+    // Commands and their build data are only moved once, if their order changed
+    bool sorted = true;
+    for (int i = 0, m = int(order.size()); i < m && sorted; ++i)
+        sorted = order[i] == i;
+    if (!sorted) {
+        applyOrder(m_commands, order);
+        applyOrder(m_commandsBuildData, order);
+    }
 
     // For RenderCommand with the same shader
     // We compute the adjacent change cost
@@ -571,7 +729,7 @@ void RenderView::sort()
                 // not the copy
                 PackUniformHash &uniforms = m_commands[j].m_parameterPack.m_uniforms;
 
-                for (int u = 0; u < uniforms.keys.size();) {
+                uniforms.removeIf([&cachedUniforms] (int uniformNameId, const UniformValue &newValue) {
                     // We are comparing the values:
                     // - raw uniform values
                     // - the texture Node id if the uniform represents a texture
@@ -579,19 +737,14 @@ void RenderView::sort()
                     // sharing the same material (shader) are rendered, we can't have the case
                     // where two uniforms, referencing the same texture eventually have 2 different
                     // texture unit values
-                    const int uniformNameId = uniforms.keys.at(u);
-                    const UniformValue &refValue = cachedUniforms.value(uniformNameId);
-                    const UniformValue &newValue = uniforms.values.at(u);
-                    if (newValue == refValue) {
-                        uniforms.erase(u);
-                    } else {
-                        // Record updated value so that subsequent comparison
-                        // for the next command will be made againts latest
-                        // uniform value
-                        cachedUniforms.insert(uniformNameId, newValue);
-                        ++u;
-                    }
-                }
+                    if (cachedUniforms.contains(uniformNameId) && cachedUniforms.value(uniformNameId) == newValue)
+                        return true;
+                    // Record updated value so that subsequent comparison
+                    // for the next command will be made againts latest
+                    // uniform value
+                    cachedUniforms.insert(uniformNameId, newValue);
+                    return false;
+                });
                 ++j;
             }
         }
@@ -669,10 +822,11 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const QVector<Entity
             for (const RenderPassParameterData &passData : renderPassData) {
                 // Add the RenderPass Parameters
                 RenderCommand command = {};
-                command.m_geometryRenderer = geometryRendererHandle;
-                command.m_geometry = geometryHandle;
+                RenderCommandBuildData buildData;
+                buildData.m_geometryRenderer = geometryRendererHandle;
+                buildData.m_geometry = geometryHandle;
 
-                command.m_material = materialHandle;
+                buildData.m_material = materialHandle;
                 // For RenderPass based states we use the globally set RenderState
                 // if no renderstates are defined as part of the pass. That means:
                 // RenderPass { renderStates: [] } will use the states defined by
@@ -683,10 +837,10 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const QVector<Entity
                     addStatesToRenderStateSet(command.m_stateSet.data(), pass->renderStates(), m_manager->renderStateManager());
                     if (m_stateSet != nullptr)
                         command.m_stateSet->merge(m_stateSet);
-                    command.m_changeCost = m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
+                    buildData.m_changeCost = m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
                 }
-                command.m_shaderId = pass->shaderProgram();
-                command.m_glShader = glShaderManager->lookupResource(command.m_shaderId);
+                buildData.m_shaderId = pass->shaderProgram();
+                command.m_glShader = glShaderManager->lookupResource(buildData.m_shaderId);
 
                 // It takes two frames to have a valid command as we can only
                 // reference a glShader at frame n if it has been loaded at frame n - 1
@@ -760,7 +914,8 @@ EntityRenderCommandData RenderView::buildDrawRenderCommands(const QVector<Entity
 
                 commands.push_back(entity,
                                    std::move(command),
-                                   std::move(passData));
+                                   std::move(buildData),
+                                   passData);
             }
         }
     }
@@ -796,6 +951,7 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const QVector<Ent
             for (const RenderPassParameterData &passData : renderPassData) {
                 // Add the RenderPass Parameters
                 RenderCommand command = {};
+                RenderCommandBuildData buildData;
                 RenderPass *pass = passData.pass;
 
                 if (pass->hasRenderStates()) {
@@ -806,17 +962,17 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const QVector<Ent
                     // so that the local stateset only overrides
                     if (m_stateSet != nullptr)
                         command.m_stateSet->merge(m_stateSet);
-                    command.m_changeCost = m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
+                    buildData.m_changeCost = m_renderer->defaultRenderState()->changeCost(command.m_stateSet.data());
                 }
-                command.m_shaderId = pass->shaderProgram();
-                command.m_glShader = glShaderManager->lookupResource(command.m_shaderId);
+                buildData.m_shaderId = pass->shaderProgram();
+                command.m_glShader = glShaderManager->lookupResource(buildData.m_shaderId);
 
                 // It takes two frames to have a valid command as we can only
                 // reference a glShader at frame n if it has been loaded at frame n - 1
                 if (!command.m_glShader)
                     continue;
 
-                command.m_computeCommand = computeCommandHandle;
+                buildData.m_computeCommand = computeCommandHandle;
                 command.m_type = RenderCommand::Compute;
                 command.m_workGroups[0] = std::max(m_workGroups[0], computeJob->x());
                 command.m_workGroups[1] = std::max(m_workGroups[1], computeJob->y());
@@ -824,7 +980,8 @@ EntityRenderCommandData RenderView::buildComputeRenderCommands(const QVector<Ent
 
                 commands.push_back(entity,
                                    std::move(command),
-                                   std::move(passData));
+                                   std::move(buildData),
+                                   passData);
             }
         }
     }
@@ -844,11 +1001,14 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
     builder->textureManager = m_manager->textureManager();
     m_localData.setLocalData(builder);
 
+    MaterialParameterPacks materialPacks;
+
     for (int i = 0, m = count; i < m; ++i) {
         const int idx = offset + i;
         Entity *entity = renderCommandData->entities.at(idx);
-        const RenderPassParameterData passData = renderCommandData->passesData.at(idx);
+        const RenderPassParameterData &passData = renderCommandData->passesData.at(idx);
         RenderCommand &command = renderCommandData->commands[idx];
+        RenderCommandBuildData &buildData = renderCommandData->buildData[idx];
 
         // Pick which lights to take in to account.
         // For now decide based on the distance by taking the MAX_LIGHTS closest lights.
@@ -861,7 +1021,7 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
             // Project the camera-to-object-center vector onto the camera
             // view vector. This gives a depth value suitable as the key
             // for BackToFront sorting.
-            command.m_depth = Vector3D::dotProduct(entity->worldBoundingVolume()->center() - m_data.m_eyePos, m_data.m_eyeViewDir);
+            buildData.m_depth = Vector3D::dotProduct(entity->worldBoundingVolume()->center() - m_data.m_eyePos, m_data.m_eyeViewDir);
 
             environmentLight = m_environmentLight;
             lightSources = m_lightSources;
@@ -879,7 +1039,7 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
         } else { // Compute
             // Note: if frameCount has reached 0 in the previous frame, isEnabled
             // would be false
-            ComputeCommand *computeJob = m_manager->computeJobManager()->data(command.m_computeCommand);
+            ComputeCommand *computeJob = m_manager->computeJobManager()->data(buildData.m_computeCommand);
             if (computeJob->runType() == QComputeCommand::Manual)
                 computeJob->updateFrameCount();
         }
@@ -889,10 +1049,12 @@ void RenderView::updateRenderCommand(EntityRenderCommandData *renderCommandData,
         // make sure this is cleared before we leave this function
 
         setShaderAndUniforms(&command,
+                             &buildData,
                              globalParameters,
                              entity,
                              lightSources,
-                             environmentLight);
+                             environmentLight,
+                             materialPacks);
     }
 
     // We reset the local data once we are done with it
@@ -1006,35 +1168,91 @@ void RenderView::setShaderStorageValue(ShaderParameterPack &uniformPack,
     }
 }
 
-void RenderView::setDefaultUniformBlockShaderDataValue(ShaderParameterPack &uniformPack, GLShader *shader, ShaderData *shaderData, const QString &structName) const
+void RenderView::setDefaultUniformBlockShaderDataValue(ShaderParameterPack &uniformPack, GLShader *shader, ShaderData *shaderData, int structNameId) const
+{
+    ShaderDataManager *shaderDataManager = m_manager->shaderDataManager();
+    QSharedPointer<const ShaderDataUniformPlan> plan = shader->shaderDataUniformPlan(shaderData->peerId(), structNameId);
+
+    // Walk the ShaderData only if it or one of its nested ShaderData changed
+    if (plan.isNull() || !plan->isUpToDate(shaderDataManager, m_manager->textureManager())) {
+        QSharedPointer<ShaderDataUniformPlan> newPlan = QSharedPointer<ShaderDataUniformPlan>::create();
+
+        UniformBlockValueBuilder *builder = m_localData.localData();
+        builder->activeUniformNamesToValue.clear();
+        // Force to update the whole block
+        builder->updatedPropertiesOnly = false;
+        // Retrieve names and description of each active uniforms in the uniform block
+        builder->uniforms = shader->activeUniformsForUniformBlock(-1);
+        // Transformed properties are left to be evaluated for each use
+        builder->plan = newPlan.data();
+        // Build name-value map for the block
+        builder->buildActiveUniformNameValueMapStructHelper(shaderData, structNameId);
+        builder->plan = nullptr;
+
+        // TO DO: Make the ShaderData store UniformValue
+        newPlan->uniforms.reserve(builder->activeUniformNamesToValue.size());
+        for (auto it = builder->activeUniformNamesToValue.cbegin(), end = builder->activeUniformNamesToValue.cend(); it != end; ++it)
+            newPlan->uniforms.push_back({ it.key(), UniformValue::fromVariant(it.value()) });
+
+        shader->setShaderDataUniformPlan(shaderData->peerId(), structNameId, newPlan);
+        plan = newPlan;
+    }
+
+    for (const auto &uniform : plan->uniforms)
+        setUniformValue(uniformPack, uniform.first, uniform.second);
+
+    // The world matrix of lights is updated for each command
+    for (const ShaderDataUniformPlan::TransformedUniform &uniform : plan->transformedUniforms)
+        setUniformValue(uniformPack, uniform.nameId,
+                        UniformValue(uniform.shaderData->transformedVector(uniform.value, uniform.transformType, m_data.m_viewMatrix)));
+}
+
+void RenderView::setMaterialParameterValues(ShaderParameterPack &uniformPack,
+                                            GLShader *shader,
+                                            const ParameterInfoList &parameters) const
 {
-    UniformBlockValueBuilder *builder = m_localData.localData();
-    builder->activeUniformNamesToValue.clear();
-
-    // Set the view matrix to be used to transform "Transformed" properties in the ShaderData
-    builder->viewMatrix = m_data.m_viewMatrix;
-    // Force to update the whole block
-    builder->updatedPropertiesOnly = false;
-    // Retrieve names and description of each active uniforms in the uniform block
-    builder->uniforms = shader->activeUniformsForUniformBlock(-1);
-    // Build name-value map for the block
-    builder->buildActiveUniformNameValueMapStructHelper(shaderData, structName);
-    // Set uniform values for each entrie of the block name-value map
-    QHash<int, QVariant>::const_iterator activeValuesIt = builder->activeUniformNamesToValue.constBegin();
-    const QHash<int, QVariant>::const_iterator activeValuesEnd = builder->activeUniformNamesToValue.constEnd();
-
-    // TO DO: Make the ShaderData store UniformValue
-    while (activeValuesIt != activeValuesEnd) {
-        setUniformValue(uniformPack, activeValuesIt.key(), UniformValue::fromVariant(activeValuesIt.value()));
-        ++activeValuesIt;
+    const QVector<int> uniformNamesIds = shader->uniformsNamesIds();
+    const QVector<int> uniformBlockNamesIds = shader->uniformBlockNamesIds();
+    const QVector<int> shaderStorageBlockNamesIds = shader->storageBlockNamesIds();
+
+    // Parameters remaining could be
+    // -> uniform scalar / vector
+    // -> uniform struct / arrays
+    // -> uniform block / array (4.3)
+    // -> ssbo block / array (4.3)
+
+    ParameterInfoList::const_iterator it = parameters.cbegin();
+    const ParameterInfoList::const_iterator parametersEnd = parameters.cend();
+
+    while (it != parametersEnd) {
+        Parameter *param = m_manager->data<Parameter, ParameterManager>(it->handle);
+        const UniformValue &uniformValue = param->uniformValue();
+        if (uniformNamesIds.contains(it->nameId)) { // Parameter is a regular uniform
+            setUniformValue(uniformPack, it->nameId, uniformValue);
+        } else if (uniformBlockNamesIds.indexOf(it->nameId) != -1) { // Parameter is a uniform block
+            setUniformBlockValue(uniformPack, shader, shader->uniformBlockForBlockNameId(it->nameId), uniformValue);
+        } else if (shaderStorageBlockNamesIds.indexOf(it->nameId) != -1) { // Parameters is a SSBO
+            setShaderStorageValue(uniformPack, shader, shader->storageBlockForBlockNameId(it->nameId), uniformValue);
+        } else { // Parameter is a struct
+            ShaderData *shaderData = nullptr;
+            if (uniformValue.valueType() == UniformValue::NodeId &&
+                    (shaderData = m_manager->shaderDataManager()->lookupResource(*uniformValue.constData<Qt3DCore::QNodeId>())) != nullptr) {
+                // Try to check if we have a struct or array matching a QShaderData parameter
+                setDefaultUniformBlockShaderDataValue(uniformPack, shader, shaderData, it->nameId);
+            }
+            // Otherwise: param unused by current shader
+        }
+        ++it;
     }
 }
 
 void RenderView::setShaderAndUniforms(RenderCommand *command,
+                                      RenderCommandBuildData *buildData,
                                       ParameterInfoList &parameters,
                                       Entity *entity,
                                       const QVector<LightSource> &activeLightSources,
-                                      EnvironmentLight *environmentLight) const
+                                      EnvironmentLight *environmentLight,
+                                      MaterialParameterPacks &materialPacks) const
 {
     // The VAO Handle is set directly in the renderer thread so as to avoid having to use a mutex here
     // Set shader, technique, and effect by basically doing :
@@ -1054,7 +1272,6 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
         // equals to the parameter name
         const QVector<int> uniformNamesIds = shader->uniformsNamesIds();
         const QVector<int> standardUniformNamesIds = shader->standardUniformNameIds();
-        const QVector<int> uniformBlockNamesIds = shader->uniformBlockNamesIds();
         const QVector<int> shaderStorageBlockNamesIds = shader->storageBlockNamesIds();
         const QVector<int> attributeNamesIds = shader->attributeNamesIds();
 
@@ -1077,47 +1294,39 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
                 !attributeNamesIds.isEmpty() ||
                 !shaderStorageBlockNamesIds.isEmpty() || !attributeNamesIds.isEmpty()) {
 
+            // Set default attributes
+            buildData->m_activeAttributes = attributeNamesIds;
+
+            // At this point we know whether the command is a valid draw command or not
+            // We still need to process the uniforms as the command could be a compute command
+            command->m_isValid = !buildData->m_activeAttributes.empty();
+
+            // Values set from the material parameters only depend on the shader
+            // and on the parameters, they are built once and shared with the
+            // other commands using the same material pass
+            const MaterialParameterPackKey materialKey(shader, parameters.constData());
+            auto materialPackIt = materialPacks.constFind(materialKey);
+            if (materialPackIt == materialPacks.cend()) {
+                ShaderParameterPack materialPack;
+                setMaterialParameterValues(materialPack, shader, parameters);
+                materialPack.m_uniforms.share();
+                materialPackIt = materialPacks.insert(materialKey, materialPack);
+            }
+            command->m_parameterPack = *materialPackIt;
+
             // Set default standard uniforms without bindings
+            command->m_parameterPack.uniforms().reserve(standardUniformNamesIds.size());
             const Matrix4x4 worldTransform = *(entity->worldTransform());
 
             for (const int uniformNameId : standardUniformNamesIds)
                     setStandardUniformValue(command->m_parameterPack, uniformNameId, uniformNameId, entity, worldTransform);
 
-            // Set default attributes
-            command->m_activeAttributes = attributeNamesIds;
-
-            // At this point we know whether the command is a valid draw command or not
-            // We still need to process the uniforms as the command could be a compute command
-            command->m_isValid = !command->m_activeAttributes.empty();
-
-            // Parameters remaining could be
-            // -> uniform scalar / vector
-            // -> uniform struct / arrays
-            // -> uniform block / array (4.3)
-            // -> ssbo block / array (4.3)
-
-            ParameterInfoList::const_iterator it = parameters.cbegin();
-            const ParameterInfoList::const_iterator parametersEnd = parameters.cend();
-
-            while (it != parametersEnd) {
-                Parameter *param = m_manager->data<Parameter, ParameterManager>(it->handle);
-                const UniformValue &uniformValue = param->uniformValue();
-                if (uniformNamesIds.contains(it->nameId)) { // Parameter is a regular uniform
-                    setUniformValue(command->m_parameterPack, it->nameId, uniformValue);
-                } else if (uniformBlockNamesIds.indexOf(it->nameId) != -1) { // Parameter is a uniform block
-                    setUniformBlockValue(command->m_parameterPack, shader, shader->uniformBlockForBlockNameId(it->nameId), uniformValue);
-                } else if (shaderStorageBlockNamesIds.indexOf(it->nameId) != -1) { // Parameters is a SSBO
-                    setShaderStorageValue(command->m_parameterPack, shader, shader->storageBlockForBlockNameId(it->nameId), uniformValue);
-                } else { // Parameter is a struct
-                    ShaderData *shaderData = nullptr;
-                    if (uniformValue.valueType() == UniformValue::NodeId &&
-                            (shaderData = m_manager->shaderDataManager()->lookupResource(*uniformValue.constData<Qt3DCore::QNodeId>())) != nullptr) {
-                        // Try to check if we have a struct or array matching a QShaderData parameter
-                        setDefaultUniformBlockShaderDataValue(command->m_parameterPack, shader, shaderData, StringToInt::lookupString(it->nameId));
-                    }
-                    // Otherwise: param unused by current shader
-                }
-                ++it;
+            // Read from the qt3d_DrawData block rather than from uniforms, the
+            // commands of different entities can then be drawn together
+            if (shader->hasDrawData()) {
+                DrawData drawData;
+                memcpy(drawData.modelMatrix, UniformValue(worldTransform).constData<float>(), sizeof(drawData.modelMatrix));
+                command->m_parameterPack.setDrawData(drawData);
             }
 
             // Lights
@@ -1187,7 +1396,8 @@ void RenderView::setShaderAndUniforms(RenderCommand *command,
             if (environmentLight && environmentLight->isEnabled()) {
                 ShaderData *shaderData = m_manager->shaderDataManager()->lookupResource(environmentLight->shaderData());
                 if (shaderData) {
-                    setDefaultUniformBlockShaderDataValue(command->m_parameterPack, shader, shaderData, QStringLiteral("envLight"));
+                    static const int envLightId = StringToInt::lookupId(QLatin1String("envLight"));
+                    setDefaultUniformBlockShaderDataValue(command->m_parameterPack, shader, shaderData, envLightId);
                     envLightCount = 1;
                 }
             } else {
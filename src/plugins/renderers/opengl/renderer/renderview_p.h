@@ -228,9 +228,23 @@ public:
                              int offset, int count);
 
 
-    void setCommands(const QVector<RenderCommand> &commands) Q_DECL_NOTHROW { m_commands = commands; }
+    // buildData holds the build data of commands, at the same indices
+    void setCommands(const QVector<RenderCommand> &commands,
+                     const QVector<RenderCommandBuildData> &buildData) Q_DECL_NOTHROW
+    {
+        m_commands = commands;
+        m_commandsBuildData = buildData;
+    }
+    void setCommands(QVector<RenderCommand> &&commands,
+                     QVector<RenderCommandBuildData> &&buildData) Q_DECL_NOTHROW
+    {
+        m_commands = std::move(commands);
+        m_commandsBuildData = std::move(buildData);
+    }
     QVector<RenderCommand> &commands() { return m_commands; }
-    QVector<RenderCommand> commands() const { return m_commands; }
+    const QVector<RenderCommand> &commands() const { return m_commands; }
+    QVector<RenderCommandBuildData> &commandsBuildData() { return m_commandsBuildData; }
+    const QVector<RenderCommandBuildData> &commandsBuildData() const { return m_commandsBuildData; }
 
     void setAttachmentPack(const AttachmentPack &pack) { m_attachmentPack = pack; }
     const AttachmentPack &attachmentPack() const { return m_attachmentPack; }
@@ -292,11 +306,18 @@ public:
     bool shouldSkipSubmission() const;
 
 private:
+    // Packs holding the values set from the parameters of a material pass,
+    // keyed by shader and by the shared data of the parameter list
+    typedef QPair<GLShader *, const ParameterInfo *> MaterialParameterPackKey;
+    typedef QHash<MaterialParameterPackKey, ShaderParameterPack> MaterialParameterPacks;
+
     void setShaderAndUniforms(RenderCommand *command,
+                              RenderCommandBuildData *buildData,
                               ParameterInfoList &parameters,
                               Entity *entity,
                               const QVector<LightSource> &activeLightSources,
-                              EnvironmentLight *environmentLight) const;
+                              EnvironmentLight *environmentLight,
+                              MaterialParameterPacks &materialPacks) const;
     mutable QThreadStorage<UniformBlockValueBuilder*> m_localData;
 
     Qt3DCore::QNodeId m_renderCaptureNodeId;
@@ -334,6 +355,7 @@ private:
     QVector<WaitFence::Data> m_waitFences;
 
     QVector<RenderCommand> m_commands;
+    QVector<RenderCommandBuildData> m_commandsBuildData;
     mutable QVector<LightSource> m_lightSources;
     EnvironmentLight *m_environmentLight;
 
@@ -387,10 +409,13 @@ private:
                                GLShader *shader,
                                const ShaderStorageBlock &block,
                                const UniformValue &value) const;
+    void setMaterialParameterValues(ShaderParameterPack &uniformPack,
+                                    GLShader *shader,
+                                    const ParameterInfoList &parameters) const;
     void setDefaultUniformBlockShaderDataValue(ShaderParameterPack &uniformPack,
                                                GLShader *shader,
                                                ShaderData *shaderData,
-                                               const QString &structName) const;
+                                               int structNameId) const;
 };
 
 } // namespace OpenGL
@@ -39,6 +39,8 @@
 
 #include "renderviewbuilder_p.h"
 #include <Qt3DRender/private/qrenderaspect_p.h>
+#include <Qt3DRender/private/geometryrenderer_p.h>
+#include <Qt3DRender/private/geometry_p.h>
 
 #include <QThread>
 
@@ -64,17 +66,49 @@ int findIdealNumberOfWorkers(int elementCount, int packetSize = 100)
 }
 
 
+RendererCache::EntityCommandRevision commandRevisionForEntity(Entity *entity, NodeManagers *managers)
+{
+    RendererCache::EntityCommandRevision revision = {};
+    revision.entity = entity;
+    revision.geometryRenderer = entity->componentHandle<GeometryRenderer>();
+    const GeometryRenderer *geometryRenderer = managers->geometryRendererManager()->data(revision.geometryRenderer);
+    if (geometryRenderer != nullptr) {
+        revision.geometryRendererRevision = geometryRenderer->revision();
+        revision.geometryRendererEnabled = geometryRenderer->isEnabled();
+        if (!geometryRenderer->geometryId().isNull()) {
+            revision.geometry = managers->geometryManager()->lookupHandle(geometryRenderer->geometryId());
+            const Geometry *geometry = managers->geometryManager()->data(revision.geometry);
+            if (geometry != nullptr)
+                revision.geometryRevision = geometry->revision();
+        }
+    }
+    return revision;
+}
+
+bool isSameCommandRevision(const RendererCache::EntityCommandRevision &a,
+                           const RendererCache::EntityCommandRevision &b)
+{
+    return a.entity == b.entity
+            && a.geometryRenderer == b.geometryRenderer
+            && a.geometry == b.geometry
+            && a.geometryRendererRevision == b.geometryRendererRevision
+            && a.geometryRevision == b.geometryRevision
+            && a.geometryRendererEnabled == b.geometryRendererEnabled;
+}
+
 class SyncPreCommandBuilding
 {
 public:
     explicit SyncPreCommandBuilding(RenderViewInitializerJobPtr renderViewInitializerJob,
                                     const QVector<RenderViewCommandBuilderJobPtr> &renderViewCommandBuilderJobs,
                                     Renderer *renderer,
-                                    FrameGraphNode *leafNode)
+                                    FrameGraphNode *leafNode,
+                                    bool fullCommandRebuild)
         : m_renderViewInitializer(renderViewInitializerJob)
         , m_renderViewCommandBuilderJobs(renderViewCommandBuilderJobs)
         , m_renderer(renderer)
         , m_leafNode(leafNode)
+        , m_fullRebuild(fullCommandRebuild)
     {
     }
 
@@ -82,25 +116,56 @@ public:
     {
         // Split commands to build among jobs
         QMutexLocker lock(m_renderer->cache()->mutex());
-        // Rebuild RenderCommands for all entities in RV (ignoring filtering)
         RendererCache *cache = m_renderer->cache();
         const RendererCache::LeafNodeData &dataCacheForLeaf = cache->leafNodeCache[m_leafNode];
         RenderView *rv = m_renderViewInitializer->renderView();
-        const auto entities = !rv->isCompute() ? cache->renderableEntities : cache->computeEntities;
+        const bool isDraw = !rv->isCompute();
+        const auto entities = isDraw ? cache->renderableEntities : cache->computeEntities;
+        const QVector<RendererCache::EntityCommandRevision> previousRevisions = dataCacheForLeaf.renderCommandRevisions;
 
         rv->setMaterialParameterTable(dataCacheForLeaf.materialParameterGatherer);
 
         lock.unlock();
 
+        QVector<RendererCache::EntityCommandRevision> revisions;
+        if (isDraw && !rv->noDraw()) {
+            revisions.reserve(entities.size());
+            for (Entity *entity : entities)
+                revisions.push_back(commandRevisionForEntity(entity, m_renderer->nodeManagers()));
+        }
+
+        // On a full rebuild, commands are built for all entities in RV (ignoring filtering).
+        // Otherwise only entities whose geometry changed since the cached
+        // commands were built need new commands. We don't track what compute
+        // commands depend on, so those are always all rebuilt.
+        QVector<Entity *> entitiesToBuild;
+        if (m_fullRebuild || !isDraw) {
+            entitiesToBuild = entities;
+        } else {
+            // Both revision vectors are sorted by Entity
+            auto pIt = previousRevisions.cbegin();
+            const auto pEnd = previousRevisions.cend();
+            for (const RendererCache::EntityCommandRevision &revision : qAsConst(revisions)) {
+                while (pIt != pEnd && pIt->entity < revision.entity)
+                    ++pIt;
+                if (pIt == pEnd || !isSameCommandRevision(*pIt, revision))
+                    entitiesToBuild.push_back(revision.entity);
+            }
+        }
+
+        lock.relock();
+        cache->leafNodeCache[m_leafNode].renderCommandRevisions = std::move(revisions);
+        lock.unlock();
+
         // Split among the ideal number of command builders
-        const int idealPacketSize = std::min(std::max(100, entities.size() / RenderViewBuilder::optimalJobCount()), entities.size());
+        const int idealPacketSize = std::min(std::max(100, entitiesToBuild.size() / RenderViewBuilder::optimalJobCount()), entitiesToBuild.size());
         // Try to split work into an ideal number of workers
-        const int m = findIdealNumberOfWorkers(entities.size(), idealPacketSize);
+        const int m = findIdealNumberOfWorkers(entitiesToBuild.size(), idealPacketSize);
 
         for (int i = 0; i < m; ++i) {
             const RenderViewCommandBuilderJobPtr renderViewCommandBuilder = m_renderViewCommandBuilderJobs.at(i);
-            const int count = (i == m - 1) ? entities.size() - (i * idealPacketSize) : idealPacketSize;
-            renderViewCommandBuilder->setEntities(entities, i * idealPacketSize, count);
+            const int count = (i == m - 1) ? entitiesToBuild.size() - (i * idealPacketSize) : idealPacketSize;
+            renderViewCommandBuilder->setEntities(entitiesToBuild, i * idealPacketSize, count);
         }
     }
 
@@ -109,6 +174,7 @@ private:
     QVector<RenderViewCommandBuilderJobPtr> m_renderViewCommandBuilderJobs;
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
+    bool m_fullRebuild;
 };
 
 class SyncRenderViewPostCommandUpdate
@@ -130,8 +196,9 @@ public:
         const EntityRenderCommandDataPtr commandData = m_renderViewCommandUpdaterJobs.first()->renderables();
 
         if (commandData) {
-            const QVector<RenderCommand> commands = std::move(commandData->commands);
-            rv->setCommands(commands);
+            // Moved rather than shared, so that sorting doesn't detach a copy
+            rv->setCommands(std::move(commandData->commands),
+                            std::move(commandData->buildData));
 
             // TO DO: Find way to store commands once or at least only when required
             // Sort the commands
@@ -240,7 +307,8 @@ public:
                                             const QVector<RenderViewCommandBuilderJobPtr> &renderViewCommandBuilderJobs,
                                             Renderer *renderer,
                                             FrameGraphNode *leafNode,
-                                            bool fullCommandRebuild)
+                                            bool fullCommandRebuild,
+                                            bool incrementalCommandUpdate)
         : m_renderViewJob(renderViewJob)
         , m_frustumCullingJob(frustumCullingJob)
         , m_filterProximityJob(filterProximityJob)
@@ -250,6 +318,7 @@ public:
         , m_renderer(renderer)
         , m_leafNode(leafNode)
         , m_fullRebuild(fullCommandRebuild)
+        , m_incrementalUpdate(incrementalCommandUpdate)
     {}
 
     void operator()()
@@ -271,7 +340,7 @@ public:
             // Rebuild RenderCommands if required
             // This should happen fairly infrequently (FrameGraph Change, Geometry/Material change)
             // and allow to skip that step most of the time
-            if (m_fullRebuild) {
+            if (m_fullRebuild || m_incrementalUpdate) {
                 EntityRenderCommandData commandData;
                 // Reduction
                 {
@@ -286,7 +355,21 @@ public:
 
                 // Store new cache
                 RendererCache::LeafNodeData &writableCacheForLeaf = cache->leafNodeCache[m_leafNode];
-                writableCacheForLeaf.renderCommandData = std::move(commandData);
+                if (m_fullRebuild) {
+                    writableCacheForLeaf.renderCommandData = std::move(commandData);
+                } else {
+                    // Only some entities had their commands rebuilt, keep the
+                    // cached commands of the others
+                    QVector<Entity *> rebuiltEntities;
+                    for (const RenderViewCommandBuilderJobPtr &renderViewCommandBuilder : qAsConst(m_renderViewCommandBuilderJobs))
+                        rebuiltEntities += renderViewCommandBuilder->entities().mid(renderViewCommandBuilder->offset(),
+                                                                                  renderViewCommandBuilder->count());
+                    writableCacheForLeaf.renderCommandData =
+                            RenderViewBuilder::mergeRenderCommandData(std::move(writableCacheForLeaf.renderCommandData),
+                                                                      std::move(commandData),
+                                                                      rebuiltEntities,
+                                                                      isDraw ? cache->renderableEntities : cache->computeEntities);
+                }
             }
             const EntityRenderCommandData commandData = dataCacheForLeaf.renderCommandData;
             const QVector<Entity *> filteredEntities = dataCacheForLeaf.filterEntitiesByLayer;
@@ -345,6 +428,7 @@ public:
                 while (cIt != cEnd && commandData.entities.at(cIt) == targetEntity) {
                     filteredCommandData->push_back(commandData.entities.at(cIt),
                                                    commandData.commands.at(cIt),
+                                                   commandData.buildData.at(cIt),
                                                    commandData.passesData.at(cIt));
                     ++cIt;
                 }
@@ -374,6 +458,7 @@ private:
     Renderer *m_renderer;
     FrameGraphNode *m_leafNode;
     bool m_fullRebuild;
+    bool m_incrementalUpdate;
 };
 
 class SetClearDrawBufferIndex
@@ -466,6 +551,7 @@ RenderViewBuilder::RenderViewBuilder(Render::FrameGraphNode *leafNode, int rende
     , m_layerCacheNeedsToBeRebuilt(false)
     , m_materialGathererCacheNeedsToBeRebuilt(false)
     , m_renderCommandCacheNeedsToBeRebuilt(false)
+    , m_renderCommandCacheNeedsToBeUpdated(false)
     , m_renderViewJob(RenderViewInitializerJobPtr::create())
     , m_filterEntityByLayerJob()
     , m_frustumCullingJob(new Render::FrustumCullingJob())
@@ -556,8 +642,9 @@ void RenderViewBuilder::prepareJobs()
     // Init what we can here
     m_filterProximityJob->setManager(m_renderer->nodeManagers());
     m_frustumCullingJob->setRoot(m_renderer->sceneRoot());
+    m_frustumCullingJob->setManagers(m_renderer->nodeManagers());
 
-    if (m_renderCommandCacheNeedsToBeRebuilt) {
+    if (m_renderCommandCacheNeedsToBeRebuilt || m_renderCommandCacheNeedsToBeUpdated) {
 
         m_renderViewCommandBuilderJobs.reserve(RenderViewBuilder::m_optimalParallelJobCount);
         for (auto i = 0; i < RenderViewBuilder::m_optimalParallelJobCount; ++i) {
@@ -567,7 +654,8 @@ void RenderViewBuilder::prepareJobs()
         m_syncRenderViewPreCommandBuildingJob = CreateSynchronizerJobPtr(SyncPreCommandBuilding(m_renderViewJob,
                                                                                                   m_renderViewCommandBuilderJobs,
                                                                                                   m_renderer,
-                                                                                                  m_leafNode),
+                                                                                                  m_leafNode,
+                                                                                                  m_renderCommandCacheNeedsToBeRebuilt),
                                                                            JobTypes::SyncRenderViewPreCommandBuilding);
     }
 
@@ -622,7 +710,8 @@ void RenderViewBuilder::prepareJobs()
                                                                                                     m_renderViewCommandBuilderJobs,
                                                                                                     m_renderer,
                                                                                                     m_leafNode,
-                                                                                                    m_renderCommandCacheNeedsToBeRebuilt),
+                                                                                                    m_renderCommandCacheNeedsToBeRebuilt,
+                                                                                                    m_renderCommandCacheNeedsToBeUpdated),
                                                                      JobTypes::SyncRenderViewPreCommandUpdate);
 
     m_syncRenderViewPostCommandUpdateJob = CreateSynchronizerJobPtr(SyncRenderViewPostCommandUpdate(m_renderViewJob,
@@ -696,7 +785,7 @@ QVector<Qt3DCore::QAspectJobPtr> RenderViewBuilder::buildJobHierachy() const
 
     jobs.push_back(m_syncRenderViewPostInitializationJob); // Step 2
 
-    if (m_renderCommandCacheNeedsToBeRebuilt) { // Step 3
+    if (m_renderCommandCacheNeedsToBeRebuilt || m_renderCommandCacheNeedsToBeUpdated) { // Step 3
         m_syncRenderViewPreCommandBuildingJob->addDependency(m_renderer->computableEntityFilterJob());
         m_syncRenderViewPreCommandBuildingJob->addDependency(m_renderer->renderableEntityFilterJob());
         m_syncRenderViewPreCommandBuildingJob->addDependency(m_syncRenderViewPostInitializationJob);
@@ -793,6 +882,16 @@ bool RenderViewBuilder::renderCommandCacheNeedsToBeRebuilt() const
     return m_renderCommandCacheNeedsToBeRebuilt;
 }
 
+void RenderViewBuilder::setRenderCommandCacheNeedsToBeUpdated(bool needsToBeUpdated)
+{
+    m_renderCommandCacheNeedsToBeUpdated = needsToBeUpdated;
+}
+
+bool RenderViewBuilder::renderCommandCacheNeedsToBeUpdated() const
+{
+    return m_renderCommandCacheNeedsToBeUpdated;
+}
+
 int RenderViewBuilder::optimalJobCount()
 {
     return RenderViewBuilder::m_optimalParallelJobCount;
@@ -809,6 +908,47 @@ QVector<Entity *> RenderViewBuilder::entitiesInSubset(const QVector<Entity *> &e
     return intersection;
 }
 
+// Entities, rebuiltEntities, cachedData and rebuiltData are all sorted by Entity.
+// Commands of the entities in rebuiltEntities are taken from rebuiltData, the
+// others keep their cached commands. Entities no longer in entities are dropped.
+EntityRenderCommandData RenderViewBuilder::mergeRenderCommandData(EntityRenderCommandData &&cachedData,
+                                                                  EntityRenderCommandData &&rebuiltData,
+                                                                  const QVector<Entity *> &rebuiltEntities,
+                                                                  const QVector<Entity *> &entities)
+{
+    EntityRenderCommandData mergedData;
+    mergedData.reserve(std::max(cachedData.size(), rebuiltData.size()));
+
+    int cIt = 0;
+    int rIt = 0;
+    auto bIt = rebuiltEntities.cbegin();
+    const auto bEnd = rebuiltEntities.cend();
+
+    const auto takeCommands = [&mergedData] (EntityRenderCommandData &source, int &sIt, Entity *entity) {
+        const int sEnd = source.size();
+        while (sIt != sEnd && source.entities.at(sIt) < entity)
+            ++sIt;
+        while (sIt != sEnd && source.entities.at(sIt) == entity) {
+            mergedData.push_back(entity,
+                                 std::move(source.commands[sIt]),
+                                 std::move(source.buildData[sIt]),
+                                 source.passesData.at(sIt));
+            ++sIt;
+        }
+    };
+
+    for (Entity *entity : entities) {
+        while (bIt != bEnd && *bIt < entity)
+            ++bIt;
+        if (bIt != bEnd && *bIt == entity)
+            takeCommands(rebuiltData, rIt, entity);
+        else
+            takeCommands(cachedData, cIt, entity);
+    }
+
+    return mergedData;
+}
+
 } // OpenGL
 
 } // Render
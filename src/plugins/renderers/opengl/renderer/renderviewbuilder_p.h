@@ -111,9 +111,15 @@ public:
     bool materialGathererCacheNeedsToBeRebuilt() const;
     void setRenderCommandCacheNeedsToBeRebuilt(bool needsToBeRebuilt);
     bool renderCommandCacheNeedsToBeRebuilt() const;
+    void setRenderCommandCacheNeedsToBeUpdated(bool needsToBeUpdated);
+    bool renderCommandCacheNeedsToBeUpdated() const;
 
     static int optimalJobCount();
     static QVector<Entity *> entitiesInSubset(const QVector<Entity *> &entities, const QVector<Entity *> &subset);
+    static EntityRenderCommandData mergeRenderCommandData(EntityRenderCommandData &&cachedData,
+                                                          EntityRenderCommandData &&rebuiltData,
+                                                          const QVector<Entity *> &rebuiltEntities,
+                                                          const QVector<Entity *> &entities);
 
 private:
     Render::FrameGraphNode *m_leafNode;
@@ -122,6 +128,7 @@ private:
     bool m_layerCacheNeedsToBeRebuilt;
     bool m_materialGathererCacheNeedsToBeRebuilt;
     bool m_renderCommandCacheNeedsToBeRebuilt;
+    bool m_renderCommandCacheNeedsToBeUpdated;
 
     RenderViewInitializerJobPtr m_renderViewJob;
     FilterLayerEntityJobPtr m_filterEntityByLayerJob;
@@ -54,6 +54,98 @@ namespace Qt3DRender {
 namespace Render {
 namespace OpenGL {
 
+void PackUniformHash::reserve(int count)
+{
+    m_own.entries.reserve(count);
+    // Most uniforms are vectors or smaller
+    m_own.arena.reserve(4 * count);
+}
+
+void PackUniformHash::insert(int nameId, const UniformValue &value)
+{
+    m_own.insert(nameId, value);
+}
+
+void PackUniformHash::clear()
+{
+    m_shared = Layer();
+    m_own.entries.clear();
+    m_own.arena.clear();
+}
+
+UniformValue PackUniformHash::value(int nameId) const
+{
+    const Layer *layer = nullptr;
+    const Entry *entry = find(nameId, &layer);
+    if (entry != nullptr)
+        return layer->value(*entry);
+    return UniformValue();
+}
+
+UniformValue::ValueType PackUniformHash::valueType(int nameId) const
+{
+    const Layer *layer = nullptr;
+    const Entry *entry = find(nameId, &layer);
+    return entry != nullptr ? entry->valueType : UniformValue::ScalarValue;
+}
+
+bool PackUniformHash::contains(int nameId) const
+{
+    const Layer *layer = nullptr;
+    return find(nameId, &layer) != nullptr;
+}
+
+int PackUniformHash::size() const
+{
+    int count = 0;
+    forEachNameId([&count] (int) { ++count; return true; });
+    return count;
+}
+
+bool PackUniformHash::hasSameValue(int nameId, const PackUniformHash &other) const
+{
+    const Layer *layer = nullptr;
+    const Layer *otherLayer = nullptr;
+    const Entry *entry = find(nameId, &layer);
+    const Entry *otherEntry = other.find(nameId, &otherLayer);
+    if (entry == nullptr || otherEntry == nullptr || entry->size != otherEntry->size)
+        return false;
+    const float *data = layer->data(*entry);
+    return std::equal(data, data + entry->size, otherLayer->data(*otherEntry));
+}
+
+void PackUniformHash::share()
+{
+    if (m_own.entries.isEmpty())
+        return;
+    unshare();
+    m_shared = std::move(m_own);
+    m_own = Layer();
+}
+
+const PackUniformHash::Entry *PackUniformHash::find(int nameId, const Layer **layer) const
+{
+    const Entry *entry = m_own.find(nameId);
+    if (entry != nullptr) {
+        *layer = &m_own;
+        return entry;
+    }
+    *layer = &m_shared;
+    return m_shared.find(nameId);
+}
+
+// Copies the shared values the hash doesn't override into its own layer
+void PackUniformHash::unshare()
+{
+    if (m_shared.entries.isEmpty())
+        return;
+    for (const Entry &entry : qAsConst(m_shared.entries)) {
+        if (m_own.find(entry.nameId) == nullptr)
+            m_own.insert(entry.nameId, m_shared.value(entry));
+    }
+    m_shared = Layer();
+}
+
 ShaderParameterPack::~ShaderParameterPack()
 {
 }
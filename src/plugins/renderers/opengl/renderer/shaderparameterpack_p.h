@@ -54,6 +54,7 @@
 #include <QVariant>
 #include <QByteArray>
 #include <QVector>
+#include <algorithm>
 #include <QOpenGLShaderProgram>
 #include <Qt3DCore/qnodeid.h>
 #include <Qt3DRender/private/renderlogging_p.h>
@@ -86,56 +87,144 @@ struct BlockToSSBO {
 QT3D_DECLARE_TYPEINFO_3(Qt3DRender, Render, OpenGL, BlockToSSBO, Q_PRIMITIVE_TYPE)
 
 
-struct PackUniformHash
+// Uniform values are stored back to back in a float arena, their entries
+// are kept sorted by name id so that lookups are binary searches.
+// Values are split into two layers: the shared one holds the values set
+// from a material and is only ever copied implicitly between the packs of
+// the commands using that material, the other one holds the values of the
+// command itself and takes precedence over the shared one.
+class Q_AUTOTEST_EXPORT PackUniformHash
 {
-    QVector<int> keys;
-    QVector<UniformValue> values;
-
-    PackUniformHash()
+public:
+    void reserve(int count);
+    void insert(int nameId, const UniformValue &value);
+    void clear();
+
+    // Returns a default constructed value if nameId isn't found
+    UniformValue value(int nameId) const;
+    UniformValue::ValueType valueType(int nameId) const;
+    bool contains(int nameId) const;
+    int size() const;
+    bool isEmpty() const { return m_shared.entries.isEmpty() && m_own.entries.isEmpty(); }
+
+    // Whether both hashes hold nameId with the same value
+    bool hasSameValue(int nameId, const PackUniformHash &other) const;
+
+    // Moves the values into the shared layer, copies of the hash made
+    // afterwards reference them instead of copying them
+    void share();
+
+    // Calls visitor(nameId) in increasing name id order, stops as soon as
+    // the visitor returns false. Returns whether all name ids were visited
+    template<typename Visitor>
+    bool forEachNameId(Visitor visitor) const
     {
-        keys.reserve(10);
-        values.reserve(10);
+        auto shared = m_shared.entries.cbegin();
+        const auto sharedEnd = m_shared.entries.cend();
+        auto own = m_own.entries.cbegin();
+        const auto ownEnd = m_own.entries.cend();
+        while (shared != sharedEnd || own != ownEnd) {
+            int nameId;
+            if (own == ownEnd || (shared != sharedEnd && shared->nameId < own->nameId)) {
+                nameId = (shared++)->nameId;
+            } else {
+                if (shared != sharedEnd && shared->nameId == own->nameId)
+                    ++shared;
+                nameId = (own++)->nameId;
+            }
+            if (!visitor(nameId))
+                return false;
+        }
+        return true;
     }
 
-    void insert(int key, const UniformValue &value)
+    // Drops the values for which predicate(nameId, value) is true. Shared
+    // values are copied into the hash first
+    template<typename Predicate>
+    void removeIf(Predicate predicate)
     {
-        const int idx = keys.indexOf(key);
-        if (idx != -1) {
-            values[idx] = value;
-        } else {
-            keys.push_back(key);
-            values.push_back(value);
+        unshare();
+        Layer kept;
+        kept.entries.reserve(m_own.entries.size());
+        kept.arena.reserve(m_own.arena.size());
+        for (const Entry &entry : qAsConst(m_own.entries)) {
+            const UniformValue value = m_own.value(entry);
+            if (!predicate(entry.nameId, value))
+                kept.insert(entry.nameId, value);
         }
+        m_own = std::move(kept);
     }
 
-    UniformValue value(int key) const
+private:
+    struct Entry
     {
-        const int idx = keys.indexOf(key);
-        if (idx != -1)
-            return values.at(idx);
-        return UniformValue();
-    }
+        int nameId;
+        int offset; // In floats from the start of the arena
+        int size;   // In floats
+        UniformValue::ValueType valueType;
+        UniformType storedType;
+    };
 
-    UniformValue& value(int key)
+    struct Layer
     {
-        const int idx = keys.indexOf(key);
-        if (idx != -1)
-            return values[idx];
-        insert(key, UniformValue());
-        return value(key);
-    }
+        QVector<Entry> entries;
+        QVector<float> arena;
 
-    void erase(int idx)
-    {
-        keys.removeAt(idx);
-        values.removeAt(idx);
-    }
+        const Entry *find(int nameId) const
+        {
+            const auto it = std::lower_bound(entries.cbegin(), entries.cend(), nameId,
+                                             [] (const Entry &entry, int id) { return entry.nameId < id; });
+            if (it != entries.cend() && it->nameId == nameId)
+                return &*it;
+            return nullptr;
+        }
 
-    bool contains(int key) const
-    {
-        return keys.contains(key);
-    }
+        void insert(int nameId, const UniformValue &value)
+        {
+            const int size = value.byteSize() / int(sizeof(float));
+            const auto it = std::lower_bound(entries.begin(), entries.end(), nameId,
+                                             [] (const Entry &entry, int id) { return entry.nameId < id; });
+            int idx = int(it - entries.begin());
+            if (it == entries.end() || it->nameId != nameId)
+                entries.insert(idx, Entry { nameId, 0, 0, UniformValue::ScalarValue, UniformType::Unknown });
+            Entry &entry = entries[idx];
+
+            // A value of a different size gets a new slot at the end of the
+            // arena, the previous one is left unused until the hash is cleared
+            if (entry.size != size) {
+                entry.offset = arena.size();
+                entry.size = size;
+                arena.resize(arena.size() + size);
+            }
+            entry.valueType = value.valueType();
+            entry.storedType = value.storedType();
+            memcpy(arena.data() + entry.offset, value.constData<float>(), size * sizeof(float));
+        }
+
+        UniformValue value(const Entry &entry) const
+        {
+            UniformValue v(entry.size * int(sizeof(float)), entry.valueType, entry.storedType);
+            memcpy(v.data<float>(), data(entry), entry.size * sizeof(float));
+            return v;
+        }
+
+        const float *data(const Entry &entry) const { return arena.constData() + entry.offset; }
+    };
+
+    const Entry *find(int nameId, const Layer **layer) const;
+    void unshare();
+
+    Layer m_shared;
+    Layer m_own;
+};
+
+// Values specific to one draw, for shaders declaring a qt3d_DrawData
+// storage block. Laid out as one element of that block's std430 array
+struct DrawData
+{
+    float modelMatrix[16];
 };
+QT3D_DECLARE_TYPEINFO_3(Qt3DRender, Render, OpenGL, DrawData, Q_PRIMITIVE_TYPE)
 
 class Q_AUTOTEST_EXPORT ShaderParameterPack
 {
@@ -149,6 +238,7 @@ public:
     void setUniformBuffer(BlockToUBO blockToUBO);
     void setShaderStorageBuffer(BlockToSSBO blockToSSBO);
     void setSubmissionUniform(const ShaderUniform &uniform);
+    void setDrawData(const DrawData &drawData) { m_drawData = drawData; }
 
     inline PackUniformHash &uniforms() { return m_uniforms; }
     inline const PackUniformHash &uniforms() const { return m_uniforms; }
@@ -195,6 +285,7 @@ public:
     inline QVector<BlockToUBO> uniformBuffers() const { return m_uniformBuffers; }
     inline QVector<BlockToSSBO> shaderStorageBuffers() const { return m_shaderStorageBuffers; }
     inline QVector<ShaderUniform> submissionUniforms() const { return m_submissionUniforms; }
+    inline const DrawData &drawData() const { return m_drawData; }
 private:
     PackUniformHash m_uniforms;
 
@@ -203,6 +294,7 @@ private:
     QVector<BlockToUBO> m_uniformBuffers;
     QVector<BlockToSSBO> m_shaderStorageBuffers;
     QVector<ShaderUniform> m_submissionUniforms;
+    DrawData m_drawData = {};
 
     friend class RenderView;
 };
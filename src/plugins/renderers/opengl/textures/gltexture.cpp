@@ -53,6 +53,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/qabstracttexture_p.h>
 #include <Qt3DRender/private/qtextureimagedata_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
 #include <renderbuffer_p.h>
 
 #if !defined(QT_OPENGL_ES_2)
@@ -113,6 +114,8 @@ GLTexture::GLTexture()
     , m_renderBuffer(nullptr)
     , m_dataFunctor()
     , m_pendingDataFunctor(nullptr)
+    , m_textureDataManager(nullptr)
+    , m_textureImageDataManager(nullptr)
     , m_sharedTextureId(-1)
     , m_externalRendering(false)
     , m_wasTextureRecreated(false)
@@ -148,7 +151,9 @@ void GLTexture::destroy()
 
 bool GLTexture::loadTextureDataFromGenerator()
 {
-    m_textureData = m_dataFunctor->operator()();
+    m_textureData = m_textureDataManager != nullptr
+            ? m_textureDataManager->getData(m_dataFunctor)
+            : m_dataFunctor->operator()();
     // if there is a texture generator, most properties will be defined by it
     if (m_textureData) {
         const QAbstractTexture::Target target = m_textureData->target();
@@ -193,7 +198,9 @@ void GLTexture::loadTextureDataFromImages()
 {
     int maxMipLevel = 0;
     for (const Image &img : qAsConst(m_images)) {
-        const QTextureImageDataPtr imgData = img.generator->operator()();
+        const QTextureImageDataPtr imgData = m_textureImageDataManager != nullptr
+                ? m_textureImageDataManager->getData(img.generator)
+                : img.generator->operator()();
         // imgData may be null in the following cases:
         // - Texture is created with TextureImages which have yet to be
         // loaded (skybox where you don't yet know the path, source set by
@@ -229,6 +236,28 @@ void GLTexture::loadTextureDataFromImages()
     }
 }
 
+bool GLTexture::hasPendingImageData() const
+{
+    if (m_textureImageDataManager == nullptr)
+        return false;
+    for (const Image &img : m_images) {
+        if (m_textureImageDataManager->isPending(img.generator))
+            return true;
+    }
+    return false;
+}
+
+// Reports the status along with the current properties, marked as updated
+// when it differs from the status last reported to the frontend
+GLTexture::TextureUpdateInfo GLTexture::statusUpdateInfo(QAbstractTexture::Status status)
+{
+    TextureUpdateInfo textureInfo;
+    textureInfo.wasUpdated = m_properties.status != status;
+    m_properties.status = status;
+    textureInfo.properties = m_properties;
+    return textureInfo;
+}
+
 // Called from RenderThread
 GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
 {
@@ -241,6 +270,10 @@ GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
     if (!hasSharedTextureId) {
         // If dataFunctor exists and we have no data and it hasn´t run yet
         if (m_dataFunctor && !m_textureData && m_dataFunctor.get() != m_pendingDataFunctor ) {
+            // Wait for the generator to have been run by its job
+            if (m_textureDataManager != nullptr && m_textureDataManager->isPending(m_dataFunctor))
+                return statusUpdateInfo(QAbstractTexture::Loading);
+
             const bool successfullyLoadedTextureData = loadTextureDataFromGenerator();
             // If successful, m_textureData has content
             if (successfullyLoadedTextureData) {
@@ -251,14 +284,15 @@ GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
                     qWarning() << "[Qt3DRender::GLTexture] No QTextureData generated from Texture Generator yet. Texture will be invalid for this frame";
                     m_pendingDataFunctor = m_dataFunctor.get();
                 }
-                textureInfo.properties.status = QAbstractTexture::Loading;
-                return textureInfo;
+                return statusUpdateInfo(QAbstractTexture::Loading);
             }
         }
 
         // If images have changed, clear previous images data
         // and regenerate m_imageData for the images
         if (testDirtyFlag(TextureImageData)) {
+            if (hasPendingImageData())
+                return statusUpdateInfo(QAbstractTexture::Loading);
             m_imageData.clear();
             loadTextureDataFromImages();
             // Mark for upload if we actually have something to upload
@@ -296,7 +330,10 @@ GLTexture::TextureUpdateInfo GLTexture::createOrUpdateGLTexture()
             setDirtyFlag(TextureData, true);
     }
 
-    m_properties.status = QAbstractTexture::Ready;
+    if (m_properties.status != QAbstractTexture::Ready) {
+        m_properties.status = QAbstractTexture::Ready;
+        textureInfo.wasUpdated = true;
+    }
 
     if (testDirtyFlag(SharedTextureId) || hasSharedTextureId) {
         // Update m_properties by doing introspection on the texture
@@ -431,6 +468,13 @@ void GLTexture::setGenerator(const QTextureGeneratorPtr &generator)
     requestUpload();
 }
 
+void GLTexture::setDataManagers(TextureDataManager *textureDataManager,
+                                TextureImageDataManager *textureImageDataManager)
+{
+    m_textureDataManager = textureDataManager;
+    m_textureImageDataManager = textureImageDataManager;
+}
+
 void GLTexture::setSharedTextureId(int textureId)
 {
     if (m_sharedTextureId != textureId) {
@@ -208,6 +208,11 @@ public:
     void setSharedTextureId(int textureId);
     void addTextureDataUpdates(const QVector<QTextureDataUpdate> &updates);
 
+    // When set, the generators are expected to be registered with and run
+    // through these managers rather than being called by the GLTexture
+    void setDataManagers(TextureDataManager *textureDataManager,
+                         TextureImageDataManager *textureImageDataManager);
+
     QVector<QTextureDataUpdate> textureDataUpdates() const { return m_pendingTextureDataUpdates; }
     QTextureGeneratorPtr dataGenerator() const { return m_dataFunctor; }
 
@@ -235,6 +240,8 @@ private:
     QOpenGLTexture *buildGLTexture();
     bool loadTextureDataFromGenerator();
     void loadTextureDataFromImages();
+    bool hasPendingImageData() const;
+    TextureUpdateInfo statusUpdateInfo(QAbstractTexture::Status status);
     void uploadGLTextureData();
     void updateGLTextureParameters();
     void introspectPropertiesFromSharedTextureId();
@@ -253,6 +260,9 @@ private:
     QTextureGenerator *m_pendingDataFunctor;
     QVector<Image> m_images;
 
+    TextureDataManager *m_textureDataManager;
+    TextureImageDataManager *m_textureImageDataManager;
+
     // cache actual image data generated by the functors
     QTextureDataPtr m_textureData;
     QVector<QTextureImageDataPtr> m_imageData;
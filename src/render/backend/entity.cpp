@@ -74,6 +74,19 @@ using namespace Qt3DCore;
 namespace Qt3DRender {
 namespace Render {
 
+namespace {
+
+template<typename Manager, typename Handle>
+void resolveHandles(Manager *manager, const QNodeIdVector &ids, QVector<Handle> &handles)
+{
+    handles.clear();
+    handles.reserve(ids.size());
+    for (const QNodeId id : ids)
+        handles.push_back(manager->lookupHandle(id));
+}
+
+} // anonymous
+
 
 EntityPrivate::EntityPrivate()
     : Qt3DCore::QBackendNodePrivate(Entity::ReadOnly)
@@ -103,6 +116,8 @@ Entity::Entity()
     : BackendNode(*new EntityPrivate)
     , m_nodeManagers(nullptr)
     , m_boundingDirty(false)
+    , m_transformDirty(false)
+    , m_transformDirtyChildren(false)
     , m_treeEnabled(true)
 {
 }
@@ -134,6 +149,8 @@ void Entity::cleanup()
     // Release all component will have to perform their own release when they receive the
     // NodeDeleted notification
     // Clear components
+    if (m_nodeManagers && !m_transformComponent.isNull())
+        m_nodeManagers->renderNodesManager()->removeTransformReference(m_transformComponent, m_handle);
     m_transformComponent = Qt3DCore::QNodeId();
     m_cameraComponent = Qt3DCore::QNodeId();
     m_materialComponent = Qt3DCore::QNodeId();
@@ -149,11 +166,14 @@ void Entity::cleanup()
     m_shaderDataComponents.clear();
     m_lightComponents.clear();
     m_environmentLightComponents.clear();
+    resolveComponentHandles();
     m_localBoundingVolume.reset();
     m_worldBoundingVolume.reset();
     m_worldBoundingVolumeWithChildren.reset();
     m_parentHandle = {};
     m_boundingDirty = false;
+    m_transformDirty = false;
+    m_transformDirtyChildren = false;
     QBackendNode::setEnabled(false);
 
     // Ensure we rebuild caches when an Entity gets cleaned up
@@ -192,8 +212,10 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     if (!node)
         return;
 
+    bool transformDirty = firstTime;
     if (this->isEnabled() != node->isEnabled()) {
-        markDirty(AbstractRenderer::EntityEnabledDirty);
+        markDirty(AbstractRenderer::EntityEnabledDirty|AbstractRenderer::TransformDirty);
+        transformDirty = true;
         // We let QBackendNode::syncFromFrontEnd change the enabled property
     }
 
@@ -207,6 +229,7 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
 
     if (parentHandle != m_parentHandle) {
         markDirty(AbstractRenderer::AllDirty);
+        transformDirty = true;
     }
 
     setParentHandle(parentHandle);
@@ -237,8 +260,18 @@ void Entity::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
             const auto idAndType = QNodeIdTypePair(c->id(), QNodePrivate::findStaticMetaObject(c->metaObject()));
             addComponent(idAndType);
         }
+
+        // The backend nodes of our components are created after us, resolve
+        // their handles once the whole subtree exists
+        if (!components.isEmpty())
+            m_nodeManagers->renderNodesManager()->addPendingComponentHandles(m_handle);
     }
 
+    // Needs to happen after the parent handle has been set so that
+    // ancestors get flagged as well
+    if (transformDirty)
+        markTransformDirty();
+
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
 }
 
@@ -316,7 +349,14 @@ void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
     const auto id = idAndType.id;
     qCDebug(Render::RenderNodes) << Q_FUNC_INFO << "id =" << id << type->className();
     if (type->inherits(&Qt3DCore::QTransform::staticMetaObject)) {
+        if (m_nodeManagers) {
+            EntityManager *entityManager = m_nodeManagers->renderNodesManager();
+            if (!m_transformComponent.isNull())
+                entityManager->removeTransformReference(m_transformComponent, m_handle);
+            entityManager->addTransformReference(id, m_handle);
+        }
         m_transformComponent = id;
+        markTransformDirty();
     } else if (type->inherits(&QCameraLens::staticMetaObject)) {
         m_cameraComponent = id;
     } else if (type->inherits(&QLayer::staticMetaObject)) {
@@ -347,13 +387,17 @@ void Entity::addComponent(Qt3DCore::QNodeIdTypePair idAndType)
     } else if (type->inherits(&QArmature::staticMetaObject)) {
         m_armatureComponent = id;
     }
+    resolveComponentHandles();
     markDirty(AbstractRenderer::AllDirty);
 }
 
 void Entity::removeComponent(Qt3DCore::QNodeId nodeId)
 {
     if (m_transformComponent == nodeId) {
+        if (m_nodeManagers)
+            m_nodeManagers->renderNodesManager()->removeTransformReference(nodeId, m_handle);
         m_transformComponent = QNodeId();
+        markTransformDirty();
     } else if (m_cameraComponent == nodeId) {
         m_cameraComponent = QNodeId();
     } else if (m_layerComponents.contains(nodeId)) {
@@ -382,9 +426,46 @@ void Entity::removeComponent(Qt3DCore::QNodeId nodeId)
     } else if (m_armatureComponent == nodeId) {
         m_armatureComponent = QNodeId();
     }
+    resolveComponentHandles();
     markDirty(AbstractRenderer::AllDirty);
 }
 
+// Called whenever the components change and, for new entities, before the
+// next frame's jobs are scheduled. Never while jobs are running.
+void Entity::resolveComponentHandles()
+{
+    if (m_nodeManagers == nullptr) {
+        m_transformHandle = HTransform();
+        m_materialHandle = HMaterial();
+        m_cameraHandle = HCamera();
+        m_geometryRendererHandle = HGeometryRenderer();
+        m_objectPickerHandle = HObjectPicker();
+        m_computeHandle = HComputeCommand();
+        m_armatureHandle = HArmature();
+        m_layerHandles = QVector<HLayer>(m_layerComponents.size());
+        m_levelOfDetailHandles = QVector<HLevelOfDetail>(m_levelOfDetailComponents.size());
+        m_rayCasterHandles = QVector<HRayCaster>(m_rayCasterComponents.size());
+        m_shaderDataHandles = QVector<HShaderData>(m_shaderDataComponents.size());
+        m_lightHandles = QVector<HLight>(m_lightComponents.size());
+        m_environmentLightHandles = QVector<HEnvironmentLight>(m_environmentLightComponents.size());
+        return;
+    }
+
+    m_transformHandle = m_nodeManagers->transformManager()->lookupHandle(m_transformComponent);
+    m_materialHandle = m_nodeManagers->materialManager()->lookupHandle(m_materialComponent);
+    m_cameraHandle = m_nodeManagers->cameraManager()->lookupHandle(m_cameraComponent);
+    m_geometryRendererHandle = m_nodeManagers->geometryRendererManager()->lookupHandle(m_geometryRendererComponent);
+    m_objectPickerHandle = m_nodeManagers->objectPickerManager()->lookupHandle(m_objectPickerComponent);
+    m_computeHandle = m_nodeManagers->computeJobManager()->lookupHandle(m_computeComponent);
+    m_armatureHandle = m_nodeManagers->armatureManager()->lookupHandle(m_armatureComponent);
+    resolveHandles(m_nodeManagers->layerManager(), m_layerComponents, m_layerHandles);
+    resolveHandles(m_nodeManagers->levelOfDetailManager(), m_levelOfDetailComponents, m_levelOfDetailHandles);
+    resolveHandles(m_nodeManagers->rayCasterManager(), m_rayCasterComponents, m_rayCasterHandles);
+    resolveHandles(m_nodeManagers->shaderDataManager(), m_shaderDataComponents, m_shaderDataHandles);
+    resolveHandles(m_nodeManagers->lightManager(), m_lightComponents, m_lightHandles);
+    resolveHandles(m_nodeManagers->environmentLightManager(), m_environmentLightComponents, m_environmentLightHandles);
+}
+
 bool Entity::isBoundingVolumeDirty() const
 {
     return m_boundingDirty;
@@ -395,6 +476,26 @@ void Entity::unsetBoundingVolumeDirty()
     m_boundingDirty = false;
 }
 
+// Flags this entity as requiring its world transform (and therefore the world
+// transforms of its whole subtree) to be recomputed. Ancestors are flagged as
+// having dirty children so that UpdateWorldTransformJob can skip clean subtrees.
+void Entity::markTransformDirty()
+{
+    m_transformDirty = true;
+
+    Entity *p = parent();
+    while (p != nullptr && !p->m_transformDirtyChildren) {
+        p->m_transformDirtyChildren = true;
+        p = p->parent();
+    }
+}
+
+void Entity::unsetTransformDirty()
+{
+    m_transformDirty = false;
+    m_transformDirtyChildren = false;
+}
+
 void Entity::addRecursiveLayerId(const QNodeId layerId)
 {
     if (!m_recursiveLayerComponents.contains(layerId) && !m_layerComponents.contains(layerId))
@@ -406,19 +507,19 @@ void Entity::removeRecursiveLayerId(const QNodeId layerId)
     m_recursiveLayerComponents.removeOne(layerId);
 }
 
-ENTITY_COMPONENT_TEMPLATE_IMPL(Material, HMaterial, MaterialManager, m_materialComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(CameraLens, HCamera, CameraManager, m_cameraComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(Transform, HTransform, TransformManager, m_transformComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(GeometryRenderer, HGeometryRenderer, GeometryRendererManager, m_geometryRendererComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(ObjectPicker, HObjectPicker, ObjectPickerManager, m_objectPickerComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(ComputeCommand, HComputeCommand, ComputeCommandManager, m_computeComponent)
-ENTITY_COMPONENT_TEMPLATE_IMPL(Armature, HArmature, ArmatureManager, m_armatureComponent)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Layer, HLayer, LayerManager, m_layerComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(LevelOfDetail, HLevelOfDetail, LevelOfDetailManager, m_levelOfDetailComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(RayCaster, HRayCaster, RayCasterManager, m_rayCasterComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(ShaderData, HShaderData, ShaderDataManager, m_shaderDataComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Light, HLight, LightManager, m_lightComponents)
-ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(EnvironmentLight, HEnvironmentLight, EnvironmentLightManager, m_environmentLightComponents)
+ENTITY_COMPONENT_TEMPLATE_IMPL(Material, HMaterial, MaterialManager, m_materialComponent, m_materialHandle)
+ENTITY_COMPONENT_TEMPLATE_IMPL(CameraLens, HCamera, CameraManager, m_cameraComponent, m_cameraHandle)
+ENTITY_COMPONENT_TEMPLATE_IMPL(Transform, HTransform, TransformManager, m_transformComponent, m_transformHandle)
+ENTITY_COMPONENT_TEMPLATE_IMPL(GeometryRenderer, HGeometryRenderer, GeometryRendererManager, m_geometryRendererComponent, m_geometryRendererHandle)
+ENTITY_COMPONENT_TEMPLATE_IMPL(ObjectPicker, HObjectPicker, ObjectPickerManager, m_objectPickerComponent, m_objectPickerHandle)
+ENTITY_COMPONENT_TEMPLATE_IMPL(ComputeCommand, HComputeCommand, ComputeCommandManager, m_computeComponent, m_computeHandle)
+ENTITY_COMPONENT_TEMPLATE_IMPL(Armature, HArmature, ArmatureManager, m_armatureComponent, m_armatureHandle)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Layer, HLayer, LayerManager, m_layerComponents, m_layerHandles)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(LevelOfDetail, HLevelOfDetail, LevelOfDetailManager, m_levelOfDetailComponents, m_levelOfDetailHandles)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(RayCaster, HRayCaster, RayCasterManager, m_rayCasterComponents, m_rayCasterHandles)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(ShaderData, HShaderData, ShaderDataManager, m_shaderDataComponents, m_shaderDataHandles)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Light, HLight, LightManager, m_lightComponents, m_lightHandles)
+ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(EnvironmentLight, HEnvironmentLight, EnvironmentLightManager, m_environmentLightComponents, m_environmentLightHandles)
 
 RenderEntityFunctor::RenderEntityFunctor(AbstractRenderer *renderer, NodeManagers *manager)
     : m_nodeManagers(manager)
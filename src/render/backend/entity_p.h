@@ -119,6 +119,11 @@ public:
     bool isBoundingVolumeDirty() const;
     void unsetBoundingVolumeDirty();
 
+    void markTransformDirty();
+    bool isTransformDirty() const { return m_transformDirty; }
+    bool hasTransformDirtyChildren() const { return m_transformDirtyChildren; }
+    void unsetTransformDirty();
+
     void setTreeEnabled(bool enabled) { m_treeEnabled = enabled; }
     bool isTreeEnabled() const { return m_treeEnabled; }
 
@@ -175,6 +180,8 @@ public:
         return containsComponentsOfType<T>() && containsComponentsOfType<Ts, Ts2...>();
     }
 
+    void resolveComponentHandles();
+
 protected:
     Q_DECLARE_PRIVATE(Entity)
 
@@ -205,11 +212,31 @@ private:
     Qt3DCore::QNodeId m_computeComponent;
     Qt3DCore::QNodeId m_armatureComponent;
 
+    // Component handles resolved whenever the components change, so that
+    // jobs don't need to look them up by id every frame
+    HTransform m_transformHandle;
+    HMaterial m_materialHandle;
+    HCamera m_cameraHandle;
+    QVector<HLayer> m_layerHandles;
+    QVector<HLevelOfDetail> m_levelOfDetailHandles;
+    QVector<HRayCaster> m_rayCasterHandles;
+    QVector<HShaderData> m_shaderDataHandles;
+    QVector<HLight> m_lightHandles;
+    QVector<HEnvironmentLight> m_environmentLightHandles;
+    HGeometryRenderer m_geometryRendererHandle;
+    HObjectPicker m_objectPickerHandle;
+    HComputeCommand m_computeHandle;
+    HArmature m_armatureHandle;
+
     // Includes recursive layers
     Qt3DCore::QNodeIdVector m_recursiveLayerComponents;
 
     QString m_objectName;
     bool m_boundingDirty;
+    // Hierarchical transform dirtiness: set on the entity whose world transform
+    // needs recomputing and on all its ancestors as m_transformDirtyChildren
+    bool m_transformDirty;
+    bool m_transformDirtyChildren;
     // true only if this and all parent nodes are enabled
     bool m_treeEnabled;
 };
@@ -237,17 +264,24 @@ private:
     template<> \
     Q_3DRENDERSHARED_PRIVATE_EXPORT Qt3DCore::QNodeIdVector Entity::componentsUuid<Type>() const;
 
-#define ENTITY_COMPONENT_TEMPLATE_IMPL(Type, Handle, Manager, variable) \
+// The cached handle is checked against the manager generation; should the
+// component have been released since the handle was resolved we fall back to
+// the id lookup
+#define ENTITY_COMPONENT_TEMPLATE_IMPL(Type, Handle, Manager, variable, handleVariable) \
     /* Handle */ \
     template<> \
     Handle Entity::componentHandle<Type>() const \
     { \
+        if (handleVariable.data() != nullptr) \
+            return handleVariable; \
         return m_nodeManagers->lookupHandle<Type, Manager, Handle>(variable); \
     } \
     /* Component */ \
     template<> \
     Type *Entity::renderComponent<Type>() const \
     { \
+        if (Type *component = handleVariable.data()) \
+            return component; \
         return m_nodeManagers->lookupResource<Type, Manager>(variable); \
     } \
     /* Uuid */ \
@@ -257,7 +291,7 @@ private:
         return variable; \
     }
 
-#define ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Type, Handle, Manager, variable) \
+#define ENTITY_COMPONENT_LIST_TEMPLATE_IMPL(Type, Handle, Manager, variable, handleVariable) \
     /* Handle */ \
     template<> \
     QVector<Handle> Entity::componentsHandle<Type>() const \
@@ -265,10 +299,12 @@ private:
         Manager *manager = m_nodeManagers->manager<Type, Manager>(); \
         QVector<Handle> entries; \
         entries.reserve(variable.size()); \
-        for (const QNodeId id : variable) \
-            entries.push_back(manager->lookupHandle(id)); \
-        return entries; \
+        for (int i = 0, m = variable.size(); i < m; ++i) { \
+            const Handle handle = handleVariable.at(i); \
+            entries.push_back(handle.data() != nullptr ? handle : manager->lookupHandle(variable.at(i))); \
         } \
+        return entries; \
+    } \
     /* Component */ \
     template<> \
     QVector<Type *> Entity::renderComponents<Type>() const \
@@ -276,8 +312,10 @@ private:
         Manager *manager = m_nodeManagers->manager<Type, Manager>(); \
         QVector<Type *> entries; \
         entries.reserve(variable.size()); \
-        for (const QNodeId id : variable) \
-            entries.push_back(manager->lookupResource(id)); \
+        for (int i = 0, m = variable.size(); i < m; ++i) { \
+            Type *component = handleVariable.at(i).data(); \
+            entries.push_back(component != nullptr ? component : manager->lookupResource(variable.at(i))); \
+        } \
         return entries; \
     } \
     /* Uuid */ \
@@ -0,0 +1,495 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "entityspatialindex_p.h"
+
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+
+#include <algorithm>
+#include <cfloat>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace Render {
+
+namespace {
+
+// Leaves are enlarged by this fraction of their half extent
+const float LeafMargin = 0.1f;
+
+using Aabb = EntitySpatialIndex::Aabb;
+
+Aabb merged(const Aabb &a, const Aabb &b)
+{
+    Aabb box;
+    for (int i = 0; i < 3; ++i) {
+        box.min[i] = std::min(a.min[i], b.min[i]);
+        box.max[i] = std::max(a.max[i], b.max[i]);
+    }
+    return box;
+}
+
+bool contains(const Aabb &outer, const Aabb &inner)
+{
+    for (int i = 0; i < 3; ++i) {
+        if (inner.min[i] < outer.min[i] || inner.max[i] > outer.max[i])
+            return false;
+    }
+    return true;
+}
+
+float area(const Aabb &box)
+{
+    const float dx = box.max[0] - box.min[0];
+    const float dy = box.max[1] - box.min[1];
+    const float dz = box.max[2] - box.min[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+Aabb enlarged(const Aabb &box)
+{
+    Aabb fat;
+    for (int i = 0; i < 3; ++i) {
+        const float margin = (box.max[i] - box.min[i]) * 0.5f * LeafMargin;
+        fat.min[i] = box.min[i] - margin;
+        fat.max[i] = box.max[i] + margin;
+    }
+    return fat;
+}
+
+// Whether a leaf box became much larger than what its entity needs
+bool isLoose(const Aabb &fat, const Aabb &box)
+{
+    for (int i = 0; i < 3; ++i) {
+        const float extent = box.max[i] - box.min[i];
+        if (fat.max[i] - fat.min[i] > 2.0f * extent * (1.0f + LeafMargin) + FLT_EPSILON)
+            return true;
+    }
+    return false;
+}
+
+} // anonymous
+
+EntitySpatialIndex::EntitySpatialIndex(EntityManager *manager)
+    : m_manager(manager)
+    , m_sceneRoot(nullptr)
+    , m_rootNode(NullNode)
+    , m_freeList(NullNode)
+    , m_stamp(0)
+{
+}
+
+void EntitySpatialIndex::clear()
+{
+    m_nodes.clear();
+    m_leaves.clear();
+    m_spheres = SphereArrays();
+    m_sceneRoot = nullptr;
+    m_rootNode = NullNode;
+    m_freeList = NullNode;
+}
+
+void EntitySpatialIndex::update(Entity *root)
+{
+    if (root != m_sceneRoot) {
+        clear();
+        m_sceneRoot = root;
+    }
+    if (root == nullptr)
+        return;
+
+    // Keeps the capacity from the previous update
+    m_spheres.entities.resize(0);
+    m_spheres.centersX.resize(0);
+    m_spheres.centersY.resize(0);
+    m_spheres.centersZ.resize(0);
+    m_spheres.radii.resize(0);
+
+    ++m_stamp;
+    root->traverse([this] (Entity *entity) {
+        const Sphere &sphere = *entity->worldBoundingVolumeWithChildren();
+        const Vector3D center = sphere.center();
+        m_spheres.entities.push_back(entity);
+        m_spheres.centersX.push_back(center.x());
+        m_spheres.centersY.push_back(center.y());
+        m_spheres.centersZ.push_back(center.z());
+        m_spheres.radii.push_back(sphere.radius());
+
+        const Aabb box = boxForSphere(sphere);
+        int leaf = m_leaves.value(entity, NullNode);
+        if (leaf == NullNode) {
+            leaf = allocateNode();
+            m_nodes[leaf].box = enlarged(box);
+            insertLeaf(leaf);
+            m_leaves.insert(entity, leaf);
+        } else if (!contains(m_nodes.at(leaf).box, box) || isLoose(m_nodes.at(leaf).box, box)) {
+            removeLeaf(leaf);
+            m_nodes[leaf].box = enlarged(box);
+            insertLeaf(leaf);
+        }
+        Node &node = m_nodes[leaf];
+        node.entity = entity->handle();
+        node.stamp = m_stamp;
+    });
+
+    // Drop the entities that are no longer part of the scene
+    for (auto it = m_leaves.begin(); it != m_leaves.end();) {
+        const int leaf = it.value();
+        if (m_nodes.at(leaf).stamp != m_stamp) {
+            removeLeaf(leaf);
+            freeNode(leaf);
+            it = m_leaves.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool EntitySpatialIndex::coversAllEntities() const
+{
+    return m_sceneRoot != nullptr && m_leaves.size() == m_manager->count();
+}
+
+Entity *EntitySpatialIndex::entityAt(const Node &node) const
+{
+    return m_manager->data(node.entity);
+}
+
+EntitySpatialIndex::Aabb EntitySpatialIndex::boxForSphere(const Sphere &sphere)
+{
+    // Null spheres have a negative radius, keep their center
+    const float radius = std::max(sphere.radius(), 0.0f);
+    const Vector3D center = sphere.center();
+    Aabb box;
+    for (int i = 0; i < 3; ++i) {
+        box.min[i] = center[i] - radius;
+        box.max[i] = center[i] + radius;
+    }
+    return box;
+}
+
+bool EntitySpatialIndex::overlaps(const Aabb &a, const Aabb &b)
+{
+    for (int i = 0; i < 3; ++i) {
+        if (a.max[i] < b.min[i] || a.min[i] > b.max[i])
+            return false;
+    }
+    return true;
+}
+
+EntitySpatialIndex::RayQuery::RayQuery(const RayCasting::QRay3D &ray)
+{
+    const Vector3D o = ray.origin();
+    const Vector3D d = ray.direction();
+    for (int i = 0; i < 3; ++i) {
+        origin[i] = o[i];
+        parallel[i] = qFuzzyIsNull(d[i]);
+        invDirection[i] = parallel[i] ? 0.0f : 1.0f / d[i];
+    }
+}
+
+bool EntitySpatialIndex::RayQuery::intersects(const Aabb &box) const
+{
+    float tmin = 0.0f;
+    float tmax = FLT_MAX;
+    for (int i = 0; i < 3; ++i) {
+        if (parallel[i]) {
+            if (origin[i] < box.min[i] || origin[i] > box.max[i])
+                return false;
+            continue;
+        }
+        float t1 = (box.min[i] - origin[i]) * invDirection[i];
+        float t2 = (box.max[i] - origin[i]) * invDirection[i];
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax)
+            return false;
+    }
+    return true;
+}
+
+int EntitySpatialIndex::allocateNode()
+{
+    int nodeIndex;
+    if (m_freeList != NullNode) {
+        nodeIndex = m_freeList;
+        m_freeList = m_nodes.at(nodeIndex).parent;
+    } else {
+        nodeIndex = m_nodes.size();
+        m_nodes.push_back(Node());
+    }
+
+    Node &node = m_nodes[nodeIndex];
+    node.parent = NullNode;
+    node.child1 = NullNode;
+    node.child2 = NullNode;
+    node.height = 0;
+    node.entity = HEntity();
+    node.stamp = 0;
+    return nodeIndex;
+}
+
+void EntitySpatialIndex::freeNode(int nodeIndex)
+{
+    Node &node = m_nodes[nodeIndex];
+    node.parent = m_freeList;
+    node.height = -1;
+    node.entity = HEntity();
+    m_freeList = nodeIndex;
+}
+
+// Picks the sibling that minimizes the growth of the tree surface area,
+// then walks back up refitting and rebalancing the ancestors
+void EntitySpatialIndex::insertLeaf(int leaf)
+{
+    if (m_rootNode == NullNode) {
+        m_rootNode = leaf;
+        m_nodes[leaf].parent = NullNode;
+        return;
+    }
+
+    const Aabb leafBox = m_nodes.at(leaf).box;
+    int index = m_rootNode;
+    while (!m_nodes.at(index).isLeaf()) {
+        const Node &node = m_nodes.at(index);
+        const float nodeArea = area(node.box);
+        const float combinedArea = area(merged(node.box, leafBox));
+
+        // Cost of making a new parent for this node and the leaf
+        const float cost = 2.0f * combinedArea;
+        // Minimum cost of pushing the leaf further down the tree
+        const float inheritanceCost = 2.0f * (combinedArea - nodeArea);
+
+        const auto descendCost = [&] (int childIndex) {
+            const Node &child = m_nodes.at(childIndex);
+            const float grownArea = area(merged(leafBox, child.box));
+            if (child.isLeaf())
+                return grownArea + inheritanceCost;
+            return grownArea - area(child.box) + inheritanceCost;
+        };
+        const float cost1 = descendCost(node.child1);
+        const float cost2 = descendCost(node.child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    const int sibling = index;
+    const int oldParent = m_nodes.at(sibling).parent;
+    const int newParent = allocateNode();
+    {
+        Node &parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.box = merged(leafBox, m_nodes.at(sibling).box);
+        parent.height = m_nodes.at(sibling).height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+    }
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent != NullNode) {
+        Node &grandParent = m_nodes[oldParent];
+        if (grandParent.child1 == sibling)
+            grandParent.child1 = newParent;
+        else
+            grandParent.child2 = newParent;
+    } else {
+        m_rootNode = newParent;
+    }
+
+    index = m_nodes.at(leaf).parent;
+    while (index != NullNode) {
+        index = balance(index);
+        Node &node = m_nodes[index];
+        const Node &child1 = m_nodes.at(node.child1);
+        const Node &child2 = m_nodes.at(node.child2);
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.box = merged(child1.box, child2.box);
+        index = node.parent;
+    }
+}
+
+void EntitySpatialIndex::removeLeaf(int leaf)
+{
+    if (leaf == m_rootNode) {
+        m_rootNode = NullNode;
+        return;
+    }
+
+    const int parent = m_nodes.at(leaf).parent;
+    const int grandParent = m_nodes.at(parent).parent;
+    const int sibling = m_nodes.at(parent).child1 == leaf ? m_nodes.at(parent).child2
+                                                          : m_nodes.at(parent).child1;
+
+    if (grandParent != NullNode) {
+        // Replace the parent by the sibling
+        Node &grandParentNode = m_nodes[grandParent];
+        if (grandParentNode.child1 == parent)
+            grandParentNode.child1 = sibling;
+        else
+            grandParentNode.child2 = sibling;
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+
+        int index = grandParent;
+        while (index != NullNode) {
+            index = balance(index);
+            Node &node = m_nodes[index];
+            const Node &child1 = m_nodes.at(node.child1);
+            const Node &child2 = m_nodes.at(node.child2);
+            node.box = merged(child1.box, child2.box);
+            node.height = 1 + std::max(child1.height, child2.height);
+            index = node.parent;
+        }
+    } else {
+        m_rootNode = sibling;
+        m_nodes[sibling].parent = NullNode;
+        freeNode(parent);
+    }
+    m_nodes[leaf].parent = NullNode;
+}
+
+// Rotates the taller grandchild up when the children heights differ by
+// more than one. Returns the index of the node now at the position of a.
+int EntitySpatialIndex::balance(int a)
+{
+    Node *nodes = m_nodes.data();
+    Node &nodeA = nodes[a];
+    if (nodeA.isLeaf() || nodeA.height < 2)
+        return a;
+
+    const int b = nodeA.child1;
+    const int c = nodeA.child2;
+    Node &nodeB = nodes[b];
+    Node &nodeC = nodes[c];
+    const int heightDifference = nodeC.height - nodeB.height;
+
+    const auto replaceChild = [&] (int parent, int oldChild, int newChild) {
+        if (parent == NullNode) {
+            m_rootNode = newChild;
+            return;
+        }
+        Node &parentNode = nodes[parent];
+        if (parentNode.child1 == oldChild)
+            parentNode.child1 = newChild;
+        else
+            parentNode.child2 = newChild;
+    };
+
+    if (heightDifference > 1) {
+        // Rotate c up
+        const int f = nodeC.child1;
+        const int g = nodeC.child2;
+        Node &nodeF = nodes[f];
+        Node &nodeG = nodes[g];
+
+        nodeC.child1 = a;
+        nodeC.parent = nodeA.parent;
+        nodeA.parent = c;
+        replaceChild(nodeC.parent, a, c);
+
+        if (nodeF.height > nodeG.height) {
+            nodeC.child2 = f;
+            nodeA.child2 = g;
+            nodeG.parent = a;
+            nodeA.box = merged(nodeB.box, nodeG.box);
+            nodeC.box = merged(nodeA.box, nodeF.box);
+            nodeA.height = 1 + std::max(nodeB.height, nodeG.height);
+            nodeC.height = 1 + std::max(nodeA.height, nodeF.height);
+        } else {
+            nodeC.child2 = g;
+            nodeA.child2 = f;
+            nodeF.parent = a;
+            nodeA.box = merged(nodeB.box, nodeF.box);
+            nodeC.box = merged(nodeA.box, nodeG.box);
+            nodeA.height = 1 + std::max(nodeB.height, nodeF.height);
+            nodeC.height = 1 + std::max(nodeA.height, nodeG.height);
+        }
+        return c;
+    }
+
+    if (heightDifference < -1) {
+        // Rotate b up
+        const int d = nodeB.child1;
+        const int e = nodeB.child2;
+        Node &nodeD = nodes[d];
+        Node &nodeE = nodes[e];
+
+        nodeB.child1 = a;
+        nodeB.parent = nodeA.parent;
+        nodeA.parent = b;
+        replaceChild(nodeB.parent, a, b);
+
+        if (nodeD.height > nodeE.height) {
+            nodeB.child2 = d;
+            nodeA.child1 = e;
+            nodeE.parent = a;
+            nodeA.box = merged(nodeC.box, nodeE.box);
+            nodeB.box = merged(nodeA.box, nodeD.box);
+            nodeA.height = 1 + std::max(nodeC.height, nodeE.height);
+            nodeB.height = 1 + std::max(nodeA.height, nodeD.height);
+        } else {
+            nodeB.child2 = e;
+            nodeA.child1 = d;
+            nodeD.parent = a;
+            nodeA.box = merged(nodeC.box, nodeD.box);
+            nodeB.box = merged(nodeA.box, nodeE.box);
+            nodeA.height = 1 + std::max(nodeC.height, nodeD.height);
+            nodeB.height = 1 + std::max(nodeA.height, nodeE.height);
+        }
+        return b;
+    }
+
+    return a;
+}
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
@@ -0,0 +1,213 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_RENDER_ENTITYSPATIALINDEX_P_H
+#define QT3DRENDER_RENDER_ENTITYSPATIALINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/handle_types_p.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <QtCore/QHash>
+#include <QtCore/QVarLengthArray>
+#include <QtCore/QVector>
+
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+
+namespace RayCasting {
+class QRay3D;
+}
+
+namespace Render {
+
+class Entity;
+class EntityManager;
+class Sphere;
+
+// Dynamic AABB tree over the worldBoundingVolumeWithChildren of every entity
+// of the scene. Leaves hold slightly enlarged boxes so that small motions
+// only need a containment check, larger ones remove and reinsert the leaf.
+// Queries are conservative, callers still run their exact test on the
+// entities they are handed.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT EntitySpatialIndex
+{
+public:
+    struct Aabb
+    {
+        float min[3];
+        float max[3];
+    };
+
+    // Bounding spheres of the indexed entities as structure of arrays, in
+    // scene traversal order. Lets culling test them several at a time.
+    struct SphereArrays
+    {
+        QVector<Entity *> entities;
+        QVector<float> centersX;
+        QVector<float> centersY;
+        QVector<float> centersZ;
+        QVector<float> radii;
+
+        int size() const { return entities.size(); }
+    };
+
+    explicit EntitySpatialIndex(EntityManager *manager);
+
+    // Refits the tree to the current bounding volumes of root and its
+    // descendants. Entities no longer in the scene are dropped.
+    void update(Entity *root);
+    void clear();
+
+    const SphereArrays &sphereArrays() const { return m_spheres; }
+
+    // Whether the tree was last updated from root
+    bool isBuiltFor(const Entity *root) const { return root != nullptr && root == m_sceneRoot; }
+    // Whether every entity of the manager is in the tree
+    bool coversAllEntities() const;
+    int entityCount() const { return m_leaves.size(); }
+    int height() const { return m_rootNode == NullNode ? 0 : m_nodes.at(m_rootNode).height; }
+
+    // Calls visitor(Entity *) for each entity whose box passes boxTest(const Aabb &)
+    template<typename BoxTest, typename Visitor>
+    void query(BoxTest &&boxTest, Visitor &&visitor) const
+    {
+        if (m_rootNode == NullNode)
+            return;
+
+        QVarLengthArray<int, 64> stack;
+        stack.push_back(m_rootNode);
+        while (!stack.isEmpty()) {
+            const Node &node = m_nodes.at(stack.takeLast());
+            if (!boxTest(node.box))
+                continue;
+            if (node.isLeaf()) {
+                Entity *entity = entityAt(node);
+                if (entity != nullptr)
+                    visitor(entity);
+            } else {
+                stack.push_back(node.child1);
+                stack.push_back(node.child2);
+            }
+        }
+    }
+
+    // Ray starting at ray.origin(), unbounded forward like intersectRaySphere
+    template<typename Visitor>
+    void queryRay(const RayCasting::QRay3D &ray, Visitor &&visitor) const
+    {
+        const RayQuery rayQuery(ray);
+        query([&rayQuery] (const Aabb &box) { return rayQuery.intersects(box); },
+              std::forward<Visitor>(visitor));
+    }
+
+    template<typename Visitor>
+    void queryBox(const Aabb &queryBox, Visitor &&visitor) const
+    {
+        query([&queryBox] (const Aabb &box) { return overlaps(box, queryBox); },
+              std::forward<Visitor>(visitor));
+    }
+
+    static Aabb boxForSphere(const Sphere &sphere);
+    static bool overlaps(const Aabb &a, const Aabb &b);
+
+private:
+    enum { NullNode = -1 };
+
+    struct Node
+    {
+        Aabb box;
+        int parent;     // Next free node when on the free list
+        int child1;
+        int child2;
+        int height;     // 0 for leaves, -1 for free nodes
+        HEntity entity;
+        uint stamp;
+
+        bool isLeaf() const { return child1 == NullNode; }
+    };
+
+    struct RayQuery
+    {
+        explicit RayQuery(const RayCasting::QRay3D &ray);
+        bool intersects(const Aabb &box) const;
+
+        float origin[3];
+        float invDirection[3];
+        bool parallel[3];
+    };
+
+    Entity *entityAt(const Node &node) const;
+
+    int allocateNode();
+    void freeNode(int nodeIndex);
+    void insertLeaf(int leaf);
+    void removeLeaf(int leaf);
+    int balance(int nodeIndex);
+
+    EntityManager *m_manager;
+    const Entity *m_sceneRoot;
+    QVector<Node> m_nodes;
+    QHash<const Entity *, int> m_leaves;
+    SphereArrays m_spheres;
+    int m_rootNode;
+    int m_freeList;
+    uint m_stamp;
+};
+
+} // namespace Render
+
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_RENDER_ENTITYSPATIALINDEX_P_H
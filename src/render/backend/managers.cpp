@@ -79,6 +79,38 @@ void FrameGraphManager::releaseNode(Qt3DCore::QNodeId id)
     }
 }
 
+void EntityManager::addPendingComponentHandles(HEntity entityHandle)
+{
+    m_pendingComponentHandles.push_back(entityHandle);
+}
+
+QVector<HEntity> EntityManager::takePendingComponentHandles()
+{
+    return std::move(m_pendingComponentHandles);
+}
+
+void EntityManager::addTransformReference(Qt3DCore::QNodeId transformId, HEntity entityHandle)
+{
+    QVector<HEntity> &entityHandles = m_transformReferences[transformId];
+    if (!entityHandles.contains(entityHandle))
+        entityHandles.push_back(entityHandle);
+}
+
+void EntityManager::removeTransformReference(Qt3DCore::QNodeId transformId, HEntity entityHandle)
+{
+    const auto it = m_transformReferences.find(transformId);
+    if (it == m_transformReferences.end())
+        return;
+    it->removeOne(entityHandle);
+    if (it->isEmpty())
+        m_transformReferences.erase(it);
+}
+
+QVector<HEntity> EntityManager::entitiesReferencingTransform(Qt3DCore::QNodeId transformId) const
+{
+    return m_transformReferences.value(transformId);
+}
+
 void SkeletonManager::addDirtySkeleton(DirtyFlag dirtyFlag, HSkeleton skeletonHandle)
 {
     switch (dirtyFlag) {
@@ -142,6 +142,19 @@ public:
                 e->setNodeManagers(nullptr);
         });
     }
+
+    void addPendingComponentHandles(HEntity entityHandle);
+    QVector<HEntity> takePendingComponentHandles();
+
+    // Entities referencing each transform component, kept up to date as
+    // components get added to and removed from the entities
+    void addTransformReference(Qt3DCore::QNodeId transformId, HEntity entityHandle);
+    void removeTransformReference(Qt3DCore::QNodeId transformId, HEntity entityHandle);
+    QVector<HEntity> entitiesReferencingTransform(Qt3DCore::QNodeId transformId) const;
+
+private:
+    QVector<HEntity> m_pendingComponentHandles;
+    QHash<Qt3DCore::QNodeId, QVector<HEntity>> m_transformReferences;
 };
 
 class FrameGraphNode;
@@ -366,6 +379,27 @@ class Q_3DRENDERSHARED_PRIVATE_EXPORT ShaderDataManager : public Qt3DCore::QReso
 {
 public:
     ShaderDataManager() {}
+
+    // Called in AspectThread by ShaderData node functor destroy
+    void addShaderDataIdToCleanup(Qt3DCore::QNodeId id)
+    {
+        m_shaderDataIdsToCleanup.push_back(id);
+    }
+
+    // Called in AspectThread by ShaderData node functor create
+    void removeShaderDataIdToCleanup(Qt3DCore::QNodeId id)
+    {
+        m_shaderDataIdsToCleanup.removeAll(id);
+    }
+
+    // Called by RenderThread in updateGLResources (locked)
+    QVector<Qt3DCore::QNodeId> takeShaderDataIdsToCleanup()
+    {
+        return std::move(m_shaderDataIdsToCleanup);
+    }
+
+private:
+    QVector<Qt3DCore::QNodeId> m_shaderDataIdsToCleanup;
 };
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT TextureImageManager : public Qt3DCore::QResourceManager<
@@ -46,6 +46,7 @@
 #include <Qt3DRender/private/techniquemanager_p.h>
 #include <Qt3DRender/private/armature_p.h>
 #include <Qt3DRender/private/skeleton_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
 
 
 QT_BEGIN_NAMESPACE
@@ -91,11 +92,13 @@ NodeManagers::NodeManagers()
     , m_skeletonManager(new SkeletonManager())
     , m_jointManager(new JointManager())
     , m_shaderImageManager(new ShaderImageManager())
+    , m_entitySpatialIndex(new EntitySpatialIndex(m_renderNodesManager))
 {
 }
 
 NodeManagers::~NodeManagers()
 {
+    delete m_entitySpatialIndex;
     delete m_cameraManager;
     delete m_materialManager;
     delete m_worldMatrixManager;
@@ -102,6 +102,7 @@ class ArmatureManager;
 class SkeletonManager;
 class JointManager;
 class ShaderImageManager;
+class EntitySpatialIndex;
 
 class FrameGraphNode;
 class Entity;
@@ -217,6 +218,7 @@ public:
     inline SkeletonManager *skeletonManager() const noexcept { return m_skeletonManager; }
     inline JointManager *jointManager() const noexcept { return m_jointManager; }
     inline ShaderImageManager *shaderImageManager() const noexcept { return m_shaderImageManager; }
+    inline EntitySpatialIndex *entitySpatialIndex() const noexcept { return m_entitySpatialIndex; }
 
 private:
     CameraManager *m_cameraManager;
@@ -255,6 +257,7 @@ private:
     SkeletonManager *m_skeletonManager;
     JointManager *m_jointManager;
     ShaderImageManager *m_shaderImageManager;
+    EntitySpatialIndex *m_entitySpatialIndex;
 };
 
 // Specializations
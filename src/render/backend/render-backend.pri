@@ -13,6 +13,7 @@ HEADERS += \
     $$PWD/entity_p_p.h \
     $$PWD/entityvisitor_p.h \
     $$PWD/entityaccumulator_p.h \
+    $$PWD/entityspatialindex_p.h \
     $$PWD/layer_p.h \
     $$PWD/levelofdetail_p.h \
     $$PWD/nodefunctor_p.h \
@@ -47,6 +48,7 @@ SOURCES += \
     $$PWD/entity.cpp \
     $$PWD/entityvisitor.cpp \
     $$PWD/entityaccumulator.cpp \
+    $$PWD/entityspatialindex.cpp \
     $$PWD/layer.cpp \
     $$PWD/levelofdetail.cpp \
     $$PWD/transform.cpp \
@@ -39,8 +39,11 @@
 
 #include "stringtoint_p.h"
 #include <QMutex>
-#include <QReadWriteLock>
-#include <QHash>
+#include <QAtomicInt>
+#include <QAtomicPointer>
+#include <algorithm>
+#include <vector>
+#include <memory>
 
 QT_BEGIN_NAMESPACE
 
@@ -50,55 +53,203 @@ namespace Render {
 
 namespace {
 
+struct Entry
+{
+    QString string;
+    uint hash;
+    int id;
+};
+
+// Same hash for the Latin-1 and UTF-16 spellings of a string
+template<typename Char>
+uint hashString(const Char *str, int size)
+{
+    uint h = 2166136261u;
+    for (int i = 0; i < size; ++i) {
+        h ^= uint(str[i]);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+template<typename Char>
+bool equals(const QString &entry, const Char *str, int size)
+{
+    if (entry.size() != size)
+        return false;
+    const ushort *utf16 = entry.utf16();
+    for (int i = 0; i < size; ++i) {
+        if (utf16[i] != ushort(str[i]))
+            return false;
+    }
+    return true;
+}
+
+QString toString(const char16_t *str, int size)
+{
+    return QString(reinterpret_cast<const QChar *>(str), size);
+}
+
+QString toString(const uchar *str, int size)
+{
+    return QString::fromLatin1(reinterpret_cast<const char *>(str), size);
+}
+
+// Open addressing hash table, entries are only ever added
+struct Table
+{
+    explicit Table(int capacity)
+        : mask(capacity - 1)
+        , slots(new QAtomicPointer<const Entry>[capacity])
+    {}
+
+    const int mask;
+    std::unique_ptr<QAtomicPointer<const Entry>[]> slots;
+};
+
+// id / ChunkSize -> chunk of entries
+struct ChunkDirectory
+{
+    explicit ChunkDirectory(int capacity)
+        : capacity(capacity)
+        , chunks(new Entry *[capacity]())
+    {}
+
+    const int capacity;
+    std::unique_ptr<Entry *[]> chunks;
+};
+
+// Readers never lock: entries are published with release stores once fully
+// constructed, and a full table is replaced by a bigger one rather than grown
+// in place. The same goes for the chunk directory. Superseded tables and
+// directories are kept alive as readers may still be using them. Writers are
+// serialized by writeMutex.
 struct StringToIntCache
 {
-    QReadWriteLock lock;
-    QHash<QString, int> map = QHash<QString, int>();
-    QVector<QString> reverseMap = QVector<QString>();
+    enum {
+        ChunkSize = 1024
+    };
+
+    QMutex writeMutex;
+    QAtomicPointer<Table> table;
+    std::vector<std::unique_ptr<Table>> tables;
+    // id -> entry, in chunks so that entries never move
+    QAtomicPointer<ChunkDirectory> directory;
+    std::vector<std::unique_ptr<ChunkDirectory>> directories;
+    std::vector<std::unique_ptr<Entry[]>> chunks;
+    QAtomicInt count;
+
+    StringToIntCache()
+    {
+        tables.emplace_back(new Table(1024));
+        table.storeRelaxed(tables.back().get());
+        directories.emplace_back(new ChunkDirectory(64));
+        directory.storeRelaxed(directories.back().get());
+    }
 
     static StringToIntCache& instance()
     {
         static StringToIntCache c;
         return c;
     }
+
+    const Entry *entry(int idx) const
+    {
+        return directory.loadAcquire()->chunks[idx / ChunkSize] + idx % ChunkSize;
+    }
+
+    template<typename Char>
+    static const Entry *find(const Table *table, uint hash, const Char *str, int size)
+    {
+        for (int i = int(hash) & table->mask; ; i = (i + 1) & table->mask) {
+            const Entry *e = table->slots[i].loadAcquire();
+            if (e == nullptr)
+                return nullptr;
+            if (e->hash == hash && equals(e->string, str, size))
+                return e;
+        }
+    }
+
+    static void insert(Table *table, const Entry *e)
+    {
+        int i = int(e->hash) & table->mask;
+        while (table->slots[i].loadRelaxed() != nullptr)
+            i = (i + 1) & table->mask;
+        table->slots[i].storeRelease(e);
+    }
+
+    template<typename Char>
+    int lookupId(const Char *str, int size)
+    {
+        const uint hash = hashString(str, size);
+        if (const Entry *e = find(table.loadAcquire(), hash, str, size))
+            return e->id;
+
+        QMutexLocker lock(&writeMutex);
+        Table *currentTable = table.loadRelaxed();
+        if (const Entry *e = find(currentTable, hash, str, size))
+            return e->id;
+
+        const int idx = count.loadRelaxed();
+
+        // Keep the load factor under 1/2
+        if (2 * (idx + 1) > currentTable->mask + 1) {
+            tables.emplace_back(new Table(2 * (currentTable->mask + 1)));
+            currentTable = tables.back().get();
+            for (int i = 0; i < idx; ++i)
+                insert(currentTable, entry(i));
+            table.storeRelease(currentTable);
+        }
+
+        if (idx % ChunkSize == 0) {
+            ChunkDirectory *currentDirectory = directory.loadRelaxed();
+            const int chunkIndex = idx / ChunkSize;
+            if (chunkIndex == currentDirectory->capacity) {
+                directories.emplace_back(new ChunkDirectory(2 * currentDirectory->capacity));
+                ChunkDirectory *newDirectory = directories.back().get();
+                std::copy(currentDirectory->chunks.get(),
+                          currentDirectory->chunks.get() + chunkIndex,
+                          newDirectory->chunks.get());
+                currentDirectory = newDirectory;
+            }
+            chunks.emplace_back(new Entry[ChunkSize]);
+            currentDirectory->chunks[chunkIndex] = chunks.back().get();
+            directory.storeRelease(currentDirectory);
+        }
+        Entry &e = directory.loadRelaxed()->chunks[idx / ChunkSize][idx % ChunkSize];
+        e.string = toString(str, size);
+        e.hash = hash;
+        e.id = idx;
+
+        // Publish to lookupString before lookupId can hand out the id
+        count.storeRelease(idx + 1);
+        insert(currentTable, &e);
+        return idx;
+    }
 };
 
 } // anonymous
 
-int StringToInt::lookupId(QLatin1String str)
+int StringToInt::lookupId(QStringView str)
 {
-    // ### optimize me
-    return lookupId(QString(str));
+    return StringToIntCache::instance().lookupId(reinterpret_cast<const char16_t *>(str.data()), int(str.size()));
 }
 
 int StringToInt::lookupId(const QString &str)
 {
-    auto& cache = StringToIntCache::instance();
-    int idx;
-    {
-        QReadLocker readLocker(&cache.lock);
-        idx = cache.map.value(str, -1);
-    }
+    return lookupId(QStringView(str));
+}
 
-    if (Q_UNLIKELY(idx < 0)) {
-        QWriteLocker writeLocker(&cache.lock);
-        idx = cache.map.value(str, -1);
-        if (idx < 0) {
-            idx = cache.reverseMap.size();
-            Q_ASSERT(cache.map.size() == cache.reverseMap.size());
-            cache.map.insert(str, idx);
-            cache.reverseMap.append(str);
-        }
-    }
-    return idx;
+int StringToInt::lookupId(QLatin1String str)
+{
+    return StringToIntCache::instance().lookupId(reinterpret_cast<const uchar *>(str.data()), str.size());
 }
 
 QString StringToInt::lookupString(int idx)
 {
-    auto& cache = StringToIntCache::instance();
-    QReadLocker readLocker(&cache.lock);
-    if (Q_LIKELY(cache.reverseMap.size() > idx))
-        return cache.reverseMap.at(idx);
+    const auto& cache = StringToIntCache::instance();
+    if (Q_LIKELY(idx >= 0 && idx < cache.count.loadAcquire()))
+        return cache.entry(idx)->string;
 
     return QString();
 }
@@ -54,6 +54,7 @@
 
 #include <QVector>
 #include <QString>
+#include <QStringView>
 #include <Qt3DRender/private/qt3drender_global_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -62,9 +63,12 @@ namespace Qt3DRender {
 
 namespace Render {
 
+// Interns strings into ids. Looking up a string that was already interned, or
+// the string of an id, takes no lock and doesn't allocate.
 class Q_3DRENDERSHARED_PRIVATE_EXPORT StringToInt
 {
 public:
+    static int lookupId(QStringView str);
     static int lookupId(const QString &str);
     static int lookupId(QLatin1String str);
     static QString lookupString(int idx);
@@ -42,6 +42,9 @@
 #include <Qt3DCore/private/qchangearbiter_p.h>
 #include <Qt3DCore/qtransform.h>
 #include <Qt3DCore/private/qtransform_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -100,17 +103,34 @@ void Transform::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     dirty |= m_translation != transform->translation();
     m_translation = transform->translation();
 
-    if (dirty || firstTime) {
+    if (dirty || firstTime)
         updateMatrix();
-        markDirty(AbstractRenderer::TransformDirty);
-    }
 
-    if (transform->isEnabled() != isEnabled())
+    if (dirty || firstTime || transform->isEnabled() != isEnabled()) {
         markDirty(AbstractRenderer::TransformDirty);
+        markEntitiesDirty();
+    }
 
     BackendNode::syncFromFrontEnd(frontEnd, firstTime);
 }
 
+void Transform::markEntitiesDirty()
+{
+    // Flag the entities referencing this transform so that only their
+    // subtrees get visited by the UpdateWorldTransformJob
+    NodeManagers *managers = m_renderer ? m_renderer->nodeManagers() : nullptr;
+    if (!managers)
+        return;
+
+    EntityManager *entityManager = managers->renderNodesManager();
+    const QVector<HEntity> entityHandles = entityManager->entitiesReferencingTransform(peerId());
+    for (const HEntity &entityHandle : entityHandles) {
+        Entity *entity = entityManager->data(entityHandle);
+        if (entity != nullptr)
+            entity->markTransformDirty();
+    }
+}
+
 void Transform::updateMatrix()
 {
     QMatrix4x4 m;
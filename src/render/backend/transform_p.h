@@ -58,6 +58,10 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace Qt3DCore {
+class QTransform;
+}
+
 namespace Qt3DRender {
 
 namespace Render {
@@ -80,6 +84,7 @@ public:
 
 private:
     void updateMatrix();
+    void markEntitiesDirty();
     Matrix4x4 m_transformMatrix;
     QQuaternion m_rotation;
     QVector3D m_scale;
@@ -175,9 +175,10 @@ public:
     }
 
     // Reserve data to be filled in later
-    UniformValue(int byteSize, ValueType valueType)
+    UniformValue(int byteSize, ValueType valueType, UniformType storedType = Unknown)
         : m_data(byteSize / sizeof(float))
         , m_valueType(valueType)
+        , m_storedType(storedType)
     {
     }
 
@@ -102,6 +102,7 @@
 #include <Qt3DRender/private/cameralens_p.h>
 #include <Qt3DRender/private/filterkey_p.h>
 #include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/abstractrenderer_p.h>
 #include <Qt3DRender/private/shaderdata_p.h>
 #include <Qt3DRender/private/renderpassfilternode_p.h>
@@ -240,6 +241,9 @@ QRenderAspectPrivate::QRenderAspectPrivate(QRenderAspect::RenderType type)
     m_updateWorldBoundingVolumeJob->addDependency(m_calculateBoundingVolumeJob);
     m_expandBoundingVolumeJob->addDependency(m_updateWorldBoundingVolumeJob);
     m_updateLevelOfDetailJob->addDependency(m_expandBoundingVolumeJob);
+    // Picking queries the entity spatial index refit by the expand job
+    m_pickBoundingVolumeJob->addDependency(m_expandBoundingVolumeJob);
+    m_rayCastingJob->addDependency(m_expandBoundingVolumeJob);
 }
 
 /*! \internal */
@@ -555,6 +559,14 @@ QVector<Qt3DCore::QAspectJobPtr> QRenderAspect::jobsToExecute(qint64 time)
     d->m_renderer->dumpInfo();
 #endif
 
+    // Resolve the component handles of the entities created since the last
+    // frame, now that the backend nodes of their components exist
+    const QVector<HEntity> pendingEntities = d->m_nodeManagers->renderNodesManager()->takePendingComponentHandles();
+    for (const HEntity &entityHandle : pendingEntities) {
+        if (Entity *entity = d->m_nodeManagers->renderNodesManager()->data(entityHandle))
+            entity->resolveComponentHandles();
+    }
+
     // Create jobs that will get executed by the threadpool
     QVector<QAspectJobPtr> jobs;
 
@@ -81,6 +81,7 @@ public:
     inline uint divisor() const { return m_divisor; }
     inline Qt3DCore::QAttribute::AttributeType attributeType() const { return m_attributeType; }
     inline bool isDirty() const { return m_attributeDirty; }
+    inline int revision() const { return m_revision; }
     void unsetDirty();
 
 private:
@@ -95,6 +96,8 @@ private:
     uint m_divisor;
     Qt3DCore::QAttribute::AttributeType m_attributeType;
     bool m_attributeDirty;
+    // Bumped whenever the attribute changes, see Buffer::revision()
+    int m_revision;
 };
 
 } // namespace Render
@@ -81,6 +81,7 @@ public:
     inline QByteArray data() const { return m_data; }
     inline QVector<Qt3DCore::QBufferUpdate> &pendingBufferUpdates() { return m_bufferUpdates; }
     inline bool isDirty() const { return m_bufferDirty; }
+    inline int revision() const { return m_revision; }
     inline Qt3DCore::QBuffer::AccessType access() const { return m_access; }
     void unsetDirty();
 
@@ -91,6 +92,9 @@ private:
     QByteArray m_data;
     QVector<Qt3DCore::QBufferUpdate> m_bufferUpdates;
     bool m_bufferDirty;
+    // Bumped whenever the CPU side data changes, lets caches built from it
+    // notice they are stale. Not reset on cleanup so it never repeats.
+    int m_revision;
     Qt3DCore::QBuffer::AccessType m_access;
     BufferManager *m_manager;
 };
@@ -54,6 +54,7 @@ namespace Render {
 Geometry::Geometry()
     : BackendNode(ReadWrite)
     , m_geometryDirty(false)
+    , m_revision(0)
 {
 }
 
@@ -79,12 +80,15 @@ void Geometry::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         return;
 
     m_geometryDirty |= firstTime;
+    if (firstTime)
+        ++m_revision;
 
     QNodeIdVector attribs = qIdsForNodes(node->attributes());
     std::sort(std::begin(attribs), std::end(attribs));
     if (m_attributes != attribs) {
         m_attributes = attribs;
         m_geometryDirty = true;
+        ++m_revision;
     }
 
     if ((node->boundingVolumePositionAttribute() && node->boundingVolumePositionAttribute()->id() != m_boundingPositionAttribute) ||
@@ -72,6 +72,7 @@ public:
 
     inline QVector<Qt3DCore::QNodeId> attributes() const { return m_attributes; }
     inline bool isDirty() const { return m_geometryDirty; }
+    inline int revision() const { return m_revision; }
     inline Qt3DCore::QNodeId boundingPositionAttribute() const { return m_boundingPositionAttribute; }
     void unsetDirty();
 
@@ -83,6 +84,8 @@ public:
 private:
     QVector<Qt3DCore::QNodeId> m_attributes;
     bool m_geometryDirty;
+    // Bumped whenever the attribute set changes, see Buffer::revision()
+    int m_revision;
     Qt3DCore::QNodeId m_boundingPositionAttribute;
     QVector3D m_min;
     QVector3D m_max;
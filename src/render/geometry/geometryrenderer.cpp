@@ -42,6 +42,7 @@
 #include <Qt3DRender/private/qboundingvolume_p.h>
 #include <Qt3DRender/private/qgeometryrenderer_p.h>
 #include <Qt3DRender/private/qmesh_p.h>
+#include <Qt3DRender/private/trianglebvh_p.h>
 #include <Qt3DCore/private/qnode_p.h>
 #include <Qt3DCore/private/qservicelocator_p.h>
 #include <QtCore/qcoreapplication.h>
@@ -68,6 +69,7 @@ GeometryRenderer::GeometryRenderer()
     , m_primitiveRestartEnabled(false)
     , m_primitiveType(QGeometryRenderer::Triangles)
     , m_dirty(false)
+    , m_revision(0)
     , m_manager(nullptr)
 {
 }
@@ -94,6 +96,7 @@ void GeometryRenderer::cleanup()
     m_geometryFactory.reset();
     qDeleteAll(m_triangleVolumes);
     m_triangleVolumes.clear();
+    m_triangleBvh.reset();
 }
 
 void GeometryRenderer::setManager(GeometryRendererManager *manager)
@@ -109,6 +112,11 @@ void GeometryRenderer::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         return;
     const Qt3DCore::QGeometryView *view = node->view();
 
+    // Track whether this sync changes anything, m_dirty may still be set from
+    // an earlier one
+    const bool wasDirty = m_dirty;
+    m_dirty = false;
+
     auto propertyUpdater = [this](const auto *node) {
         m_dirty |= m_instanceCount != node->instanceCount();
         m_instanceCount = node->instanceCount();
@@ -160,6 +168,10 @@ void GeometryRenderer::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
         }
     }
 
+    if (m_dirty || firstTime)
+        ++m_revision;
+    m_dirty |= wasDirty;
+
     markDirty(AbstractRenderer::GeometryDirty);
 }
 
@@ -55,12 +55,15 @@
 #include <Qt3DRender/private/backendnode_p.h>
 #include <Qt3DRender/qgeometryrenderer.h>
 #include <Qt3DRender/qmesh.h>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
 
 QT_BEGIN_NAMESPACE
 
 namespace Qt3DRender {
 namespace RayCasting {
 class QBoundingVolume;
+class TriangleBvh;
 }
 
 namespace Render {
@@ -96,6 +99,7 @@ public:
     inline bool primitiveRestartEnabled() const { return m_primitiveRestartEnabled; }
     inline QGeometryRenderer::PrimitiveType primitiveType() const { return m_primitiveType; }
     inline bool isDirty() const { return m_dirty; }
+    inline int revision() const { return m_revision; }
     inline Qt3DCore::QGeometryFactoryPtr geometryFactory() const { return m_geometryFactory; }
     void unsetDirty();
 
@@ -104,6 +108,12 @@ public:
     // Pick volumes job
     QVector<RayCasting::QBoundingVolume *> triangleData() const;
 
+    // Picking and ray casting jobs, lazily built and shared between them.
+    // Hold triangleBvhMutex() while checking or replacing the cached BVH.
+    QMutex *triangleBvhMutex() const { return &m_triangleBvhMutex; }
+    QSharedPointer<RayCasting::TriangleBvh> triangleBvh() const { return m_triangleBvh; }
+    void setTriangleBvh(const QSharedPointer<RayCasting::TriangleBvh> &bvh) { m_triangleBvh = bvh; }
+
 private:
     Qt3DCore::QNodeId m_geometryId;
     int m_instanceCount;
@@ -117,9 +127,13 @@ private:
     bool m_primitiveRestartEnabled;
     QGeometryRenderer::PrimitiveType m_primitiveType;
     bool m_dirty;
+    // Bumped whenever a property changes, see Buffer::revision()
+    int m_revision;
     Qt3DCore::QGeometryFactoryPtr m_geometryFactory;
     GeometryRendererManager *m_manager;
     QVector<RayCasting::QBoundingVolume *> m_triangleVolumes;
+    mutable QMutex m_triangleBvhMutex;
+    QSharedPointer<RayCasting::TriangleBvh> m_triangleBvh;
 };
 
 class GeometryRendererFunctor : public Qt3DCore::QBackendNodeMapper
@@ -54,11 +54,9 @@
 #include <Qt3DRender/private/entityvisitor_p.h>
 #include <Qt3DCore/private/qgeometry_p.h>
 #include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qparallelfor_p.h>
 
 #include <QtCore/qmath.h>
-#if QT_CONFIG(concurrent)
-#include <QtConcurrent/QtConcurrent>
-#endif
 #include <Qt3DRender/private/job_common_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -350,26 +348,6 @@ QVector<Geometry *> calculateLocalBoundingVolume(NodeManagers *manager, const Bo
     return updatedGeometries;
 }
 
-struct UpdateBoundFunctor
-{
-    NodeManagers *manager;
-
-    // This define is required to work with QtConcurrent
-    typedef QVector<Geometry *> result_type;
-    QVector<Geometry *> operator ()(const BoundingVolumeComputeData &data)
-    {
-        return calculateLocalBoundingVolume(manager, data);
-    }
-};
-
-struct ReduceUpdateBoundFunctor
-{
-    void operator ()(QVector<Geometry *> &result, const QVector<Geometry *> &values)
-    {
-        result += values;
-    }
-};
-
 class DirtyEntityAccumulator : public EntityVisitor
 {
 public:
@@ -433,18 +411,16 @@ void CalculateBoundingVolumeJob::run()
     QVector<Geometry *> updatedGeometries;
     updatedGeometries.reserve(entities.size());
 
-#if QT_CONFIG(concurrent)
-    if (entities.size() > 1) {
-        UpdateBoundFunctor functor;
-        functor.manager = m_manager;
-        ReduceUpdateBoundFunctor reduceFunctor;
-        updatedGeometries += QtConcurrent::blockingMappedReduced<decltype(updatedGeometries)>(entities, functor, reduceFunctor);
-    } else
-#endif
-    {
-        for (const auto &data: entities)
-            updatedGeometries += calculateLocalBoundingVolume(m_manager, data);
-    }
+    // Reading the vertices is costly, a chunk may hold a single entity
+    const Qt3DCore::QParallelFor parallelFor(int(entities.size()), 1);
+    QVector<QVector<Geometry *>> updatedGeometriesPerChunk(parallelFor.chunkCount());
+    parallelFor.run([&](int chunk, int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            updatedGeometriesPerChunk[chunk] += calculateLocalBoundingVolume(m_manager, entities[i]);
+    }, this);
+
+    for (const QVector<Geometry *> &geometries : qAsConst(updatedGeometriesPerChunk))
+        updatedGeometries += geometries;
 
     Q_D(CalculateBoundingVolumeJob);
     d->m_updatedGeometries = std::move(updatedGeometries);
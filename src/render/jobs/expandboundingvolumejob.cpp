@@ -42,6 +42,7 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/renderlogging_p.h>
 #include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
@@ -104,6 +105,10 @@ void ExpandBoundingVolumeJob::run()
     // TODO: Implement this using a parallel_for
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
     expandWorldBoundingVolume(m_manager, m_node);
+
+    // Culling, picking and proximity filtering query the expanded volumes
+    // through the spatial index, refit it while we know they just changed
+    m_manager->entitySpatialIndex()->update(m_node);
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
 
@@ -43,6 +43,7 @@
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/layerfilternode_p.h>
+#include <Qt3DCore/private/qparallelfor_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -76,7 +77,7 @@ void FilterLayerEntityJob::run()
 }
 
 // We accept the entity if it contains any of the layers that are in the layer filter
-void FilterLayerEntityJob::filterAcceptAnyMatchingLayers(Entity *entity,
+bool FilterLayerEntityJob::filterAcceptAnyMatchingLayers(Entity *entity,
                                                          const Qt3DCore::QNodeIdVector &layerIds)
 {
     const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
@@ -84,16 +85,15 @@ void FilterLayerEntityJob::filterAcceptAnyMatchingLayers(Entity *entity,
     for (const Qt3DCore::QNodeId id : entityLayers) {
         const bool layerAccepted = layerIds.contains(id);
 
-        if (layerAccepted) {
-            m_filteredEntities.push_back(entity);
-            break;
-        }
+        if (layerAccepted)
+            return true;
     }
+    return false;
 }
 
 // We accept the entity if it contains all the layers that are in the layer
 // filter
-void FilterLayerEntityJob::filterAcceptAllMatchingLayers(Entity *entity,
+bool FilterLayerEntityJob::filterAcceptAllMatchingLayers(Entity *entity,
                                                          const Qt3DCore::QNodeIdVector &layerIds)
 {
     const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
@@ -104,15 +104,14 @@ void FilterLayerEntityJob::filterAcceptAllMatchingLayers(Entity *entity,
             ++layersAccepted;
     }
 
-    if (layersAccepted == layerIds.size())
-        m_filteredEntities.push_back(entity);
+    return layersAccepted == layerIds.size();
 }
 
 // We discard the entity if it contains any of the layers that are in the layer
 // filter
 // In other words that means we select an entity if one of its layers is not on
 // the layer filter
-void FilterLayerEntityJob::filterDiscardAnyMatchingLayers(Entity *entity,
+bool FilterLayerEntityJob::filterDiscardAnyMatchingLayers(Entity *entity,
                                                           const Qt3DCore::QNodeIdVector &layerIds)
 {
     const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
@@ -125,15 +124,14 @@ void FilterLayerEntityJob::filterDiscardAnyMatchingLayers(Entity *entity,
         }
     }
 
-    if (!entityCanBeDiscarded)
-        m_filteredEntities.push_back(entity);
+    return !entityCanBeDiscarded;
 }
 
 // We discard the entity if it contains all of the layers that are in the layer
 // filter
 // In other words that means we select an entity if none of its layers are on
 // the layer filter
-void FilterLayerEntityJob::filterDiscardAllMatchingLayers(Entity *entity,
+bool FilterLayerEntityJob::filterDiscardAllMatchingLayers(Entity *entity,
                                                           const Qt3DCore::QNodeIdVector &layerIds)
 {
     const Qt3DCore::QNodeIdVector entityLayers = entity->layerIds();
@@ -145,8 +143,7 @@ void FilterLayerEntityJob::filterDiscardAllMatchingLayers(Entity *entity,
             ++containedLayers;
     }
 
-    if (containedLayers != layerIds.size())
-        m_filteredEntities.push_back(entity);
+    return containedLayers != layerIds.size();
 }
 
 void FilterLayerEntityJob::filterLayerAndEntity()
@@ -180,29 +177,40 @@ void FilterLayerEntityJob::filterLayerAndEntity()
 
         const QLayerFilter::FilterMode filterMode = layerFilter->filterMode();
 
+        bool (*filter)(Entity *, const Qt3DCore::QNodeIdVector &) = nullptr;
+        switch (filterMode) {
+        case QLayerFilter::AcceptAnyMatchingLayers:
+            filter = &FilterLayerEntityJob::filterAcceptAnyMatchingLayers;
+            break;
+        case QLayerFilter::AcceptAllMatchingLayers:
+            filter = &FilterLayerEntityJob::filterAcceptAllMatchingLayers;
+            break;
+        case QLayerFilter::DiscardAnyMatchingLayers:
+            filter = &FilterLayerEntityJob::filterDiscardAnyMatchingLayers;
+            break;
+        case QLayerFilter::DiscardAllMatchingLayers:
+            filter = &FilterLayerEntityJob::filterDiscardAllMatchingLayers;
+            break;
+        default:
+            Q_UNREACHABLE();
+        }
+
         // Perform filtering
-        for (Entity *entity : entitiesToFilter) {
-            switch (filterMode) {
-            case QLayerFilter::AcceptAnyMatchingLayers: {
-                filterAcceptAnyMatchingLayers(entity, layerIds);
-                break;
-            }
-            case QLayerFilter::AcceptAllMatchingLayers: {
-                filterAcceptAllMatchingLayers(entity, layerIds);
-                break;
-            }
-            case QLayerFilter::DiscardAnyMatchingLayers: {
-                filterDiscardAnyMatchingLayers(entity, layerIds);
-                break;
-            }
-            case QLayerFilter::DiscardAllMatchingLayers: {
-                filterDiscardAllMatchingLayers(entity, layerIds);
-                break;
+        const Qt3DCore::QParallelFor parallelFor(entitiesToFilter.size(), 1024);
+        QVector<QVector<Entity *>> filteredEntitiesPerChunk(parallelFor.chunkCount());
+        parallelFor.run([&](int chunk, int begin, int end) {
+            QVector<Entity *> &filteredEntities = filteredEntitiesPerChunk[chunk];
+            for (int i = begin; i < end; ++i) {
+                Entity *entity = entitiesToFilter.at(i);
+                if (filter(entity, layerIds))
+                    filteredEntities.push_back(entity);
             }
-            default:
-                Q_UNREACHABLE();
-            }
-        }
+        }, this);
+
+        m_filteredEntities.clear();
+        m_filteredEntities.reserve(entitiesToFilter.size());
+        for (const QVector<Entity *> &filteredEntities : qAsConst(filteredEntitiesPerChunk))
+            m_filteredEntities += filteredEntities;
 
         // Entities to filter for the next frame are the filtered result of the
         // current LayerFilter
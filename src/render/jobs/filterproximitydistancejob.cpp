@@ -33,6 +33,9 @@
 #include <Qt3DRender/private/proximityfilter_p.h>
 #include <Qt3DRender/private/job_common_p.h>
 #include <Qt3DRender/private/sphere_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
+
+#include <cmath>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,8 +62,8 @@ void FilterProximityDistanceJob::run()
     // otherwise it will be used as the base list of entities to filter
 
     if (hasProximityFilter()) {
-        selectAllEntities();
-        QVector<Entity *> entitiesToFilter = std::move(m_filteredEntities);
+        QVector<Entity *> entitiesToFilter;
+        bool firstFilter = true;
         FrameGraphManager *frameGraphManager = m_manager->frameGraphManager();
         EntityManager *entityManager = m_manager->renderNodesManager();
 
@@ -75,12 +78,23 @@ void FilterProximityDistanceJob::run()
                 m_filteredEntities.clear();
                 return;
             }
+
+            // The first filter selects from the whole scene, the next ones
+            // refine what the previous ones selected
+            if (firstFilter) {
+                selectCandidateEntities();
+                entitiesToFilter = std::move(m_filteredEntities);
+                m_filteredEntities.clear();
+                firstFilter = false;
+            }
+
             // Otherwise we filter
             filterEntities(entitiesToFilter);
 
             // And we make the filtered subset be the list of entities to filter
             // for the next loop
             entitiesToFilter = std::move(m_filteredEntities);
+            m_filteredEntities.clear();
         }
         m_filteredEntities = std::move(entitiesToFilter);
     }
@@ -101,6 +115,28 @@ void FilterProximityDistanceJob::selectAllEntities()
     }
 }
 
+void FilterProximityDistanceJob::selectCandidateEntities()
+{
+    const EntitySpatialIndex *spatialIndex = m_manager->entitySpatialIndex();
+    if (!spatialIndex->coversAllEntities()) {
+        selectAllEntities();
+        return;
+    }
+
+    // Bounding volume centers lie within the entity boxes, so every entity
+    // close enough to the target has a box overlapping the cube around it
+    const Vector3D center = m_targetEntity->worldBoundingVolumeWithChildren()->center();
+    const float threshold = std::sqrt(m_distanceThresholdSquared) * 1.0001f;
+    EntitySpatialIndex::Aabb box;
+    for (int i = 0; i < 3; ++i) {
+        box.min[i] = center[i] - threshold;
+        box.max[i] = center[i] + threshold;
+    }
+    spatialIndex->queryBox(box, [this](Entity *entity) {
+        m_filteredEntities.push_back(entity);
+    });
+}
+
 void FilterProximityDistanceJob::filterEntities(const QVector<Entity *> &entitiesToFilter)
 {
     const Sphere *target = m_targetEntity->worldBoundingVolumeWithChildren();
@@ -44,6 +44,18 @@
 #include <Qt3DRender/private/sphere_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
+#include <Qt3DCore/private/qparallelfor_p.h>
+#include <Qt3DCore/private/qt3dcore-config_p.h>
+#include <QtCore/qalgorithms.h>
+#include <private/qsimd_p.h>
+
+// Same conditions as the Matrix4x4 and Vector3D SIMD implementations
+#if QT_CONFIG(qt3d_simd_avx2) && defined(__AVX2__) && defined(QT_COMPILER_SUPPORTS_AVX2)
+#  define QT3D_FRUSTUM_CULLING_AVX2
+#elif QT_CONFIG(qt3d_simd_sse2) && defined(__SSE2__) && defined(QT_COMPILER_SUPPORTS_SSE2)
+#  define QT3D_FRUSTUM_CULLING_SSE2
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -85,25 +97,153 @@ void FrustumCullingJob::run()
 
 void FrustumCullingJob::cullScene(Entity *e, const Plane *planes)
 {
-    e->traverse([planes, this](Entity *e) {
+    // The spatial index keeps the spheres of the whole scene in flat arrays,
+    // test them several at a time rather than chasing Entity pointers
+    const EntitySpatialIndex *spatialIndex = m_manager ? m_manager->entitySpatialIndex() : nullptr;
+    if (spatialIndex && spatialIndex->isBuiltFor(e)) {
+        const EntitySpatialIndex::SphereArrays &spheres = spatialIndex->sphereArrays();
+        Vector4D planeEquations[6];
+        for (int i = 0; i < 6; ++i)
+            planeEquations[i] = Vector4D(planes[i].normal, planes[i].d);
+
+        const Qt3DCore::QParallelFor parallelFor(spheres.size(), 16384);
+        QVector<QVector<Entity *>> visibleEntitiesPerChunk(parallelFor.chunkCount());
+        parallelFor.run([&](int chunk, int begin, int end) {
+            QVector<int> visibleIndices;
+            cullSpheres(spheres.centersX.constData(), spheres.centersY.constData(),
+                        spheres.centersZ.constData(), spheres.radii.constData(),
+                        begin, end, planeEquations, visibleIndices);
+
+            QVector<Entity *> &visibleEntities = visibleEntitiesPerChunk[chunk];
+            visibleEntities.reserve(visibleIndices.size());
+            for (const int index : qAsConst(visibleIndices))
+                visibleEntities.push_back(spheres.entities.at(index));
+        }, this);
+
+        for (const QVector<Entity *> &visibleEntities : qAsConst(visibleEntitiesPerChunk))
+            m_visibleEntities += visibleEntities;
+        return;
+    }
+
+    const auto isVisible = [planes](Entity *e) {
         const Sphere *s = e->worldBoundingVolumeWithChildren();
 
         // Unrolled loop
         if (Vector3D::dotProduct(s->center(), planes[0].normal) + planes[0].d < -s->radius())
-            return;
+            return false;
         if (Vector3D::dotProduct(s->center(), planes[1].normal) + planes[1].d < -s->radius())
-            return;
+            return false;
         if (Vector3D::dotProduct(s->center(), planes[2].normal) + planes[2].d < -s->radius())
-            return;
+            return false;
         if (Vector3D::dotProduct(s->center(), planes[3].normal) + planes[3].d < -s->radius())
-            return;
+            return false;
         if (Vector3D::dotProduct(s->center(), planes[4].normal) + planes[4].d < -s->radius())
-            return;
+            return false;
         if (Vector3D::dotProduct(s->center(), planes[5].normal) + planes[5].d < -s->radius())
-            return;
+            return false;
+        return true;
+    };
 
-        m_visibleEntities.push_back(e);
+    QVector<Entity *> entities;
+    e->traverse([&entities](Entity *e) {
+        entities.push_back(e);
     });
+
+    const Qt3DCore::QParallelFor parallelFor(entities.size(), 1024);
+    QVector<QVector<Entity *>> visibleEntitiesPerChunk(parallelFor.chunkCount());
+    parallelFor.run([&](int chunk, int begin, int end) {
+        QVector<Entity *> &visibleEntities = visibleEntitiesPerChunk[chunk];
+        for (int i = begin; i < end; ++i) {
+            Entity *e = entities.at(i);
+            if (isVisible(e))
+                visibleEntities.push_back(e);
+        }
+    }, this);
+
+    for (const QVector<Entity *> &visibleEntities : qAsConst(visibleEntitiesPerChunk))
+        m_visibleEntities += visibleEntities;
+}
+
+void FrustumCullingJob::cullSpheres(const float *centersX, const float *centersY, const float *centersZ,
+                                    const float *radii, int begin, int end,
+                                    const Vector4D *planes, QVector<int> &visibleIndices)
+{
+    int i = begin;
+
+#if defined(QT3D_FRUSTUM_CULLING_AVX2)
+    __m256 normalsX[6], normalsY[6], normalsZ[6], distances[6];
+    for (int p = 0; p < 6; ++p) {
+        normalsX[p] = _mm256_set1_ps(planes[p].x());
+        normalsY[p] = _mm256_set1_ps(planes[p].y());
+        normalsZ[p] = _mm256_set1_ps(planes[p].z());
+        distances[p] = _mm256_set1_ps(planes[p].w());
+    }
+
+    for (; i + 8 <= end; i += 8) {
+        const __m256 x = _mm256_loadu_ps(centersX + i);
+        const __m256 y = _mm256_loadu_ps(centersY + i);
+        const __m256 z = _mm256_loadu_ps(centersZ + i);
+        const __m256 negativeRadii = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radii + i));
+
+        __m256 culled = _mm256_setzero_ps();
+        for (int p = 0; p < 6; ++p) {
+            const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, normalsX[p]),
+                                                                _mm256_mul_ps(y, normalsY[p])),
+                                                  _mm256_add_ps(_mm256_mul_ps(z, normalsZ[p]),
+                                                                distances[p]));
+            culled = _mm256_or_ps(culled, _mm256_cmp_ps(distance, negativeRadii, _CMP_LT_OQ));
+        }
+
+        uint visibleMask = ~uint(_mm256_movemask_ps(culled)) & 0xffu;
+        while (visibleMask) {
+            visibleIndices.push_back(i + int(qCountTrailingZeroBits(visibleMask)));
+            visibleMask &= visibleMask - 1;
+        }
+    }
+#elif defined(QT3D_FRUSTUM_CULLING_SSE2)
+    __m128 normalsX[6], normalsY[6], normalsZ[6], distances[6];
+    for (int p = 0; p < 6; ++p) {
+        normalsX[p] = _mm_set1_ps(planes[p].x());
+        normalsY[p] = _mm_set1_ps(planes[p].y());
+        normalsZ[p] = _mm_set1_ps(planes[p].z());
+        distances[p] = _mm_set1_ps(planes[p].w());
+    }
+
+    for (; i + 4 <= end; i += 4) {
+        const __m128 x = _mm_loadu_ps(centersX + i);
+        const __m128 y = _mm_loadu_ps(centersY + i);
+        const __m128 z = _mm_loadu_ps(centersZ + i);
+        const __m128 negativeRadii = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radii + i));
+
+        __m128 culled = _mm_setzero_ps();
+        for (int p = 0; p < 6; ++p) {
+            const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, normalsX[p]),
+                                                          _mm_mul_ps(y, normalsY[p])),
+                                               _mm_add_ps(_mm_mul_ps(z, normalsZ[p]),
+                                                          distances[p]));
+            culled = _mm_or_ps(culled, _mm_cmplt_ps(distance, negativeRadii));
+        }
+
+        uint visibleMask = ~uint(_mm_movemask_ps(culled)) & 0xfu;
+        while (visibleMask) {
+            visibleIndices.push_back(i + int(qCountTrailingZeroBits(visibleMask)));
+            visibleMask &= visibleMask - 1;
+        }
+    }
+#endif
+
+    // Remaining spheres, or all of them without SIMD. Same operation order
+    // as the vectorized paths.
+    for (; i < end; ++i) {
+        bool culled = false;
+        for (int p = 0; p < 6 && !culled; ++p) {
+            const float distance = (centersX[i] * planes[p].x() + centersY[i] * planes[p].y())
+                    + (centersZ[i] * planes[p].z() + planes[p].w());
+            culled = distance < -radii[i];
+        }
+        if (!culled)
+            visibleIndices.push_back(i);
+    }
 }
 
 } // Render
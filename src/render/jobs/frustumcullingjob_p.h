@@ -85,6 +85,13 @@ public:
 
     QVector<Entity *> visibleEntities() const Q_DECL_NOTHROW { return m_visibleEntities; }
 
+    // Appends to visibleIndices the indices in [begin, end) of the spheres not
+    // entirely behind one of the 6 planes, given as (normal, d). Uses SSE2 or
+    // AVX2 when enabled.
+    static void cullSpheres(const float *centersX, const float *centersY, const float *centersZ,
+                            const float *radii, int begin, int end,
+                            const Vector4D *planes, QVector<int> &visibleIndices);
+
     void run() final;
 
 private:
@@ -42,6 +42,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/entity_p.h>
 #include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/qparallelfor_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -57,6 +58,17 @@ LightGatherer::LightGatherer()
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::LightGathering, 0)
 }
 
+namespace {
+
+struct LightGathererChunk
+{
+    QVector<LightSource> lights;
+    EnvironmentLight *environmentLight = nullptr;
+    int environmentLightCount = 0;
+};
+
+} // anonymous
+
 void LightGatherer::run()
 {
     m_lights.clear();
@@ -65,15 +77,28 @@ void LightGatherer::run()
     const QVector<HEntity> handles = m_manager->activeHandles();
     int envLightCount = 0;
 
-    for (const HEntity &handle : handles) {
-        Entity *node = m_manager->data(handle);
-        const QVector<Light *> lights = node->renderComponents<Light>();
-        if (!lights.isEmpty())
-            m_lights.push_back(LightSource(node, lights));
-        const QVector<EnvironmentLight *> envLights = node->renderComponents<EnvironmentLight>();
-        envLightCount += envLights.size();
-        if (!envLights.isEmpty() && !m_environmentLight)
-            m_environmentLight = envLights.first();
+    const Qt3DCore::QParallelFor parallelFor(handles.size(), 1024);
+    QVector<LightGathererChunk> chunks(parallelFor.chunkCount());
+    parallelFor.run([&](int chunk, int begin, int end) {
+        LightGathererChunk &result = chunks[chunk];
+        for (int i = begin; i < end; ++i) {
+            Entity *node = m_manager->data(handles.at(i));
+            const QVector<Light *> lights = node->renderComponents<Light>();
+            if (!lights.isEmpty())
+                result.lights.push_back(LightSource(node, lights));
+            const QVector<EnvironmentLight *> envLights = node->renderComponents<EnvironmentLight>();
+            result.environmentLightCount += envLights.size();
+            if (!envLights.isEmpty() && !result.environmentLight)
+                result.environmentLight = envLights.first();
+        }
+    }, this);
+
+    // Merge in handle order so that the first environment light wins as before
+    for (const LightGathererChunk &result : qAsConst(chunks)) {
+        m_lights += result.lights;
+        envLightCount += result.environmentLightCount;
+        if (!m_environmentLight)
+            m_environmentLight = result.environmentLight;
     }
 
     if (envLightCount > 1)
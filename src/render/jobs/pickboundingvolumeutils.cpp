@@ -52,6 +52,12 @@
 #include <Qt3DRender/private/segmentsvisitor_p.h>
 #include <Qt3DRender/private/pointsvisitor_p.h>
 #include <Qt3DRender/private/layer_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/geometry_p.h>
+#include <Qt3DRender/private/attribute_p.h>
+#include <Qt3DRender/private/buffer_p.h>
+#include <Qt3DRender/private/trianglebvh_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
 
 #include <vector>
 #include <algorithm>
@@ -210,6 +216,85 @@ bool TriangleCollisionVisitor::intersectsSegmentTriangle(uint andx, const Vector
     return intersected;
 }
 
+namespace {
+
+class TriangleGatherer : public TrianglesVisitor
+{
+public:
+    QVector<TriangleBvh::Triangle> triangles;
+
+    explicit TriangleGatherer(NodeManagers *manager)
+        : TrianglesVisitor(manager)
+    {
+    }
+
+private:
+    void visit(uint andx, const Vector3D &a,
+               uint bndx, const Vector3D &b,
+               uint cndx, const Vector3D &c) override
+    {
+        TriangleBvh::Triangle triangle;
+        const Vector3D *vertices[3] = { &a, &b, &c };
+        for (int i = 0; i < 3; ++i) {
+            triangle.vertices[i][0] = vertices[i]->x();
+            triangle.vertices[i][1] = vertices[i]->y();
+            triangle.vertices[i][2] = vertices[i]->z();
+        }
+        triangle.vertexIndices[0] = andx;
+        triangle.vertexIndices[1] = bndx;
+        triangle.vertexIndices[2] = cndx;
+        // Same numbering as TriangleCollisionVisitor::m_triangleIndex
+        triangle.primitiveIndex = uint(triangles.size());
+        triangles.push_back(triangle);
+    }
+};
+
+// Revisions of everything the triangles of renderer are read from
+QVector<int> triangleSourceRevisions(NodeManagers *manager, const GeometryRenderer *renderer)
+{
+    QVector<int> revisions;
+    revisions.push_back(renderer->revision());
+
+    const Geometry *geometry = manager->lookupResource<Geometry, GeometryManager>(renderer->geometryId());
+    if (!geometry)
+        return revisions;
+    revisions.push_back(geometry->revision());
+
+    const auto attributeIds = geometry->attributes();
+    for (const Qt3DCore::QNodeId attributeId : attributeIds) {
+        const Attribute *attribute = manager->lookupResource<Attribute, AttributeManager>(attributeId);
+        if (!attribute) {
+            revisions.push_back(-1);
+            continue;
+        }
+        revisions.push_back(attribute->revision());
+        const Buffer *buffer = manager->lookupResource<Buffer, BufferManager>(attribute->bufferId());
+        revisions.push_back(buffer ? buffer->revision() : -1);
+    }
+    return revisions;
+}
+
+// Returns the BVH cached on renderer, building it if the mesh changed
+QSharedPointer<TriangleBvh> triangleBvh(NodeManagers *manager, GeometryRenderer *renderer,
+                                        Qt3DCore::QNodeId entityId)
+{
+    const QVector<int> revisions = triangleSourceRevisions(manager, renderer);
+
+    QMutexLocker lock(renderer->triangleBvhMutex());
+    QSharedPointer<TriangleBvh> bvh = renderer->triangleBvh();
+    if (bvh && bvh->sourceRevisions() == revisions)
+        return bvh;
+
+    TriangleGatherer gatherer(manager);
+    gatherer.apply(renderer, entityId);
+    bvh.reset(new TriangleBvh(gatherer.triangles));
+    bvh->setSourceRevisions(revisions);
+    renderer->setTriangleBvh(bvh);
+    return bvh;
+}
+
+} // anonymous
+
 class LineCollisionVisitor : public SegmentsVisitor
 {
 public:
@@ -591,14 +676,74 @@ HitList TriangleCollisionGathererFunctor::pick(const Entity *entity) const
     if (!gRenderer)
         return result;
 
-    if (rayHitsEntity(entity)) {
+    if (!rayHitsEntity(entity))
+        return result;
+
+    bool invertible = false;
+    const QMatrix4x4 worldMatrix = convertToQMatrix4x4(*entity->worldTransform());
+    const QMatrix4x4 inverseWorldMatrix = worldMatrix.inverted(&invertible);
+    if (!invertible) {
+        // Cannot bring the ray into model space, test every triangle in world space
         TriangleCollisionVisitor visitor(m_manager, entity, m_ray, m_frontFaceRequested, m_backFaceRequested);
         visitor.apply(gRenderer, entity->peerId());
         result = visitor.hits;
-
         sortHits(result);
+        return result;
     }
 
+    // The segment parameter and barycentric coordinates returned by
+    // intersectsSegmentTriangle are preserved by affine transforms, so the
+    // test can be done in model space against the cached BVH. A mirroring
+    // transform flips the winding of every triangle though.
+    const Matrix4x4 toLocal(inverseWorldMatrix);
+    const Vector3D localOrigin = toLocal * m_ray.origin();
+    const Vector3D localEnd = toLocal * m_ray.point(m_ray.distance());
+    const Vector3D localSegment = localEnd - localOrigin;
+    const QRay3D localRay(localOrigin, localSegment, localSegment.length());
+    const bool mirrored = worldMatrix.determinant() < 0.0;
+
+    const auto addHit = [&] (const TriangleBvh::Triangle &triangle, uint andx, uint bndx, uint cndx,
+                             const Vector3D &uvw, float t) {
+        QCollisionQueryResult::Hit queryResult;
+        queryResult.m_type = QCollisionQueryResult::Hit::Triangle;
+        queryResult.m_entityId = entity->peerId();
+        queryResult.m_primitiveIndex = triangle.primitiveIndex;
+        queryResult.m_vertexIndex[0] = andx;
+        queryResult.m_vertexIndex[1] = bndx;
+        queryResult.m_vertexIndex[2] = cndx;
+        queryResult.m_uvw = uvw;
+        queryResult.m_intersection = m_ray.point(t * m_ray.distance());
+        queryResult.m_distance = m_ray.projectedDistance(queryResult.m_intersection);
+        result.push_back(queryResult);
+    };
+
+    // Same faces and vertex order as TriangleCollisionVisitor::visit
+    const auto testFace = [&] (const TriangleBvh::Triangle &triangle, int i0, int i1, int i2) {
+        float t = 0.0f;
+        Vector3D uvw;
+        if (!mirrored) {
+            if (!Render::intersectsSegmentTriangle(localRay, triangle.vertex(i0), triangle.vertex(i1),
+                                                   triangle.vertex(i2), uvw, t))
+                return false;
+        } else {
+            if (!Render::intersectsSegmentTriangle(localRay, triangle.vertex(i2), triangle.vertex(i1),
+                                                   triangle.vertex(i0), uvw, t))
+                return false;
+            uvw = Vector3D(uvw.z(), uvw.y(), uvw.x());
+        }
+        addHit(triangle, triangle.vertexIndices[i0], triangle.vertexIndices[i1],
+               triangle.vertexIndices[i2], uvw, t);
+        return true;
+    };
+
+    const QSharedPointer<TriangleBvh> bvh = triangleBvh(m_manager, gRenderer, entity->peerId());
+    bvh->traverse(localRay, [&] (const TriangleBvh::Triangle &triangle) {
+        const bool intersected = m_frontFaceRequested && testFace(triangle, 2, 1, 0);
+        if (!intersected && m_backFaceRequested)
+            testFace(triangle, 0, 1, 2);
+    });
+
+    sortHits(result);
     return result;
 }
 
@@ -725,8 +870,24 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
         Qt3DCore::QNodeIdVector recursiveLayers;
         int priority;
     };
+    // Entities the ray misses according to the spatial index would fail the
+    // bounding volume test below, don't walk down to them
+    const EntitySpatialIndex *spatialIndex = manager->entitySpatialIndex();
+    const bool useSpatialIndex = spatialIndex->isBuiltFor(root);
+    m_candidates.clear();
+    if (useSpatialIndex) {
+        spatialIndex->queryRay(m_ray, [this](Entity *entity) {
+            m_candidates.push_back(entity);
+        });
+        std::sort(m_candidates.begin(), m_candidates.end());
+    }
+    const auto isCandidate = [&](const Entity *entity) {
+        return !useSpatialIndex || std::binary_search(m_candidates.cbegin(), m_candidates.cend(), entity);
+    };
+
     std::vector<EntityData> worklist;
-    worklist.push_back({root, !root->componentHandle<ObjectPicker>().isNull(), {}, 0});
+    if (isCandidate(root))
+        worklist.push_back({root, !root->componentHandle<ObjectPicker>().isNull(), {}, 0});
 
     LayerManager *layerManager = manager->layerManager();
 
@@ -803,7 +964,7 @@ bool HierarchicalEntityPicker::collectHits(NodeManagers *manager, Entity *root)
         const auto childrenHandles = current.entity->childrenHandles();
         for (const HEntity &handle : childrenHandles) {
             Entity *child = manager->renderNodesManager()->data(handle);
-            if (child) {
+            if (child && isCandidate(child)) {
                 ObjectPicker *childPicker = child->renderComponent<ObjectPicker>();
                 worklist.push_back({child, current.hasObjectPicker || childPicker,
                                     current.recursiveLayers + recursiveLayers,
@@ -57,6 +57,8 @@
 #include <Qt3DRender/private/qraycastingservice_p.h>
 #include <Qt3DRender/qpickingsettings.h>
 
+#include <vector>
+
 
 QT_BEGIN_NAMESPACE
 
@@ -123,6 +125,9 @@ private:
     Qt3DCore::QNodeIdVector m_layerIds;
     QAbstractRayCaster::FilterMode m_filterMode;
     QHash<Qt3DCore::QNodeId, int> m_entityToPriorityTable;
+    // Entities hit according to the spatial index, sorted, kept around to
+    // reuse the storage from one pick to the next
+    std::vector<const Entity *> m_candidates;
 };
 
 struct Q_AUTOTEST_EXPORT AbstractCollisionGathererFunctor
@@ -46,6 +46,7 @@
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/sphere_p.h>
 #include <Qt3DRender/private/pickboundingvolumeutils_p.h>
+#include <Qt3DCore/private/qparallelfor_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -59,19 +60,17 @@ double approxRollingAverage(double avg, double input) {
     return avg;
 }
 
-class LODUpdateVisitor : public Qt3DRender::Render::EntityVisitor
+// Collects the entities whose LoD has to be evaluated
+class LODGatherVisitor : public Qt3DRender::Render::EntityVisitor
 {
 public:
-    LODUpdateVisitor(double filterValue, Qt3DRender::Render::FrameGraphNode *frameGraphRoot, Qt3DRender::Render::NodeManagers *manager)
+    LODGatherVisitor(Qt3DRender::Render::NodeManagers *manager)
         : Qt3DRender::Render::EntityVisitor(manager)
-        , m_filterValue(filterValue)
-        , m_frameGraphRoot(frameGraphRoot)
     {
-        m_updatedIndices.reserve(manager->levelOfDetailManager()->count());
+        m_lods.reserve(manager->levelOfDetailManager()->count());
     }
 
-    double filterValue() const { return m_filterValue; }
-    const QVector<QPair<Qt3DCore::QNodeId, int>> &updatedIndices() const { return m_updatedIndices; }
+    const QVector<QPair<Qt3DRender::Render::Entity *, Qt3DRender::Render::LevelOfDetail *>> &lods() const { return m_lods; }
 
     Operation visit(Qt3DRender::Render::Entity *entity = nullptr) override {
         using namespace Qt3DRender;
@@ -84,30 +83,48 @@ public:
         if (!lods.empty()) {
             LevelOfDetail* lod = lods.front();  // other lods are ignored
 
-            if (lod->isEnabled() && !lod->thresholds().isEmpty()) {
-                switch (lod->thresholdType()) {
-                case QLevelOfDetail::DistanceToCameraThreshold:
-                    updateEntityLodByDistance(entity, lod);
-                    break;
-                case QLevelOfDetail::ProjectedScreenPixelSizeThreshold:
-                    updateEntityLodByScreenArea(entity, lod);
-                    break;
-                default:
-                    Q_ASSERT(false);
-                    break;
-                }
-            }
+            if (lod->isEnabled() && !lod->thresholds().isEmpty())
+                m_lods.push_back({entity, lod});
         }
 
         return Continue;
     }
 
 private:
-    double m_filterValue = 0.;
+    QVector<QPair<Qt3DRender::Render::Entity *, Qt3DRender::Render::LevelOfDetail *>> m_lods;
+};
+
+// Computes the threshold index matching the current view, -1 if there is none
+class LODIndexEvaluator
+{
+public:
+    LODIndexEvaluator(Qt3DRender::Render::FrameGraphNode *frameGraphRoot, Qt3DRender::Render::NodeManagers *manager)
+        : m_frameGraphRoot(frameGraphRoot)
+        , m_manager(manager)
+    {
+    }
+
+    int evaluate(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod) const
+    {
+        using namespace Qt3DRender;
+
+        switch (lod->thresholdType()) {
+        case QLevelOfDetail::DistanceToCameraThreshold:
+            return lodIndexByDistance(entity, lod);
+        case QLevelOfDetail::ProjectedScreenPixelSizeThreshold:
+            return lodIndexByScreenArea(entity, lod);
+        default:
+            Q_ASSERT(false);
+            break;
+        }
+        return -1;
+    }
+
+private:
     Qt3DRender::Render::FrameGraphNode *m_frameGraphRoot;
-    QVector<QPair<Qt3DCore::QNodeId, int>> m_updatedIndices;
+    Qt3DRender::Render::NodeManagers *m_manager;
 
-    void updateEntityLodByDistance(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod)
+    int lodIndexByDistance(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod) const
     {
         using namespace Qt3DRender;
         using namespace Qt3DRender::Render;
@@ -115,7 +132,7 @@ private:
         Matrix4x4 viewMatrix;
         Matrix4x4 projectionMatrix;
         if (!Render::CameraLens::viewMatrixForCamera(m_manager->renderNodesManager(), lod->camera(), viewMatrix, projectionMatrix))
-            return;
+            return -1;
 
         const QVector<qreal> thresholds = lod->thresholds();
         Vector3D center(lod->center());
@@ -129,19 +146,13 @@ private:
         const float dist = tcenter.length();
         const int n = thresholds.size();
         for (int i=0; i<n; ++i) {
-            if (dist <= thresholds[i] || i == n -1) {
-                m_filterValue = approxRollingAverage<30>(m_filterValue, i);
-                i = qBound(0, static_cast<int>(qRound(m_filterValue)), n - 1);
-                if (lod->currentIndex() != i) {
-                    lod->setCurrentIndex(i);
-                    m_updatedIndices.push_back({lod->peerId(), i});
-                }
-                break;
-            }
+            if (dist <= thresholds[i] || i == n -1)
+                return i;
         }
+        return -1;
     }
 
-    void updateEntityLodByScreenArea(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod)
+    int lodIndexByScreenArea(Qt3DRender::Render::Entity *entity, Qt3DRender::Render::LevelOfDetail *lod) const
     {
         using namespace Qt3DRender;
         using namespace Qt3DRender::Render;
@@ -149,12 +160,12 @@ private:
         Matrix4x4 viewMatrix;
         Matrix4x4 projectionMatrix;
         if (!Render::CameraLens::viewMatrixForCamera(m_manager->renderNodesManager(), lod->camera(), viewMatrix, projectionMatrix))
-            return;
+            return -1;
 
         PickingUtils::ViewportCameraAreaGatherer vcaGatherer(lod->camera());
         const QVector<PickingUtils::ViewportCameraAreaDetails> vcaTriplets = vcaGatherer.gather(m_frameGraphRoot);
         if (vcaTriplets.isEmpty())
-            return;
+            return -1;
 
         const PickingUtils::ViewportCameraAreaDetails &vca = vcaTriplets.front();
 
@@ -175,16 +186,10 @@ private:
 
         const int n = thresholds.size();
         for (int i = 0; i < n; ++i) {
-            if (thresholds[i] < area || i == n -1) {
-                m_filterValue = approxRollingAverage<30>(m_filterValue, i);
-                i = qBound(0, static_cast<int>(qRound(m_filterValue)), n - 1);
-                if (lod->currentIndex() != i) {
-                    lod->setCurrentIndex(i);
-                    m_updatedIndices.push_back({lod->peerId(), i});
-                }
-                break;
-            }
+            if (thresholds[i] < area || i == n -1)
+                return i;
         }
+        return -1;
     }
 
     QRect windowViewport(const QSize &area, const QRectF &relativeViewport) const
@@ -260,10 +265,34 @@ void UpdateLevelOfDetailJob::run()
     if (m_manager->levelOfDetailManager()->count() == 0)
         return;
 
-    LODUpdateVisitor visitor(m_filterValue, m_frameGraphRoot, m_manager);
+    LODGatherVisitor visitor(m_manager);
     visitor.apply(m_root);
-    m_filterValue = visitor.filterValue();
-    d->m_updatedIndices = visitor.updatedIndices();
+    const auto &lods = visitor.lods();
+
+    // Evaluating the thresholds is what costs, do it in parallel
+    const LODIndexEvaluator evaluator(m_frameGraphRoot, m_manager);
+    QVector<int> lodIndices(lods.size());
+    const Qt3DCore::QParallelFor parallelFor(lods.size(), 64);
+    parallelFor.run([&](int, int begin, int end) {
+        for (int i = begin; i < end; ++i)
+            lodIndices[i] = evaluator.evaluate(lods.at(i).first, lods.at(i).second);
+    }, this);
+
+    // The filter value is a rolling average over all LoDs in traversal order
+    d->m_updatedIndices.clear();
+    for (int i = 0, m = lods.size(); i < m; ++i) {
+        int lodIndex = lodIndices.at(i);
+        if (lodIndex < 0)
+            continue;
+        LevelOfDetail *lod = lods.at(i).second;
+        const int n = lod->thresholds().size();
+        m_filterValue = approxRollingAverage<30>(m_filterValue, lodIndex);
+        lodIndex = qBound(0, static_cast<int>(qRound(m_filterValue)), n - 1);
+        if (lod->currentIndex() != lodIndex) {
+            lod->setCurrentIndex(lodIndex);
+            d->m_updatedIndices.push_back({lod->peerId(), lodIndex});
+        }
+    }
 }
 
 bool UpdateLevelOfDetailJobPrivate::isRequired()
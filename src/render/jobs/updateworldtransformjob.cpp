@@ -50,6 +50,9 @@
 #include <Qt3DRender/private/nodemanagers_p.h>
 
 #include <QThread>
+#if QT_CONFIG(concurrent)
+#include <QtConcurrent/QtConcurrent>
+#endif
 
 QT_BEGIN_NAMESPACE
 
@@ -64,32 +67,123 @@ struct TransformUpdate
     QMatrix4x4 worldTransformMatrix;
 };
 
-void updateWorldTransformAndBounds(NodeManagers *manager, Entity *node, const Matrix4x4 &parentTransform, QVector<TransformUpdate> &updatedTransforms)
+// Root of a subtree that can be processed independently from the others. We
+// keep a pointer to the parent world matrix rather than a copy to avoid
+// alignment issues when passing these around through QtConcurrent.
+struct SubtreeRoot
 {
+    Entity *node;
+    const Matrix4x4 *parentTransform;
+    // true if the parent world transform has changed, in which case the
+    // whole subtree has to be updated regardless of its dirty flags
+    bool parentChanged;
+};
+
+// Computes the world transform of node from its parent world transform if
+// node or one of its ancestors is dirty. Returns whether the children of
+// node need to be visited, and in childrenNeedUpdate whether they need to be
+// updated because the world transform of node has changed.
+bool updateNodeWorldTransform(const SubtreeRoot &subtree, bool &childrenNeedUpdate, QVector<TransformUpdate> &updatedTransforms)
+{
+    Entity *node = subtree.node;
+    childrenNeedUpdate = false;
+
+    // Dirty flags of disabled subtrees are left untouched,
+    // they will be processed once the entity is enabled again
     if (!node->isEnabled())
-        return;
+        return false;
 
-    Matrix4x4 worldTransform(parentTransform);
-    Transform *nodeTransform = node->renderComponent<Transform>();
+    const bool needsUpdate = subtree.parentChanged || node->isTransformDirty();
+    const bool hasDirtyChildren = node->hasTransformDirtyChildren();
+    node->unsetTransformDirty();
 
-    const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
-    if (hasTransformComponent)
-        worldTransform = worldTransform * nodeTransform->transformMatrix();
+    if (needsUpdate) {
+        Matrix4x4 worldTransform(*subtree.parentTransform);
+        Transform *nodeTransform = node->renderComponent<Transform>();
 
-    if (*(node->worldTransform()) != worldTransform) {
-        *(node->worldTransform()) = worldTransform;
+        const bool hasTransformComponent = nodeTransform != nullptr && nodeTransform->isEnabled();
         if (hasTransformComponent)
-            updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
+            worldTransform = worldTransform * nodeTransform->transformMatrix();
+
+        if (*(node->worldTransform()) != worldTransform) {
+            *(node->worldTransform()) = worldTransform;
+            childrenNeedUpdate = true;
+            if (hasTransformComponent)
+                updatedTransforms.push_back({nodeTransform->peerId(), convertToQMatrix4x4(worldTransform)});
+        }
     }
 
-    const auto childrenHandles = node->childrenHandles();
+    return childrenNeedUpdate || hasDirtyChildren;
+}
+
+void updateWorldTransformAndBounds(NodeManagers *manager, const SubtreeRoot &subtree, QVector<TransformUpdate> &updatedTransforms)
+{
+    bool childrenNeedUpdate = false;
+    if (!updateNodeWorldTransform(subtree, childrenNeedUpdate, updatedTransforms))
+        return;
+
+    const Matrix4x4 *worldTransform = subtree.node->worldTransform();
+    const auto childrenHandles = subtree.node->childrenHandles();
     for (const HEntity &handle : childrenHandles) {
         Entity *child = manager->renderNodesManager()->data(handle);
         if (child)
-            updateWorldTransformAndBounds(manager, child, worldTransform, updatedTransforms);
+            updateWorldTransformAndBounds(manager, { child, worldTransform, childrenNeedUpdate }, updatedTransforms);
     }
 }
 
+// Processes the hierarchy breadth first, level by level, until we have
+// gathered enough independent subtrees to keep all the threads busy
+QVector<SubtreeRoot> splitIntoSubtrees(NodeManagers *manager,
+                                       const SubtreeRoot &root,
+                                       int subtreeCount,
+                                       QVector<TransformUpdate> &updatedTransforms)
+{
+    QVector<SubtreeRoot> level = { root };
+    QVector<SubtreeRoot> nextLevel;
+
+    while (!level.empty() && level.size() < subtreeCount) {
+        nextLevel.clear();
+        for (const SubtreeRoot &subtree : qAsConst(level)) {
+            bool childrenNeedUpdate = false;
+            if (!updateNodeWorldTransform(subtree, childrenNeedUpdate, updatedTransforms))
+                continue;
+
+            const Matrix4x4 *worldTransform = subtree.node->worldTransform();
+            const auto childrenHandles = subtree.node->childrenHandles();
+            for (const HEntity &handle : childrenHandles) {
+                Entity *child = manager->renderNodesManager()->data(handle);
+                if (child)
+                    nextLevel.push_back({ child, worldTransform, childrenNeedUpdate });
+            }
+        }
+        level.swap(nextLevel);
+    }
+
+    return level;
+}
+
+struct UpdateSubtreeFunctor
+{
+    NodeManagers *manager;
+
+    // This define is required to work with QtConcurrent
+    typedef QVector<TransformUpdate> result_type;
+    QVector<TransformUpdate> operator ()(const SubtreeRoot &subtree) const
+    {
+        QVector<TransformUpdate> updatedTransforms;
+        updateWorldTransformAndBounds(manager, subtree, updatedTransforms);
+        return updatedTransforms;
+    }
+};
+
+struct ReduceTransformUpdatesFunctor
+{
+    void operator ()(QVector<TransformUpdate> &result, const QVector<TransformUpdate> &values)
+    {
+        result += values;
+    }
+};
+
 }
 
 class Q_3DRENDERSHARED_PRIVATE_EXPORT UpdateWorldTransformJobPrivate : public Qt3DCore::QAspectJobPrivate
@@ -107,6 +201,7 @@ UpdateWorldTransformJob::UpdateWorldTransformJob()
     : Qt3DCore::QAspectJob(*new UpdateWorldTransformJobPrivate())
     , m_node(nullptr)
     , m_manager(nullptr)
+    , m_parallelUpdate(true)
 {
     SET_JOB_RUN_STAT_TYPE(this, JobTypes::UpdateTransform, 0)
 }
@@ -121,23 +216,57 @@ void UpdateWorldTransformJob::setManagers(NodeManagers *manager)
     m_manager = manager;
 }
 
+void UpdateWorldTransformJob::setParallelUpdateEnabled(bool enabled)
+{
+    m_parallelUpdate = enabled;
+}
+
+bool UpdateWorldTransformJob::isParallelUpdateEnabled() const
+{
+    return m_parallelUpdate;
+}
+
 void UpdateWorldTransformJob::run()
 {
     // Iterate over each level of hierarchy in our scene
     // and update each node's world transform from its
     // local transform and its parent's world transform
 
-    // TODO: Parallelise this on each level using a parallel_for
-    // implementation.
-
     Q_D(UpdateWorldTransformJob);
     qCDebug(Jobs) << "Entering" << Q_FUNC_INFO << QThread::currentThread();
 
+    // Only subtrees containing entities flagged with markTransformDirty are
+    // visited, world transforms of clean subtrees are left untouched
     Matrix4x4 parentTransform;
     Entity *parent = m_node->parent();
     if (parent != nullptr)
         parentTransform = *(parent->worldTransform());
-    updateWorldTransformAndBounds(m_manager, m_node, parentTransform, d->m_updatedTransforms);
+    const SubtreeRoot root = { m_node, &parentTransform, false };
+
+#if QT_CONFIG(concurrent)
+    if (m_parallelUpdate) {
+        // Walk the first levels of the tree until we have enough independent
+        // subtrees, then update each of these subtrees on the thread pool.
+        // Each subtree records its own updates which are merged for postFrame
+        const int subtreeCount = QThread::idealThreadCount() * 4;
+        const QVector<SubtreeRoot> subtrees = splitIntoSubtrees(m_manager,
+                                                                root,
+                                                                subtreeCount,
+                                                                d->m_updatedTransforms);
+        if (subtrees.size() > 1) {
+            UpdateSubtreeFunctor functor;
+            functor.manager = m_manager;
+            ReduceTransformUpdatesFunctor reduceFunctor;
+            d->m_updatedTransforms += QtConcurrent::blockingMappedReduced<QVector<TransformUpdate>>(subtrees, functor, reduceFunctor);
+        } else {
+            for (const SubtreeRoot &subtree : subtrees)
+                updateWorldTransformAndBounds(m_manager, subtree, d->m_updatedTransforms);
+        }
+    } else
+#endif
+    {
+        updateWorldTransformAndBounds(m_manager, root, d->m_updatedTransforms);
+    }
 
     qCDebug(Jobs) << "Exiting" << Q_FUNC_INFO << QThread::currentThread();
 }
@@ -73,11 +73,15 @@ public:
     void setRoot(Entity *root);
     void setManagers(NodeManagers *manager);
 
+    void setParallelUpdateEnabled(bool enabled);
+    bool isParallelUpdateEnabled() const;
+
     void run() override;
 
 private:
     Entity *m_node;
     NodeManagers *m_manager;
+    bool m_parallelUpdate;
     Q_DECLARE_PRIVATE(UpdateWorldTransformJob)
 };
 
@@ -174,6 +174,25 @@
         \li {3, 1} const int maxJoints = 100; \br uniform mat4 skinningPalette[maxJoints];
 
     \endtable
+
+    With the OpenGL renderer on OpenGL 4.3 and later, a shader can read the
+    model matrix of each draw from a \c qt3d_DrawData shader storage block
+    instead of the \c modelMatrix uniform. Draws of different entities sharing
+    the same material and geometry layout can then be submitted with a single
+    multi draw call.
+
+    \badcode
+    #extension GL_ARB_shader_draw_parameters : require
+    layout(std430) readonly buffer qt3d_DrawData {
+        mat4 modelMatrices[];
+    };
+
+    void main()
+    {
+        mat4 modelMatrix = modelMatrices[gl_DrawIDARB];
+        ...
+    }
+    \endcode
 */
 
 /*!
@@ -306,6 +325,25 @@
         \li {3, 1} const int maxJoints = 100; \br uniform mat4 skinningPalette[maxJoints];
 
     \endtable
+
+    With the OpenGL renderer on OpenGL 4.3 and later, a shader can read the
+    model matrix of each draw from a \c qt3d_DrawData shader storage block
+    instead of the \c modelMatrix uniform. Draws of different entities sharing
+    the same material and geometry layout can then be submitted with a single
+    multi draw call.
+
+    \badcode
+    #extension GL_ARB_shader_draw_parameters : require
+    layout(std430) readonly buffer qt3d_DrawData {
+        mat4 modelMatrices[];
+    };
+
+    void main()
+    {
+        mat4 modelMatrix = modelMatrices[gl_DrawIDARB];
+        ...
+    }
+    \endcode
 */
 
 /*!
@@ -45,6 +45,7 @@
 #include <private/qbackendnode_p.h>
 #include <private/managers_p.h>
 #include <private/nodemanagers_p.h>
+#include <private/stringtoint_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -57,10 +58,17 @@ namespace {
 
 const int qNodeIdTypeId = qMetaTypeId<Qt3DCore::QNodeId>();
 
+uint nextRevision()
+{
+    static QAtomicInteger<uint> revision;
+    return ++revision;
+}
+
 }
 
 ShaderData::ShaderData()
     : m_managers(nullptr)
+    , m_revision(0)
 {
 }
 
@@ -127,6 +135,7 @@ void ShaderData::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
             }
             m_originalProperties.insert(propertyName, { propertyValue, isNested, isTransformed });
         }
+        m_revision = nextRevision();
         BackendNode::markDirty(AbstractRenderer::ParameterDirty);
     } else {
         // Updates
@@ -138,9 +147,15 @@ void ShaderData::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
                 const QVariant newValue = m_propertyReader->readProperty(node->property(it.key().toLatin1()));
                 PropertyValue &propValue = it.value();
                 if (propValue.value != newValue) {
+                    // The element names depend on the size of lists
+                    if (newValue.userType() == QMetaType::QVariantList) {
+                        QWriteLocker lock(&m_propertyNameIdsLock);
+                        m_propertyNameIds.clear();
+                    }
                     // Note we aren't notified about nested QShaderData in this call
                     // only scalar / vec properties
                     propValue.value = newValue;
+                    m_revision = nextRevision();
                     BackendNode::markDirty(AbstractRenderer::ParameterDirty);
                 }
                 ++it;
@@ -149,6 +164,36 @@ void ShaderData::syncFromFrontEnd(const QNode *frontEnd, bool firstTime)
     }
 }
 
+QVector<ShaderData::PropertyNameIds> ShaderData::propertyNameIds(int blockNameId) const
+{
+    {
+        QReadLocker lock(&m_propertyNameIdsLock);
+        const auto it = m_propertyNameIds.constFind(blockNameId);
+        if (it != m_propertyNameIds.constEnd())
+            return it.value();
+    }
+
+    const QString blockName = StringToInt::lookupString(blockNameId);
+    QVector<PropertyNameIds> nameIds;
+    nameIds.reserve(m_originalProperties.size());
+    for (auto it = m_originalProperties.cbegin(), end = m_originalProperties.cend(); it != end; ++it) {
+        const QString name = blockName + QLatin1Char('.') + it.key();
+        PropertyNameIds propertyNameIds;
+        propertyNameIds.nameId = StringToInt::lookupId(name);
+        if (it.value().value.userType() == QMetaType::QVariantList) {
+            const int elementCount = qMax(1, it.value().value.value<QVariantList>().size());
+            propertyNameIds.elementNameIds.reserve(elementCount);
+            for (int i = 0; i < elementCount; ++i)
+                propertyNameIds.elementNameIds.push_back(StringToInt::lookupId(name + QLatin1Char('[') + QString::number(i) + QLatin1Char(']')));
+        }
+        nameIds.push_back(propertyNameIds);
+    }
+
+    QWriteLocker lock(&m_propertyNameIdsLock);
+    m_propertyNameIds.insert(blockNameId, nameIds);
+    return nameIds;
+}
+
 ShaderData *ShaderData::lookupResource(NodeManagers *managers, QNodeId id)
 {
     return managers->shaderDataManager()->lookupResource(id);
@@ -172,16 +217,9 @@ QVariant ShaderData::getTransformedProperty(const QString &name, const Matrix4x4
             if (transformedIt != m_originalProperties.constEnd()) {
                 const PropertyValue &transformedValue = transformedIt.value();
                 const TransformType transformType = static_cast<TransformType>(transformedValue.value.toInt());
-                switch (transformType) {
-                case ModelToEye:
-                    return QVariant::fromValue(viewMatrix * m_worldMatrix * Vector3D(propertyValue.value.value<QVector3D>()));
-                case ModelToWorld:
-                    return QVariant::fromValue(m_worldMatrix * Vector3D(propertyValue.value.value<QVector3D>()));
-                case ModelToWorldDirection:
-                    return QVariant::fromValue(Vector3D(m_worldMatrix * Vector4D(propertyValue.value.value<QVector3D>(), 0.0f)));
-                case NoTransform:
-                    break;
-                }
+                if (transformType != NoTransform)
+                    return QVariant::fromValue(transformedVector(Vector3D(propertyValue.value.value<QVector3D>()),
+                                                                 transformType, viewMatrix));
             }
         }
         return propertyValue.value;
@@ -189,7 +227,21 @@ QVariant ShaderData::getTransformedProperty(const QString &name, const Matrix4x4
     return QVariant();
 }
 
-// Unit tests only
+Vector3D ShaderData::transformedVector(const Vector3D &vector, TransformType transformType, const Matrix4x4 &viewMatrix) const
+{
+    switch (transformType) {
+    case ModelToEye:
+        return viewMatrix * m_worldMatrix * vector;
+    case ModelToWorld:
+        return m_worldMatrix * vector;
+    case ModelToWorldDirection:
+        return Vector3D(m_worldMatrix * Vector4D(vector, 0.0f));
+    case NoTransform:
+        break;
+    }
+    return vector;
+}
+
 ShaderData::TransformType ShaderData::propertyTransformType(const QString &name) const
 {
     const auto it = m_originalProperties.constFind(name);
@@ -221,6 +273,8 @@ RenderShaderDataFunctor::RenderShaderDataFunctor(AbstractRenderer *renderer, Nod
 Qt3DCore::QBackendNode *RenderShaderDataFunctor::create(Qt3DCore::QNodeId id) const
 {
     ShaderData *backend = m_managers->shaderDataManager()->getOrCreateResource(id);
+    // Remove id from cleanup list if it's there
+    m_managers->shaderDataManager()->removeShaderDataIdToCleanup(id);
     backend->setManagers(m_managers);
     backend->setRenderer(m_renderer);
     return backend;
@@ -234,6 +288,8 @@ Qt3DCore::QBackendNode *RenderShaderDataFunctor::get(Qt3DCore::QNodeId id) const
 void RenderShaderDataFunctor::destroy(Qt3DCore::QNodeId id) const
 {
     m_managers->shaderDataManager()->releaseResource(id);
+    // Lets the renderer drop what it cached for the ShaderData
+    m_managers->shaderDataManager()->addShaderDataIdToCleanup(id);
 }
 
 } // namespace Render
@@ -54,6 +54,7 @@
 #include <Qt3DRender/private/backendnode_p.h>
 #include <Qt3DRender/qshaderdata.h>
 #include <QMutex>
+#include <QReadWriteLock>
 #include <Qt3DCore/private/matrix4x4_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -81,19 +82,32 @@ public:
         bool isTransformed;
     };
 
+    // Interned uniform names of a property, see propertyNameIds()
+    struct PropertyNameIds {
+        int nameId; // block.property
+        QVector<int> elementNameIds; // block.property[i], for list properties
+    };
+
     ShaderData();
     ~ShaderData();
 
     QHash<QString, PropertyValue> properties() const { return m_originalProperties; }
 
+    // Uniform name ids of each property, in properties() order, when this
+    // ShaderData is used as the block or struct named blockNameId
+    QVector<PropertyNameIds> propertyNameIds(int blockNameId) const;
+
     // Called by FramePreparationJob
     void updateWorldTransform(const Matrix4x4 &worldMatrix);
 
     QVariant getTransformedProperty(const QString &name, const Matrix4x4 &viewMatrix);
+    Vector3D transformedVector(const Vector3D &vector, TransformType transformType, const Matrix4x4 &viewMatrix) const;
 
-    // Unit tests purposes only
     TransformType propertyTransformType(const QString &name) const;
 
+    // Changes whenever a property value changes, unique across ShaderData
+    uint revision() const { return m_revision; }
+
     void setManagers(NodeManagers *managers);
 
     void syncFromFrontEnd(const Qt3DCore::QNode *frontEnd, bool firstTime) override;
@@ -112,6 +126,11 @@ protected:
 
     Matrix4x4 m_worldMatrix;
     NodeManagers *m_managers;
+    uint m_revision;
+
+    // Render views look these up concurrently
+    mutable QReadWriteLock m_propertyNameIdsLock;
+    mutable QHash<int, QVector<PropertyNameIds>> m_propertyNameIds;
 
     static ShaderData *lookupResource(NodeManagers *managers, Qt3DCore::QNodeId id);
     ShaderData *lookupResource(Qt3DCore::QNodeId id);
@@ -7,7 +7,8 @@ HEADERS += \
     $$PWD/qboundingvolumeprovider_p.h \
     $$PWD/qcollisionqueryresult_p.h \
     $$PWD/qray3d_p.h \
-    $$PWD/qraycastingservice_p.h
+    $$PWD/qraycastingservice_p.h \
+    $$PWD/trianglebvh_p.h
 
 SOURCES += \
     $$PWD/qabstractcollisionqueryservice.cpp \
@@ -16,4 +17,5 @@ SOURCES += \
     $$PWD/qboundingvolumeprovider.cpp \
     $$PWD/qcollisionqueryresult.cpp \
     $$PWD/qray3d.cpp \
-    $$PWD/qraycastingservice.cpp
+    $$PWD/qraycastingservice.cpp \
+    $$PWD/trianglebvh.cpp
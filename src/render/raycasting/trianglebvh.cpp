@@ -0,0 +1,270 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "trianglebvh_p.h"
+
+#include <algorithm>
+#include <cfloat>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+namespace RayCasting {
+
+namespace {
+
+const int BinCount = 16;
+
+struct Bounds
+{
+    float min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+    float max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+
+    void expand(const float *pmin, const float *pmax)
+    {
+        for (int i = 0; i < 3; ++i) {
+            min[i] = std::min(min[i], pmin[i]);
+            max[i] = std::max(max[i], pmax[i]);
+        }
+    }
+
+    void expand(const Bounds &other) { expand(other.min, other.max); }
+
+    bool isEmpty() const { return min[0] > max[0]; }
+
+    float area() const
+    {
+        if (isEmpty())
+            return 0.0f;
+        const float dx = max[0] - min[0];
+        const float dy = max[1] - min[1];
+        const float dz = max[2] - min[2];
+        return dx * dy + dy * dz + dz * dx;
+    }
+};
+
+} // anonymous
+
+TriangleBvh::TriangleBvh(const QVector<Triangle> &triangles)
+{
+    const int triangleCount = triangles.size();
+    if (triangleCount == 0)
+        return;
+
+    m_bounds.resize(triangleCount * 6);
+    m_centroids.resize(triangleCount * 3);
+    QVector<int> order(triangleCount);
+    for (int t = 0; t < triangleCount; ++t) {
+        const Triangle &triangle = triangles.at(t);
+        float *bounds = m_bounds.data() + t * 6;
+        float *centroid = m_centroids.data() + t * 3;
+        for (int i = 0; i < 3; ++i) {
+            const float a = triangle.vertices[0][i];
+            const float b = triangle.vertices[1][i];
+            const float c = triangle.vertices[2][i];
+            bounds[i] = std::min(a, std::min(b, c));
+            bounds[3 + i] = std::max(a, std::max(b, c));
+            centroid[i] = (bounds[i] + bounds[3 + i]) * 0.5f;
+        }
+        order[t] = t;
+    }
+
+    // Worst case is a node per triangle for the leaves plus the inner nodes
+    m_nodes.reserve(2 * triangleCount);
+    build(order, 0, triangleCount, 0);
+
+    m_triangles.reserve(triangleCount);
+    for (int t : qAsConst(order))
+        m_triangles.push_back(triangles.at(t));
+
+    m_bounds.clear();
+    m_bounds.squeeze();
+    m_centroids.clear();
+    m_centroids.squeeze();
+}
+
+// Returns the index of the node created for order[begin, end)
+int TriangleBvh::build(QVector<int> &order, int begin, int end, int depth)
+{
+    const int nodeIndex = m_nodes.size();
+    m_nodes.push_back(Node());
+
+    Bounds bounds;
+    Bounds centroidBounds;
+    for (int i = begin; i < end; ++i) {
+        const int t = order.at(i);
+        bounds.expand(m_bounds.constData() + t * 6, m_bounds.constData() + t * 6 + 3);
+        const float *centroid = m_centroids.constData() + t * 3;
+        centroidBounds.expand(centroid, centroid);
+    }
+
+    // Pad a little so that rays grazing a face or an edge still reach it
+    {
+        Node &node = m_nodes[nodeIndex];
+        for (int i = 0; i < 3; ++i) {
+            const float padding = (bounds.max[i] - bounds.min[i]) * 1e-5f + 1e-6f;
+            node.min[i] = bounds.min[i] - padding;
+            node.max[i] = bounds.max[i] + padding;
+        }
+    }
+
+    const int count = end - begin;
+    const auto makeLeaf = [&] {
+        Node &node = m_nodes[nodeIndex];
+        node.offset = begin;
+        node.count = count;
+        return nodeIndex;
+    };
+
+    if (count <= MaxLeafSize || depth >= MaxDepth - 1)
+        return makeLeaf();
+
+    // Split along the axis with the largest centroid extent
+    int axis = 0;
+    for (int i = 1; i < 3; ++i) {
+        if (centroidBounds.max[i] - centroidBounds.min[i] > centroidBounds.max[axis] - centroidBounds.min[axis])
+            axis = i;
+    }
+    const float axisMin = centroidBounds.min[axis];
+    const float axisExtent = centroidBounds.max[axis] - axisMin;
+
+    int mid = begin;
+    if (axisExtent > 0.0f) {
+        // Binned SAH
+        Bounds binBounds[BinCount];
+        int binCounts[BinCount] = {};
+        const float binScale = BinCount / axisExtent;
+        const auto binOf = [&] (int t) {
+            const int bin = int((m_centroids.at(t * 3 + axis) - axisMin) * binScale);
+            return qBound(0, bin, BinCount - 1);
+        };
+        for (int i = begin; i < end; ++i) {
+            const int t = order.at(i);
+            const int bin = binOf(t);
+            ++binCounts[bin];
+            binBounds[bin].expand(m_bounds.constData() + t * 6, m_bounds.constData() + t * 6 + 3);
+        }
+
+        // Sweep from the right to get the cost of every right hand side
+        float rightCosts[BinCount] = {};
+        Bounds rightBounds;
+        int rightCount = 0;
+        for (int bin = BinCount - 1; bin > 0; --bin) {
+            rightBounds.expand(binBounds[bin]);
+            rightCount += binCounts[bin];
+            rightCosts[bin] = rightBounds.area() * rightCount;
+        }
+
+        Bounds leftBounds;
+        int leftCount = 0;
+        int bestSplit = -1;
+        float bestCost = FLT_MAX;
+        for (int bin = 0; bin < BinCount - 1; ++bin) {
+            leftBounds.expand(binBounds[bin]);
+            leftCount += binCounts[bin];
+            if (leftCount == 0 || leftCount == count)
+                continue;
+            const float cost = leftBounds.area() * leftCount + rightCosts[bin + 1];
+            if (cost < bestCost) {
+                bestCost = cost;
+                bestSplit = bin;
+            }
+        }
+
+        if (bestSplit >= 0) {
+            mid = int(std::partition(order.begin() + begin, order.begin() + end,
+                                     [&] (int t) { return binOf(t) <= bestSplit; }) - order.begin());
+        }
+    }
+
+    // All centroids in the same spot or in the same bin, split in the middle
+    if (mid == begin || mid == end) {
+        mid = begin + count / 2;
+        std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                         [&] (int a, int b) {
+            return m_centroids.at(a * 3 + axis) < m_centroids.at(b * 3 + axis);
+        });
+    }
+
+    build(order, begin, mid, depth + 1);
+    const int rightIndex = build(order, mid, end, depth + 1);
+    Node &node = m_nodes[nodeIndex];
+    node.offset = rightIndex;
+    node.count = 0;
+    return nodeIndex;
+}
+
+TriangleBvh::SegmentQuery::SegmentQuery(const QRay3D &ray)
+    : length(ray.distance())
+{
+    const Vector3D o = ray.origin();
+    const Vector3D d = ray.direction();
+    for (int i = 0; i < 3; ++i) {
+        origin[i] = o[i];
+        parallel[i] = qFuzzyIsNull(d[i]);
+        invDirection[i] = parallel[i] ? 0.0f : 1.0f / d[i];
+    }
+}
+
+bool TriangleBvh::SegmentQuery::intersects(const Node &node) const
+{
+    float tmin = 0.0f;
+    float tmax = length;
+    for (int i = 0; i < 3; ++i) {
+        if (parallel[i]) {
+            if (origin[i] < node.min[i] || origin[i] > node.max[i])
+                return false;
+            continue;
+        }
+        float t1 = (node.min[i] - origin[i]) * invDirection[i];
+        float t2 = (node.max[i] - origin[i]) * invDirection[i];
+        if (t1 > t2)
+            std::swap(t1, t2);
+        tmin = std::max(tmin, t1);
+        tmax = std::min(tmax, t2);
+        if (tmin > tmax)
+            return false;
+    }
+    return true;
+}
+
+} // namespace RayCasting
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
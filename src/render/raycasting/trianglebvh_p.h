@@ -0,0 +1,162 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QT3DRENDER_TRIANGLEBVH_P_H
+#define QT3DRENDER_TRIANGLEBVH_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists for the convenience
+// of other Qt classes.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <Qt3DRender/private/qray3d_p.h>
+#include <Qt3DRender/private/qt3drender_global_p.h>
+#include <Qt3DCore/private/vector3d_p.h>
+#include <QtCore/QVector>
+
+QT_BEGIN_NAMESPACE
+
+namespace Qt3DRender {
+namespace RayCasting {
+
+// Bounding volume hierarchy over the triangles of a mesh, in model space.
+// Built with binned SAH splits and stored as a flat, depth first node array.
+class Q_3DRENDERSHARED_PRIVATE_EXPORT TriangleBvh
+{
+public:
+    enum {
+        MaxLeafSize = 4,
+        MaxDepth = 64
+    };
+
+    struct Triangle
+    {
+        float vertices[3][3];
+        uint vertexIndices[3];
+        uint primitiveIndex;
+
+        Vector3D vertex(int i) const { return Vector3D(vertices[i][0], vertices[i][1], vertices[i][2]); }
+    };
+
+    explicit TriangleBvh(const QVector<Triangle> &triangles);
+
+    int triangleCount() const { return m_triangles.size(); }
+    int nodeCount() const { return m_nodes.size(); }
+    const QVector<Triangle> &triangles() const { return m_triangles; }
+
+    // Revisions of the data the triangles were read from, set by the owner
+    QVector<int> sourceRevisions() const { return m_sourceRevisions; }
+    void setSourceRevisions(const QVector<int> &revisions) { m_sourceRevisions = revisions; }
+
+    // Calls visitor(const Triangle &) for every triangle of the leaves
+    // crossed by the segment from ray.origin() to ray.point(ray.distance())
+    template<typename Visitor>
+    void traverse(const QRay3D &ray, Visitor &&visitor) const
+    {
+        if (m_nodes.isEmpty())
+            return;
+
+        const SegmentQuery query(ray);
+        int stack[MaxDepth];
+        int stackSize = 0;
+        int nodeIndex = 0;
+        while (true) {
+            const Node &node = m_nodes.at(nodeIndex);
+            if (query.intersects(node)) {
+                if (node.count > 0) {
+                    for (int i = node.offset, end = node.offset + node.count; i < end; ++i)
+                        visitor(m_triangles.at(i));
+                } else {
+                    Q_ASSERT(stackSize < MaxDepth);
+                    stack[stackSize++] = node.offset;
+                    nodeIndex = nodeIndex + 1;
+                    continue;
+                }
+            }
+            if (stackSize == 0)
+                break;
+            nodeIndex = stack[--stackSize];
+        }
+    }
+
+private:
+    struct Node
+    {
+        float min[3];
+        float max[3];
+        // Leaf: triangles [offset, offset + count)
+        // Inner node (count == 0): left child follows, right child at offset
+        int offset;
+        int count;
+    };
+
+    struct SegmentQuery
+    {
+        explicit SegmentQuery(const QRay3D &ray);
+        bool intersects(const Node &node) const;
+
+        float origin[3];
+        float invDirection[3];
+        bool parallel[3];
+        float length;
+    };
+
+    int build(QVector<int> &order, int begin, int end, int depth);
+
+    QVector<Node> m_nodes;
+    QVector<Triangle> m_triangles;
+    QVector<int> m_sourceRevisions;
+
+    // Scratch data used while building
+    QVector<float> m_bounds;    // min xyz, max xyz per triangle
+    QVector<float> m_centroids; // xyz per triangle
+};
+
+} // namespace RayCasting
+} // namespace Qt3DRender
+
+QT_END_NAMESPACE
+
+#endif // QT3DRENDER_TRIANGLEBVH_P_H
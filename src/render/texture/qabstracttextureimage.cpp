@@ -83,6 +83,7 @@ QTextureImageDataGenerator::~QTextureImageDataGenerator() = default;
     the \l QTextureImageData.
 */
 
+
 QAbstractTextureImagePrivate::QAbstractTextureImagePrivate()
     : QNodePrivate(),
       m_mipLevel(0),
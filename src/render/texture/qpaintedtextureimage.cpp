@@ -247,6 +247,11 @@ bool QPaintedTextureImageDataGenerator::operator ==(const QTextureImageDataGener
     return (otherFunctor != nullptr && otherFunctor->m_generation == m_generation && otherFunctor->m_paintedTextureImageId == m_paintedTextureImageId);
 }
 
+uint QPaintedTextureImageDataGenerator::hash() const
+{
+    return qHash(m_paintedTextureImageId, qHash(m_generation));
+}
+
 } // namespace Qt3DRender
 
 QT_END_NAMESPACE
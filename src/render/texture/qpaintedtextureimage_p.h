@@ -92,6 +92,8 @@ public:
     // Will be executed from within a QAspectJob
     QTextureImageDataPtr operator ()() final;
     bool operator ==(const QTextureImageDataGenerator &other) const final;
+    // Equal generators have the same hash, see TextureImageDataManager
+    uint hash() const;
 
     QT3D_FUNCTOR(QPaintedTextureImageDataGenerator)
 
@@ -1689,6 +1689,13 @@ bool QTextureFromSourceGenerator::operator ==(const QTextureGenerator &other) co
             otherFunctor->m_sourceData == m_sourceData);
 }
 
+uint QTextureFromSourceGenerator::hash() const
+{
+    // Only hash the size of the source data, hashing its content would cost
+    // as much as comparing it
+    return qHash(m_url, uint(m_sourceData.size()));
+}
+
 QUrl QTextureFromSourceGenerator::url() const
 {
     return m_url;
@@ -107,6 +107,7 @@ public:
 
     QTextureDataPtr operator ()() override;
     bool operator ==(const QTextureGenerator &other) const override;
+    uint hash() const override;
     inline QAbstractTexture::Status status() const { return m_status; }
 
     QT3D_FUNCTOR(QTextureFromSourceGenerator)
@@ -38,6 +38,7 @@
 ****************************************************************************/
 
 #include "qtexturegenerator_p.h"
+#include <QtCore/qhash.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -51,6 +52,11 @@ QTextureGenerator::~QTextureGenerator()
 {
 }
 
+uint QTextureGenerator::hash() const
+{
+    return qHash(id());
+}
+
 /*!
    \class Qt3DRender::QTextureGenerator
    \inmodule Qt3DRender
@@ -66,6 +72,13 @@ QTextureGenerator::~QTextureGenerator()
 
     Compare these texture data to \a other. Returns \c true if both are equal.
 */
+/*!
+    \fn uint Qt3DRender::QTextureGenerator::hash() const
+
+    Returns a hash value for the generator. Generators that compare equal
+    must return the same value. The default implementation hashes the
+    type of the functor.
+*/
 } // Qt3DRender
 
 QT_END_NAMESPACE
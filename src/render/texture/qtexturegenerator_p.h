@@ -69,6 +69,7 @@ public:
     virtual ~QTextureGenerator();
     virtual QTextureDataPtr operator()() = 0;
     virtual bool operator ==(const QTextureGenerator &other) const = 0;
+    virtual uint hash() const;
 };
 
 typedef QSharedPointer<QTextureGenerator> QTextureGeneratorPtr;
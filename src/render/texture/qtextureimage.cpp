@@ -305,6 +305,11 @@ bool QImageTextureDataFunctor::operator ==(const QTextureImageDataGenerator &oth
             otherFunctor->m_mirrored == m_mirrored);
 }
 
+uint QImageTextureDataFunctor::hash() const
+{
+    return qHash(m_url);
+}
+
 QUrl QImageTextureDataFunctor::url() const
 {
     return m_url;
@@ -86,6 +86,8 @@ public:
     // Will be executed from within a QAspectJob
     QTextureImageDataPtr operator ()() final;
     bool operator ==(const QTextureImageDataGenerator &other) const final;
+    // Equal generators have the same hash, see TextureImageDataManager
+    uint hash() const;
     inline QTextureImage::Status status() const { return m_status; }
     QT3D_FUNCTOR(QImageTextureDataFunctor)
 
@@ -21,7 +21,8 @@ HEADERS += \
     $$PWD/qpaintedtextureimage.h \
     $$PWD/qpaintedtextureimage_p.h \
     $$PWD/qtexturedataupdate.h \
-    $$PWD/qtexturedataupdate_p.h
+    $$PWD/qtexturedataupdate_p.h \
+    $$PWD/texturedatamanager_p.h
 
 SOURCES += \
     $$PWD/qabstracttextureimage.cpp \
@@ -35,4 +36,5 @@ SOURCES += \
     $$PWD/qtexturedata.cpp \
     $$PWD/qtexturegenerator.cpp \
     $$PWD/qpaintedtextureimage.cpp \
-    $$PWD/qtexturedataupdate.cpp
+    $$PWD/qtexturedataupdate.cpp \
+    $$PWD/texturedatamanager.cpp
@@ -51,8 +51,10 @@
 // We mean it.
 //
 
+#include <QHash>
 #include <QMutex>
 #include <QMutexLocker>
+#include <QSet>
 #include <Qt3DRender/qtexture.h>
 #include <Qt3DRender/qtextureimagedata.h>
 #include <Qt3DRender/qtexturegenerator.h>
@@ -64,6 +66,16 @@ QT_BEGIN_NAMESPACE
 namespace Qt3DRender {
 namespace Render {
 
+inline uint generatorHash(const QTextureGeneratorPtr &generator)
+{
+    return generator->hash();
+}
+
+// QTextureImageDataGenerator is public API and has no hash() of its own,
+// only the Qt 3D generators provide one. Other generators all land in the
+// bucket of their type.
+Q_3DRENDERSHARED_PRIVATE_EXPORT uint generatorHash(const QTextureImageDataGeneratorPtr &generator);
+
 /**
  * The texture data managers associates each texture data generator
  * with the data objects generated by them. That is, either
@@ -75,7 +87,8 @@ namespace Render {
  * Aspect jobs will make sure that at the start of each frame, all generators
  * registered with the GeneratorDataManagers have been executed.
  *
- * This guarantees that no texture data generator is executed twice.
+ * This guarantees that no texture data generator is executed again once it
+ * has produced its data.
  *
  * Each Generator is associated with a number of textures that reference it.
  * If the last texture disassociates from a generator, the QTextureData will
@@ -98,13 +111,13 @@ public:
     {
         QMutexLocker lock(&m_mutex);
 
-        Entry *entry = findEntry(generator);
+        const uint hash = generatorHash(generator);
+        Entry *entry = findEntry(generator, hash);
         const bool needsToBeCreated = (entry == nullptr);
         if (needsToBeCreated)
-            entry = createEntry(generator);
+            entry = createEntry(generator, hash);
         Q_ASSERT(entry);
-        if (!entry->referencingObjects.contains(r))
-            entry->referencingObjects.push_back(r);
+        entry->referencingObjects.insert(r);
         return needsToBeCreated;
     }
 
@@ -116,16 +129,24 @@ public:
     {
         QMutexLocker lock(&m_mutex);
 
-        const auto end = m_data.end();
-        for (auto it = m_data.begin(); it != end; ++it) {
-            Entry &entry = *it;
+        const auto it = m_data.find(generatorHash(generator));
+        if (it == m_data.end())
+            return;
+
+        Bucket &bucket = it.value();
+        for (int i = 0, sz = bucket.size(); i < sz; ++i) {
+            Entry &entry = bucket[i];
             if (*entry.generator == *generator) {
-                entry.referencingObjects.removeAll(r);
+                entry.referencingObjects.remove(r);
                 // delete, if that was the last reference
-                if (entry.referencingObjects.empty()) {
-                    m_data.erase(it);
-                    return;
+                if (entry.referencingObjects.isEmpty()) {
+                    if (!entry.executed)
+                        --m_pendingCount;
+                    bucket.remove(i);
+                    if (bucket.isEmpty())
+                        m_data.erase(it);
                 }
+                return;
             }
         }
     }
@@ -137,76 +158,135 @@ public:
     {
         QMutexLocker lock(&m_mutex);
 
-        const Entry *entry = findEntry(generator);
+        const Entry *entry = findEntry(generator, generatorHash(generator));
         return entry ? entry->data : DataPtr();
     }
 
     /*!
-     * Returns all generators that were not yet executed
+     * Returns all generators that have not produced their data yet
      */
     QVector<GeneratorPtr> pendingGenerators()
     {
         QMutexLocker lock(&m_mutex);
 
         QVector<GeneratorPtr> ret;
-        for (const Entry &entry : m_data)
-            if (!entry.data && !ret.contains(entry.generator))
-                ret.push_back(entry.generator);
+        if (m_pendingCount == 0)
+            return ret;
+
+        // Entries are unique per generator, no need to check for duplicates
+        ret.reserve(m_pendingCount);
+        for (const Bucket &bucket : qAsConst(m_data)) {
+            for (const Entry &entry : bucket)
+                if (!entry.executed)
+                    ret.push_back(entry.generator);
+        }
         return ret;
     }
 
+    /*!
+     * Returns true if some of the pending generators were never executed,
+     * as opposed to generators that returned no data and are retried
+     */
+    bool hasNewGenerators()
+    {
+        QMutexLocker lock(&m_mutex);
+
+        if (m_pendingCount == 0)
+            return false;
+        for (const Bucket &bucket : qAsConst(m_data)) {
+            for (const Entry &entry : bucket)
+                if (!entry.executed && !entry.failed)
+                    return true;
+        }
+        return false;
+    }
+
+    /*!
+     * Returns true if the given generator is referenced but has not
+     * generated its data yet.
+     */
+    bool isPending(const GeneratorPtr &generator)
+    {
+        QMutexLocker lock(&m_mutex);
+
+        const Entry *entry = findEntry(generator, generatorHash(generator));
+        return entry != nullptr && !entry->executed;
+    }
+
     /*!
      * Assigns a piece of data to the generator that was used to
-     * create it.
+     * create it. A generator that returned no data stays pending and is
+     * executed again the next frame.
      */
     void assignData(const GeneratorPtr &generator, const DataPtr &data)
     {
         QMutexLocker lock(&m_mutex);
 
-        Entry *entry = findEntry(generator);
+        Entry *entry = findEntry(generator, generatorHash(generator));
         if (!entry) {
             qWarning() << "[TextureDataManager] assignData() called with non-existent generator";
             return;
         }
+        if (!data) {
+            entry->failed = true;
+            return;
+        }
+        if (!entry->executed)
+            --m_pendingCount;
         entry->data = data;
+        entry->executed = true;
     }
 
     bool contains(const GeneratorPtr &generator)
     {
-        return findEntry(generator) != nullptr;
+        QMutexLocker lock(&m_mutex);
+
+        return findEntry(generator, generatorHash(generator)) != nullptr;
     }
 
 private:
 
     struct Entry {
         GeneratorPtr generator;
-        QVector<ReferencedType> referencingObjects;
+        QSet<ReferencedType> referencingObjects;
         DataPtr data;
+        bool executed = false;
+        bool failed = false;
     };
 
+    // Entries whose generators share the same hash. Generators comparing
+    // equal have the same hash, so a bucket usually holds a single entry.
+    using Bucket = QVector<Entry>;
+
     /*!
      * Helper function: return entry for given generator if it exists, nullptr
      * otherwise.
      */
-    Entry* findEntry(const GeneratorPtr &generator)
+    Entry* findEntry(const GeneratorPtr &generator, uint hash)
     {
-        for (int i = 0, sz = m_data.size(); i < sz; ++i)
-            if (*m_data[i].generator == *generator)
-                return &m_data[i];
+        const auto it = m_data.find(hash);
+        if (it == m_data.end())
+            return nullptr;
+        for (Entry &entry : it.value())
+            if (*entry.generator == *generator)
+                return &entry;
         return nullptr;
     }
 
-    Entry *createEntry(const GeneratorPtr &generator)
+    Entry *createEntry(const GeneratorPtr &generator, uint hash)
     {
         Entry newEntry;
         newEntry.generator = generator;
 
-        m_data.push_back(newEntry);
-        return &m_data.back();
+        Bucket &bucket = m_data[hash];
+        bucket.push_back(newEntry);
+        ++m_pendingCount;
+        return &bucket.back();
     }
 
     QMutex m_mutex;
-    QVector<Entry> m_data;
+    QHash<uint, Bucket> m_data;
+    int m_pendingCount = 0;
 };
 
 class QT3DRENDERSHARED_PRIVATE_EXPORT TextureDataManager
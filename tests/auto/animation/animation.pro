@@ -21,7 +21,6 @@ qtConfig(private_tests) {
     SUBDIRS += \
         animationclip \
         fcurve \
-        functionrangefinder \
         bezierevaluator \
         clipanimator \
         blendedclipanimator \
@@ -40,5 +39,6 @@ qtConfig(private_tests) {
         clock \
         skeleton \
         findrunningclipanimatorsjob \
+        handler \
         qchannelmapping
 }
@@ -38,6 +38,11 @@
 #include <Qt3DAnimation/private/additiveclipblend_p.h>
 #include <Qt3DAnimation/private/lerpclipblend_p.h>
 #include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DAnimation/qanimationclip.h>
+#include <Qt3DAnimation/qanimationclipdata.h>
+#include <Qt3DAnimation/qchannel.h>
+#include <Qt3DAnimation/qchannelcomponent.h>
+#include <Qt3DAnimation/qkeyframe.h>
 #include <QtGui/qvector2d.h>
 #include <QtGui/qvector3d.h>
 #include <QtGui/qvector4d.h>
@@ -1310,10 +1315,100 @@ private Q_SLOTS:
             QVERIFY(fuzzyCompare(actual, expected) == true);
         }
 
+        // WHEN -> evaluating into a buffer left over from another clip
+        ClipResults reusedResults(expectedResults.size() + 3, -1.0f);
+        evaluateClipAtLocalTime(clip, localTime, reusedResults);
+
+        // THEN
+        QCOMPARE(reusedResults, actualResults);
+
         // Cleanup
         delete handler;
     }
 
+    void checkEvaluateClipWithState()
+    {
+        // GIVEN -> keyframes cycling through linear, constant and bezier
+        // interpolation, differently for each channel component
+        const Qt3DAnimation::QKeyFrame::InterpolationType interpolations[] = {
+            Qt3DAnimation::QKeyFrame::LinearInterpolation,
+            Qt3DAnimation::QKeyFrame::ConstantInterpolation,
+            Qt3DAnimation::QKeyFrame::BezierInterpolation
+        };
+        Qt3DAnimation::QAnimationClipData clipData;
+        int componentIndex = 0;
+        for (const QString &channelName : { QStringLiteral("Location"), QStringLiteral("Opacity") }) {
+            Qt3DAnimation::QChannel channel(channelName);
+            const int componentCount = channelName == QLatin1String("Location") ? 3 : 1;
+            for (int j = 0; j < componentCount; ++j, ++componentIndex) {
+                Qt3DAnimation::QChannelComponent component;
+                for (int k = 0; k < 8; ++k) {
+                    const float time = 0.5f * k;
+                    const float value = float((k % 2 ? -1 : 1) * (componentIndex + 1) * k);
+                    Qt3DAnimation::QKeyFrame keyFrame(QVector2D(time, value),
+                                                      QVector2D(time - 0.15f, value - 0.5f),
+                                                      QVector2D(time + 0.15f, value + 0.5f));
+                    keyFrame.setInterpolationType(interpolations[(componentIndex + k) % 3]);
+                    component.appendKeyFrame(keyFrame);
+                }
+                channel.appendChannelComponent(component);
+            }
+            clipData.appendChannel(channel);
+        }
+
+        Handler handler;
+        Qt3DAnimation::QAnimationClip frontendClip;
+        frontendClip.setClipData(clipData);
+        AnimationClip clip;
+        clip.setHandler(&handler);
+        simulateInitializationSync(&frontendClip, &clip);
+        clip.loadAnimation();
+        QCOMPARE(clip.channelCount(), 4);
+
+        // WHEN -> sweeping forward twice, past both ends of the clip
+        ClipEvaluationState state;
+        ClipResults results;
+        for (int sweep = 0; sweep < 2; ++sweep) {
+            for (float localTime = -0.25f; localTime < 4.0f; localTime += 0.05f) {
+                evaluateClipAtLocalTime(&clip, localTime, results, &state);
+
+                // THEN
+                QCOMPARE(results, evaluateClipAtLocalTime(&clip, localTime));
+            }
+        }
+    }
+
+    void checkClipEvaluationPlan()
+    {
+        // GIVEN
+        Handler handler;
+        AnimationClip *clip = createAnimationClipLoader(&handler, QUrl("qrc:/clip3.json"));
+
+        // WHEN
+        const QVector<ChannelEvaluationPlan> plan = clip->evaluationPlan();
+
+        // THEN -> Rotation, Location, Base Color, Metalness, Roughness
+        QCOMPARE(plan.size(), 5);
+        const int expectedOffsets[] = { 0, 4, 7, 10, 11 };
+        const int expectedCounts[] = { 4, 3, 3, 1, 1 };
+        for (int i = 0; i < plan.size(); ++i) {
+            QCOMPARE(plan[i].componentOffset, expectedOffsets[i]);
+            QCOMPARE(plan[i].componentCount, expectedCounts[i]);
+            QCOMPARE(clip->channelComponentBaseIndex(i), expectedOffsets[i]);
+        }
+        QCOMPARE(plan[0].interpolation, ChannelEvaluationPlan::QuaternionSlerp);
+        for (int i = 1; i < plan.size(); ++i)
+            QCOMPARE(plan[i].interpolation, ChannelEvaluationPlan::PerComponent);
+
+        // WHEN -> channel names are matched case sensitively
+        clip = createAnimationClipLoader(&handler, QUrl("qrc:/clip2.json"));
+
+        // THEN
+        QCOMPARE(clip->evaluationPlan().size(), 2);
+        QCOMPARE(clip->evaluationPlan()[1].componentOffset, 3);
+        QCOMPARE(clip->evaluationPlan()[1].interpolation, ChannelEvaluationPlan::PerComponent);
+    }
+
     void checkEvaluateClipAtPhase_data()
     {
         QTest::addColumn<Handler *>("handler");
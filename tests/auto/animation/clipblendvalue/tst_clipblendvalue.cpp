@@ -270,6 +270,42 @@ private Q_SLOTS:
 
         delete blendNode;
     }
+
+    void checkEvaluationStatePerAnimator()
+    {
+        // GIVEN
+        Qt3DAnimation::QClipBlendValue clipBlendValue;
+        Qt3DAnimation::QAnimationClipLoader clip;
+        clipBlendValue.setClip(&clip);
+        ClipBlendValue backendClipBlendValue;
+        simulateInitializationSync(&clipBlendValue, &backendClipBlendValue);
+        const Qt3DCore::QNodeId animatorId1 = Qt3DCore::QNodeId::createId();
+        const Qt3DCore::QNodeId animatorId2 = Qt3DCore::QNodeId::createId();
+        backendClipBlendValue.setClipFormat(animatorId1, ClipFormat());
+        backendClipBlendValue.setClipFormat(animatorId2, ClipFormat());
+
+        // WHEN
+        backendClipBlendValue.evaluationState(animatorId1)->keyframeCursors = { 3, 5 };
+
+        // THEN
+        QVERIFY(backendClipBlendValue.evaluationState(animatorId1) != backendClipBlendValue.evaluationState(animatorId2));
+        QCOMPARE(backendClipBlendValue.evaluationState(animatorId1)->keyframeCursors, QVector<int>({ 3, 5 }));
+        QVERIFY(backendClipBlendValue.evaluationState(animatorId2)->keyframeCursors.isEmpty());
+
+        // WHEN
+        backendClipBlendValue.setClipFormat(animatorId1, ClipFormat());
+
+        // THEN -> same clip, the cursors are kept
+        QCOMPARE(backendClipBlendValue.evaluationState(animatorId1)->keyframeCursors, QVector<int>({ 3, 5 }));
+
+        // WHEN
+        Qt3DAnimation::QAnimationClipLoader newClip;
+        clipBlendValue.setClip(&newClip);
+        backendClipBlendValue.syncFromFrontEnd(&clipBlendValue, false);
+
+        // THEN
+        QVERIFY(backendClipBlendValue.evaluationState(animatorId1)->keyframeCursors.isEmpty());
+    }
 };
 
 QTEST_MAIN(tst_ClipBlendValue)
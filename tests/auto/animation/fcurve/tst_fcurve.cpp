@@ -116,6 +116,57 @@ private Q_SLOTS:
 
         QCOMPARE(expectedValue, actualValue);
     }
+
+    void checkLowerKeyframeBoundWithCursor()
+    {
+        // GIVEN
+        FCurve curve;
+        for (int i = 0; i < 10; ++i)
+            curve.appendKeyframe(float(i), Keyframe{float(i), {0.0f, 0.0f}, {0.0f, 0.0f}, QKeyFrame::LinearInterpolation});
+        int cursor = 0;
+
+        // WHEN playing forward, THEN
+        for (float time = 0.0f; time <= 9.0f; time += 0.25f) {
+            const int expectedBound = curve.lowerKeyframeBound(time);
+            QCOMPARE(curve.lowerKeyframeBound(time, &cursor), expectedBound);
+            QCOMPARE(cursor, expectedBound);
+            QCOMPARE(curve.evaluateAtTime(time, cursor), time);
+        }
+        QCOMPARE(cursor, 8);
+
+        // WHEN jumping backwards, THEN
+        QCOMPARE(curve.lowerKeyframeBound(2.5f, &cursor), 2);
+        QCOMPARE(cursor, 2);
+
+        // WHEN jumping forward past the next keyframe, THEN
+        QCOMPARE(curve.lowerKeyframeBound(6.5f, &cursor), 6);
+        QCOMPARE(cursor, 6);
+
+        // WHEN the cursor is out of range, THEN
+        cursor = 42;
+        QCOMPARE(curve.lowerKeyframeBound(4.0f, &cursor), 4);
+        QCOMPARE(cursor, 4);
+
+        // WHEN evaluating outside of the keyframes, THEN
+        QCOMPARE(curve.lowerKeyframeBound(-1.0f, &cursor), 0);
+        QCOMPARE(curve.lowerKeyframeBound(10.0f, &cursor), 0);
+    }
+
+    void checkIsLinearSegment()
+    {
+        // GIVEN
+        FCurve curve;
+        curve.appendKeyframe(0.0f, Keyframe{0.0f, {0.0f, 0.0f}, {0.0f, 0.0f}, QKeyFrame::LinearInterpolation});
+        curve.appendKeyframe(1.0f, Keyframe{1.0f, {0.0f, 0.0f}, {0.0f, 0.0f}, QKeyFrame::ConstantInterpolation});
+        curve.appendKeyframe(2.0f, Keyframe{2.0f, {0.0f, 0.0f}, {0.0f, 0.0f}, QKeyFrame::LinearInterpolation});
+
+        // THEN
+        QVERIFY(curve.isLinearSegment(0.5f, 0));
+        QVERIFY(!curve.isLinearSegment(1.5f, 1));
+        QVERIFY(!curve.isLinearSegment(0.5f, -1));
+        QCOMPARE(curve.value(2), 2.0f);
+        QCOMPARE(curve.interpolation(1), QKeyFrame::ConstantInterpolation);
+    }
 };
 
 QTEST_APPLESS_MAIN(tst_FCurve)
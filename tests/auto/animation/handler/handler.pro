@@ -1,11 +1,15 @@
 TEMPLATE = app
 
-TARGET = tst_sandwichfinder
+TARGET = tst_handler
 
 QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
 
 CONFIG += testcase
 
 SOURCES += \
-    tst_functionrangefinder.cpp
+    tst_handler.cpp
 
+include(../../core/common/common.pri)
+
+RESOURCES += \
+    handler.qrc
@@ -0,0 +1,303 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/qanimationcallback.h>
+#include <Qt3DAnimation/qclipanimator.h>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/channelmapper_p.h>
+#include <Qt3DAnimation/private/channelmapping_p.h>
+#include <Qt3DAnimation/private/clipanimator_p.h>
+#include <Qt3DAnimation/private/findrunningclipanimatorsjob_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qaspectjob_p.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DCore/private/qscene_p.h>
+#include <qbackendnodetester.h>
+
+using namespace Qt3DAnimation::Animation;
+
+namespace {
+
+class RecordingCallback : public Qt3DAnimation::QAnimationCallback
+{
+public:
+    void valueChanged(const QVariant &value) override
+    {
+        lastValue = value;
+        ++callCount;
+    }
+
+    QVariant lastValue;
+    int callCount = 0;
+};
+
+// The frontend nodes postFrame applies the evaluation of an animator to
+struct AnimatorNodes
+{
+    Qt3DCore::QTransform *target = nullptr;
+    Qt3DAnimation::QClipAnimator *animator = nullptr;
+    QSharedPointer<RecordingCallback> callback;
+};
+
+} // anonymous
+
+class tst_Handler : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+
+    // Sets up animatorCount running animators playing the same clip at
+    // different phases, every third one only plays once. Each animator maps
+    // the location to a target and to a callback of its own.
+    QVector<AnimatorNodes> setupAnimators(Handler *handler, int animatorCount, Qt3DCore::QEntity *root)
+    {
+        const Qt3DCore::QNodeId clipId = Qt3DCore::QNodeId::createId();
+        AnimationClip *clip = handler->animationClipLoaderManager()->getOrCreateResource(clipId);
+        setPeerId(clip, clipId);
+        clip->setHandler(handler);
+        clip->setDataType(AnimationClip::File);
+        clip->setSource(QUrl("qrc:/clip1.json"));
+        clip->loadAnimation();
+
+        QVector<AnimatorNodes> nodes;
+        QVector<HClipAnimator> animators;
+        for (int i = 0; i < animatorCount; ++i) {
+            AnimatorNodes frontend;
+            frontend.target = new Qt3DCore::QTransform();
+            frontend.animator = new Qt3DAnimation::QClipAnimator();
+            frontend.animator->setRunning(true);
+            frontend.callback.reset(new RecordingCallback);
+            // Registers the nodes with the scene for the lookups of postFrame
+            frontend.target->setParent(root);
+            frontend.animator->setParent(root);
+
+            const Qt3DCore::QNodeId mappingId = Qt3DCore::QNodeId::createId();
+            ChannelMapping *mapping = handler->channelMappingManager()->getOrCreateResource(mappingId);
+            setPeerId(mapping, mappingId);
+            mapping->setHandler(handler);
+            mapping->setTargetId(frontend.target->id());
+            mapping->setPropertyName("translation");
+            mapping->setChannelName(QLatin1String("Location"));
+            mapping->setType(static_cast<int>(QVariant::Vector3D));
+            mapping->setComponentCount(3);
+            mapping->setMappingType(ChannelMapping::ChannelMappingType);
+
+            const Qt3DCore::QNodeId callbackMappingId = Qt3DCore::QNodeId::createId();
+            ChannelMapping *callbackMapping = handler->channelMappingManager()->getOrCreateResource(callbackMappingId);
+            setPeerId(callbackMapping, callbackMappingId);
+            callbackMapping->setHandler(handler);
+            callbackMapping->setChannelName(QLatin1String("Location"));
+            callbackMapping->setType(static_cast<int>(QVariant::Vector3D));
+            callbackMapping->setComponentCount(3);
+            callbackMapping->setCallback(frontend.callback.data());
+            callbackMapping->setCallbackFlags(Qt3DAnimation::QAnimationCallback::OnOwningThread);
+            callbackMapping->setMappingType(ChannelMapping::CallbackMappingType);
+
+            const Qt3DCore::QNodeId mapperId = Qt3DCore::QNodeId::createId();
+            ChannelMapper *mapper = handler->channelMapperManager()->getOrCreateResource(mapperId);
+            setPeerId(mapper, mapperId);
+            mapper->setHandler(handler);
+            mapper->setMappingIds({ mappingId, callbackMappingId });
+
+            const Qt3DCore::QNodeId animatorId = frontend.animator->id();
+            ClipAnimator *animator = handler->clipAnimatorManager()->getOrCreateResource(animatorId);
+            setPeerId(animator, animatorId);
+            animator->setHandler(handler);
+            animator->setLoops(i % 3 == 0 ? 1 : Qt3DAnimation::QAbstractClipAnimator::Infinite);
+            animator->setClipId(clipId);
+            animator->setMapperId(mapperId);
+            animator->setRunning(true);
+            animator->setEnabled(true);
+            nodes.push_back(frontend);
+            animators.push_back(handler->clipAnimatorManager()->getOrAcquireHandle(animatorId));
+        }
+
+        // Builds the mapping data and marks the animators as running
+        FindRunningClipAnimatorsJob findJob;
+        findJob.setHandler(handler);
+        findJob.setDirtyClipAnimators(animators);
+        findJob.run();
+
+        for (int i = 0; i < animatorCount; ++i)
+            handler->clipAnimatorManager()->data(animators.at(i))->setStartTime(-i * 50000000);
+
+        return nodes;
+    }
+
+    // Runs the jobs of a frame in order, then lets them apply their
+    // results to the frontend nodes
+    void runFrame(Handler *handler, qint64 time, Qt3DCore::QAspectManager *manager)
+    {
+        const QVector<Qt3DCore::QAspectJobPtr> jobs = handler->jobsToExecute(time);
+        for (const Qt3DCore::QAspectJobPtr &job : jobs)
+            job->run();
+        for (const Qt3DCore::QAspectJobPtr &job : jobs)
+            Qt3DCore::QAspectJobPrivate::get(job.data())->postFrame(manager);
+    }
+
+    // Changes the running state of the animator without letting the
+    // FindRunningClipAnimatorsJob update the running set
+    void setRunningBehindHandler(Handler *handler, Qt3DCore::QNodeId animatorId, bool running)
+    {
+        handler->clipAnimatorManager()->lookupResource(animatorId)->setRunning(running);
+        handler->m_dirtyClipAnimators.clear();
+    }
+
+    static QVector<int> callCounts(const QVector<AnimatorNodes> &nodes)
+    {
+        QVector<int> counts;
+        for (const AnimatorNodes &frontend : nodes)
+            counts.push_back(frontend.callback->callCount);
+        return counts;
+    }
+
+private Q_SLOTS:
+    void checkBatchedEvaluationMatchesPerAnimatorEvaluation()
+    {
+        // GIVEN
+        Qt3DCore::QAspectManager manager;
+        Qt3DCore::QScene scene;
+        Qt3DCore::QEntity rootEntity;
+        Qt3DCore::QNodePrivate::get(&rootEntity)->setScene(&scene);
+
+        const int animatorCount = 80;
+        Handler perAnimatorHandler;
+        perAnimatorHandler.setClipAnimatorEvaluationMode(Handler::PerAnimatorEvaluation);
+        const QVector<AnimatorNodes> perAnimatorNodes = setupAnimators(&perAnimatorHandler, animatorCount, &rootEntity);
+        Handler batchedHandler;
+        batchedHandler.setClipAnimatorEvaluationMode(Handler::BatchedEvaluation);
+        const QVector<AnimatorNodes> batchedNodes = setupAnimators(&batchedHandler, animatorCount, &rootEntity);
+
+        // RootEntity is the entry point to retrieve the scene instance for lookups
+        manager.setRootEntity(&rootEntity, {});
+
+        // WHEN -> play until the animators playing once have all finished
+        for (qint64 time = 0; time <= 8000000000; time += 100000000) {
+            runFrame(&perAnimatorHandler, time, &manager);
+            runFrame(&batchedHandler, time, &manager);
+
+            // THEN
+            QCOMPARE(batchedHandler.runningClipAnimators().size(),
+                     perAnimatorHandler.runningClipAnimators().size());
+
+            for (int i = 0; i < animatorCount; ++i) {
+                const AnimatorNodes &expected = perAnimatorNodes.at(i);
+                const AnimatorNodes &actual = batchedNodes.at(i);
+                QCOMPARE(actual.target->translation(), expected.target->translation());
+                QCOMPARE(actual.animator->normalizedTime(), expected.animator->normalizedTime());
+                QCOMPARE(actual.animator->isRunning(), expected.animator->isRunning());
+                QCOMPARE(actual.callback->callCount, expected.callback->callCount);
+                QCOMPARE(actual.callback->lastValue, expected.callback->lastValue);
+            }
+        }
+
+        // THEN
+        QCOMPARE(batchedHandler.runningClipAnimators().size(), animatorCount - (animatorCount + 2) / 3);
+        for (int i = 0; i < animatorCount; ++i) {
+            QCOMPARE(batchedNodes.at(i).animator->isRunning(), i % 3 != 0);
+            QVERIFY(batchedNodes.at(i).callback->callCount > 0);
+        }
+    }
+
+    void checkStoppedAnimatorsAreRemovedOnNextFrame()
+    {
+        // GIVEN
+        Qt3DCore::QAspectManager manager;
+        Qt3DCore::QScene scene;
+        Qt3DCore::QEntity rootEntity;
+        Qt3DCore::QNodePrivate::get(&rootEntity)->setScene(&scene);
+
+        const int animatorCount = 10;
+        Handler handler;
+        handler.setClipAnimatorEvaluationMode(Handler::BatchedEvaluation);
+        const QVector<AnimatorNodes> nodes = setupAnimators(&handler, animatorCount, &rootEntity);
+        manager.setRootEntity(&rootEntity, {});
+        runFrame(&handler, 0, &manager);
+        const Qt3DCore::QNodeId stoppedId = nodes.at(1).animator->id();
+        const HClipAnimator stoppedHandle = handler.clipAnimatorManager()->getOrAcquireHandle(stoppedId);
+        const QVector<int> countsBefore = callCounts(nodes);
+
+        // WHEN
+        setRunningBehindHandler(&handler, stoppedId, false);
+        runFrame(&handler, 100000000, &manager);
+
+        // THEN -> found stopped, but still in the running set
+        const QVector<int> countsAfter = callCounts(nodes);
+        for (int i = 0; i < animatorCount; ++i)
+            QCOMPARE(countsAfter.at(i), countsBefore.at(i) + (i == 1 ? 0 : 1));
+        QCOMPARE(handler.runningClipAnimators().size(), animatorCount);
+
+        // WHEN
+        handler.jobsToExecute(200000000);
+
+        // THEN
+        QCOMPARE(handler.runningClipAnimators().size(), animatorCount - 1);
+        QVERIFY(!handler.runningClipAnimators().contains(stoppedHandle));
+    }
+
+    void checkEvaluationModeChangeDropsStoppedAnimators()
+    {
+        // GIVEN
+        Qt3DCore::QAspectManager manager;
+        Qt3DCore::QScene scene;
+        Qt3DCore::QEntity rootEntity;
+        Qt3DCore::QNodePrivate::get(&rootEntity)->setScene(&scene);
+
+        const int animatorCount = 10;
+        Handler handler;
+        handler.setClipAnimatorEvaluationMode(Handler::BatchedEvaluation);
+        const QVector<AnimatorNodes> nodes = setupAnimators(&handler, animatorCount, &rootEntity);
+        manager.setRootEntity(&rootEntity, {});
+        runFrame(&handler, 0, &manager);
+        const Qt3DCore::QNodeId animatorId = nodes.at(1).animator->id();
+
+        // WHEN -> found stopped by a batch job, then restarted
+        setRunningBehindHandler(&handler, animatorId, false);
+        runFrame(&handler, 100000000, &manager);
+        setRunningBehindHandler(&handler, animatorId, true);
+        handler.setClipAnimatorEvaluationMode(Handler::PerAnimatorEvaluation);
+        handler.setClipAnimatorEvaluationMode(Handler::BatchedEvaluation);
+        const QVector<int> countsBefore = callCounts(nodes);
+        runFrame(&handler, 200000000, &manager);
+
+        // THEN -> the restarted animator wasn't dropped
+        QCOMPARE(handler.runningClipAnimators().size(), animatorCount);
+        const QVector<int> countsAfter = callCounts(nodes);
+        for (int i = 0; i < animatorCount; ++i)
+            QCOMPARE(countsAfter.at(i), countsBefore.at(i) + 1);
+    }
+};
+
+QTEST_MAIN(tst_Handler)
+
+#include "tst_handler.moc"
@@ -51,13 +51,18 @@ public:
             setArbiterOnNode(n);
     }
 
-    QVector<Qt3DCore::QNode *> dirtyNodes() const { return m_dirtyFrontEndNodes; }
+    QVector<Qt3DCore::QNode *> dirtyNodes() const
+    {
+        QVector<Qt3DCore::QNode *> nodes = m_dirtyFrontEndNodes;
+        nodes.removeAll(nullptr);
+        return nodes;
+    }
     QVector<Qt3DCore::ComponentRelationshipChange> dirtyComponents() const { return m_dirtyEntityComponentNodeChanges; }
 
     void clear()
     {
-        m_dirtyFrontEndNodes.clear();
-        m_dirtyEntityComponentNodeChanges.clear();
+        takeDirtyFrontEndNodes();
+        takeDirtyEntityComponentNodes();
     }
 };
 
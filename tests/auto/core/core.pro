@@ -20,6 +20,8 @@ qtConfig(private_tests) {
         qentity \
         qtransform \
         threadpooler \
+        workstealingjobmanager \
+        qparallelfor \
         vector4d_base \
         vector3d_base \
         aspectcommanddebugger \
@@ -45,6 +45,7 @@ class tst_QChangeArbiter : public QObject
 
 private slots:
     void recordsDirtyNodes();
+    void dirtyNodesAreUniqueAndOrdered();
 };
 
 
@@ -133,6 +134,41 @@ void tst_QChangeArbiter::recordsDirtyNodes()
     QCOMPARE(arbiter->dirtyNodes().size(), 2);
 }
 
+void tst_QChangeArbiter::dirtyNodesAreUniqueAndOrdered()
+{
+    // GIVEN
+    Qt3DCore::QChangeArbiter arbiter;
+    PropertyTestNode a, b, c, d;
+
+    // WHEN
+    arbiter.addDirtyFrontEndNode(&a);
+    arbiter.addDirtyFrontEndNode(&b);
+    arbiter.addDirtyFrontEndNode(&a);
+    arbiter.addDirtyFrontEndNode(&c);
+    arbiter.addDirtyFrontEndNode(&b);
+
+    // THEN
+    QCOMPARE(arbiter.takeDirtyFrontEndNodes(), QVector<Qt3DCore::QNode *>({ &a, &b, &c }));
+    QVERIFY(arbiter.takeDirtyFrontEndNodes().isEmpty());
+
+    // WHEN
+    arbiter.addDirtyFrontEndNode(&d);
+    arbiter.addDirtyFrontEndNode(&c);
+    arbiter.addDirtyFrontEndNode(&b);
+    arbiter.removeDirtyFrontEndNode(&c);
+    arbiter.removeDirtyFrontEndNode(&a);
+    arbiter.addDirtyFrontEndNode(&a);
+    arbiter.addDirtyFrontEndNode(&d);
+
+    // THEN
+    QCOMPARE(arbiter.takeDirtyFrontEndNodes(), QVector<Qt3DCore::QNode *>({ &d, &b, &a }));
+
+    // WHEN - nodes taken can be marked dirty again
+    arbiter.addDirtyFrontEndNode(&c);
+
+    // THEN
+    QCOMPARE(arbiter.takeDirtyFrontEndNodes(), QVector<Qt3DCore::QNode *>({ &c }));
+}
 
 QTEST_MAIN(tst_QChangeArbiter)
 
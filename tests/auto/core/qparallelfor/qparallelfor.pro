@@ -0,0 +1,7 @@
+TARGET = tst_qparallelfor
+CONFIG += testcase
+TEMPLATE = app
+
+SOURCES += tst_qparallelfor.cpp
+
+QT += testlib 3dcore 3dcore-private
@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/private/qparallelfor_p.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QThread>
+
+class tst_QParallelFor : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkChunkCount_data()
+    {
+        QTest::addColumn<int>("size");
+        QTest::addColumn<int>("minChunkSize");
+        QTest::addColumn<int>("expectedChunkCount");
+
+        const int maxChunkCount = QThread::idealThreadCount() * 4;
+        QTest::newRow("empty") << 0 << 16 << 0;
+        QTest::newRow("smaller than a chunk") << 10 << 16 << 1;
+        QTest::newRow("two chunks") << 17 << 16 << qMin(2, maxChunkCount);
+        QTest::newRow("capped by thread count") << 1000000 << 1 << maxChunkCount;
+    }
+
+    void checkChunkCount()
+    {
+        // GIVEN
+        QFETCH(int, size);
+        QFETCH(int, minChunkSize);
+        QFETCH(int, expectedChunkCount);
+
+        // WHEN
+        const Qt3DCore::QParallelFor parallelFor(size, minChunkSize);
+
+        // THEN
+        QCOMPARE(parallelFor.size(), size);
+        QCOMPARE(parallelFor.chunkCount(), expectedChunkCount);
+    }
+
+    void checkCoversRangeOnce_data()
+    {
+        QTest::addColumn<int>("size");
+        QTest::addColumn<int>("minChunkSize");
+
+        QTest::newRow("1") << 1 << 1;
+        QTest::newRow("1000") << 1000 << 1;
+        QTest::newRow("100000") << 100000 << 256;
+    }
+
+    void checkCoversRangeOnce()
+    {
+        // GIVEN
+        QFETCH(int, size);
+        QFETCH(int, minChunkSize);
+        const Qt3DCore::QParallelFor parallelFor(size, minChunkSize);
+        QVector<QAtomicInt> visits(size);
+        QVector<QPair<int, int>> chunkRanges(parallelFor.chunkCount());
+
+        // WHEN
+        parallelFor.run([&](int chunk, int begin, int end) {
+            chunkRanges[chunk] = { begin, end };
+            for (int i = begin; i < end; ++i)
+                visits[i].ref();
+        });
+
+        // THEN
+        for (int i = 0; i < size; ++i)
+            QCOMPARE(visits.at(i).loadRelaxed(), 1);
+
+        // Chunks are numbered in range order
+        int expectedBegin = 0;
+        for (const auto &range : qAsConst(chunkRanges)) {
+            QCOMPARE(range.first, expectedBegin);
+            QVERIFY(range.second > range.first);
+            expectedBegin = range.second;
+        }
+        QCOMPARE(expectedBegin, size);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_QParallelFor)
+
+#include "tst_qparallelfor.moc"
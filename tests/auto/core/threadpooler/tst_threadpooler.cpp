@@ -65,6 +65,7 @@ private Q_SLOTS:
     void defaultAspectQueue();
     void doubleAspectQueue();
     void dependencyAspectQueue();
+    void reusedAspectQueue();
     void massTest();
     void perThreadUniqueCall();
 };
@@ -285,6 +286,45 @@ void tst_ThreadPooler::dependencyAspectQueue()
     QVERIFY(value == 8);
 }
 
+/*
+ * Enqueues the same jobs several times, the task graph built the first time
+ * gets reused until the dependencies change.
+ */
+void tst_ThreadPooler::reusedAspectQueue()
+{
+    // GIVEN
+    QAtomicInt callCounter; // Not used in this test
+    int value = 2;
+    QVector<QSharedPointer<Qt3DCore::QAspectJob> > jobList;
+
+    QSharedPointer<TestAspectJob> job1(new TestAspectJob(add2, &callCounter, &value));
+    QSharedPointer<TestAspectJob> job2(new TestAspectJob(multiplyBy2, &callCounter, &value));
+    job2->addDependency(job1);
+    jobList.append(job1);
+    jobList.append(job2);
+
+    // WHEN
+    for (int i = 0; i < 3; ++i) {
+        m_jobManager->enqueueJobs(jobList);
+        m_jobManager->waitForAllJobs();
+    }
+
+    // THEN
+    // value should be (((2+2)*2+2)*2+2)*2 = 44
+    QCOMPARE(value, 44);
+
+    // WHEN
+    value = 2;
+    job2->removeDependency(job1);
+    job1->addDependency(job2);
+    m_jobManager->enqueueJobs(jobList);
+    m_jobManager->waitForAllJobs();
+
+    // THEN
+    // value should be 2*2+2 = 6
+    QCOMPARE(value, 6);
+}
+
 void tst_ThreadPooler::massTest()
 {
     // GIVEN
@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qworkstealingjobmanager_p.h>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QThread>
+
+#include <functional>
+
+namespace {
+
+class FunctorJob : public Qt3DCore::QAspectJob
+{
+public:
+    explicit FunctorJob(std::function<void ()> func)
+        : m_func(std::move(func))
+    {}
+
+    void run() override { m_func(); }
+
+private:
+    std::function<void ()> m_func;
+};
+
+struct ThreadCollector
+{
+    QMutex mutex;
+    QVector<QThread *> threads;
+};
+
+void collectThread(void *arg)
+{
+    ThreadCollector *collector = static_cast<ThreadCollector *>(arg);
+    const QMutexLocker locker(&collector->mutex);
+    collector->threads.push_back(QThread::currentThread());
+}
+
+} // anonymous
+
+class tst_WorkStealingJobManager : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkIndependentJobs()
+    {
+        // GIVEN
+        Qt3DCore::QWorkStealingJobManager manager;
+        QAtomicInt callCounter(0);
+        QVector<Qt3DCore::QAspectJobPtr> jobs;
+        const int jobCount = 500;
+        for (int i = 0; i < jobCount; ++i)
+            jobs.push_back(Qt3DCore::QAspectJobPtr(new FunctorJob([&] { callCounter.ref(); })));
+
+        // WHEN
+        manager.enqueueJobs(jobs);
+        const int runJobs = manager.waitForAllJobs();
+
+        // THEN
+        QCOMPARE(callCounter.loadRelaxed(), jobCount);
+        QCOMPARE(runJobs, jobCount);
+    }
+
+    void checkDependencyOrder()
+    {
+        // GIVEN
+        Qt3DCore::QWorkStealingJobManager manager;
+        QMutex mutex;
+        QVector<int> order;
+        QVector<Qt3DCore::QAspectJobPtr> jobs;
+
+        // Diamond: 0 -> (1, 2) -> 3
+        for (int i = 0; i < 4; ++i) {
+            jobs.push_back(Qt3DCore::QAspectJobPtr(new FunctorJob([&, i] {
+                const QMutexLocker locker(&mutex);
+                order.push_back(i);
+            })));
+        }
+        jobs[1]->addDependency(jobs[0]);
+        jobs[2]->addDependency(jobs[0]);
+        jobs[3]->addDependency(jobs[1]);
+        jobs[3]->addDependency(jobs[2]);
+
+        // WHEN
+        for (int frame = 0; frame < 20; ++frame) {
+            order.clear();
+            manager.enqueueJobs(jobs);
+            manager.waitForAllJobs();
+
+            // THEN
+            QCOMPARE(order.size(), 4);
+            QCOMPARE(order.first(), 0);
+            QCOMPARE(order.last(), 3);
+        }
+    }
+
+    void checkDoubleQueue()
+    {
+        // GIVEN
+        Qt3DCore::QWorkStealingJobManager manager;
+        QAtomicInt callCounter(0);
+        QVector<Qt3DCore::QAspectJobPtr> jobs1;
+        QVector<Qt3DCore::QAspectJobPtr> jobs2;
+        for (int i = 0; i < 3; ++i) {
+            jobs1.push_back(Qt3DCore::QAspectJobPtr(new FunctorJob([&] { callCounter.ref(); })));
+            jobs2.push_back(Qt3DCore::QAspectJobPtr(new FunctorJob([&] { callCounter.ref(); })));
+        }
+
+        // WHEN
+        manager.enqueueJobs(jobs1);
+        manager.enqueueJobs(jobs2);
+        manager.waitForAllJobs();
+
+        // THEN
+        QCOMPARE(callCounter.loadRelaxed(), 6);
+    }
+
+    void checkPerThreadFunction()
+    {
+        // GIVEN
+        Qt3DCore::QWorkStealingJobManager manager;
+        ThreadCollector collector;
+
+        // WHEN
+        manager.waitForPerThreadFunction(collectThread, &collector);
+
+        // THEN
+        QCOMPARE(collector.threads.size(), manager.workerCount());
+        const QSet<QThread *> uniqueThreads(collector.threads.cbegin(), collector.threads.cend());
+        QCOMPARE(uniqueThreads.size(), manager.workerCount());
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_WorkStealingJobManager)
+
+#include "tst_workstealingjobmanager.moc"
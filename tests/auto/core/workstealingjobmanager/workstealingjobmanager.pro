@@ -0,0 +1,7 @@
+TARGET = tst_workstealingjobmanager
+CONFIG += testcase
+TEMPLATE = app
+
+SOURCES += tst_workstealingjobmanager.cpp
+
+QT += testlib 3dcore 3dcore-private
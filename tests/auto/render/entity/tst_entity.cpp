@@ -361,6 +361,49 @@ private slots:
         renderer.resetDirty();
     }
 
+    void checkTransformDirtyPropagation()
+    {
+        // GIVEN
+        TestRenderer renderer;
+        NodeManagers nodeManagers;
+        Qt3DCore::QEntity frontendEntityA, frontendEntityB, frontendEntityC;
+        frontendEntityB.setParent(&frontendEntityA);
+        frontendEntityC.setParent(&frontendEntityB);
+
+        auto backendA = createEntity(renderer, nodeManagers, frontendEntityA);
+        auto backendB = createEntity(renderer, nodeManagers, frontendEntityB);
+        auto backendC = createEntity(renderer, nodeManagers, frontendEntityC);
+
+        // THEN - newly created entities need their transforms computed
+        QVERIFY(backendA->isTransformDirty());
+        QVERIFY(backendB->isTransformDirty());
+        QVERIFY(backendC->isTransformDirty());
+        QVERIFY(backendA->hasTransformDirtyChildren());
+        QVERIFY(backendB->hasTransformDirtyChildren());
+        QVERIFY(!backendC->hasTransformDirtyChildren());
+
+        // WHEN
+        backendA->unsetTransformDirty();
+        backendB->unsetTransformDirty();
+        backendC->unsetTransformDirty();
+        backendC->markTransformDirty();
+
+        // THEN - only C is dirty, ancestors know they have dirty children
+        QVERIFY(!backendA->isTransformDirty());
+        QVERIFY(!backendB->isTransformDirty());
+        QVERIFY(backendC->isTransformDirty());
+        QVERIFY(backendA->hasTransformDirtyChildren());
+        QVERIFY(backendB->hasTransformDirtyChildren());
+        QVERIFY(!backendC->hasTransformDirtyChildren());
+
+        // WHEN
+        backendC->cleanup();
+
+        // THEN
+        QVERIFY(!backendC->isTransformDirty());
+        QVERIFY(!backendC->hasTransformDirtyChildren());
+    }
+
     void shouldHandleSingleComponentEvents_data()
     {
         QTest::addColumn<QComponent*>("component");
@@ -479,6 +522,56 @@ private slots:
         qDeleteAll(components);
     }
 
+    void checkCachedComponentHandles()
+    {
+        // GIVEN
+        TestRenderer renderer;
+        NodeManagers nodeManagers;
+        Qt3DCore::QEntity frontendEntity;
+        Qt3DCore::QTransform *frontendTransform = new Qt3DCore::QTransform(&frontendEntity);
+        QLayer *frontendLayer = new QLayer(&frontendEntity);
+        Transform *transform = nodeManagers.transformManager()->getOrCreateResource(frontendTransform->id());
+        Layer *layer = nodeManagers.layerManager()->getOrCreateResource(frontendLayer->id());
+        Entity *entity = createEntity(renderer, nodeManagers, frontendEntity);
+
+        // WHEN
+        EntityPrivate::get(entity)->componentAdded(frontendTransform);
+        EntityPrivate::get(entity)->componentAdded(frontendLayer);
+
+        // THEN
+        QCOMPARE(entity->renderComponent<Transform>(), transform);
+        QCOMPARE(entity->componentHandle<Transform>(),
+                 nodeManagers.transformManager()->lookupHandle(frontendTransform->id()));
+        QCOMPARE(entity->renderComponents<Layer>(), QVector<Layer *>({ layer }));
+        QCOMPARE(entity->componentsHandle<Layer>(),
+                 QVector<HLayer>({ nodeManagers.layerManager()->lookupHandle(frontendLayer->id()) }));
+
+        // WHEN - the backend components are released and recreated
+        nodeManagers.transformManager()->releaseResource(frontendTransform->id());
+        nodeManagers.layerManager()->releaseResource(frontendLayer->id());
+
+        // THEN
+        QVERIFY(entity->renderComponent<Transform>() == nullptr);
+        QVERIFY(entity->componentHandle<Transform>().isNull());
+        QCOMPARE(entity->renderComponents<Layer>(), QVector<Layer *>({ nullptr }));
+
+        // WHEN
+        transform = nodeManagers.transformManager()->getOrCreateResource(frontendTransform->id());
+        layer = nodeManagers.layerManager()->getOrCreateResource(frontendLayer->id());
+
+        // THEN
+        QCOMPARE(entity->renderComponent<Transform>(), transform);
+        QCOMPARE(entity->renderComponents<Layer>(), QVector<Layer *>({ layer }));
+
+        // WHEN
+        EntityPrivate::get(entity)->componentRemoved(frontendTransform);
+        EntityPrivate::get(entity)->componentRemoved(frontendLayer);
+
+        // THEN
+        QVERIFY(entity->renderComponent<Transform>() == nullptr);
+        QVERIFY(entity->renderComponents<Layer>().isEmpty());
+    }
+
     void traversal() {
         // GIVEN
         TestRenderer renderer;
@@ -0,0 +1,13 @@
+TEMPLATE = app
+
+TARGET = tst_entityspatialindex
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_entityspatialindex.cpp
+
+CONFIG += useCommonTestAspect
+
+include(../commons/commons.pri)
@@ -0,0 +1,261 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/entityspatialindex_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <Qt3DRender/private/sphere_p.h>
+#include <QtCore/QRandomGenerator>
+
+#include "testaspect.h"
+
+using Qt3DRender::Render::Entity;
+using Qt3DRender::Render::EntitySpatialIndex;
+using Qt3DRender::Render::Sphere;
+using Qt3DRender::RayCasting::QRay3D;
+
+namespace {
+
+struct Scene
+{
+    Qt3DCore::QEntity *root = nullptr;
+    QScopedPointer<Qt3DRender::TestAspect> aspect;
+    Entity *backendRoot = nullptr;
+    QVector<Entity *> entities;
+};
+
+// A flat list of siblings plus a few nested entities, as backend nodes
+void buildScene(Scene &scene, int siblingCount)
+{
+    scene.root = new Qt3DCore::QEntity();
+    QVector<Qt3DCore::QEntity *> frontendEntities;
+    for (int i = 0; i < siblingCount; ++i)
+        frontendEntities.push_back(new Qt3DCore::QEntity(scene.root));
+    for (int i = 0; i < siblingCount / 10; ++i)
+        frontendEntities.push_back(new Qt3DCore::QEntity(frontendEntities.at(i)));
+
+    scene.aspect.reset(new Qt3DRender::TestAspect(scene.root));
+    Qt3DRender::Render::EntityManager *entityManager = scene.aspect->nodeManagers()->renderNodesManager();
+    scene.backendRoot = entityManager->lookupResource(scene.root->id());
+    scene.entities.push_back(scene.backendRoot);
+    for (const Qt3DCore::QEntity *entity : qAsConst(frontendEntities))
+        scene.entities.push_back(entityManager->lookupResource(entity->id()));
+}
+
+void placeRandomly(const QVector<Entity *> &entities, QRandomGenerator &generator)
+{
+    for (Entity *entity : entities) {
+        const Vector3D center(float(generator.bounded(200.0)) - 100.0f,
+                              float(generator.bounded(200.0)) - 100.0f,
+                              float(generator.bounded(200.0)) - 100.0f);
+        *entity->worldBoundingVolumeWithChildren() = Sphere(center, float(generator.bounded(2.0)));
+    }
+}
+
+EntitySpatialIndex::Aabb randomBox(QRandomGenerator &generator)
+{
+    EntitySpatialIndex::Aabb box;
+    for (int i = 0; i < 3; ++i) {
+        box.min[i] = float(generator.bounded(200.0)) - 100.0f;
+        box.max[i] = box.min[i] + float(generator.bounded(40.0));
+    }
+    return box;
+}
+
+QVector<Entity *> sorted(QVector<Entity *> entities)
+{
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+
+} // anonymous
+
+class tst_EntitySpatialIndex : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkInitialState()
+    {
+        // GIVEN
+        Qt3DRender::Render::EntityManager manager;
+        EntitySpatialIndex index(&manager);
+
+        // THEN
+        QCOMPARE(index.entityCount(), 0);
+        QCOMPARE(index.height(), 0);
+        QVERIFY(!index.isBuiltFor(nullptr));
+        QVERIFY(!index.coversAllEntities());
+
+        int visited = 0;
+        index.queryBox(EntitySpatialIndex::Aabb { { -1.0f, -1.0f, -1.0f }, { 1.0f, 1.0f, 1.0f } },
+                       [&visited](Entity *) { ++visited; });
+        QCOMPARE(visited, 0);
+    }
+
+    void checkIndexesWholeScene()
+    {
+        // GIVEN
+        Scene scene;
+        buildScene(scene, 1000);
+        QRandomGenerator generator(1);
+        placeRandomly(scene.entities, generator);
+        EntitySpatialIndex index(scene.aspect->nodeManagers()->renderNodesManager());
+
+        // WHEN
+        index.update(scene.backendRoot);
+
+        // THEN
+        QVERIFY(index.isBuiltFor(scene.backendRoot));
+        QVERIFY(index.coversAllEntities());
+        QCOMPARE(index.entityCount(), scene.entities.size());
+        // Balanced, no degenerate chains for flat scenes
+        QVERIFY(index.height() <= 25);
+    }
+
+    void checkBoxQueriesAreConservative()
+    {
+        // GIVEN
+        Scene scene;
+        buildScene(scene, 2000);
+        QRandomGenerator generator(2);
+        placeRandomly(scene.entities, generator);
+        EntitySpatialIndex index(scene.aspect->nodeManagers()->renderNodesManager());
+        index.update(scene.backendRoot);
+
+        for (int i = 0; i < 100; ++i) {
+            // WHEN
+            const EntitySpatialIndex::Aabb queryBox = randomBox(generator);
+            QVector<Entity *> results;
+            index.queryBox(queryBox, [&results](Entity *entity) { results.push_back(entity); });
+            results = sorted(results);
+
+            // THEN
+            QVERIFY(std::adjacent_find(results.cbegin(), results.cend()) == results.cend());
+            for (Entity *entity : qAsConst(scene.entities)) {
+                const EntitySpatialIndex::Aabb box = EntitySpatialIndex::boxForSphere(*entity->worldBoundingVolumeWithChildren());
+                if (EntitySpatialIndex::overlaps(box, queryBox))
+                    QVERIFY(std::binary_search(results.cbegin(), results.cend(), entity));
+            }
+        }
+    }
+
+    void checkRayQueriesAreConservative()
+    {
+        // GIVEN
+        Scene scene;
+        buildScene(scene, 2000);
+        QRandomGenerator generator(3);
+        placeRandomly(scene.entities, generator);
+        EntitySpatialIndex index(scene.aspect->nodeManagers()->renderNodesManager());
+        index.update(scene.backendRoot);
+
+        for (int i = 0; i < 100; ++i) {
+            // WHEN
+            const Vector3D origin(float(generator.bounded(200.0)) - 100.0f, -150.0f,
+                                  float(generator.bounded(200.0)) - 100.0f);
+            const Vector3D direction(float(generator.bounded(0.2)) - 0.1f, 1.0f,
+                                     float(generator.bounded(0.2)) - 0.1f);
+            const QRay3D ray(origin, direction, 1.0f);
+            QVector<Entity *> results;
+            index.queryRay(ray, [&results](Entity *entity) { results.push_back(entity); });
+            results = sorted(results);
+
+            // THEN
+            for (Entity *entity : qAsConst(scene.entities)) {
+                if (entity->worldBoundingVolumeWithChildren()->intersects(ray, nullptr))
+                    QVERIFY(std::binary_search(results.cbegin(), results.cend(), entity));
+            }
+        }
+    }
+
+    void checkRefitsMovedEntities()
+    {
+        // GIVEN
+        Scene scene;
+        buildScene(scene, 500);
+        QRandomGenerator generator(4);
+        placeRandomly(scene.entities, generator);
+        EntitySpatialIndex index(scene.aspect->nodeManagers()->renderNodesManager());
+        index.update(scene.backendRoot);
+
+        // WHEN
+        Entity *moved = scene.entities.at(42);
+        *moved->worldBoundingVolumeWithChildren() = Sphere(Vector3D(500.0f, 500.0f, 500.0f), 1.0f);
+        index.update(scene.backendRoot);
+
+        // THEN
+        QVector<Entity *> results;
+        index.queryBox(EntitySpatialIndex::Aabb { { 490.0f, 490.0f, 490.0f }, { 510.0f, 510.0f, 510.0f } },
+                       [&results](Entity *entity) { results.push_back(entity); });
+        QCOMPARE(results, QVector<Entity *>({ moved }));
+        QCOMPARE(index.entityCount(), scene.entities.size());
+    }
+
+    void checkDropsEntitiesLeavingTheScene()
+    {
+        // GIVEN
+        Scene scene;
+        buildScene(scene, 100);
+        QRandomGenerator generator(5);
+        placeRandomly(scene.entities, generator);
+        EntitySpatialIndex index(scene.aspect->nodeManagers()->renderNodesManager());
+        index.update(scene.backendRoot);
+        QCOMPARE(index.entityCount(), scene.entities.size());
+
+        // WHEN
+        Entity *detached = scene.entities.last();
+        Entity *parent = scene.aspect->nodeManagers()->renderNodesManager()->data(detached->parentHandle());
+        parent->removeChildHandle(detached->handle());
+        index.update(scene.backendRoot);
+
+        // THEN
+        QCOMPARE(index.entityCount(), scene.entities.size() - 1);
+        QVERIFY(!index.coversAllEntities());
+        bool found = false;
+        index.query([](const EntitySpatialIndex::Aabb &) { return true; },
+                    [&](Entity *entity) { found |= entity == detached; });
+        QVERIFY(!found);
+
+        // WHEN
+        index.update(parent);
+
+        // THEN
+        QVERIFY(index.isBuiltFor(parent));
+        QVERIFY(!index.isBuiltFor(scene.backendRoot));
+        QCOMPARE(index.entityCount(), 1 + parent->childrenHandles().size());
+    }
+};
+
+QTEST_MAIN(tst_EntitySpatialIndex)
+
+#include "tst_entityspatialindex.moc"
@@ -0,0 +1,184 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DRender/private/frustumcullingjob_p.h>
+#include <QtCore/QRandomGenerator>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::Render;
+
+namespace {
+
+struct Spheres
+{
+    QVector<float> centersX;
+    QVector<float> centersY;
+    QVector<float> centersZ;
+    QVector<float> radii;
+};
+
+float randomFloat(QRandomGenerator &generator, float min, float max)
+{
+    return min + float(generator.generateDouble()) * (max - min);
+}
+
+// Every tenth sphere is a null sphere
+Spheres randomSpheres(QRandomGenerator &generator, int count)
+{
+    Spheres spheres;
+    for (int i = 0; i < count; ++i) {
+        spheres.centersX.push_back(randomFloat(generator, -20.0f, 20.0f));
+        spheres.centersY.push_back(randomFloat(generator, -20.0f, 20.0f));
+        spheres.centersZ.push_back(randomFloat(generator, -20.0f, 20.0f));
+        spheres.radii.push_back(i % 10 == 9 ? -1.0f : randomFloat(generator, 0.0f, 3.0f));
+    }
+    return spheres;
+}
+
+// Axis aligned box [-10, 10]^3, normals pointing inwards
+void boxPlanes(Vector4D *planes)
+{
+    planes[0] = Vector4D(1.0f, 0.0f, 0.0f, 10.0f);
+    planes[1] = Vector4D(-1.0f, 0.0f, 0.0f, 10.0f);
+    planes[2] = Vector4D(0.0f, 1.0f, 0.0f, 10.0f);
+    planes[3] = Vector4D(0.0f, -1.0f, 0.0f, 10.0f);
+    planes[4] = Vector4D(0.0f, 0.0f, 1.0f, 10.0f);
+    planes[5] = Vector4D(0.0f, 0.0f, -1.0f, 10.0f);
+}
+
+QVector<int> referenceCull(const Spheres &spheres, int begin, int end, const Vector4D *planes)
+{
+    QVector<int> visibleIndices;
+    for (int i = begin; i < end; ++i) {
+        bool visible = true;
+        for (int p = 0; p < 6; ++p) {
+            const float distance = (spheres.centersX.at(i) * planes[p].x() + spheres.centersY.at(i) * planes[p].y())
+                    + (spheres.centersZ.at(i) * planes[p].z() + planes[p].w());
+            if (distance < -spheres.radii.at(i))
+                visible = false;
+        }
+        if (visible)
+            visibleIndices.push_back(i);
+    }
+    return visibleIndices;
+}
+
+QVector<int> cull(const Spheres &spheres, int begin, int end, const Vector4D *planes)
+{
+    QVector<int> visibleIndices;
+    FrustumCullingJob::cullSpheres(spheres.centersX.constData(), spheres.centersY.constData(),
+                                   spheres.centersZ.constData(), spheres.radii.constData(),
+                                   begin, end, planes, visibleIndices);
+    return visibleIndices;
+}
+
+} // anonymous
+
+class tst_FrustumCulling : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void checkCullSpheres_data()
+    {
+        QTest::addColumn<int>("count");
+        QTest::addColumn<int>("begin");
+
+        QTest::newRow("empty") << 0 << 0;
+        QTest::newRow("single") << 1 << 0;
+        QTest::newRow("tail only") << 7 << 0;
+        QTest::newRow("one block") << 8 << 0;
+        QTest::newRow("blocks and tail") << 1003 << 0;
+        QTest::newRow("unaligned begin") << 1003 << 5;
+    }
+
+    void checkCullSpheres()
+    {
+        // GIVEN
+        QFETCH(int, count);
+        QFETCH(int, begin);
+        QRandomGenerator generator(count);
+        const Spheres spheres = randomSpheres(generator, count);
+        Vector4D planes[6];
+        boxPlanes(planes);
+
+        // WHEN
+        const QVector<int> visibleIndices = cull(spheres, begin, count, planes);
+
+        // THEN
+        QCOMPARE(visibleIndices, referenceCull(spheres, begin, count, planes));
+    }
+
+    void checkBoundaries()
+    {
+        // GIVEN
+        Spheres spheres;
+        // Inside, touching a plane from outside, just beyond a plane, null at the origin
+        const float centersX[] = { 0.0f, 11.0f, 11.5f, 0.0f };
+        const float radii[] = { 1.0f, 1.0f, 1.0f, -1.0f };
+        for (int i = 0; i < 4; ++i) {
+            spheres.centersX.push_back(centersX[i]);
+            spheres.centersY.push_back(0.0f);
+            spheres.centersZ.push_back(0.0f);
+            spheres.radii.push_back(radii[i]);
+        }
+        Vector4D planes[6];
+        boxPlanes(planes);
+
+        // WHEN
+        const QVector<int> visibleIndices = cull(spheres, 0, 4, planes);
+
+        // THEN
+        QCOMPARE(visibleIndices, QVector<int>({ 0, 1 }));
+    }
+
+    void checkOutputIsAppended()
+    {
+        // GIVEN
+        QRandomGenerator generator(42);
+        const Spheres spheres = randomSpheres(generator, 100);
+        Vector4D planes[6];
+        boxPlanes(planes);
+        QVector<int> visibleIndices = { -1 };
+
+        // WHEN
+        FrustumCullingJob::cullSpheres(spheres.centersX.constData(), spheres.centersY.constData(),
+                                       spheres.centersZ.constData(), spheres.radii.constData(),
+                                       0, 100, planes, visibleIndices);
+
+        // THEN
+        QCOMPARE(visibleIndices.first(), -1);
+        QCOMPARE(visibleIndices.mid(1), referenceCull(spheres, 0, 100, planes));
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_FrustumCulling)
+
+#include "tst_frustumculling.moc"
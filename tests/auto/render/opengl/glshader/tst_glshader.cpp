@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <glshader_p.h>
+#include <renderviewjobutils_p.h>
+#include <submissioncontext_p.h>
+#include <Qt3DRender/private/stringtoint_p.h>
+#include <Qt3DRender/private/uniform_p.h>
+
+using namespace Qt3DRender::Render;
+using namespace Qt3DRender::Render::OpenGL;
+
+class tst_GLShader : public QObject
+{
+    Q_OBJECT
+
+    void initializeUniforms(GLShader *shader, const QStringList &names)
+    {
+        QVector<ShaderUniform> uniforms;
+        for (const QString &name : names) {
+            ShaderUniform uniform;
+            uniform.m_name = name;
+            uniform.m_type = GL_FLOAT;
+            uniform.m_size = 1;
+            uniform.m_location = uniforms.size();
+            uniforms.push_back(uniform);
+        }
+        shader->initializeUniforms(uniforms);
+    }
+
+private Q_SLOTS:
+    void checkUploadedUniformValues()
+    {
+        // GIVEN
+        GLShader shader;
+        initializeUniforms(&shader, { QStringLiteral("alpha"), QStringLiteral("beta") });
+        const int alphaId = StringToInt::lookupId(QStringLiteral("alpha"));
+        const int betaId = StringToInt::lookupId(QStringLiteral("beta"));
+        const int unknownId = StringToInt::lookupId(QStringLiteral("notAnActiveUniform"));
+        SubmissionContext::UniformUploadStatistics statistics;
+
+        // THEN - nothing has been uploaded yet
+        QVERIFY(SubmissionContext::needsUniformUpload(&shader, alphaId, UniformValue(1.0f), statistics));
+        QVERIFY(SubmissionContext::needsUniformUpload(&shader, betaId, UniformValue(1.0f), statistics));
+        QCOMPARE(statistics.uploaded, 2);
+        QCOMPARE(statistics.skipped, 0);
+
+        // WHEN - unchanged value
+        const bool unchangedUploaded = SubmissionContext::needsUniformUpload(&shader, alphaId, UniformValue(1.0f), statistics);
+
+        // THEN
+        QVERIFY(!unchangedUploaded);
+        QCOMPARE(statistics.uploaded, 2);
+        QCOMPARE(statistics.skipped, 1);
+
+        // WHEN - changed value
+        const bool changedUploaded = SubmissionContext::needsUniformUpload(&shader, alphaId, UniformValue(2.0f), statistics);
+
+        // THEN
+        QVERIFY(changedUploaded);
+        QCOMPARE(statistics.uploaded, 3);
+        QCOMPARE(statistics.skipped, 1);
+        QVERIFY(!shader.updateUploadedUniformValue(alphaId, UniformValue(2.0f)));
+        QVERIFY(!shader.updateUploadedUniformValue(betaId, UniformValue(1.0f)));
+
+        // THEN - uniforms not known to the shader are always uploaded
+        QVERIFY(shader.updateUploadedUniformValue(unknownId, UniformValue(1.0f)));
+        QVERIFY(shader.updateUploadedUniformValue(unknownId, UniformValue(1.0f)));
+
+        // WHEN - the program was linked again
+        initializeUniforms(&shader, { QStringLiteral("alpha"), QStringLiteral("beta") });
+
+        // THEN
+        QVERIFY(SubmissionContext::needsUniformUpload(&shader, alphaId, UniformValue(2.0f), statistics));
+        QVERIFY(SubmissionContext::needsUniformUpload(&shader, betaId, UniformValue(1.0f), statistics));
+        QCOMPARE(statistics.uploaded, 5);
+        QCOMPARE(statistics.skipped, 1);
+
+        // THEN - without a shader there is nothing to compare against
+        QVERIFY(SubmissionContext::needsUniformUpload(nullptr, alphaId, UniformValue(2.0f), statistics));
+        QCOMPARE(statistics.uploaded, 6);
+    }
+
+    void checkShaderDataUniformPlansRemoval()
+    {
+        // GIVEN
+        GLShader shader;
+        const Qt3DCore::QNodeId shaderDataId1 = Qt3DCore::QNodeId::createId();
+        const Qt3DCore::QNodeId shaderDataId2 = Qt3DCore::QNodeId::createId();
+        const int blockNameId = StringToInt::lookupId(QStringLiteral("block"));
+        const int otherBlockNameId = StringToInt::lookupId(QStringLiteral("otherBlock"));
+        const auto plan = QSharedPointer<const ShaderDataUniformPlan>::create();
+        shader.setShaderDataUniformPlan(shaderDataId1, blockNameId, plan);
+        shader.setShaderDataUniformPlan(shaderDataId1, otherBlockNameId, plan);
+        shader.setShaderDataUniformPlan(shaderDataId2, blockNameId, plan);
+
+        // WHEN
+        shader.removeShaderDataUniformPlans({ shaderDataId1 });
+
+        // THEN
+        QVERIFY(shader.shaderDataUniformPlan(shaderDataId1, blockNameId).isNull());
+        QVERIFY(shader.shaderDataUniformPlan(shaderDataId1, otherBlockNameId).isNull());
+        QCOMPARE(shader.shaderDataUniformPlan(shaderDataId2, blockNameId), plan);
+    }
+};
+
+QTEST_MAIN(tst_GLShader)
+
+#include "tst_glshader.moc"
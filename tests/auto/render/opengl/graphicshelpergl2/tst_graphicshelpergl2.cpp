@@ -930,6 +930,8 @@ private Q_SLOTS:
         SUPPORTS_FEATURE(GraphicsHelperInterface::IndirectDrawing, false);
         SUPPORTS_FEATURE(GraphicsHelperInterface::MapBuffer, true);
         SUPPORTS_FEATURE(GraphicsHelperInterface::Fences, false);
+        SUPPORTS_FEATURE(GraphicsHelperInterface::MultiDrawIndirect, false);
+        SUPPORTS_FEATURE(GraphicsHelperInterface::BufferStorage, false);
     }
 
 
@@ -1320,6 +1320,8 @@ private Q_SLOTS:
         SUPPORTS_FEATURE(GraphicsHelperInterface::DrawBuffersBlend, false);
         // Tesselation could be true or false depending on extensions so not tested
         SUPPORTS_FEATURE(GraphicsHelperInterface::BlitFramebuffer, true);
+        SUPPORTS_FEATURE(GraphicsHelperInterface::MultiDrawIndirect, false);
+        SUPPORTS_FEATURE(GraphicsHelperInterface::BufferStorage, false);
     }
 
 
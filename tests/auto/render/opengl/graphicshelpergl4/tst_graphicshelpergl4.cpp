@@ -1484,8 +1484,9 @@ private Q_SLOTS:
 
     void supportsFeature()
     {
-        for (int i = 0; i <= GraphicsHelperInterface::Fences; ++i)
+        for (int i = 0; i <= GraphicsHelperInterface::MultiDrawIndirect; ++i)
             QVERIFY(m_glHelper.supportsFeature(static_cast<GraphicsHelperInterface::Feature>(i)));
+        // BufferStorage depends on GL_ARB_buffer_storage with a 4.3 context so not tested
     }
 
 
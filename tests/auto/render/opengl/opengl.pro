@@ -6,6 +6,7 @@ SUBDIRS += \
         graphicshelpergl3_2 \
         graphicshelpergl2 \
         glshadermanager \
+        glshader \
         materialparametergathererjob \
         textures \
         renderer \
@@ -14,6 +15,7 @@ SUBDIRS += \
         renderqueue \
         renderviewbuilder \
         qgraphicsutils \
+        ringbufferallocator \
         computecommand
 
 !macos: SUBDIRS += graphicshelpergl4
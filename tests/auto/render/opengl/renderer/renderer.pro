@@ -8,6 +8,8 @@ CONFIG += testcase
 
 SOURCES += tst_renderer.cpp
 
+include(../../../core/common/common.pri)
+
 # Link Against OpenGL Renderer Plugin
 include(../opengl_render_plugin.pri)
 
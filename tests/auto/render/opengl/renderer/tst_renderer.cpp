@@ -34,6 +34,12 @@
 #include <renderview_p.h>
 #include <renderviewbuilder_p.h>
 #include <renderqueue_p.h>
+#include <glshader_p.h>
+#include <rendercommand_p.h>
+#include <qbackendnodetester.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/stringtoint_p.h>
 #include <Qt3DRender/private/viewportnode_p.h>
 #include <Qt3DRender/private/offscreensurfacehelper_p.h>
 #include <Qt3DRender/private/qrenderaspect_p.h>
@@ -47,6 +53,42 @@ public :
     tst_Renderer() {}
     ~tst_Renderer() {}
 
+    // Introspection data of a shader with a single vertexPosition attribute
+    void initializeShader(Qt3DRender::Render::OpenGL::GLShader *shader,
+                          const QStringList &uniformNames,
+                          const QStringList &storageBlockNames)
+    {
+        QVector<Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
+        for (const QString &name : uniformNames) {
+            Qt3DRender::Render::OpenGL::ShaderUniform uniform;
+            uniform.m_name = name;
+            uniform.m_type = GL_FLOAT_MAT4;
+            uniform.m_size = 1;
+            uniform.m_location = uniforms.size();
+            uniforms.push_back(uniform);
+        }
+
+        Qt3DRender::Render::OpenGL::ShaderAttribute attribute;
+        attribute.m_name = QStringLiteral("vertexPosition");
+        attribute.m_type = GL_FLOAT_VEC3;
+        attribute.m_size = 1;
+        attribute.m_location = 0;
+
+        QVector<Qt3DRender::Render::OpenGL::ShaderStorageBlock> storageBlocks;
+        for (const QString &name : storageBlockNames) {
+            Qt3DRender::Render::OpenGL::ShaderStorageBlock block;
+            block.m_name = name;
+            block.m_index = storageBlocks.size();
+            block.m_binding = storageBlocks.size();
+            storageBlocks.push_back(block);
+        }
+
+        shader->initializeUniforms(uniforms);
+        shader->initializeAttributes({ attribute });
+        shader->initializeShaderStorageBlocks(storageBlocks);
+        shader->setLoaded(true);
+    }
+
 private Q_SLOTS:
 
     void checkPreRenderBinJobs()
@@ -293,6 +335,145 @@ private Q_SLOTS:
         // Properly shutdown command thread
         renderer.shutdown();
     }
+
+    void checkMultiDrawBatchSize()
+    {
+        // GIVEN
+        Qt3DRender::Render::OpenGL::GLShader shader;
+        Qt3DRender::Render::OpenGL::GLShader otherShader;
+        const int modelMatrixId = Qt3DRender::Render::StringToInt::lookupId(QLatin1String("modelMatrix"));
+
+        const auto drawCommand = [&] (int firstVertex, float uniformValue) {
+            Qt3DRender::Render::OpenGL::RenderCommand command;
+            command.m_isValid = true;
+            command.m_glShader = &shader;
+            command.m_firstVertex = firstVertex;
+            command.m_primitiveCount = 3;
+            command.m_instanceCount = 1;
+            command.m_parameterPack.setUniform(modelMatrixId, Qt3DRender::Render::UniformValue(uniformValue));
+            return command;
+        };
+
+        QVector<Qt3DRender::Render::OpenGL::RenderCommand> commands = {
+            drawCommand(0, 1.0f),
+            drawCommand(3, 1.0f),
+            drawCommand(6, 1.0f),
+            drawCommand(9, 2.0f),
+            drawCommand(12, 2.0f)
+        };
+        commands[4].m_glShader = &otherShader;
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 0), 3);
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 1), 2);
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 3), 1);
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 4), 1);
+
+        // WHEN
+        commands[1].m_parameterPack.uniforms().clear();
+
+        // THEN -> Uniforms removed by minimization are those of the previous command
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 0), 3);
+
+        // WHEN
+        commands[2].m_primitiveRestartEnabled = true;
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 0), 2);
+
+        // WHEN
+        commands[0].m_drawIndirect = true;
+
+        // THEN
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(commands, 0), 1);
+    }
+
+    void checkEntitiesWithDrawDataAreMultiDrawn()
+    {
+        // GIVEN
+        Qt3DRender::Render::NodeManagers nodeManagers;
+        Qt3DRender::Render::OpenGL::Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
+        Qt3DRender::Render::OffscreenSurfaceHelper offscreenHelper(&renderer);
+        Qt3DRender::Render::RenderSettings settings;
+        // owned by FG manager
+        Qt3DRender::Render::ViewportNode *fgRoot = new Qt3DRender::Render::ViewportNode();
+        const Qt3DCore::QNodeId fgRootId = Qt3DCore::QNodeId::createId();
+
+        nodeManagers.frameGraphManager()->appendNode(fgRootId, fgRoot);
+        settings.setActiveFrameGraphId(fgRootId);
+
+        renderer.setNodeManagers(&nodeManagers);
+        renderer.setSettings(&settings);
+        renderer.setOffscreenSurfaceHelper(&offscreenHelper);
+        renderer.initialize();
+
+        // Ensure invoke calls are performed
+        QCoreApplication::processEvents();
+
+        // Reads the model matrix from its qt3d_DrawData block
+        Qt3DRender::Render::OpenGL::GLShader drawDataShader;
+        initializeShader(&drawDataShader,
+                         { QStringLiteral("viewProjectionMatrix") },
+                         { QStringLiteral("qt3d_DrawData") });
+        // Reads it from the modelMatrix uniform
+        Qt3DRender::Render::OpenGL::GLShader uniformShader;
+        initializeShader(&uniformShader,
+                         { QStringLiteral("viewProjectionMatrix"), QStringLiteral("modelMatrix") },
+                         {});
+        QVERIFY(drawDataShader.hasDrawData());
+        QVERIFY(!uniformShader.hasDrawData());
+
+        const int entityCount = 8;
+        Qt3DCore::QBackendNodeTester backendNodeTester;
+        Qt3DCore::QEntity frontendEntities[entityCount];
+        Qt3DRender::Render::Entity backendEntities[entityCount];
+        Qt3DRender::Render::OpenGL::EntityRenderCommandData drawDataCommands;
+        Qt3DRender::Render::OpenGL::EntityRenderCommandData uniformCommands;
+
+        for (int i = 0; i < entityCount; ++i) {
+            Qt3DRender::Render::Entity *entity = &backendEntities[i];
+            entity->setRenderer(&renderer);
+            entity->setNodeManagers(&nodeManagers);
+            backendNodeTester.simulateInitializationSync(&frontendEntities[i], entity);
+            QMatrix4x4 worldTransform;
+            worldTransform.translate(float(i), 0.0f, 0.0f);
+            *entity->worldTransform() = Matrix4x4(worldTransform);
+
+            // Same mesh drawn at different places
+            Qt3DRender::Render::OpenGL::RenderCommand command;
+            command.m_firstVertex = 0;
+            command.m_primitiveCount = 3;
+            command.m_instanceCount = 1;
+
+            command.m_glShader = &drawDataShader;
+            drawDataCommands.push_back(entity, command, {}, {});
+            command.m_glShader = &uniformShader;
+            uniformCommands.push_back(entity, command, {}, {});
+        }
+
+        Qt3DRender::Render::OpenGL::RenderView renderView;
+        renderView.setRenderer(&renderer);
+
+        // WHEN
+        renderView.updateRenderCommand(&drawDataCommands, 0, entityCount);
+        renderView.updateRenderCommand(&uniformCommands, 0, entityCount);
+
+        // THEN -> Per entity values only split the batch when read from uniforms
+        QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(drawDataCommands.commands, 0), entityCount);
+        for (int i = 0; i < entityCount; ++i)
+            QCOMPARE(Qt3DRender::Render::OpenGL::Renderer::multiDrawBatchSize(uniformCommands.commands, i), 1);
+
+        // THEN -> DrawData holds the world transform of each entity (column major)
+        for (int i = 0; i < entityCount; ++i) {
+            const Qt3DRender::Render::OpenGL::DrawData &drawData = drawDataCommands.commands.at(i).m_parameterPack.drawData();
+            QCOMPARE(drawData.modelMatrix[0], 1.0f);
+            QCOMPARE(drawData.modelMatrix[12], float(i));
+            QCOMPARE(drawData.modelMatrix[15], 1.0f);
+        }
+
+        // Properly shutdown command thread
+        renderer.shutdown();
+    }
 };
 
 QTEST_MAIN(tst_Renderer)
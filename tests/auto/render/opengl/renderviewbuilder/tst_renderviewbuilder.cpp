@@ -224,6 +224,8 @@ private Q_SLOTS:
             QCOMPARE(renderViewBuilder.renderer(), testAspect.renderer());
             QCOMPARE(renderViewBuilder.layerCacheNeedsToBeRebuilt(), false);
             QCOMPARE(renderViewBuilder.materialGathererCacheNeedsToBeRebuilt(), false);
+            QCOMPARE(renderViewBuilder.renderCommandCacheNeedsToBeRebuilt(), false);
+            QCOMPARE(renderViewBuilder.renderCommandCacheNeedsToBeUpdated(), false);
             QVERIFY(!renderViewBuilder.renderViewJob().isNull());
             QVERIFY(!renderViewBuilder.frustumCullingJob().isNull());
             QVERIFY(!renderViewBuilder.syncPreFrustumCullingJob().isNull());
@@ -282,6 +284,21 @@ private Q_SLOTS:
             // mark jobs dirty and recheck
             QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 9 + 2 * Qt3DRender::Render::OpenGL::RenderViewBuilder::optimalJobCount());
         }
+
+        {
+            // WHEN
+            Qt3DRender::Render::OpenGL::RenderViewBuilder renderViewBuilder(leafNode, 0, testAspect.renderer());
+            renderViewBuilder.setRenderCommandCacheNeedsToBeUpdated(true);
+            renderViewBuilder.prepareJobs();
+
+            // THEN
+            QCOMPARE(renderViewBuilder.renderCommandCacheNeedsToBeUpdated(), true);
+            QCOMPARE(renderViewBuilder.renderViewCommandBuilderJobs().size(), Qt3DRender::Render::OpenGL::RenderViewBuilder::optimalJobCount());
+            QVERIFY(!renderViewBuilder.syncRenderViewPreCommandBuildingJob().isNull());
+
+            // mark jobs dirty and recheck
+            QCOMPARE(renderViewBuilder.buildJobHierachy().size(), 9 + 2 * Qt3DRender::Render::OpenGL::RenderViewBuilder::optimalJobCount());
+        }
     }
 
     void checkCheckJobDependencies()
@@ -666,6 +683,64 @@ private Q_SLOTS:
         }
     }
 
+    void checkMergeRenderCommandData()
+    {
+        // GIVEN
+        Qt3DRender::Render::Entity backendEntities[4];
+        QVector<Qt3DRender::Render::Entity *> entities;
+        for (Qt3DRender::Render::Entity &entity : backendEntities)
+            entities.push_back(&entity);
+        std::sort(entities.begin(), entities.end());
+
+        const auto commandFor = [] (int tag) {
+            Qt3DRender::Render::OpenGL::RenderCommand command;
+            command.m_firstInstance = tag;
+            return command;
+        };
+        const auto buildDataFor = [] (int tag) {
+            Qt3DRender::Render::OpenGL::RenderCommandBuildData buildData;
+            buildData.m_changeCost = tag;
+            return buildData;
+        };
+        const Qt3DRender::Render::OpenGL::RenderPassParameterData passData = {};
+
+        // Two commands per entity, tagged with 0 when cached
+        Qt3DRender::Render::OpenGL::EntityRenderCommandData cachedData;
+        for (Qt3DRender::Render::Entity *entity : qAsConst(entities)) {
+            cachedData.push_back(entity, commandFor(0), buildDataFor(0), passData);
+            cachedData.push_back(entity, commandFor(0), buildDataFor(0), passData);
+        }
+
+        // entities[1] rebuilt with a single command and entities[2] rebuilt
+        // without any command
+        Qt3DRender::Render::OpenGL::EntityRenderCommandData rebuiltData;
+        rebuiltData.push_back(entities[1], commandFor(1), buildDataFor(1), passData);
+        const QVector<Qt3DRender::Render::Entity *> rebuiltEntities = { entities[1], entities[2] };
+
+        // entities[3] no longer renderable
+        const QVector<Qt3DRender::Render::Entity *> currentEntities = entities.mid(0, 3);
+
+        // WHEN
+        const Qt3DRender::Render::OpenGL::EntityRenderCommandData mergedData =
+                Qt3DRender::Render::OpenGL::RenderViewBuilder::mergeRenderCommandData(std::move(cachedData),
+                                                                                      std::move(rebuiltData),
+                                                                                      rebuiltEntities,
+                                                                                      currentEntities);
+
+        // THEN
+        QCOMPARE(mergedData.size(), 3);
+        QCOMPARE(mergedData.entities.at(0), entities[0]);
+        QCOMPARE(mergedData.entities.at(1), entities[0]);
+        QCOMPARE(mergedData.entities.at(2), entities[1]);
+        QCOMPARE(mergedData.commands.at(0).m_firstInstance, 0);
+        QCOMPARE(mergedData.commands.at(1).m_firstInstance, 0);
+        QCOMPARE(mergedData.commands.at(2).m_firstInstance, 1);
+        QCOMPARE(mergedData.buildData.size(), 3);
+        QCOMPARE(mergedData.buildData.at(0).m_changeCost, 0);
+        QCOMPARE(mergedData.buildData.at(1).m_changeCost, 0);
+        QCOMPARE(mergedData.buildData.at(2).m_changeCost, 1);
+    }
+
 };
 
 QTEST_MAIN(tst_RenderViewBuilder)
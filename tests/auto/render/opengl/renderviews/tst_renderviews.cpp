@@ -39,6 +39,7 @@
 #include <renderer_p.h>
 #include <glresourcemanagers_p.h>
 #include <private/shader_p.h>
+#include <numeric>
 
 QT_BEGIN_NAMESPACE
 
@@ -56,12 +57,13 @@ void compareShaderParameterPacks(const ShaderParameterPack &t1,
     const PackUniformHash hash1 = t1.uniforms();
     const PackUniformHash hash2 = t2.uniforms();
 
-    QCOMPARE(hash1.keys.size(), hash2.keys.size());
+    QCOMPARE(hash1.size(), hash2.size());
 
-    for (int i = 0, m = hash1.keys.size(); i < m; ++i) {
-        const int key = hash1.keys.at(i);
-        QCOMPARE(hash1.value(key), hash2.value(key));
-    }
+    QVector<int> nameIds;
+    hash1.forEachNameId([&nameIds] (int nameId) { nameIds.push_back(nameId); return true; });
+
+    for (const int nameId : qAsConst(nameIds))
+        QCOMPARE(hash1.value(nameId), hash2.value(nameId));
 }
 
 } // anonymous
@@ -142,6 +144,7 @@ private Q_SLOTS:
         Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
         RenderView renderView;
         QVector<RenderCommand> rawCommands;
+        QVector<RenderCommandBuildData> rawBuildData;
         QVector<QSortPolicy::SortType> sortTypes;
 
         renderer.setNodeManagers(&nodeManagers);
@@ -151,20 +154,28 @@ private Q_SLOTS:
 
         for (int i = 0; i < 200; ++i) {
             RenderCommand c;
-            c.m_depth = float(i);
+            c.m_firstInstance = i;
+            RenderCommandBuildData b;
+            b.m_depth = float(i);
             rawCommands.push_back(c);
+            rawBuildData.push_back(b);
         }
 
         // WHEN
         renderView.addSortType(sortTypes);
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, rawBuildData);
         renderView.sort();
 
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
+        const QVector<RenderCommandBuildData> sortedBuildData = renderView.commandsBuildData();
         QCOMPARE(rawCommands.size(), sortedCommands.size());
+        QCOMPARE(rawBuildData.size(), sortedBuildData.size());
         for (int j = 1; j < sortedCommands.size(); ++j)
-            QVERIFY(sortedCommands.at(j - 1).m_depth > sortedCommands.at(j).m_depth);
+            QVERIFY(sortedBuildData.at(j - 1).m_depth > sortedBuildData.at(j).m_depth);
+        // Commands follow their build data
+        for (int j = 0; j < sortedCommands.size(); ++j)
+            QCOMPARE(sortedCommands.at(j).m_firstInstance, int(sortedBuildData.at(j).m_depth));
 
         // RenderCommands are deleted by RenderView dtor
         renderer.shutdown();
@@ -200,12 +211,13 @@ private Q_SLOTS:
 
         // WHEN
         renderView.addSortType(sortTypes);
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, QVector<RenderCommandBuildData>(rawCommands.size()));
         renderView.sort();
 
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
         QCOMPARE(rawCommands.size(), sortedCommands.size());
+        QCOMPARE(renderView.commandsBuildData().size(), sortedCommands.size());
         GLShader *targetShader;
 
         for (int j = 0; j < sortedCommands.size(); ++j) {
@@ -257,6 +269,28 @@ private Q_SLOTS:
                 << (QVector<QShaderProgram*>() << shader1 << shader1 << shader1 << shader2 << shader2 << shader2)
                 << (QVector<ShaderParameterPack>() << pack1 << pack1 << pack1 << pack1 << pack1 << pack1)
                 << (QVector<ShaderParameterPack>() << pack1 << minifiedPack1 << minifiedPack1 << pack1 << minifiedPack1 << minifiedPack1);
+
+        ShaderParameterPack pack2 = pack1;
+        pack2.setUniform(2, UniformValue(42.0f));
+        ShaderParameterPack minifiedPack2;
+        minifiedPack2.setUniform(2, UniformValue(42.0f));
+        ShaderParameterPack minifiedPack2Restored;
+        minifiedPack2Restored.setUniform(2, UniformValue(1584.0f));
+
+        QTest::newRow("ChangedValuesKept")
+                << (QVector<QShaderProgram*>() << shader1 << shader1 << shader1)
+                << (QVector<ShaderParameterPack>() << pack1 << pack2 << pack1)
+                << (QVector<ShaderParameterPack>() << pack1 << minifiedPack2 << minifiedPack2Restored);
+
+        ShaderParameterPack pack3 = pack1;
+        pack3.setUniform(4, UniformValue(0));
+        ShaderParameterPack minifiedPack3;
+        minifiedPack3.setUniform(4, UniformValue(0));
+
+        QTest::newRow("NewDefaultValueKept")
+                << (QVector<QShaderProgram*>() << shader1 << shader1)
+                << (QVector<ShaderParameterPack>() << pack1 << pack3)
+                << (QVector<ShaderParameterPack>() << pack1 << minifiedPack3);
     }
 
     void checkRenderViewUniformMinification()
@@ -279,28 +313,33 @@ private Q_SLOTS:
 
         RenderView renderView;
         QVector<RenderCommand> rawCommands;
+        QVector<RenderCommandBuildData> rawBuildData;
         renderView.setRenderer(&renderer);
 
         for (int i = 0, m = shaders.size(); i < m; ++i) {
+            RenderCommandBuildData b;
+            b.m_shaderId = shaders.at(i)->id();
             RenderCommand c;
-            c.m_shaderId = shaders.at(i)->id();
-            c.m_glShader = shaderManager->lookupResource(c.m_shaderId);
+            c.m_glShader = shaderManager->lookupResource(b.m_shaderId);
             c.m_parameterPack = rawParameters.at(i);
             rawCommands.push_back(c);
+            rawBuildData.push_back(b);
         }
 
         // WHEN
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, rawBuildData);
         renderView.addSortType((QVector<QSortPolicy::SortType>() << QSortPolicy::Uniform));
         renderView.sort();
 
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
+        const QVector<RenderCommandBuildData> sortedBuildData = renderView.commandsBuildData();
         QCOMPARE(rawCommands, sortedCommands);
+        QCOMPARE(rawBuildData, sortedBuildData);
 
         for (int i = 0, m = shaders.size(); i < m; ++i) {
             const RenderCommand c = sortedCommands.at(i);
-            QCOMPARE(c.m_shaderId, shaders.at(i)->id());
+            QCOMPARE(sortedBuildData.at(i).m_shaderId, shaders.at(i)->id());
             compareShaderParameterPacks(c.m_parameterPack, expectedMinimizedParameters.at(i));
         }
 
@@ -308,6 +347,50 @@ private Q_SLOTS:
     }
 
 
+    void checkPackUniformHashSharedValues()
+    {
+        // GIVEN
+        PackUniformHash material;
+        material.insert(8, UniformValue(Vector3D(1.0f, 2.0f, 3.0f)));
+        material.insert(2, UniformValue(883));
+        material.insert(5, UniformValue(1584.0f));
+        material.share();
+
+        // WHEN
+        PackUniformHash command = material;
+        command.insert(5, UniformValue(42.0f));
+        command.insert(3, UniformValue(Vector4D(1.0f, 0.0f, 0.0f, 1.0f)));
+
+        // THEN
+        QVector<int> nameIds;
+        command.forEachNameId([&nameIds] (int nameId) { nameIds.push_back(nameId); return true; });
+        QCOMPARE(nameIds, QVector<int>() << 2 << 3 << 5 << 8);
+        QCOMPARE(command.size(), 4);
+        QCOMPARE(command.value(5), UniformValue(42.0f));
+        QCOMPARE(command.value(8), UniformValue(Vector3D(1.0f, 2.0f, 3.0f)));
+        QVERIFY(!command.contains(4));
+        QVERIFY(command.hasSameValue(2, material));
+        QVERIFY(!command.hasSameValue(5, material));
+        QCOMPARE(material.size(), 3);
+        QCOMPARE(material.value(5), UniformValue(1584.0f));
+
+        // WHEN
+        command.removeIf([] (int nameId, const UniformValue &) { return nameId == 8 || nameId == 3; });
+
+        // THEN
+        QCOMPARE(command.size(), 2);
+        QCOMPARE(command.value(2), UniformValue(883));
+        QCOMPARE(command.value(5), UniformValue(42.0f));
+        QVERIFY(material.contains(8));
+
+        // WHEN -> a value of a different size replaces the previous one
+        command.insert(2, UniformValue(QMatrix3x3()));
+
+        // THEN
+        QCOMPARE(command.value(2), UniformValue(QMatrix3x3()));
+        QCOMPARE(command.value(5), UniformValue(42.0f));
+    }
+
     void checkRenderCommandFrontToBackSorting()
     {
         // GIVEN
@@ -315,6 +398,7 @@ private Q_SLOTS:
         Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
         RenderView renderView;
         QVector<RenderCommand> rawCommands;
+        QVector<RenderCommandBuildData> rawBuildData;
         QVector<QSortPolicy::SortType> sortTypes;
 
         renderer.setNodeManagers(&nodeManagers);
@@ -324,20 +408,28 @@ private Q_SLOTS:
 
         for (int i = 0; i < 200; ++i) {
             RenderCommand c;
-            c.m_depth = float(i);
+            c.m_firstInstance = i;
+            RenderCommandBuildData b;
+            b.m_depth = float(i);
             rawCommands.push_back(c);
+            rawBuildData.push_back(b);
         }
 
         // WHEN
         renderView.addSortType(sortTypes);
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, rawBuildData);
         renderView.sort();
 
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
+        const QVector<RenderCommandBuildData> sortedBuildData = renderView.commandsBuildData();
         QCOMPARE(rawCommands.size(), sortedCommands.size());
+        QCOMPARE(rawBuildData.size(), sortedBuildData.size());
         for (int j = 1; j < sortedCommands.size(); ++j)
-            QVERIFY(sortedCommands.at(j - 1).m_depth < sortedCommands.at(j).m_depth);
+            QVERIFY(sortedBuildData.at(j - 1).m_depth < sortedBuildData.at(j).m_depth);
+        // Commands follow their build data
+        for (int j = 0; j < sortedCommands.size(); ++j)
+            QCOMPARE(sortedCommands.at(j).m_firstInstance, int(sortedBuildData.at(j).m_depth));
 
         // RenderCommands are deleted by RenderView dtor
         renderer.shutdown();
@@ -350,6 +442,7 @@ private Q_SLOTS:
         Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
         RenderView renderView;
         QVector<RenderCommand> rawCommands;
+        QVector<RenderCommandBuildData> rawBuildData;
         QVector<QSortPolicy::SortType> sortTypes;
 
         renderer.setNodeManagers(&nodeManagers);
@@ -359,20 +452,27 @@ private Q_SLOTS:
 
         for (int i = 0; i < 200; ++i) {
             RenderCommand c;
-            c.m_changeCost = i;
+            c.m_firstInstance = i;
+            RenderCommandBuildData b;
+            b.m_changeCost = i;
             rawCommands.push_back(c);
+            rawBuildData.push_back(b);
         }
 
         // WHEN
         renderView.addSortType(sortTypes);
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, rawBuildData);
         renderView.sort();
 
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
+        const QVector<RenderCommandBuildData> sortedBuildData = renderView.commandsBuildData();
         QCOMPARE(rawCommands.size(), sortedCommands.size());
+        QCOMPARE(rawBuildData.size(), sortedBuildData.size());
         for (int j = 1; j < sortedCommands.size(); ++j)
-            QVERIFY(sortedCommands.at(j - 1).m_changeCost > sortedCommands.at(j).m_changeCost);
+            QVERIFY(sortedBuildData.at(j - 1).m_changeCost > sortedBuildData.at(j).m_changeCost);
+        for (int j = 0; j < sortedCommands.size(); ++j)
+            QCOMPARE(sortedCommands.at(j).m_firstInstance, sortedBuildData.at(j).m_changeCost);
 
         // RenderCommands are deleted by RenderView dtor
         renderer.shutdown();
@@ -385,6 +485,7 @@ private Q_SLOTS:
         Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
         RenderView renderView;
         QVector<RenderCommand> rawCommands;
+        QVector<RenderCommandBuildData> rawBuildData;
         QVector<QSortPolicy::SortType> sortTypes;
 
         renderer.setNodeManagers(&nodeManagers);
@@ -413,54 +514,118 @@ private Q_SLOTS:
             200
         };
 
-        auto buildRC = [] (GLShader *dna, float depth, int changeCost) {
+        auto buildRC = [&] (GLShader *dna, float depth, int changeCost) {
             RenderCommand c;
             c.m_glShader = dna;
-            c.m_depth = depth;
-            c.m_changeCost = changeCost;
-            return c;
+            RenderCommandBuildData b;
+            b.m_depth = depth;
+            b.m_changeCost = changeCost;
+            rawCommands.push_back(c);
+            rawBuildData.push_back(b);
+            return rawCommands.size() - 1;
         };
 
-        RenderCommand c5 = buildRC(dna[3], depth[1], stateChangeCost[1]);
-        RenderCommand c3 = buildRC(dna[3], depth[0], stateChangeCost[1]);
-        RenderCommand c4 = buildRC(dna[2], depth[1], stateChangeCost[1]);
-        RenderCommand c8 = buildRC(dna[1], depth[1], stateChangeCost[1]);
-        RenderCommand c0 = buildRC(dna[0], depth[2], stateChangeCost[1]);
-
-        RenderCommand c2 = buildRC(dna[2], depth[2], stateChangeCost[0]);
-        RenderCommand c9 = buildRC(dna[2], depth[0], stateChangeCost[0]);
-        RenderCommand c1 = buildRC(dna[1], depth[0], stateChangeCost[0]);
-        RenderCommand c7 = buildRC(dna[0], depth[2], stateChangeCost[0]);
-        RenderCommand c6 = buildRC(dna[0], depth[1], stateChangeCost[0]);
-
-        rawCommands << c0 << c1 << c2 << c3 << c4 << c5 << c6 << c7 << c8 << c9;
+        const int c0 = buildRC(dna[0], depth[2], stateChangeCost[1]);
+        const int c1 = buildRC(dna[1], depth[0], stateChangeCost[0]);
+        const int c2 = buildRC(dna[2], depth[2], stateChangeCost[0]);
+        const int c3 = buildRC(dna[3], depth[0], stateChangeCost[1]);
+        const int c4 = buildRC(dna[2], depth[1], stateChangeCost[1]);
+        const int c5 = buildRC(dna[3], depth[1], stateChangeCost[1]);
+        const int c6 = buildRC(dna[0], depth[1], stateChangeCost[0]);
+        const int c7 = buildRC(dna[0], depth[2], stateChangeCost[0]);
+        const int c8 = buildRC(dna[1], depth[1], stateChangeCost[1]);
+        const int c9 = buildRC(dna[2], depth[0], stateChangeCost[0]);
 
         // WHEN
         renderView.addSortType(sortTypes);
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, rawBuildData);
         renderView.sort();
 
         // THEN
         const QVector<RenderCommand> sortedCommands = renderView.commands();
+        const QVector<RenderCommandBuildData> sortedBuildData = renderView.commandsBuildData();
         QCOMPARE(rawCommands.size(), sortedCommands.size());
+        QCOMPARE(rawBuildData.size(), sortedBuildData.size());
+
+        const auto isSortedAt = [&] (int rawIndex, int sortedIndex) {
+            return rawCommands.at(rawIndex) == sortedCommands.at(sortedIndex)
+                    && rawBuildData.at(rawIndex) == sortedBuildData.at(sortedIndex);
+        };
 
         // Ordered by higher state, higher shaderDNA and higher depth
-        QCOMPARE(c0, sortedCommands.at(4));
-        QCOMPARE(c3, sortedCommands.at(1));
-        QCOMPARE(c4, sortedCommands.at(2));
-        QCOMPARE(c5, sortedCommands.at(0));
-        QCOMPARE(c8, sortedCommands.at(3));
-
-        QCOMPARE(c1, sortedCommands.at(7));
-        QCOMPARE(c2, sortedCommands.at(5));
-        QCOMPARE(c6, sortedCommands.at(9));
-        QCOMPARE(c7, sortedCommands.at(8));
-        QCOMPARE(c9, sortedCommands.at(6));
+        QVERIFY(isSortedAt(c0, 4));
+        QVERIFY(isSortedAt(c3, 1));
+        QVERIFY(isSortedAt(c4, 2));
+        QVERIFY(isSortedAt(c5, 0));
+        QVERIFY(isSortedAt(c8, 3));
+
+        QVERIFY(isSortedAt(c1, 7));
+        QVERIFY(isSortedAt(c2, 5));
+        QVERIFY(isSortedAt(c6, 9));
+        QVERIFY(isSortedAt(c7, 8));
+        QVERIFY(isSortedAt(c9, 6));
 
         // RenderCommands are deleted by RenderView dtor
         renderer.shutdown();
     }
 
+    void checkRenderCommandSortingMatchesStableSort()
+    {
+        // GIVEN
+        RenderView renderView;
+        QVector<RenderCommand> rawCommands;
+        QVector<RenderCommandBuildData> rawBuildData;
+        QVector<QSortPolicy::SortType> sortTypes;
+
+        sortTypes.push_back(QSortPolicy::StateChangeCost);
+        sortTypes.push_back(QSortPolicy::Material);
+        sortTypes.push_back(QSortPolicy::FrontToBack);
+
+        GLShader *dnas[4] = {
+            reinterpret_cast<GLShader *>(0x250),
+            reinterpret_cast<GLShader *>(0x500),
+            reinterpret_cast<GLShader *>(0x1000),
+            reinterpret_cast<GLShader *>(0x1500)
+        };
+
+        for (int i = 0; i < 1000; ++i) {
+            RenderCommand c;
+            c.m_glShader = dnas[(i * 5) % 4];
+            // Identifies the command to check the sort is stable
+            c.m_firstInstance = i;
+            RenderCommandBuildData b;
+            b.m_changeCost = (i * 7) % 3 - 1;
+            b.m_depth = float((i * 13) % 9) - 4.0f;
+            rawCommands.push_back(c);
+            rawBuildData.push_back(b);
+        }
+
+        QVector<int> expectedOrder(rawCommands.size());
+        std::iota(expectedOrder.begin(), expectedOrder.end(), 0);
+        std::stable_sort(expectedOrder.begin(), expectedOrder.end(), [&] (int a, int b) {
+            if (rawBuildData.at(a).m_changeCost != rawBuildData.at(b).m_changeCost)
+                return rawBuildData.at(a).m_changeCost > rawBuildData.at(b).m_changeCost;
+            if (rawCommands.at(a).m_glShader != rawCommands.at(b).m_glShader)
+                return rawCommands.at(a).m_glShader > rawCommands.at(b).m_glShader;
+            return rawBuildData.at(a).m_depth < rawBuildData.at(b).m_depth;
+        });
+
+        // WHEN
+        renderView.addSortType(sortTypes);
+        renderView.setCommands(rawCommands, rawBuildData);
+        renderView.sort();
+
+        // THEN
+        const QVector<RenderCommand> sortedCommands = renderView.commands();
+        const QVector<RenderCommandBuildData> sortedBuildData = renderView.commandsBuildData();
+        QCOMPARE(sortedCommands.size(), expectedOrder.size());
+        QCOMPARE(sortedBuildData.size(), expectedOrder.size());
+        for (int i = 0, m = sortedCommands.size(); i < m; ++i) {
+            QCOMPARE(sortedCommands.at(i).m_firstInstance, expectedOrder.at(i));
+            QVERIFY(sortedBuildData.at(i) == rawBuildData.at(expectedOrder.at(i)));
+        }
+    }
+
     void checkRenderCommandTextureSorting()
     {
         // GIVEN
@@ -524,7 +689,7 @@ private Q_SLOTS:
         // WHEN
         QVector<RenderCommand> rawCommands = {a, b, c, d, e, f, g};
         renderView.addSortType(sortTypes);
-        renderView.setCommands(rawCommands);
+        renderView.setCommands(rawCommands, QVector<RenderCommandBuildData>(rawCommands.size()));
         renderView.sort();
 
         // THEN
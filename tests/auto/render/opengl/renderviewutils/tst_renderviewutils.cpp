@@ -51,6 +51,8 @@ private Q_SLOTS:
     void topLevelStructValue();
     void topLevelDynamicProperties();
     void transformedProperties();
+    void shaderDataUniformPlan();
+    void shaderDataUniformPlanNestedIds();
     void shouldNotifyDynamicPropertyChanges();
 
 private:
@@ -107,11 +109,11 @@ public:
         return m_scalar;
     }
 
-    QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
+    QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
     {
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
 
-        uniforms.insert(blockName + QStringLiteral(".scalar"), Qt3DRender::Render::OpenGL::ShaderUniform());
+        uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(blockName + QStringLiteral(".scalar")), Qt3DRender::Render::OpenGL::ShaderUniform());
 
         return uniforms;
     }
@@ -148,11 +150,11 @@ public:
         return m_texture;
     }
 
-    QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
+    QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
     {
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
 
-        uniforms.insert(blockName + QStringLiteral(".texture"), Qt3DRender::Render::OpenGL::ShaderUniform());
+        uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(blockName + QStringLiteral(".texture")), Qt3DRender::Render::OpenGL::ShaderUniform());
 
         return uniforms;
     }
@@ -189,11 +191,11 @@ public:
         return m_array;
     }
 
-    QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
+    QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
     {
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
 
-        uniforms.insert(blockName + QStringLiteral(".array[0]"), Qt3DRender::Render::OpenGL::ShaderUniform());
+        uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(blockName + QStringLiteral(".array[0]")), Qt3DRender::Render::OpenGL::ShaderUniform());
 
         return uniforms;
     }
@@ -244,12 +246,12 @@ public:
         return m_array;
     }
 
-    virtual QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
+    virtual QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName)
     {
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms;
 
-        uniforms.insert(blockName + QStringLiteral(".scalar"), Qt3DRender::Render::OpenGL::ShaderUniform());
-        uniforms.insert(blockName + QStringLiteral(".array[0]"), Qt3DRender::Render::OpenGL::ShaderUniform());
+        uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(blockName + QStringLiteral(".scalar")), Qt3DRender::Render::OpenGL::ShaderUniform());
+        uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(blockName + QStringLiteral(".array[0]")), Qt3DRender::Render::OpenGL::ShaderUniform());
 
         return uniforms;
     }
@@ -298,20 +300,20 @@ public:
         return m_inner;
     }
 
-    QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName) override
+    QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> buildUniformMap(const QString &blockName) override
     {
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> innerUniforms;
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> innerUniforms;
 
         StructShaderData *innerData = nullptr;
         if ((innerData = qobject_cast<StructShaderData *>(m_inner)) != nullptr)
-            innerUniforms = innerData->buildUniformMap(QStringLiteral(".inner"));
+            innerUniforms = innerData->buildUniformMap(blockName + QStringLiteral(".inner"));
 
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms = StructShaderData::buildUniformMap(blockName);
-        QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform>::const_iterator it = innerUniforms.begin();
-        const QHash<QString, Qt3DRender::Render::OpenGL::ShaderUniform>::const_iterator end = innerUniforms.end();
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform> uniforms = StructShaderData::buildUniformMap(blockName);
+        QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform>::const_iterator it = innerUniforms.begin();
+        const QHash<int, Qt3DRender::Render::OpenGL::ShaderUniform>::const_iterator end = innerUniforms.end();
 
         while (it != end) {
-            uniforms.insert(blockName + it.key(), it.value());
+            uniforms.insert(it.key(), it.value());
             ++it;
         }
         return uniforms;
@@ -408,7 +410,7 @@ void tst_RenderViewUtils::topLevelScalarValue()
 
     while (it != end) {
         // THEN
-        QVERIFY(blockBuilder.uniforms.contains(Qt3DRender::Render::StringToInt::lookupString(it.key())));
+        QVERIFY(blockBuilder.uniforms.contains(it.key()));
         QCOMPARE(it.value(), QVariant(shaderData->scalar()));
         ++it;
     }
@@ -481,7 +483,7 @@ void tst_RenderViewUtils::topLevelTextureValue()
 
     while (it != end) {
         // THEN
-        QVERIFY(blockBuilder.uniforms.contains(Qt3DRender::Render::StringToInt::lookupString(it.key())));
+        QVERIFY(blockBuilder.uniforms.contains(it.key()));
         QCOMPARE(it.value(), QVariant::fromValue(shaderData->texture()->id()));
         ++it;
     }
@@ -523,7 +525,7 @@ void tst_RenderViewUtils::topLevelArrayValue()
 
     while (it != end) {
         // THEN
-        QVERIFY(blockBuilder.uniforms.contains(Qt3DRender::Render::StringToInt::lookupString(it.key())));
+        QVERIFY(blockBuilder.uniforms.contains(it.key()));
         QCOMPARE(it.value(), QVariant(arrayValues));
         ++it;
     }
@@ -574,9 +576,9 @@ void tst_RenderViewUtils::nestedShaderDataValue()
     blockBuilder.shaderDataManager = manager.data();
     blockBuilder.textureManager = textureManager.data();
     blockBuilder.updatedPropertiesOnly = false;
-    blockBuilder.uniforms.insert(QStringLiteral("MyBlock.array[0].scalar"), Qt3DRender::Render::OpenGL::ShaderUniform());
-    blockBuilder.uniforms.insert(QStringLiteral("MyBlock.array[1].scalar"), Qt3DRender::Render::OpenGL::ShaderUniform());
-    blockBuilder.uniforms.insert(QStringLiteral("MyBlock.array[2].scalar"), Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.array[0].scalar")), Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.array[1].scalar")), Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.array[2].scalar")), Qt3DRender::Render::OpenGL::ShaderUniform());
     // build name-value map
     blockBuilder.buildActiveUniformNameValueMapStructHelper(backendArrayShaderData, QStringLiteral("MyBlock"));
 
@@ -590,9 +592,9 @@ void tst_RenderViewUtils::nestedShaderDataValue()
 
     while (it != end) {
         // THEN
-        const int nameId = Qt3DRender::Render::StringToInt::lookupId(it.key());
+        const int nameId = it.key();
         QVERIFY(blockBuilder.activeUniformNamesToValue.contains(nameId));
-        QCOMPARE(blockBuilder.activeUniformNamesToValue[nameId], scalarValues.value(it.key()));
+        QCOMPARE(blockBuilder.activeUniformNamesToValue[nameId], scalarValues.value(Qt3DRender::Render::StringToInt::lookupString(nameId)));
         ++it;
     }
 }
@@ -664,7 +666,7 @@ void tst_RenderViewUtils::topLevelStructValue()
 
     while (it != end) {
         // THEN
-        QVERIFY(blockBuilder.uniforms.contains(Qt3DRender::Render::StringToInt::lookupString(it.key())));
+        QVERIFY(blockBuilder.uniforms.contains(it.key()));
         QVERIFY(expectedValues.contains(Qt3DRender::Render::StringToInt::lookupString(it.key())));
         QCOMPARE(it.value(), expectedValues.value(Qt3DRender::Render::StringToInt::lookupString(it.key())));
         ++it;
@@ -696,9 +698,9 @@ void tst_RenderViewUtils::topLevelDynamicProperties()
     blockBuilder.shaderDataManager = manager.data();
     blockBuilder.textureManager = textureManager.data();
     blockBuilder.updatedPropertiesOnly = false;
-    blockBuilder.uniforms.insert(QStringLiteral("MyBlock.scalar"), Qt3DRender::Render::OpenGL::ShaderUniform());
-    blockBuilder.uniforms.insert(QStringLiteral("MyBlock.array[0]"), Qt3DRender::Render::OpenGL::ShaderUniform());
-    blockBuilder.uniforms.insert(QStringLiteral("MyBlock.texture"), Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.scalar")), Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.array[0]")), Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.texture")), Qt3DRender::Render::OpenGL::ShaderUniform());
     // build name-value map
     blockBuilder.buildActiveUniformNameValueMapStructHelper(backendShaderData, QStringLiteral("MyBlock"));
 
@@ -768,6 +770,104 @@ void tst_RenderViewUtils::transformedProperties()
     QCOMPARE(position3Value, Vector3D((worldMatrix * Vector4D(position, 0.0f))));
 }
 
+void tst_RenderViewUtils::shaderDataUniformPlan()
+{
+    // GIVEN
+    QScopedPointer<Qt3DRender::QShaderData> shaderData(new Qt3DRender::QShaderData());
+    QScopedPointer<Qt3DRender::Render::ShaderDataManager> manager(new Qt3DRender::Render::ShaderDataManager());
+    QScopedPointer<Qt3DRender::Render::TextureManager> textureManager(new Qt3DRender::Render::TextureManager());
+    TestRenderer renderer;
+
+    const QVector3D position(15.0f, -5.0f, 10.0f);
+    shaderData->setProperty("position0", position);
+    shaderData->setProperty("position1", position);
+    shaderData->setProperty("position1Transformed", Qt3DRender::Render::ShaderData::ModelToWorld);
+    initBackendShaderData(&renderer, shaderData.data(), manager.data());
+
+    Qt3DRender::Render::ShaderData *backendShaderData = manager->lookupResource(shaderData->id());
+    QVERIFY(backendShaderData != nullptr);
+    const uint revision = backendShaderData->revision();
+    QVERIFY(revision != 0);
+
+    const int position0Id = Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.position0"));
+    const int position1Id = Qt3DRender::Render::StringToInt::lookupId(QStringLiteral("MyBlock.position1"));
+
+    // WHEN
+    Qt3DRender::Render::OpenGL::ShaderDataUniformPlan plan;
+    Qt3DRender::Render::OpenGL::UniformBlockValueBuilder blockBuilder;
+    blockBuilder.shaderDataManager = manager.data();
+    blockBuilder.textureManager = textureManager.data();
+    blockBuilder.updatedPropertiesOnly = false;
+    blockBuilder.uniforms.insert(position0Id, Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.uniforms.insert(position1Id, Qt3DRender::Render::OpenGL::ShaderUniform());
+    blockBuilder.plan = &plan;
+    blockBuilder.buildActiveUniformNameValueMapStructHelper(backendShaderData, QStringLiteral("MyBlock"));
+
+    // THEN
+    QCOMPARE(blockBuilder.activeUniformNamesToValue.size(), 1);
+    QCOMPARE(blockBuilder.activeUniformNamesToValue.value(position0Id), QVariant(position));
+    QCOMPARE(plan.transformedUniforms.size(), 1);
+    QCOMPARE(plan.transformedUniforms.first().nameId, position1Id);
+    QCOMPARE(plan.transformedUniforms.first().shaderData, backendShaderData);
+    QCOMPARE(plan.transformedUniforms.first().transformType, Qt3DRender::Render::ShaderData::ModelToWorld);
+    QCOMPARE(plan.dependencies.size(), 1);
+    QCOMPARE(plan.dependencies.first().first, shaderData->id());
+    QCOMPARE(plan.dependencies.first().second, revision);
+    QVERIFY(plan.isUpToDate(manager.data(), textureManager.data()));
+
+    // WHEN
+    shaderData->setProperty("position0", QVector3D(1.0f, 2.0f, 3.0f));
+    backendShaderData->syncFromFrontEnd(shaderData.data(), false);
+
+    // THEN
+    QVERIFY(backendShaderData->revision() != revision);
+    QVERIFY(!plan.isUpToDate(manager.data(), textureManager.data()));
+}
+
+void tst_RenderViewUtils::shaderDataUniformPlanNestedIds()
+{
+    // GIVEN
+    QScopedPointer<Qt3DRender::QShaderData> shaderData(new Qt3DRender::QShaderData());
+    QScopedPointer<Qt3DRender::Render::ShaderDataManager> manager(new Qt3DRender::Render::ShaderDataManager());
+    QScopedPointer<Qt3DRender::Render::TextureManager> textureManager(new Qt3DRender::Render::TextureManager());
+    QScopedPointer<Qt3DRender::QTexture2D> texture(new Qt3DRender::QTexture2D());
+    TestRenderer renderer;
+
+    const Qt3DCore::QNodeId innerId = Qt3DCore::QNodeId::createId();
+    shaderData->setProperty("texture", QVariant::fromValue(texture->id()));
+    shaderData->setProperty("inner", QVariant::fromValue(innerId));
+    initBackendShaderData(&renderer, shaderData.data(), manager.data());
+    initBackendTexture(texture.data(), textureManager.data());
+    Qt3DRender::Render::ShaderData *backendShaderData = manager->lookupResource(shaderData->id());
+
+    // WHEN
+    Qt3DRender::Render::OpenGL::ShaderDataUniformPlan plan;
+    Qt3DRender::Render::OpenGL::UniformBlockValueBuilder blockBuilder;
+    blockBuilder.shaderDataManager = manager.data();
+    blockBuilder.textureManager = textureManager.data();
+    blockBuilder.updatedPropertiesOnly = false;
+    blockBuilder.plan = &plan;
+    blockBuilder.buildActiveUniformNameValueMapStructHelper(backendShaderData, QStringLiteral("MyBlock"));
+
+    // THEN
+    QCOMPARE(plan.textureDependencies, QVector<Qt3DCore::QNodeId>({ texture->id() }));
+    QCOMPARE(plan.unresolvedDependencies, QVector<Qt3DCore::QNodeId>({ innerId }));
+    QVERIFY(plan.isUpToDate(manager.data(), textureManager.data()));
+
+    // WHEN -> the nested ShaderData was created after the plan
+    manager->getOrCreateResource(innerId);
+
+    // THEN
+    QVERIFY(!plan.isUpToDate(manager.data(), textureManager.data()));
+
+    // WHEN
+    manager->releaseResource(innerId);
+    textureManager->releaseResource(texture->id());
+
+    // THEN
+    QVERIFY(!plan.isUpToDate(manager.data(), textureManager.data()));
+}
+
 void tst_RenderViewUtils::shouldNotifyDynamicPropertyChanges()
 {
     // GIVEN
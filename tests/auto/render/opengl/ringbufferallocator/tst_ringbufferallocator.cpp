@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <ringbufferallocator_p.h>
+
+using Qt3DRender::Render::OpenGL::RingBufferAllocator;
+
+class tst_RingBufferAllocator : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkInitialState()
+    {
+        // GIVEN
+        RingBufferAllocator ring;
+
+        // THEN
+        QCOMPARE(ring.size(), 0u);
+        QCOMPARE(ring.usedSize(), 0u);
+        QCOMPARE(ring.allocate(16), -1);
+        QVERIFY(!ring.closeRange());
+    }
+
+    void checkWrapAtTheEnd()
+    {
+        // GIVEN
+        RingBufferAllocator ring;
+        ring.reset(64);
+
+        // WHEN
+        QCOMPARE(ring.allocate(32), 0);
+        QVERIFY(ring.closeRange());
+        QCOMPARE(ring.allocate(16), 32);
+        QVERIFY(ring.closeRange());
+        ring.releaseRanges(1);
+
+        // THEN
+        QCOMPARE(ring.usedSize(), 16u);
+        QCOMPARE(ring.closedRangeCount(), 1);
+
+        // WHEN - only 16 bytes left at the end, the 16 skipped count as used
+        const int offset = ring.allocate(32);
+
+        // THEN
+        QCOMPARE(offset, 0);
+        QCOMPARE(ring.usedSize(), 64u);
+        QCOMPARE(ring.allocate(16), -1);
+
+        // WHEN
+        QVERIFY(ring.closeRange());
+        ring.releaseRanges(2);
+
+        // THEN - an empty ring starts over from the beginning
+        QCOMPARE(ring.usedSize(), 0u);
+        QCOMPARE(ring.allocate(48), 0);
+    }
+
+    void checkAllocationLargerThanFreeSpace()
+    {
+        // GIVEN
+        RingBufferAllocator ring;
+        ring.reset(64);
+
+        // THEN
+        QCOMPARE(ring.allocate(128), -1);
+        QCOMPARE(ring.allocate(48), 0);
+        QCOMPARE(ring.allocate(32), -1);
+        QCOMPARE(ring.usedSize(), 48u);
+
+        // WHEN
+        QVERIFY(ring.closeRange());
+        ring.releaseRanges(1);
+        QCOMPARE(ring.allocate(16), 0);
+        QVERIFY(ring.closeRange());
+        QCOMPARE(ring.allocate(32), 16);
+        QVERIFY(ring.closeRange());
+        ring.releaseRanges(1);
+
+        // THEN - 32 bytes are free, split between the end and the
+        // beginning of the ring
+        QCOMPARE(ring.usedSize(), 32u);
+        QCOMPARE(ring.allocate(24), -1);
+        QCOMPARE(ring.allocate(16), 48);
+        QCOMPARE(ring.allocate(16), 0);
+        QCOMPARE(ring.usedSize(), 64u);
+    }
+
+    void checkReleaseAfterFenceSignaled()
+    {
+        // GIVEN
+        RingBufferAllocator ring;
+        ring.reset(64);
+        QCOMPARE(ring.allocate(16), 0);
+        QCOMPARE(ring.allocate(16), 16);
+        QVERIFY(ring.closeRange());
+        QCOMPARE(ring.allocate(32), 32);
+
+        // THEN - nothing can be released before the range is fenced
+        QCOMPARE(ring.closedRangeCount(), 1);
+        QCOMPARE(ring.allocate(16), -1);
+
+        // WHEN - the fence of the first range was signaled
+        ring.releaseRanges(1);
+
+        // THEN
+        QCOMPARE(ring.closedRangeCount(), 0);
+        QCOMPARE(ring.usedSize(), 32u);
+        QCOMPARE(ring.allocate(32), 0);
+
+        // WHEN
+        QVERIFY(ring.closeRange());
+        ring.releaseRanges(1);
+
+        // THEN - both allocations made since the first range was closed
+        // went into a single range
+        QCOMPARE(ring.usedSize(), 0u);
+        QVERIFY(!ring.closeRange());
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_RingBufferAllocator)
+
+#include "tst_ringbufferallocator.moc"
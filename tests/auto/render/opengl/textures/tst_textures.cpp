@@ -45,6 +45,12 @@ QT_WARNING_DISABLE_DEPRECATED
 #include <Qt3DRender/private/nodemanagers_p.h>
 #include <Qt3DRender/private/managers_p.h>
 #include <Qt3DRender/private/qtexture_p.h>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/private/qaspectmanager_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+#include <Qt3DCore/private/qscene_p.h>
+#include <QtGui/qoffscreensurface.h>
+#include <QtGui/qopenglcontext.h>
 
 #include <testrenderer.h>
 
@@ -92,6 +98,39 @@ public:
 
 typedef QSharedPointer<TestTextureGenerator> TestTextureGeneratorPtr;
 
+/**
+ * @brief QTextureGenerator returning no data for its first calls
+ */
+class DelayedTextureGenerator : public Qt3DRender::QTextureGenerator
+{
+    int m_id;
+    int m_failedCalls;
+public:
+    DelayedTextureGenerator(int id, int failedCalls) : m_id(id), m_failedCalls(failedCalls) {}
+
+    Qt3DRender::QTextureDataPtr operator ()() override {
+        if (m_failedCalls > 0) {
+            --m_failedCalls;
+            return {};
+        }
+        Qt3DRender::QTextureDataPtr data = Qt3DRender::QTextureDataPtr::create();
+        data->setTarget(Qt3DRender::QAbstractTexture::Target2D);
+        data->setFormat(Qt3DRender::QAbstractTexture::RGBA8_UNorm);
+        data->setWidth(1);
+        data->setHeight(1);
+        data->setDepth(1);
+        data->setLayers(1);
+        return data;
+    }
+
+    bool operator ==(const Qt3DRender::QTextureGenerator &other) const override {
+        const DelayedTextureGenerator *otherFunctor = Qt3DCore::functor_cast<DelayedTextureGenerator>(&other);
+        return (otherFunctor != nullptr && otherFunctor->m_id == m_id);
+    }
+
+    QT3D_FUNCTOR(DelayedTextureGenerator)
+};
+
 class TestTexturePrivate : public Qt3DRender::QAbstractTexturePrivate
 {
 public:
@@ -115,6 +154,16 @@ private:
     Q_DECLARE_PRIVATE(TestTexture)
 };
 
+class GeneratedTexture : public Qt3DRender::QAbstractTexture
+{
+public:
+    GeneratedTexture(const Qt3DRender::QTextureGeneratorPtr &generator, Qt3DCore::QNode *p = nullptr)
+        : QAbstractTexture(p)
+    {
+        static_cast<Qt3DRender::QAbstractTexturePrivate *>(Qt3DCore::QNodePrivate::get(this))->setDataFunctor(generator);
+    }
+};
+
 class TestSharedGLTexturePrivate : public Qt3DRender::QAbstractTexturePrivate
 {
 };
@@ -172,6 +221,32 @@ public:
     }
 };
 
+// tst_Renderer is a friend class of Renderer
+class tst_Renderer : public Qt3DRender::Render::OpenGL::Renderer
+{
+public:
+    tst_Renderer()
+        : Qt3DRender::Render::OpenGL::Renderer(Qt3DRender::QRenderAspect::Synchronous)
+    {}
+
+    // Updates the GLTexture and records its changes for the frontend
+    // the way updateGLResources does
+    void updateGLTexture(Qt3DCore::QNodeId textureId)
+    {
+        Qt3DRender::Render::OpenGL::GLTexture *glTexture = glResourceManagers()->glTextureManager()->lookupResource(textureId);
+        const Qt3DRender::Render::OpenGL::GLTexture::TextureUpdateInfo info = glTexture->createOrUpdateGLTexture();
+        if (info.wasUpdated) {
+            Qt3DRender::Render::Texture::TextureUpdateInfo updateInfo;
+            updateInfo.properties = info.properties;
+            m_updatedTextureProperties.push_back({updateInfo, { textureId }});
+        }
+    }
+
+    int pendingTextureChanges() const { return m_updatedTextureProperties.size(); }
+
+    void sendTextureChanges(Qt3DCore::QAspectManager *manager) { sendTextureChangesToFrontend(manager); }
+};
+
 class tst_RenderTextures : public Qt3DCore::QBackendNodeTester
 {
     Q_OBJECT
@@ -422,6 +497,135 @@ private Q_SLOTS:
         renderer.shutdown();
     }
 
+    void generatorsShouldBeRunByDataJobs()
+    {
+        QScopedPointer<Qt3DRender::Render::NodeManagers> mgrs(new Qt3DRender::Render::NodeManagers());
+        Qt3DRender::Render::OpenGL::Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
+        renderer.setNodeManagers(mgrs.data());
+
+        // GIVEN
+        QVector<Qt3DRender::QAbstractTexture*> textures;
+        textures << createQTexture(1, {1}, true);
+        textures << createQTexture(2, {1,2}, true);
+        textures << createQTexture(1, {1,2}, true);
+
+        // WHEN
+        for (auto *t : textures) {
+            Qt3DRender::Render::Texture *backendTexture = createBackendTexture(t,
+                                                                               mgrs->textureManager(),
+                                                                               mgrs->textureImageManager(),
+                                                                               &renderer);
+            renderer.updateTexture(backendTexture);
+        }
+        const QVector<Qt3DCore::QAspectJobPtr> jobs = renderer.preRenderingJobs();
+
+        // THEN -> One job per distinct texture and image generator
+        QCOMPARE(jobs.size(), 4);
+
+        // WHEN
+        for (const Qt3DCore::QAspectJobPtr &job : jobs)
+            job->run();
+
+        // THEN
+        QVERIFY(renderer.preRenderingJobs().isEmpty());
+
+        renderer.shutdown();
+    }
+
+    void generatorsReturningNoDataShouldBeRetried()
+    {
+        QScopedPointer<Qt3DRender::Render::NodeManagers> mgrs(new Qt3DRender::Render::NodeManagers());
+        Qt3DRender::Render::OpenGL::Renderer renderer(Qt3DRender::QRenderAspect::Synchronous);
+        renderer.setNodeManagers(mgrs.data());
+
+        // GIVEN
+        QScopedPointer<Qt3DRender::QAbstractTexture> texture(new GeneratedTexture(QSharedPointer<DelayedTextureGenerator>::create(1, 1)));
+        Qt3DRender::Render::Texture *backendTexture = createBackendTexture(texture.data(),
+                                                                           mgrs->textureManager(),
+                                                                           mgrs->textureImageManager(),
+                                                                           &renderer);
+        renderer.updateTexture(backendTexture);
+
+        // WHEN
+        QVector<Qt3DCore::QAspectJobPtr> jobs = renderer.preRenderingJobs();
+        QCOMPARE(jobs.size(), 1);
+        jobs.first()->run();
+
+        // THEN -> No data was generated, the generator runs again
+        jobs = renderer.preRenderingJobs();
+        QCOMPARE(jobs.size(), 1);
+
+        // WHEN
+        jobs.first()->run();
+
+        // THEN
+        QVERIFY(renderer.preRenderingJobs().isEmpty());
+
+        renderer.shutdown();
+    }
+
+    void statusShouldBeSentToFrontend()
+    {
+        QScopedPointer<Qt3DRender::Render::NodeManagers> mgrs(new Qt3DRender::Render::NodeManagers());
+        tst_Renderer renderer;
+        renderer.setNodeManagers(mgrs.data());
+
+        Qt3DCore::QAspectManager manager;
+        Qt3DCore::QScene scene;
+        Qt3DCore::QEntity rootEntity;
+        Qt3DCore::QNodePrivate::get(&rootEntity)->setScene(&scene);
+
+        // GIVEN
+        Qt3DRender::QAbstractTexture *texture = new GeneratedTexture(QSharedPointer<DelayedTextureGenerator>::create(1, 0));
+        texture->setParent(&rootEntity);
+        // RootEntity is the entry point to retrieve the scene instance for lookups
+        manager.setRootEntity(&rootEntity, {});
+
+        Qt3DRender::Render::Texture *backendTexture = createBackendTexture(texture,
+                                                                           mgrs->textureManager(),
+                                                                           mgrs->textureImageManager(),
+                                                                           &renderer);
+        renderer.updateTexture(backendTexture);
+        backendTexture->unsetDirty();
+
+        // WHEN -> the generator has yet to run
+        renderer.updateGLTexture(texture->id());
+        renderer.sendTextureChanges(&manager);
+
+        // THEN
+        QCOMPARE(texture->status(), Qt3DRender::QAbstractTexture::Loading);
+
+        // WHEN -> still loading
+        renderer.updateGLTexture(texture->id());
+
+        // THEN -> nothing new to tell the frontend
+        QCOMPARE(renderer.pendingTextureChanges(), 0);
+
+        // WHEN
+        const QVector<Qt3DCore::QAspectJobPtr> jobs = renderer.preRenderingJobs();
+        for (const Qt3DCore::QAspectJobPtr &job : jobs)
+            job->run();
+
+        QOffscreenSurface surface;
+        surface.create();
+        QOpenGLContext context;
+        if (!context.create() || !context.makeCurrent(&surface)) {
+            renderer.shutdown();
+            QSKIP("Creating the texture requires an OpenGL context");
+        }
+        renderer.updateGLTexture(texture->id());
+        renderer.sendTextureChanges(&manager);
+
+        // THEN
+        QCOMPARE(texture->status(), Qt3DRender::QAbstractTexture::Ready);
+        QCOMPARE(texture->width(), 1);
+        QCOMPARE(texture->height(), 1);
+
+        renderer.glResourceManagers()->glTextureManager()->lookupResource(texture->id())->destroy();
+        context.doneCurrent();
+        renderer.shutdown();
+    }
+
     void checkTextureImageInitialState()
     {
         // GIVEN
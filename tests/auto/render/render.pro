@@ -92,6 +92,7 @@ qtConfig(private_tests) {
         qproximityfilter \
         proximityfilter \
         proximityfiltering \
+        entityspatialindex \
         qblitframebuffer \
         blitframebuffer \
         qraycaster \
@@ -105,7 +106,8 @@ qtConfig(private_tests) {
         waitfence \
         qtexturedataupdate \
         qshaderimage \
-        shaderimage
+        shaderimage \
+        updateworldtransformjob
 
     QT_FOR_CONFIG = 3dcore-private
     # TO DO: These could be restored to be executed in all cases
@@ -115,6 +117,9 @@ qtConfig(private_tests) {
         qray3d \
         raycasting \
         triangleboundingvolume \
+        trianglebvh \
+        frustumculling \
+        stringtoint \
     }
 }
 
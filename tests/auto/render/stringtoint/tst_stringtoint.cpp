@@ -0,0 +1,130 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <Qt3DRender/private/stringtoint_p.h>
+#include <limits>
+#include <thread>
+#include <vector>
+
+using namespace Qt3DRender::Render;
+
+class tst_StringToInt : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void checkSameIdForAllSpellings()
+    {
+        // GIVEN
+        const QString name = QStringLiteral("tst_stringtoint.spelling");
+
+        // WHEN
+        const int id = StringToInt::lookupId(name);
+
+        // THEN
+        QVERIFY(id >= 0);
+        QCOMPARE(StringToInt::lookupId(QLatin1String("tst_stringtoint.spelling")), id);
+        QCOMPARE(StringToInt::lookupId(QStringView(name)), id);
+        QCOMPARE(StringToInt::lookupId(QStringView(name).left(15)),
+                 StringToInt::lookupId(QStringLiteral("tst_stringtoint")));
+        QVERIFY(StringToInt::lookupId(QStringLiteral("tst_stringtoint.other")) != id);
+    }
+
+    void checkLookupString()
+    {
+        // GIVEN
+        const QString name = QStringLiteral("tst_stringtoint.roundtrip[3]");
+
+        // WHEN
+        const int id = StringToInt::lookupId(name);
+
+        // THEN
+        QCOMPARE(StringToInt::lookupString(id), name);
+        QVERIFY(StringToInt::lookupString(-1).isNull());
+        QVERIFY(StringToInt::lookupString(std::numeric_limits<int>::max()).isNull());
+    }
+
+    void checkGrowth()
+    {
+        // GIVEN
+        QVector<int> ids;
+        // Enough strings to outgrow the initial chunk directory twice
+        const int count = 150000;
+        ids.reserve(count);
+
+        // WHEN
+        for (int i = 0; i < count; ++i)
+            ids.push_back(StringToInt::lookupId(QStringLiteral("tst_stringtoint.growth[%1]").arg(i)));
+
+        // THEN
+        for (int i = 0; i < count; ++i) {
+            const QString name = QStringLiteral("tst_stringtoint.growth[%1]").arg(i);
+            QCOMPARE(StringToInt::lookupId(name), ids.at(i));
+            QCOMPARE(StringToInt::lookupString(ids.at(i)), name);
+        }
+    }
+
+    void checkConcurrentLookups()
+    {
+        // GIVEN
+        const int threadCount = 8;
+        const int count = 2000;
+        std::vector<QVector<int>> idsPerThread(threadCount);
+
+        // WHEN
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t) {
+            threads.emplace_back([t, count, &idsPerThread] {
+                QVector<int> &ids = idsPerThread[t];
+                ids.reserve(count);
+                // Each thread walks the names in a different order
+                for (int i = 0; i < count; ++i) {
+                    const int n = (i * (t + 1)) % count;
+                    ids.push_back(StringToInt::lookupId(QStringLiteral("tst_stringtoint.concurrent[%1]").arg(n)));
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+            thread.join();
+
+        // THEN
+        for (int t = 0; t < threadCount; ++t) {
+            for (int i = 0; i < count; ++i) {
+                const int n = (i * (t + 1)) % count;
+                const QString name = QStringLiteral("tst_stringtoint.concurrent[%1]").arg(n);
+                QCOMPARE(StringToInt::lookupId(name), idsPerThread[t].at(i));
+                QCOMPARE(StringToInt::lookupString(idsPerThread[t].at(i)), name);
+            }
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_StringToInt)
+
+#include "tst_stringtoint.moc"
@@ -29,6 +29,7 @@
 #include <QtTest/QTest>
 #include <qbackendnodetester.h>
 #include <Qt3DRender/private/texture_p.h>
+#include <Qt3DRender/private/texturedatamanager_p.h>
 
 #include "testrenderer.h"
 #include <testarbiter.h>
@@ -60,6 +61,57 @@ public:
     }
 };
 
+class IdGenerator : public Qt3DRender::QTextureGenerator
+{
+public:
+    explicit IdGenerator(int id) : m_id(id) {}
+
+    QT3D_FUNCTOR(IdGenerator)
+
+    Qt3DRender::QTextureDataPtr operator ()() override
+    {
+        return Qt3DRender::QTextureDataPtr::create();
+    }
+
+    bool operator ==(const QTextureGenerator &other) const override
+    {
+        const IdGenerator *otherFunctor = Qt3DCore::functor_cast<IdGenerator>(&other);
+        return otherFunctor != nullptr && otherFunctor->m_id == m_id;
+    }
+
+    // Collides on purpose
+    uint hash() const override
+    {
+        return uint(m_id % 2);
+    }
+
+private:
+    int m_id;
+};
+
+// Doesn't provide a hash, the manager falls back to the functor type
+class IdImageGenerator : public Qt3DRender::QTextureImageDataGenerator
+{
+public:
+    explicit IdImageGenerator(int id) : m_id(id) {}
+
+    QT3D_FUNCTOR(IdImageGenerator)
+
+    Qt3DRender::QTextureImageDataPtr operator ()() override
+    {
+        return Qt3DRender::QTextureImageDataPtr::create();
+    }
+
+    bool operator ==(const QTextureImageDataGenerator &other) const override
+    {
+        const IdImageGenerator *otherFunctor = Qt3DCore::functor_cast<IdImageGenerator>(&other);
+        return otherFunctor != nullptr && otherFunctor->m_id == m_id;
+    }
+
+private:
+    int m_id;
+};
+
 class tst_RenderTexture : public Qt3DCore::QBackendNodeTester
 {
     Q_OBJECT
@@ -75,6 +127,8 @@ private slots:
     void checkPropertyChanges();
     void checkTextureImageBookeeping();
     void checkInitialUpdateData();
+    void checkTextureDataManagerBookkeeping();
+    void checkTextureImageDataManagerWithoutHash();
 };
 
 void tst_RenderTexture::checkDefaults()
@@ -518,6 +572,95 @@ void tst_RenderTexture::checkInitialUpdateData()
     QVERIFY(backend.dirtyFlags() & Qt3DRender::Render::Texture::DirtyPendingDataUpdates);
 }
 
+void tst_RenderTexture::checkTextureDataManagerBookkeeping()
+{
+    // GIVEN
+    Qt3DRender::Render::TextureDataManager manager;
+    const Qt3DRender::QTextureGeneratorPtr gen1(new IdGenerator(1));
+    const Qt3DRender::QTextureGeneratorPtr gen1Copy(new IdGenerator(1));
+    const Qt3DRender::QTextureGeneratorPtr gen3(new IdGenerator(3));
+    int a = 0;
+    int b = 0;
+
+    // WHEN
+    const bool gen1Created = manager.requestData(gen1, &a);
+    const bool gen1CopyCreated = manager.requestData(gen1Copy, &b);
+    const bool gen3Created = manager.requestData(gen3, &a);
+    manager.requestData(gen3, &a);
+
+    // THEN -> equal generators share an entry, colliding hashes don't
+    QVERIFY(gen1Created);
+    QVERIFY(!gen1CopyCreated);
+    QVERIFY(gen3Created);
+    QCOMPARE(manager.pendingGenerators().size(), 2);
+    QVERIFY(manager.isPending(gen1Copy));
+
+    // WHEN
+    const Qt3DRender::QTextureDataPtr data = Qt3DRender::QTextureDataPtr::create();
+    manager.assignData(gen1Copy, data);
+
+    // THEN
+    QCOMPARE(manager.pendingGenerators().size(), 1);
+    QCOMPARE(manager.pendingGenerators().first(), gen3);
+    QCOMPARE(manager.getData(gen1), data);
+
+    // WHEN -> a single release drops a reference registered twice
+    manager.releaseData(gen3, &a);
+
+    // THEN
+    QVERIFY(!manager.contains(gen3));
+    QVERIFY(manager.pendingGenerators().isEmpty());
+
+    // WHEN
+    manager.releaseData(gen1, &a);
+
+    // THEN
+    QVERIFY(manager.contains(gen1));
+
+    // WHEN
+    manager.releaseData(gen1, &b);
+
+    // THEN
+    QVERIFY(!manager.contains(gen1));
+    QVERIFY(manager.getData(gen1).isNull());
+}
+
+void tst_RenderTexture::checkTextureImageDataManagerWithoutHash()
+{
+    // GIVEN
+    Qt3DRender::Render::TextureImageDataManager manager;
+    const Qt3DRender::QTextureImageDataGeneratorPtr gen1(new IdImageGenerator(1));
+    const Qt3DRender::QTextureImageDataGeneratorPtr gen1Copy(new IdImageGenerator(1));
+    const Qt3DRender::QTextureImageDataGeneratorPtr gen2(new IdImageGenerator(2));
+    const Qt3DCore::QNodeId a = Qt3DCore::QNodeId::createId();
+    const Qt3DCore::QNodeId b = Qt3DCore::QNodeId::createId();
+
+    // WHEN
+    const bool gen1Created = manager.requestData(gen1, a);
+    const bool gen1CopyCreated = manager.requestData(gen1Copy, b);
+    const bool gen2Created = manager.requestData(gen2, a);
+
+    // THEN -> equal generators still share an entry
+    QVERIFY(gen1Created);
+    QVERIFY(!gen1CopyCreated);
+    QVERIFY(gen2Created);
+    QCOMPARE(manager.pendingGenerators().size(), 2);
+
+    // WHEN
+    manager.releaseData(gen2, a);
+    manager.releaseData(gen1, a);
+
+    // THEN
+    QVERIFY(!manager.contains(gen2));
+    QVERIFY(manager.contains(gen1Copy));
+
+    // WHEN
+    manager.releaseData(gen1Copy, b);
+
+    // THEN
+    QVERIFY(!manager.contains(gen1));
+}
+
 QTEST_APPLESS_MAIN(tst_RenderTexture)
 
 #include "tst_texture.moc"
@@ -0,0 +1,249 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DRender/private/trianglebvh_p.h>
+#include <Qt3DRender/private/triangleboundingvolume_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <QtCore/QRandomGenerator>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::RayCasting;
+
+namespace {
+
+float randomFloat(QRandomGenerator &generator, float min, float max)
+{
+    return min + float(generator.generateDouble()) * (max - min);
+}
+
+Vector3D randomPoint(QRandomGenerator &generator, float extent)
+{
+    return Vector3D(randomFloat(generator, -extent, extent),
+                    randomFloat(generator, -extent, extent),
+                    randomFloat(generator, -extent, extent));
+}
+
+TriangleBvh::Triangle makeTriangle(const Vector3D &a, const Vector3D &b, const Vector3D &c, uint index)
+{
+    TriangleBvh::Triangle triangle;
+    const Vector3D vertices[3] = { a, b, c };
+    for (int i = 0; i < 3; ++i) {
+        triangle.vertices[i][0] = vertices[i].x();
+        triangle.vertices[i][1] = vertices[i].y();
+        triangle.vertices[i][2] = vertices[i].z();
+        triangle.vertexIndices[i] = index * 3 + i;
+    }
+    triangle.primitiveIndex = index;
+    return triangle;
+}
+
+// Small triangles scattered in a cube
+QVector<TriangleBvh::Triangle> randomTriangles(QRandomGenerator &generator, int count)
+{
+    QVector<TriangleBvh::Triangle> triangles;
+    for (int i = 0; i < count; ++i) {
+        const Vector3D center = randomPoint(generator, 10.0f);
+        triangles.push_back(makeTriangle(center + randomPoint(generator, 1.0f),
+                                         center + randomPoint(generator, 1.0f),
+                                         center + randomPoint(generator, 1.0f),
+                                         uint(i)));
+    }
+    return triangles;
+}
+
+bool intersects(const QRay3D &ray, const TriangleBvh::Triangle &triangle)
+{
+    Vector3D uvw;
+    float t = 0.0f;
+    // Either winding
+    return Render::intersectsSegmentTriangle(ray, triangle.vertex(0), triangle.vertex(1), triangle.vertex(2), uvw, t)
+            || Render::intersectsSegmentTriangle(ray, triangle.vertex(2), triangle.vertex(1), triangle.vertex(0), uvw, t);
+}
+
+QVector<uint> bruteForceHits(const QVector<TriangleBvh::Triangle> &triangles, const QRay3D &ray)
+{
+    QVector<uint> hits;
+    for (const TriangleBvh::Triangle &triangle : triangles) {
+        if (intersects(ray, triangle))
+            hits.push_back(triangle.primitiveIndex);
+    }
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+QVector<uint> bvhHits(const TriangleBvh &bvh, const QRay3D &ray)
+{
+    QVector<uint> hits;
+    bvh.traverse(ray, [&] (const TriangleBvh::Triangle &triangle) {
+        if (intersects(ray, triangle))
+            hits.push_back(triangle.primitiveIndex);
+    });
+    std::sort(hits.begin(), hits.end());
+    return hits;
+}
+
+} // anonymous
+
+class tst_TriangleBvh : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void checkEmpty()
+    {
+        // GIVEN
+        const TriangleBvh bvh(QVector<TriangleBvh::Triangle>{});
+
+        // THEN
+        QCOMPARE(bvh.triangleCount(), 0);
+        QCOMPARE(bvh.nodeCount(), 0);
+
+        // WHEN
+        int visited = 0;
+        bvh.traverse(QRay3D(Vector3D(), Vector3D(0.0f, 0.0f, 1.0f), 100.0f),
+                     [&] (const TriangleBvh::Triangle &) { ++visited; });
+
+        // THEN
+        QCOMPARE(visited, 0);
+    }
+
+    void checkKeepsAllTriangles()
+    {
+        // GIVEN
+        QRandomGenerator generator(1234);
+        const QVector<TriangleBvh::Triangle> triangles = randomTriangles(generator, 1000);
+
+        // WHEN
+        const TriangleBvh bvh(triangles);
+
+        // THEN
+        QCOMPARE(bvh.triangleCount(), triangles.size());
+        QVERIFY(bvh.nodeCount() > 1);
+        QVERIFY(bvh.nodeCount() < 2 * triangles.size());
+
+        QVector<uint> indices;
+        for (const TriangleBvh::Triangle &triangle : bvh.triangles())
+            indices.push_back(triangle.primitiveIndex);
+        std::sort(indices.begin(), indices.end());
+        for (int i = 0; i < indices.size(); ++i)
+            QCOMPARE(indices.at(i), uint(i));
+    }
+
+    void checkMatchesBruteForce_data()
+    {
+        QTest::addColumn<int>("triangleCount");
+        QTest::addColumn<bool>("axisAlignedRays");
+
+        QTest::newRow("single") << 1 << false;
+        QTest::newRow("few") << 7 << false;
+        QTest::newRow("many") << 5000 << false;
+        QTest::newRow("many-axis-aligned") << 5000 << true;
+    }
+
+    void checkMatchesBruteForce()
+    {
+        // GIVEN
+        QFETCH(int, triangleCount);
+        QFETCH(bool, axisAlignedRays);
+        QRandomGenerator generator(42);
+        const QVector<TriangleBvh::Triangle> triangles = randomTriangles(generator, triangleCount);
+        const TriangleBvh bvh(triangles);
+
+        for (int i = 0; i < 500; ++i) {
+            // WHEN
+            const Vector3D origin = randomPoint(generator, 15.0f);
+            Vector3D direction = randomPoint(generator, 1.0f);
+            if (axisAlignedRays) {
+                const float sign = (i % 2) ? 1.0f : -1.0f;
+                const int axis = i % 3;
+                direction = Vector3D(axis == 0 ? sign : 0.0f,
+                                     axis == 1 ? sign : 0.0f,
+                                     axis == 2 ? sign : 0.0f);
+            }
+            const QRay3D ray(origin, direction, randomFloat(generator, 1.0f, 40.0f));
+
+            // THEN
+            QCOMPARE(bvhHits(bvh, ray), bruteForceHits(triangles, ray));
+        }
+    }
+
+    void checkCoincidentCentroids()
+    {
+        // GIVEN
+        QVector<TriangleBvh::Triangle> triangles;
+        for (int i = 0; i < 100; ++i) {
+            const float scale = 1.0f + i;
+            triangles.push_back(makeTriangle(Vector3D(-scale, -scale, 0.0f),
+                                             Vector3D(scale, -scale, 0.0f),
+                                             Vector3D(0.0f, scale, 0.0f),
+                                             uint(i)));
+        }
+
+        // WHEN
+        const TriangleBvh bvh(triangles);
+        const QRay3D ray(Vector3D(0.0f, 0.0f, 10.0f), Vector3D(0.0f, 0.0f, -1.0f), 20.0f);
+
+        // THEN
+        QCOMPARE(bvh.triangleCount(), triangles.size());
+        QCOMPARE(bvhHits(bvh, ray).size(), 100);
+    }
+
+    void checkSegmentLength()
+    {
+        // GIVEN
+        const QVector<TriangleBvh::Triangle> triangles = {
+            makeTriangle(Vector3D(-1.0f, -1.0f, 5.0f), Vector3D(1.0f, -1.0f, 5.0f), Vector3D(0.0f, 1.0f, 5.0f), 0)
+        };
+        const TriangleBvh bvh(triangles);
+
+        // THEN
+        QCOMPARE(bvhHits(bvh, QRay3D(Vector3D(), Vector3D(0.0f, 0.0f, 1.0f), 10.0f)).size(), 1);
+        QCOMPARE(bvhHits(bvh, QRay3D(Vector3D(), Vector3D(0.0f, 0.0f, 1.0f), 4.0f)).size(), 0);
+        QCOMPARE(bvhHits(bvh, QRay3D(Vector3D(), Vector3D(0.0f, 0.0f, -1.0f), 10.0f)).size(), 0);
+    }
+
+    void checkSourceRevisions()
+    {
+        // GIVEN
+        TriangleBvh bvh(QVector<TriangleBvh::Triangle>{});
+
+        // THEN
+        QVERIFY(bvh.sourceRevisions().isEmpty());
+
+        // WHEN
+        bvh.setSourceRevisions({ 1, 2, 3 });
+
+        // THEN
+        QCOMPARE(bvh.sourceRevisions(), QVector<int>({ 1, 2, 3 }));
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_TriangleBvh)
+
+#include "tst_trianglebvh.moc"
@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/matrix4x4_p.h>
+#include <Qt3DRender/private/nodemanagers_p.h>
+#include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
+#include <Qt3DRender/private/transform_p.h>
+#include <Qt3DRender/private/updateworldtransformjob_p.h>
+
+#include "testaspect.h"
+
+namespace {
+
+Qt3DCore::QEntity *buildEntity(const QVector3D &translation, Qt3DCore::QEntity *parent)
+{
+    Qt3DCore::QEntity *entity = new Qt3DCore::QEntity(parent);
+    Qt3DCore::QTransform *transform = new Qt3DCore::QTransform(entity);
+    transform->setTranslation(translation);
+    entity->addComponent(transform);
+    return entity;
+}
+
+QMatrix4x4 translationMatrix(const QVector3D &translation)
+{
+    QMatrix4x4 m;
+    m.translate(translation);
+    return m;
+}
+
+} // anonymous
+
+class tst_UpdateWorldTransformJob : public QObject
+{
+    Q_OBJECT
+
+    Qt3DRender::Render::Entity *backendEntity(Qt3DRender::TestAspect *aspect, Qt3DCore::QEntity *entity)
+    {
+        return aspect->nodeManagers()->renderNodesManager()->lookupResource(entity->id());
+    }
+
+    void syncTransform(Qt3DRender::TestAspect *aspect, Qt3DCore::QEntity *entity)
+    {
+        Qt3DCore::QTransform *transform = entity->componentsOfType<Qt3DCore::QTransform>().first();
+        Qt3DRender::Render::Transform *backendTransform = aspect->nodeManagers()->transformManager()->lookupResource(transform->id());
+        QVERIFY(backendTransform);
+        backendTransform->syncFromFrontEnd(transform, false);
+    }
+
+    void runJob(Qt3DRender::TestAspect *aspect, Qt3DCore::QEntity *root)
+    {
+        Qt3DRender::Render::UpdateWorldTransformJob updateWorldTransform;
+        updateWorldTransform.setRoot(backendEntity(aspect, root));
+        updateWorldTransform.setManagers(aspect->nodeManagers());
+        updateWorldTransform.run();
+    }
+
+private Q_SLOTS:
+    void checkOnlyDirtySubtreesAreUpdated()
+    {
+        // GIVEN
+        //   root
+        //   |- inner (1, 0, 0)
+        //   |  |- innerChild (0, 1, 0)
+        //   |- branch (0, 0, 1)
+        //      |- leaf (2, 0, 0)
+        //      |- sibling (0, 2, 0)
+        QScopedPointer<Qt3DCore::QEntity> root(new Qt3DCore::QEntity());
+        Qt3DCore::QEntity *inner = buildEntity(QVector3D(1.0f, 0.0f, 0.0f), root.data());
+        Qt3DCore::QEntity *innerChild = buildEntity(QVector3D(0.0f, 1.0f, 0.0f), inner);
+        Qt3DCore::QEntity *branch = buildEntity(QVector3D(0.0f, 0.0f, 1.0f), root.data());
+        Qt3DCore::QEntity *leaf = buildEntity(QVector3D(2.0f, 0.0f, 0.0f), branch);
+        Qt3DCore::QEntity *sibling = buildEntity(QVector3D(0.0f, 2.0f, 0.0f), branch);
+
+        QScopedPointer<Qt3DRender::TestAspect> aspect(new Qt3DRender::TestAspect(root.data()));
+        runJob(aspect.data(), root.data());
+
+        // THEN
+        Qt3DRender::Render::Entity *backendInnerChild = backendEntity(aspect.data(), innerChild);
+        Qt3DRender::Render::Entity *backendLeaf = backendEntity(aspect.data(), leaf);
+        Qt3DRender::Render::Entity *backendSibling = backendEntity(aspect.data(), sibling);
+        QCOMPARE(convertToQMatrix4x4(*backendInnerChild->worldTransform()), translationMatrix(QVector3D(1.0f, 1.0f, 0.0f)));
+        QCOMPARE(convertToQMatrix4x4(*backendLeaf->worldTransform()), translationMatrix(QVector3D(2.0f, 0.0f, 1.0f)));
+        QCOMPARE(convertToQMatrix4x4(*backendSibling->worldTransform()), translationMatrix(QVector3D(0.0f, 2.0f, 1.0f)));
+        QVERIFY(!backendEntity(aspect.data(), root.data())->hasTransformDirtyChildren());
+        const Qt3DCore::QNodeId leafTransformId = leaf->componentsOfType<Qt3DCore::QTransform>().first()->id();
+        QCOMPARE(aspect->nodeManagers()->renderNodesManager()->entitiesReferencingTransform(leafTransformId),
+                 QVector<Qt3DRender::Render::HEntity>() << backendLeaf->handle());
+
+        // WHEN
+        // Overwrite the world transform of the sibling, it can only be
+        // restored if the job visits the clean sibling
+        const QMatrix4x4 bogusMatrix = translationMatrix(QVector3D(42.0f, 42.0f, 42.0f));
+        *backendSibling->worldTransform() = Matrix4x4(bogusMatrix);
+
+        inner->componentsOfType<Qt3DCore::QTransform>().first()->setTranslation(QVector3D(3.0f, 0.0f, 0.0f));
+        syncTransform(aspect.data(), inner);
+        leaf->componentsOfType<Qt3DCore::QTransform>().first()->setTranslation(QVector3D(4.0f, 0.0f, 0.0f));
+        syncTransform(aspect.data(), leaf);
+
+        // THEN
+        QVERIFY(backendEntity(aspect.data(), inner)->isTransformDirty());
+        QVERIFY(backendLeaf->isTransformDirty());
+        QVERIFY(!backendSibling->isTransformDirty());
+        QVERIFY(backendEntity(aspect.data(), branch)->hasTransformDirtyChildren());
+
+        // WHEN
+        runJob(aspect.data(), root.data());
+
+        // THEN
+        QCOMPARE(convertToQMatrix4x4(*backendEntity(aspect.data(), inner)->worldTransform()), translationMatrix(QVector3D(3.0f, 0.0f, 0.0f)));
+        QCOMPARE(convertToQMatrix4x4(*backendInnerChild->worldTransform()), translationMatrix(QVector3D(3.0f, 1.0f, 0.0f)));
+        QCOMPARE(convertToQMatrix4x4(*backendLeaf->worldTransform()), translationMatrix(QVector3D(4.0f, 0.0f, 1.0f)));
+        QCOMPARE(convertToQMatrix4x4(*backendSibling->worldTransform()), bogusMatrix);
+        QVERIFY(!backendEntity(aspect.data(), inner)->isTransformDirty());
+        QVERIFY(!backendLeaf->isTransformDirty());
+        QVERIFY(!backendEntity(aspect.data(), branch)->hasTransformDirtyChildren());
+    }
+};
+
+QTEST_MAIN(tst_UpdateWorldTransformJob)
+
+#include "tst_updateworldtransformjob.moc"
@@ -0,0 +1,7 @@
+TEMPLATE=subdirs
+
+qtConfig(private_tests) {
+    SUBDIRS += \
+        clipanimatorevaluation \
+        fcurveevaluation
+}
@@ -0,0 +1,14 @@
+TEMPLATE = app
+
+TARGET = tst_bench_clipanimatorevaluation
+
+QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_bench_clipanimatorevaluation.cpp
+
+RESOURCES += \
+    clipanimatorevaluation.qrc
+
+include(../../../auto/core/common/common.pri)
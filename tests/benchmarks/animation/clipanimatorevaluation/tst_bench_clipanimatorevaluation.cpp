@@ -0,0 +1,154 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <QtCore/QThread>
+#include <Qt3DAnimation/qabstractclipanimator.h>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/channelmapper_p.h>
+#include <Qt3DAnimation/private/channelmapping_p.h>
+#include <Qt3DAnimation/private/clipanimator_p.h>
+#include <Qt3DAnimation/private/findrunningclipanimatorsjob_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <Qt3DAnimation/private/managers_p.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <qbackendnodetester.h>
+
+using namespace Qt3DAnimation::Animation;
+
+Q_DECLARE_METATYPE(Qt3DAnimation::Animation::Handler::ClipAnimatorEvaluationMode)
+
+class tst_BenchClipAnimatorEvaluation : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+
+    // Sets up animatorCount running animators playing the same clip, each
+    // mapping its location to a target of its own
+    void setupAnimators(Handler *handler, int animatorCount)
+    {
+        const Qt3DCore::QNodeId clipId = Qt3DCore::QNodeId::createId();
+        AnimationClip *clip = handler->animationClipLoaderManager()->getOrCreateResource(clipId);
+        setPeerId(clip, clipId);
+        clip->setHandler(handler);
+        clip->setDataType(AnimationClip::File);
+        clip->setSource(QUrl("qrc:/clip1.json"));
+        clip->loadAnimation();
+
+        QVector<HClipAnimator> animators;
+        animators.reserve(animatorCount);
+        for (int i = 0; i < animatorCount; ++i) {
+            const Qt3DCore::QNodeId mappingId = Qt3DCore::QNodeId::createId();
+            ChannelMapping *mapping = handler->channelMappingManager()->getOrCreateResource(mappingId);
+            setPeerId(mapping, mappingId);
+            mapping->setHandler(handler);
+            mapping->setTargetId(Qt3DCore::QNodeId::createId());
+            mapping->setPropertyName("translation");
+            mapping->setChannelName(QLatin1String("Location"));
+            mapping->setType(static_cast<int>(QVariant::Vector3D));
+            mapping->setComponentCount(3);
+            mapping->setMappingType(ChannelMapping::ChannelMappingType);
+
+            const Qt3DCore::QNodeId mapperId = Qt3DCore::QNodeId::createId();
+            ChannelMapper *mapper = handler->channelMapperManager()->getOrCreateResource(mapperId);
+            setPeerId(mapper, mapperId);
+            mapper->setHandler(handler);
+            mapper->setMappingIds({ mappingId });
+
+            const Qt3DCore::QNodeId animatorId = Qt3DCore::QNodeId::createId();
+            ClipAnimator *animator = handler->clipAnimatorManager()->getOrCreateResource(animatorId);
+            setPeerId(animator, animatorId);
+            animator->setHandler(handler);
+            animator->setStartTime(0);
+            animator->setLoops(Qt3DAnimation::QAbstractClipAnimator::Infinite);
+            animator->setClipId(clipId);
+            animator->setMapperId(mapperId);
+            animator->setRunning(true);
+            animator->setEnabled(true);
+            animators.push_back(handler->clipAnimatorManager()->getOrAcquireHandle(animatorId));
+        }
+
+        // Builds the mapping data and marks the animators as running
+        FindRunningClipAnimatorsJob findJob;
+        findJob.setHandler(handler);
+        findJob.setDirtyClipAnimators(animators);
+        findJob.run();
+    }
+
+private Q_SLOTS:
+    void evaluate_data()
+    {
+        QTest::addColumn<Handler::ClipAnimatorEvaluationMode>("mode");
+        QTest::addColumn<int>("animatorCount");
+
+        for (const int count : { 10, 100, 1000, 10000 }) {
+            QTest::addRow("PerAnimator-%d", count) << Handler::PerAnimatorEvaluation << count;
+            QTest::addRow("Batched-%d", count) << Handler::BatchedEvaluation << count;
+        }
+    }
+
+    void evaluate()
+    {
+        QFETCH(Handler::ClipAnimatorEvaluationMode, mode);
+        QFETCH(int, animatorCount);
+
+        // GIVEN
+        Handler handler;
+        handler.setClipAnimatorEvaluationMode(mode);
+        setupAnimators(&handler, animatorCount);
+        QCOMPARE(handler.runningClipAnimators().size(), animatorCount);
+
+        Qt3DCore::QAspectJobManager jobManager;
+        jobManager.initialize();
+        qint64 time = 0;
+
+        // Drop the jobs processing the dirty animators, already run above
+        handler.jobsToExecute(time);
+
+        // THEN
+        const int jobCount = handler.jobsToExecute(time).size();
+        if (mode == Handler::PerAnimatorEvaluation)
+            QCOMPARE(jobCount, animatorCount);
+        else
+            QVERIFY(jobCount <= qMax(1, QThread::idealThreadCount()));
+
+        // WHEN
+        QBENCHMARK {
+            time += 16000000;
+            jobManager.enqueueJobs(handler.jobsToExecute(time));
+            jobManager.waitForAllJobs();
+        }
+
+        // THEN
+        QCOMPARE(handler.runningClipAnimators().size(), animatorCount);
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_BenchClipAnimatorEvaluation)
+
+#include "tst_bench_clipanimatorevaluation.moc"
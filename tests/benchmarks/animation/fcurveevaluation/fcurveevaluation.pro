@@ -0,0 +1,11 @@
+TEMPLATE = app
+
+TARGET = tst_bench_fcurveevaluation
+
+QT += core-private 3dcore 3dcore-private 3danimation 3danimation-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_bench_fcurveevaluation.cpp
+
+include(../../../auto/core/common/common.pri)
@@ -0,0 +1,150 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DAnimation/qanimationclip.h>
+#include <Qt3DAnimation/qanimationclipdata.h>
+#include <Qt3DAnimation/qchannel.h>
+#include <Qt3DAnimation/qchannelcomponent.h>
+#include <Qt3DAnimation/qkeyframe.h>
+#include <Qt3DAnimation/private/animationclip_p.h>
+#include <Qt3DAnimation/private/animationutils_p.h>
+#include <Qt3DAnimation/private/fcurve_p.h>
+#include <Qt3DAnimation/private/handler_p.h>
+#include <qbackendnodetester.h>
+
+#include <cmath>
+
+using namespace Qt3DAnimation::Animation;
+
+namespace {
+
+enum LookupMode {
+    BinarySearchLookup,
+    CursorLookup,
+    BatchedClipEvaluation
+};
+
+const float keyframeInterval = 1.0f / 30.0f;
+const float frameInterval = 1.0f / 60.0f;
+
+} // anonymous
+
+Q_DECLARE_METATYPE(LookupMode)
+
+class tst_BenchFCurveEvaluation : public Qt3DCore::QBackendNodeTester
+{
+    Q_OBJECT
+
+    // Builds a clip of single component channels, linearly interpolated
+    Qt3DAnimation::QAnimationClipData buildClipData(int channelCount, int keyframeCount)
+    {
+        Qt3DAnimation::QAnimationClipData clipData;
+        for (int i = 0; i < channelCount; ++i) {
+            Qt3DAnimation::QChannelComponent component(QStringLiteral("Value"));
+            for (int j = 0; j < keyframeCount; ++j)
+                component.appendKeyFrame(Qt3DAnimation::QKeyFrame(QVector2D(j * keyframeInterval, std::sin(float(i + j)))));
+
+            Qt3DAnimation::QChannel channel(QStringLiteral("Channel%1").arg(i));
+            channel.appendChannelComponent(component);
+            clipData.appendChannel(channel);
+        }
+        return clipData;
+    }
+
+private Q_SLOTS:
+    void evaluate_data()
+    {
+        QTest::addColumn<LookupMode>("mode");
+        QTest::addColumn<int>("channelCount");
+        QTest::addColumn<int>("keyframeCount");
+
+        QTest::addRow("BinarySearch-200x10000") << BinarySearchLookup << 200 << 10000;
+        QTest::addRow("Cursor-200x10000") << CursorLookup << 200 << 10000;
+        QTest::addRow("Batched-200x10000") << BatchedClipEvaluation << 200 << 10000;
+    }
+
+    void evaluate()
+    {
+        QFETCH(LookupMode, mode);
+        QFETCH(int, channelCount);
+        QFETCH(int, keyframeCount);
+
+        // GIVEN
+        Handler handler;
+        Qt3DAnimation::QAnimationClip frontendClip;
+        frontendClip.setClipData(buildClipData(channelCount, keyframeCount));
+        AnimationClip clip;
+        clip.setHandler(&handler);
+        simulateInitializationSync(&frontendClip, &clip);
+        clip.loadAnimation();
+        QCOMPARE(clip.channelCount(), channelCount);
+
+        const QVector<Channel> &channels = clip.channels();
+        QVector<int> cursors(channelCount, 0);
+        ClipEvaluationState state;
+        ClipResults results(channelCount);
+        float localTime = 0.0f;
+
+        // THEN
+        evaluateClipAtLocalTime(&clip, 123.45f, results, &state);
+        for (int i = 0; i < channelCount; ++i)
+            QCOMPARE(results[i], channels[i].channelComponents[0].fcurve.evaluateAtTime(123.45f));
+
+        // WHEN
+        QBENCHMARK {
+            // Plays the clip forward one frame at a time
+            localTime += frameInterval;
+            if (localTime > clip.duration())
+                localTime = 0.0f;
+
+            switch (mode) {
+            case BinarySearchLookup:
+                for (int i = 0; i < channelCount; ++i) {
+                    const FCurve &fcurve = channels[i].channelComponents[0].fcurve;
+                    results[i] = fcurve.evaluateAtTime(localTime, fcurve.lowerKeyframeBound(localTime));
+                }
+                break;
+            case CursorLookup:
+                for (int i = 0; i < channelCount; ++i) {
+                    const FCurve &fcurve = channels[i].channelComponents[0].fcurve;
+                    results[i] = fcurve.evaluateAtTime(localTime, fcurve.lowerKeyframeBound(localTime, &cursors[i]));
+                }
+                break;
+            case BatchedClipEvaluation:
+                evaluateClipAtLocalTime(&clip, localTime, results, &state);
+                break;
+            }
+        }
+    }
+};
+
+QTEST_MAIN(tst_BenchFCurveEvaluation)
+
+#include "tst_bench_fcurveevaluation.moc"
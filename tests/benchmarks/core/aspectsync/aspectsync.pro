@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = tst_bench_aspectsync
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private 3dinput 3dlogic 3danimation testlib
+
+CONFIG += testcase
+
+SOURCES += tst_bench_aspectsync.cpp
+
+# Needed to use the TestAspect
+DEFINES += QT_BUILD_INTERNAL
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qentity.h>
+#include <Qt3DCore/qtransform.h>
+#include <Qt3DCore/private/qabstractaspect_p.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qnodevisitor_p.h>
+#include <Qt3DCore/private/qnode_p.h>
+
+#include <Qt3DRender/qrenderaspect.h>
+#include <Qt3DRender/qmaterial.h>
+#include <Qt3DRender/qgeometryrenderer.h>
+#include <Qt3DRender/qobjectpicker.h>
+#include <Qt3DInput/qinputaspect.h>
+#include <Qt3DInput/qmousehandler.h>
+#include <Qt3DLogic/qlogicaspect.h>
+#include <Qt3DLogic/qframeaction.h>
+#include <Qt3DAnimation/qanimationaspect.h>
+#include <Qt3DAnimation/qclipanimator.h>
+
+namespace {
+
+class TestRenderAspect : public Qt3DRender::QRenderAspect
+{
+public:
+    TestRenderAspect()
+        : Qt3DRender::QRenderAspect(Qt3DRender::QRenderAspect::Synchronous)
+        , m_jobManager(new Qt3DCore::QAspectJobManager())
+    {
+        Qt3DCore::QAbstractAspectPrivate::get(this)->m_jobManager = m_jobManager.data();
+        QRenderAspect::onRegistered();
+    }
+
+    ~TestRenderAspect()
+    {
+        QRenderAspect::onUnregistered();
+    }
+
+private:
+    QScopedPointer<Qt3DCore::QAspectJobManager> m_jobManager;
+};
+
+Qt3DCore::QEntity *buildTestScene(int entityCount, QVector<Qt3DCore::QNode *> &dirtyNodes)
+{
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+
+    for (int i = 0; i < entityCount; ++i) {
+        Qt3DCore::QEntity *entity = new Qt3DCore::QEntity(root);
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform(entity);
+        transform->setTranslation(QVector3D(float(i), 0.0f, 0.0f));
+        entity->addComponent(transform);
+        entity->addComponent(new Qt3DRender::QMaterial(entity));
+        entity->addComponent(new Qt3DRender::QGeometryRenderer(entity));
+        entity->addComponent(new Qt3DRender::QObjectPicker(entity));
+        entity->addComponent(new Qt3DInput::QMouseHandler(entity));
+        entity->addComponent(new Qt3DLogic::QFrameAction(entity));
+        entity->addComponent(new Qt3DAnimation::QClipAnimator(entity));
+
+        // What is typically marked dirty when objects move around
+        dirtyNodes.push_back(entity);
+        dirtyNodes.push_back(transform);
+    }
+
+    return root;
+}
+
+QVector<Qt3DCore::NodeTreeChange> nodeTreeChangesForScene(Qt3DCore::QNode *root)
+{
+    QVector<Qt3DCore::NodeTreeChange> nodes;
+    Qt3DCore::QNodeVisitor v;
+    v.traverse(root, [&nodes](Qt3DCore::QNode *node) {
+        Qt3DCore::QNodePrivate *d = Qt3DCore::QNodePrivate::get(node);
+        d->m_typeInfo = const_cast<QMetaObject*>(Qt3DCore::QNodePrivate::findStaticMetaObject(node->metaObject()));
+        d->m_hasBackendNode = true;
+        nodes.push_back({
+            node->id(),
+            d->m_typeInfo,
+            Qt3DCore::NodeTreeChange::Added,
+            node
+        });
+    });
+    return nodes;
+}
+
+} // anonymous
+
+class tst_AspectSync : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+
+    void syncDirtyFrontEndNodes_data()
+    {
+        QTest::addColumn<int>("entityCount");
+
+        QTest::newRow("1000") << 1000;
+        QTest::newRow("10000") << 10000;
+        QTest::newRow("50000") << 50000;
+    }
+
+    void syncDirtyFrontEndNodes()
+    {
+        // GIVEN
+        QFETCH(int, entityCount);
+        QVector<Qt3DCore::QNode *> dirtyNodes;
+        QScopedPointer<Qt3DCore::QEntity> root(buildTestScene(entityCount, dirtyNodes));
+
+        TestRenderAspect renderAspect;
+        Qt3DInput::QInputAspect inputAspect;
+        Qt3DLogic::QLogicAspect logicAspect;
+        Qt3DAnimation::QAnimationAspect animationAspect;
+        const QVector<Qt3DCore::QAbstractAspect *> aspects = {
+            &renderAspect, &inputAspect, &logicAspect, &animationAspect
+        };
+
+        const QVector<Qt3DCore::NodeTreeChange> nodeTreeChanges = nodeTreeChangesForScene(root.data());
+        for (Qt3DCore::QAbstractAspect *aspect : aspects) {
+            for (const Qt3DCore::NodeTreeChange &change : nodeTreeChanges)
+                Qt3DCore::QAbstractAspectPrivate::get(aspect)->createBackendNode(change);
+        }
+
+        // WHEN
+        QBENCHMARK {
+            // Mirrors the sync step of QAspectManager::processFrame
+            for (Qt3DCore::QAbstractAspect *aspect : aspects)
+                Qt3DCore::QAbstractAspectPrivate::get(aspect)->syncDirtyFrontEndNodes(dirtyNodes);
+        }
+    }
+};
+
+QTEST_MAIN(tst_AspectSync)
+
+#include "tst_bench_aspectsync.moc"
@@ -1,4 +1,7 @@
 TEMPLATE = subdirs
 
 SUBDIRS += \
-    qresourcesmanager
+    qresourcesmanager \
+    qchangearbiter \
+    aspectsync \
+    jobscheduling
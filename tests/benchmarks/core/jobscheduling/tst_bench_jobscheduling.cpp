@@ -0,0 +1,235 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qaspectjob.h>
+#include <Qt3DCore/private/qaspectjobmanager_p.h>
+#include <Qt3DCore/private/qworkstealingjobmanager_p.h>
+
+class tst_JobScheduling : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void stableGraph_data();
+    void stableGraph();
+    void changingGraph_data();
+    void changingGraph();
+    void wideGraph_data();
+    void wideGraph();
+    void deepGraph_data();
+    void deepGraph();
+};
+
+namespace {
+
+class EmptyJob : public Qt3DCore::QAspectJob
+{
+public:
+    void run() override {}
+};
+
+// jobCount jobs split into chains of chainLength jobs each depending on the previous one
+QVector<Qt3DCore::QAspectJobPtr> createJobs(int jobCount, int chainLength)
+{
+    QVector<Qt3DCore::QAspectJobPtr> jobs;
+    jobs.reserve(jobCount);
+    for (int i = 0; i < jobCount; ++i) {
+        Qt3DCore::QAspectJobPtr job(new EmptyJob());
+        if (i % chainLength != 0)
+            job->addDependency(jobs.last());
+        jobs.push_back(job);
+    }
+    return jobs;
+}
+
+void addJobRows()
+{
+    QTest::addColumn<int>("jobCount");
+    QTest::addColumn<int>("chainLength");
+    QTest::newRow("100 jobs, independent") << 100 << 1;
+    QTest::newRow("100 jobs, chains of 10") << 100 << 10;
+    QTest::newRow("300 jobs, independent") << 300 << 1;
+    QTest::newRow("300 jobs, chains of 10") << 300 << 10;
+}
+
+// A job doing a small amount of work, like most render jobs do
+class TinyJob : public Qt3DCore::QAspectJob
+{
+public:
+    void run() override
+    {
+        float v = 1.0f;
+        for (int i = 0; i < 200; ++i)
+            v = v * 1.0001f + 0.5f;
+        m_result = v;
+    }
+
+private:
+    volatile float m_result = 0.0f;
+};
+
+enum Scheduler {
+    ThreadPool,
+    WorkStealing
+};
+
+Qt3DCore::QAbstractAspectJobManager *createManager(Scheduler scheduler)
+{
+    if (scheduler == WorkStealing)
+        return new Qt3DCore::QWorkStealingJobManager();
+    return new Qt3DCore::QAspectJobManager();
+}
+
+void addSchedulerRows(const char *shape, const QVector<int> &sizes)
+{
+    QTest::addColumn<int>("scheduler");
+    QTest::addColumn<int>("size");
+    for (int size : sizes) {
+        QTest::addRow("QThreadPool, %s %d", shape, size) << int(ThreadPool) << size;
+        QTest::addRow("work stealing, %s %d", shape, size) << int(WorkStealing) << size;
+    }
+}
+
+void runGraph(Scheduler scheduler, const QVector<Qt3DCore::QAspectJobPtr> &jobs)
+{
+    QScopedPointer<Qt3DCore::QAbstractAspectJobManager> manager(createManager(scheduler));
+    QBENCHMARK {
+        manager->enqueueJobs(jobs);
+        manager->waitForAllJobs();
+    }
+}
+
+} // anonymous
+
+void tst_JobScheduling::stableGraph_data()
+{
+    addJobRows();
+}
+
+void tst_JobScheduling::stableGraph()
+{
+    // GIVEN
+    QFETCH(int, jobCount);
+    QFETCH(int, chainLength);
+    Qt3DCore::QAspectJobManager manager;
+    const QVector<Qt3DCore::QAspectJobPtr> jobs = createJobs(jobCount, chainLength);
+
+    // WHEN
+    QBENCHMARK {
+        manager.enqueueJobs(jobs);
+        manager.waitForAllJobs();
+    }
+}
+
+void tst_JobScheduling::changingGraph_data()
+{
+    addJobRows();
+}
+
+void tst_JobScheduling::changingGraph()
+{
+    // GIVEN
+    QFETCH(int, jobCount);
+    QFETCH(int, chainLength);
+    Qt3DCore::QAspectJobManager manager;
+    const QVector<Qt3DCore::QAspectJobPtr> jobs = createJobs(jobCount, chainLength);
+    const Qt3DCore::QAspectJobPtr extraDependency(new EmptyJob());
+
+    // WHEN
+    QBENCHMARK {
+        // Touching the dependencies forces the task graph to be rebuilt
+        jobs.last()->addDependency(extraDependency);
+        jobs.last()->removeDependency(extraDependency);
+        manager.enqueueJobs(jobs);
+        manager.waitForAllJobs();
+    }
+}
+
+void tst_JobScheduling::wideGraph_data()
+{
+    addSchedulerRows("wide", { 256, 1024, 4096 });
+}
+
+void tst_JobScheduling::wideGraph()
+{
+    // GIVEN
+    QFETCH(int, scheduler);
+    QFETCH(int, size);
+
+    // One root fanning out to size jobs, all joined by a final job
+    QVector<Qt3DCore::QAspectJobPtr> jobs;
+    const Qt3DCore::QAspectJobPtr root(new TinyJob());
+    const Qt3DCore::QAspectJobPtr join(new TinyJob());
+    jobs.push_back(root);
+    for (int i = 0; i < size; ++i) {
+        Qt3DCore::QAspectJobPtr job(new TinyJob());
+        job->addDependency(root);
+        join->addDependency(job);
+        jobs.push_back(job);
+    }
+    jobs.push_back(join);
+
+    // WHEN
+    runGraph(Scheduler(scheduler), jobs);
+}
+
+void tst_JobScheduling::deepGraph_data()
+{
+    addSchedulerRows("deep", { 64, 256, 1024 });
+}
+
+void tst_JobScheduling::deepGraph()
+{
+    // GIVEN
+    QFETCH(int, scheduler);
+    QFETCH(int, size);
+
+    // Four chains of size jobs, each link also depending on the previous
+    // link of the neighbouring chain
+    const int chainCount = 4;
+    QVector<Qt3DCore::QAspectJobPtr> jobs;
+    jobs.reserve(chainCount * size);
+    for (int depth = 0; depth < size; ++depth) {
+        for (int chain = 0; chain < chainCount; ++chain) {
+            Qt3DCore::QAspectJobPtr job(new TinyJob());
+            if (depth > 0) {
+                const int previousRow = (depth - 1) * chainCount;
+                job->addDependency(jobs.at(previousRow + chain));
+                job->addDependency(jobs.at(previousRow + (chain + 1) % chainCount));
+            }
+            jobs.push_back(job);
+        }
+    }
+
+    // WHEN
+    runGraph(Scheduler(scheduler), jobs);
+}
+
+QTEST_MAIN(tst_JobScheduling)
+
+#include "tst_bench_jobscheduling.moc"
@@ -0,0 +1,119 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DCore/qnode.h>
+#include <Qt3DCore/private/qchangearbiter_p.h>
+
+class tst_QChangeArbiter : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void addDirtyFrontEndNodes_data();
+    void addDirtyFrontEndNodes();
+    void removeDirtyFrontEndNodes_data();
+    void removeDirtyFrontEndNodes();
+};
+
+namespace {
+
+QVector<Qt3DCore::QNode *> createNodes(int count)
+{
+    QVector<Qt3DCore::QNode *> nodes;
+    nodes.reserve(count);
+    for (int i = 0; i < count; ++i)
+        nodes.push_back(new Qt3DCore::QNode());
+    return nodes;
+}
+
+void addNodeCountRows()
+{
+    QTest::addColumn<int>("nodeCount");
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+
+} // anonymous
+
+void tst_QChangeArbiter::addDirtyFrontEndNodes_data()
+{
+    addNodeCountRows();
+}
+
+void tst_QChangeArbiter::addDirtyFrontEndNodes()
+{
+    // GIVEN
+    QFETCH(int, nodeCount);
+    Qt3DCore::QChangeArbiter arbiter;
+    const QVector<Qt3DCore::QNode *> nodes = createNodes(nodeCount);
+
+    // WHEN
+    QBENCHMARK {
+        // Each node gets dirtied twice as it would when
+        // several properties change during the same frame
+        for (Qt3DCore::QNode *node : nodes)
+            arbiter.addDirtyFrontEndNode(node);
+        for (Qt3DCore::QNode *node : nodes)
+            arbiter.addDirtyFrontEndNode(node);
+        const QVector<Qt3DCore::QNode *> dirtyNodes = arbiter.takeDirtyFrontEndNodes();
+        Q_UNUSED(dirtyNodes);
+    }
+
+    qDeleteAll(nodes);
+}
+
+void tst_QChangeArbiter::removeDirtyFrontEndNodes_data()
+{
+    addNodeCountRows();
+}
+
+void tst_QChangeArbiter::removeDirtyFrontEndNodes()
+{
+    // GIVEN
+    QFETCH(int, nodeCount);
+    Qt3DCore::QChangeArbiter arbiter;
+    const QVector<Qt3DCore::QNode *> nodes = createNodes(nodeCount);
+
+    // WHEN
+    QBENCHMARK {
+        for (Qt3DCore::QNode *node : nodes)
+            arbiter.addDirtyFrontEndNode(node);
+        // Remove every other node
+        for (int i = 0, m = nodes.size(); i < m; i += 2)
+            arbiter.removeDirtyFrontEndNode(nodes.at(i));
+        const QVector<Qt3DCore::QNode *> dirtyNodes = arbiter.takeDirtyFrontEndNodes();
+        Q_UNUSED(dirtyNodes);
+    }
+
+    qDeleteAll(nodes);
+}
+
+QTEST_MAIN(tst_QChangeArbiter)
+
+#include "tst_bench_qchangearbiter.moc"
@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DRender/private/frustumcullingjob_p.h>
+#include <QtCore/QRandomGenerator>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::Render;
+
+class tst_Bench_FrustumCulling : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_Bench_FrustumCulling()
+    {
+        QRandomGenerator generator(1024);
+        const int count = 1000000;
+        for (int i = 0; i < count; ++i) {
+            m_centersX.push_back(float(generator.generateDouble()) * 200.0f - 100.0f);
+            m_centersY.push_back(float(generator.generateDouble()) * 200.0f - 100.0f);
+            m_centersZ.push_back(float(generator.generateDouble()) * 200.0f - 100.0f);
+            m_radii.push_back(float(generator.generateDouble()) * 2.0f);
+        }
+
+        // Roughly a 90 degrees perspective frustum looking down -z
+        const float s = float(M_SQRT1_2);
+        m_planes[0] = Vector4D(s, 0.0f, -s, 0.0f);
+        m_planes[1] = Vector4D(-s, 0.0f, -s, 0.0f);
+        m_planes[2] = Vector4D(0.0f, s, -s, 0.0f);
+        m_planes[3] = Vector4D(0.0f, -s, -s, 0.0f);
+        m_planes[4] = Vector4D(0.0f, 0.0f, -1.0f, -0.1f);
+        m_planes[5] = Vector4D(0.0f, 0.0f, 1.0f, 100.0f);
+    }
+
+private Q_SLOTS:
+    void cullSpheres()
+    {
+        QVector<int> visibleIndices;
+        visibleIndices.reserve(m_radii.size());
+
+        QBENCHMARK {
+            visibleIndices.clear();
+            FrustumCullingJob::cullSpheres(m_centersX.constData(), m_centersY.constData(),
+                                           m_centersZ.constData(), m_radii.constData(),
+                                           0, m_radii.size(), m_planes, visibleIndices);
+        }
+    }
+
+private:
+    QVector<float> m_centersX;
+    QVector<float> m_centersY;
+    QVector<float> m_centersZ;
+    QVector<float> m_radii;
+    Vector4D m_planes[6];
+};
+
+QTEST_APPLESS_MAIN(tst_Bench_FrustumCulling)
+
+#include "tst_bench_frustumculling.moc"
@@ -37,6 +37,7 @@
 #include <Qt3DRender/QRenderSettings>
 #include <Qt3DRender/QGeometryRenderer>
 #include <Qt3DRender/private/managers_p.h>
+#include <Qt3DRender/private/entity_p.h>
 
 #include <Qt3DCore/private/qresourcemanager_p.h>
 #include <Qt3DRender/qcamera.h>
@@ -86,14 +87,20 @@ namespace Qt3DRender {
             }
         }
 
-        QVector<Qt3DCore::QAspectJobPtr> worldTransformJob()
+        QVector<Qt3DCore::QAspectJobPtr> worldTransformJob(bool parallel = true)
         {
             auto renderer = static_cast<Render::OpenGL::Renderer *>(d_func()->m_renderer);
             auto daspect = Qt3DRender::QRenderAspectPrivate::get(renderer->aspect());
             daspect->m_worldTransformJob->setRoot(d_func()->m_renderer->sceneRoot());
+            daspect->m_worldTransformJob->setParallelUpdateEnabled(parallel);
             return QVector<Qt3DCore::QAspectJobPtr>() << daspect->m_worldTransformJob;
         }
 
+        Render::NodeManagers *nodeManagers() const
+        {
+            return d_func()->m_renderer->nodeManagers();
+        }
+
         QVector<Qt3DCore::QAspectJobPtr> updateBoundingJob()
         {
             auto renderer = static_cast<Render::OpenGL::Renderer *>(d_func()->m_renderer);
@@ -235,16 +242,41 @@ Qt3DCore::QEntity *buildBigScene()
     return root;
 }
 
+void buildTransformTree(Qt3DCore::QEntity *parent, int depth, int childCount)
+{
+    if (depth == 0)
+        return;
+
+    for (int i = 0; i < childCount; ++i) {
+        Qt3DCore::QEntity *e = new Qt3DCore::QEntity(parent);
+        Qt3DCore::QTransform *transform = new Qt3DCore::QTransform();
+        transform->setTranslation(QVector3D(float(i), float(depth), 0.0f));
+        transform->setRotationY(float(i * depth));
+        e->addComponent(transform);
+        buildTransformTree(e, depth - 1, childCount);
+    }
+}
+
+Qt3DCore::QEntity *buildDeepTransformScene()
+{
+    // 8 levels with 4 children each: ~87k entities
+    Qt3DCore::QEntity *root = new Qt3DCore::QEntity();
+    buildTransformTree(root, 8, 4);
+    return root;
+}
+
 class tst_benchJobs : public QObject
 {
     Q_OBJECT
 
 private:
     Qt3DCore::QEntity *m_bigSceneRoot;
+    Qt3DCore::QEntity *m_deepSceneRoot;
 
 public:
     tst_benchJobs()
         : m_bigSceneRoot(buildBigScene())
+        , m_deepSceneRoot(buildDeepTransformScene())
     {}
 
 private Q_SLOTS:
@@ -252,21 +284,42 @@ private Q_SLOTS:
     void updateTransformJob_data()
     {
         QTest::addColumn<Qt3DCore::QEntity*>("rootEntity");
-        QTest::newRow("bigscene") << m_bigSceneRoot;
+        QTest::addColumn<bool>("parallel");
+        QTest::addColumn<int>("dirtyPercentage");
+        QTest::newRow("bigscene-serial") << m_bigSceneRoot << false << 100;
+        QTest::newRow("bigscene-parallel") << m_bigSceneRoot << true << 100;
+        QTest::newRow("deepscene-serial") << m_deepSceneRoot << false << 100;
+        QTest::newRow("deepscene-parallel") << m_deepSceneRoot << true << 100;
+        QTest::newRow("deepscene-1%-dirty-serial") << m_deepSceneRoot << false << 1;
+        QTest::newRow("deepscene-1%-dirty-parallel") << m_deepSceneRoot << true << 1;
     }
 
     void updateTransformJob()
     {
         // GIVEN
         QFETCH(Qt3DCore::QEntity*, rootEntity);
+        QFETCH(bool, parallel);
+        QFETCH(int, dirtyPercentage);
         QRenderAspectTester aspect;
 
         Qt3DCore::QAbstractAspectPrivate::get(&aspect)->setRootAndCreateNodes(qobject_cast<Qt3DCore::QEntity *>(rootEntity), {});
 
+        // Entities to flag as dirty prior to each run
+        QVector<Render::Entity *> dirtyEntities;
+        int entityCount = 0;
+        Qt3DCore::QNodeVisitor v;
+        v.traverse(rootEntity, [&](Qt3DCore::QNode *node) {
+            Render::Entity *entity = aspect.nodeManagers()->renderNodesManager()->lookupResource(node->id());
+            if (entity != nullptr && (entityCount++ % (100 / dirtyPercentage)) == 0)
+                dirtyEntities.push_back(entity);
+        });
+
         // WHEN
-        QVector<Qt3DCore::QAspectJobPtr> jobs = aspect.worldTransformJob();
+        QVector<Qt3DCore::QAspectJobPtr> jobs = aspect.worldTransformJob(parallel);
 
         QBENCHMARK {
+            for (Render::Entity *entity : qAsConst(dirtyEntities))
+                entity->markTransformDirty();
             Qt3DCore::QAbstractAspectPrivate::get(&aspect)->jobManager()->enqueueJobs(jobs);
             Qt3DCore::QAbstractAspectPrivate::get(&aspect)->jobManager()->waitForAllJobs();
         }
@@ -363,6 +416,65 @@ private Q_SLOTS:
         }
     }
 
+    void componentLookup_data()
+    {
+        QTest::addColumn<Qt3DCore::QEntity*>("rootEntity");
+        QTest::addColumn<bool>("cachedHandles");
+        QTest::newRow("bigscene-cached-handles") << m_bigSceneRoot << true;
+        QTest::newRow("bigscene-id-lookup") << m_bigSceneRoot << false;
+    }
+
+    void componentLookup()
+    {
+        // GIVEN
+        QFETCH(Qt3DCore::QEntity*, rootEntity);
+        QFETCH(bool, cachedHandles);
+        QRenderAspectTester aspect;
+
+        Qt3DCore::QAbstractAspectPrivate::get(&aspect)->setRootAndCreateNodes(qobject_cast<Qt3DCore::QEntity *>(rootEntity), {});
+
+        // As done by QRenderAspect::jobsToExecute
+        Render::NodeManagers *nodeManagers = aspect.nodeManagers();
+        const QVector<Render::HEntity> pendingEntities = nodeManagers->renderNodesManager()->takePendingComponentHandles();
+        for (const Render::HEntity &entityHandle : pendingEntities)
+            nodeManagers->renderNodesManager()->data(entityHandle)->resolveComponentHandles();
+
+        QVector<Render::Entity *> entities;
+        Qt3DCore::QNodeVisitor v;
+        v.traverse(rootEntity, [&](Qt3DCore::QNode *node) {
+            Render::Entity *entity = nodeManagers->renderNodesManager()->lookupResource(node->id());
+            if (entity != nullptr)
+                entities.push_back(entity);
+        });
+
+        // WHEN
+        // What the transform, culling and render command jobs ask of each entity
+        int found = 0;
+        QBENCHMARK {
+            found = 0;
+            if (cachedHandles) {
+                for (const Render::Entity *entity : qAsConst(entities)) {
+                    found += entity->renderComponent<Render::Transform>() != nullptr;
+                    found += entity->renderComponent<Render::GeometryRenderer>() != nullptr;
+                    found += entity->renderComponent<Render::Material>() != nullptr;
+                    found += entity->renderComponents<Render::Layer>().size();
+                }
+            } else {
+                for (const Render::Entity *entity : qAsConst(entities)) {
+                    found += nodeManagers->transformManager()->lookupResource(entity->componentUuid<Render::Transform>()) != nullptr;
+                    found += nodeManagers->geometryRendererManager()->lookupResource(entity->componentUuid<Render::GeometryRenderer>()) != nullptr;
+                    found += nodeManagers->materialManager()->lookupResource(entity->componentUuid<Render::Material>()) != nullptr;
+                    const Qt3DCore::QNodeIdVector layerIds = entity->componentsUuid<Render::Layer>();
+                    for (const Qt3DCore::QNodeId layerId : layerIds)
+                        found += nodeManagers->layerManager()->lookupResource(layerId) != nullptr;
+                }
+            }
+        }
+
+        // THEN
+        QVERIFY(found >= 3000);
+    }
+
     /*  Note: The renderer still needs to be simplified to run
         these jobs
     void renderBinJobs_data()
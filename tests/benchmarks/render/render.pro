@@ -3,5 +3,9 @@ TEMPLATE=subdirs
 qtConfig(private_tests) {
     SUBDIRS += jobs \
                layerfiltering \
-               materialparametergathering
+               materialparametergathering \
+               trianglebvh \
+               frustumculling \
+               rendercommandsorting \
+               texturedatamanager
 }
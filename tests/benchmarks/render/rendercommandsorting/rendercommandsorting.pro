@@ -0,0 +1,12 @@
+TEMPLATE = app
+
+TARGET = tst_bench_rendercommandsorting
+
+QT += core-private 3dcore 3dcore-private 3drender 3drender-private testlib
+
+CONFIG += testcase
+
+SOURCES += tst_bench_rendercommandsorting.cpp
+
+# Link Against OpenGL Renderer Plugin
+include(../../../auto/render/opengl/opengl_render_plugin.pri)
@@ -0,0 +1,101 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QTest>
+#include <renderview_p.h>
+#include <rendercommand_p.h>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::Render::OpenGL;
+
+namespace {
+
+void buildCommands(int count, QVector<RenderCommand> &commands,
+                   QVector<RenderCommandBuildData> &buildData)
+{
+    GLShader *shaders[8];
+    for (int i = 0; i < 8; ++i)
+        shaders[i] = reinterpret_cast<GLShader *>(quintptr(0x1000 * (i + 1)));
+
+    commands.reserve(count);
+    buildData.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        RenderCommand c;
+        c.m_glShader = shaders[(i * 7) % 8];
+        RenderCommandBuildData b;
+        b.m_changeCost = (i * 31) % 5;
+        b.m_depth = float((i * 7919) % 10007) * 0.01f;
+        commands.push_back(c);
+        buildData.push_back(b);
+    }
+}
+
+} // anonymous
+
+class tst_BenchRenderCommandSorting : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sort_data()
+    {
+        QTest::addColumn<QVector<QSortPolicy::SortType>>("sortTypes");
+        QTest::addColumn<int>("commandCount");
+
+        const QVector<QSortPolicy::SortType> backToFront = { QSortPolicy::BackToFront };
+        const QVector<QSortPolicy::SortType> combined = { QSortPolicy::StateChangeCost,
+                                                          QSortPolicy::Material,
+                                                          QSortPolicy::BackToFront };
+
+        QTest::newRow("BackToFront-1000") << backToFront << 1000;
+        QTest::newRow("BackToFront-100000") << backToFront << 100000;
+        QTest::newRow("StateMaterialBackToFront-1000") << combined << 1000;
+        QTest::newRow("StateMaterialBackToFront-100000") << combined << 100000;
+    }
+
+    void sort()
+    {
+        QFETCH(QVector<QSortPolicy::SortType>, sortTypes);
+        QFETCH(int, commandCount);
+
+        QVector<RenderCommand> commands;
+        QVector<RenderCommandBuildData> buildData;
+        buildCommands(commandCount, commands, buildData);
+        RenderView renderView;
+        renderView.addSortType(sortTypes);
+
+        QBENCHMARK {
+            renderView.setCommands(commands, buildData);
+            renderView.sort();
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_BenchRenderCommandSorting)
+
+#include "tst_bench_rendercommandsorting.moc"
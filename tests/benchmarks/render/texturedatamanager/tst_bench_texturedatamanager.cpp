@@ -0,0 +1,88 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QtTest/QTest>
+#include <Qt3DRender/private/texturedatamanager_p.h>
+#include <Qt3DRender/private/qtextureimage_p.h>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::Render;
+
+class tst_BenchTextureDataManager : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void registerAndRelease_data()
+    {
+        QTest::addColumn<int>("textureCount");
+        QTest::addColumn<int>("generatorCount");
+
+        QTest::newRow("10000-textures-unique") << 10000 << 10000;
+        QTest::newRow("100000-textures-unique") << 100000 << 100000;
+        QTest::newRow("100000-textures-shared") << 100000 << 1000;
+    }
+
+    void registerAndRelease()
+    {
+        QFETCH(int, textureCount);
+        QFETCH(int, generatorCount);
+
+        // Each texture gets its own generator instance, generators
+        // referring to the same image compare equal
+        QVector<QTextureImageDataGeneratorPtr> generators;
+        QVector<Qt3DCore::QNodeId> textureIds;
+        generators.reserve(textureCount);
+        textureIds.reserve(textureCount);
+        for (int i = 0; i < textureCount; ++i) {
+            generators.push_back(QSharedPointer<QImageTextureDataFunctor>::create(
+                                      QUrl(QStringLiteral("qrc:/image%1.png").arg(i % generatorCount)), false));
+            textureIds.push_back(Qt3DCore::QNodeId::createId());
+        }
+
+        QBENCHMARK {
+            TextureImageDataManager manager;
+            for (int i = 0; i < textureCount; ++i)
+                manager.requestData(generators.at(i), textureIds.at(i));
+
+            const QVector<QTextureImageDataGeneratorPtr> pending = manager.pendingGenerators();
+            QCOMPARE(pending.size(), generatorCount);
+            for (const QTextureImageDataGeneratorPtr &generator : pending)
+                manager.assignData(generator, QTextureImageDataPtr());
+
+            for (int i = 0; i < textureCount; ++i)
+                manager.releaseData(generators.at(i), textureIds.at(i));
+            QVERIFY(!manager.contains(generators.first()));
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_BenchTextureDataManager)
+
+#include "tst_bench_texturedatamanager.moc"
@@ -0,0 +1,170 @@
+/****************************************************************************
+**
+** Copyright (C) 2020 Klaralvdalens Datakonsult AB (KDAB).
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the Qt3D module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtTest/QtTest>
+#include <Qt3DRender/private/trianglebvh_p.h>
+#include <Qt3DRender/private/triangleboundingvolume_p.h>
+#include <Qt3DRender/private/qray3d_p.h>
+#include <QtCore/QRandomGenerator>
+#include <cmath>
+
+using namespace Qt3DRender;
+using namespace Qt3DRender::RayCasting;
+
+namespace {
+
+// Wavy height field of 2 * resolution^2 triangles spanning [-1, 1] on x and y
+QVector<TriangleBvh::Triangle> heightField(int resolution)
+{
+    const auto vertex = [resolution] (int x, int y) {
+        const float fx = 2.0f * x / resolution - 1.0f;
+        const float fy = 2.0f * y / resolution - 1.0f;
+        return Vector3D(fx, fy, 0.1f * std::sin(fx * 10.0f) * std::cos(fy * 10.0f));
+    };
+
+    QVector<TriangleBvh::Triangle> triangles;
+    triangles.reserve(2 * resolution * resolution);
+    const auto addTriangle = [&triangles] (const Vector3D &a, const Vector3D &b, const Vector3D &c) {
+        TriangleBvh::Triangle triangle;
+        const Vector3D vertices[3] = { a, b, c };
+        for (int i = 0; i < 3; ++i) {
+            triangle.vertices[i][0] = vertices[i].x();
+            triangle.vertices[i][1] = vertices[i].y();
+            triangle.vertices[i][2] = vertices[i].z();
+            triangle.vertexIndices[i] = uint(triangles.size() * 3 + i);
+        }
+        triangle.primitiveIndex = uint(triangles.size());
+        triangles.push_back(triangle);
+    };
+
+    for (int y = 0; y < resolution; ++y) {
+        for (int x = 0; x < resolution; ++x) {
+            addTriangle(vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1));
+            addTriangle(vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1));
+        }
+    }
+    return triangles;
+}
+
+// Rays looking down on the height field from random spots above it
+QVector<QRay3D> pickingRays(int count)
+{
+    QRandomGenerator generator(1337);
+    QVector<QRay3D> rays;
+    rays.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        const Vector3D origin(float(generator.generateDouble()) * 2.0f - 1.0f,
+                              float(generator.generateDouble()) * 2.0f - 1.0f,
+                              2.0f);
+        const Vector3D direction(float(generator.generateDouble()) * 0.4f - 0.2f,
+                                 float(generator.generateDouble()) * 0.4f - 0.2f,
+                                 -1.0f);
+        rays.push_back(QRay3D(origin, direction, 10.0f));
+    }
+    return rays;
+}
+
+int intersect(const QRay3D &ray, const TriangleBvh::Triangle &triangle)
+{
+    Vector3D uvw;
+    float t = 0.0f;
+    return Render::intersectsSegmentTriangle(ray, triangle.vertex(0), triangle.vertex(1), triangle.vertex(2), uvw, t) ? 1 : 0;
+}
+
+} // anonymous
+
+class tst_BenchTriangleBvh : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+
+    void build_data()
+    {
+        QTest::addColumn<int>("resolution");
+
+        QTest::newRow("2K triangles") << 32;
+        QTest::newRow("32K triangles") << 128;
+        QTest::newRow("512K triangles") << 512;
+    }
+
+    void build()
+    {
+        QFETCH(int, resolution);
+        const QVector<TriangleBvh::Triangle> triangles = heightField(resolution);
+
+        QBENCHMARK {
+            TriangleBvh bvh(triangles);
+            Q_UNUSED(bvh);
+        }
+    }
+
+    void rayCast_data()
+    {
+        QTest::addColumn<int>("resolution");
+        QTest::addColumn<bool>("useBvh");
+
+        QTest::newRow("2K triangles - brute force") << 32 << false;
+        QTest::newRow("2K triangles - BVH") << 32 << true;
+        QTest::newRow("32K triangles - brute force") << 128 << false;
+        QTest::newRow("32K triangles - BVH") << 128 << true;
+        QTest::newRow("512K triangles - brute force") << 512 << false;
+        QTest::newRow("512K triangles - BVH") << 512 << true;
+    }
+
+    void rayCast()
+    {
+        QFETCH(int, resolution);
+        QFETCH(bool, useBvh);
+
+        const QVector<TriangleBvh::Triangle> triangles = heightField(resolution);
+        const TriangleBvh bvh(triangles);
+        const QVector<QRay3D> rays = pickingRays(100);
+        int hitCount = 0;
+
+        QBENCHMARK {
+            hitCount = 0;
+            for (const QRay3D &ray : rays) {
+                if (useBvh) {
+                    bvh.traverse(ray, [&] (const TriangleBvh::Triangle &triangle) {
+                        hitCount += intersect(ray, triangle);
+                    });
+                } else {
+                    for (const TriangleBvh::Triangle &triangle : triangles)
+                        hitCount += intersect(ray, triangle);
+                }
+            }
+        }
+
+        // Every ray ends up on the height field
+        QVERIFY(hitCount >= rays.size());
+    }
+};
+
+QTEST_APPLESS_MAIN(tst_BenchTriangleBvh)
+
+#include "tst_bench_trianglebvh.moc"